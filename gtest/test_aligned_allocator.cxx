@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "../src/aligned_allocator.hxx"
+#include "../src/deque.hxx"
+#include "../src/list.hxx"
+#include "../src/small_vector.hxx"
+#include "../src/string.hxx"
+#include "../src/tracking_allocator.hxx"
+#include "../src/vector.hxx"
+
+
+
+static bool is_aligned(const void* p, size_t alignment)
+{
+	return ( reinterpret_cast<size_t>(p) % alignment ) == 0;
+}
+
+
+/// Exactly one cache line, so every element in an aligned chunk is itself aligned
+class line
+{
+	public:
+
+		line(char c = 0) { bytes[0] = c; }
+
+		char bytes[64];
+};
+
+
+
+TEST(AlignedAllocator, blocksAreAligned)
+{
+	dstd::aligned_allocator<char, 128> a;
+	for(size_t n = 1; n < 1000; n = n * 3 + 1)
+	{
+		char* p = a.allocate(n);
+		ASSERT_TRUE( is_aligned(p, 128) );
+		a.deallocate(p, n);
+	}
+	ASSERT_THROW( a.allocate( static_cast<size_t>(-1) ), dstd::bad_alloc );
+}
+
+
+TEST(AlignedAllocator, rebindKeepsAlignment)
+{
+	typedef dstd::aligned_allocator<char, 64>::rebind<double>::other rebound;
+	ASSERT_EQ( 64, rebound::alignment );
+	ASSERT_EQ( 16, (dstd::aligned_allocator<long double, 8>::alignment) );
+	ASSERT_TRUE( (dstd::aligned_allocator<char, 64>() == rebound()) );
+}
+
+
+TEST(AlignedAllocator, vectorDataStaysAlignedThroughGrowth)
+{
+	dstd::vector< float, dstd::aligned_allocator<float, 64> > v;
+	for(int i = 0; i != 1000; ++i)
+	{
+		v.push_back( static_cast<float>(i) );
+		ASSERT_TRUE( is_aligned(&v[0], 64) );
+	}
+	v.resize(10);
+	v.shrink_to_fit();
+	ASSERT_TRUE( is_aligned(&v[0], 64) );
+	ASSERT_EQ( 9.0f, v.back() );
+}
+
+
+TEST(AlignedAllocator, smallVectorInlineStorageIsAligned)
+{
+	dstd::small_vector< float, 4, dstd::aligned_allocator<float, 64> > v;
+	v.push_back(1.0f);
+	ASSERT_TRUE( v.is_inline() );
+	ASSERT_TRUE( is_aligned(&v[0], 64) );
+}
+
+
+TEST(AlignedAllocator, trackingAllocatorKeepsTheAlignment)
+{
+	typedef dstd::tracking_allocator< float, dstd::aligned_allocator<float, 64> > tracked;
+	ASSERT_EQ( 64, tracked::alignment );
+	ASSERT_EQ( 64, tracked::rebind<char>::other::alignment );
+	ASSERT_EQ( alignof(float), dstd::tracking_allocator<float>::alignment );
+
+	dstd::small_vector< float, 4, tracked > v;
+	v.push_back(1.0f);
+	ASSERT_TRUE( v.is_inline() );
+	ASSERT_TRUE( is_aligned(&v[0], 64) );
+}
+
+
+TEST(AlignedAllocator, stringDataIsAligned)
+{
+	dstd::basic_string< char, dstd::char_traits<char>, dstd::aligned_allocator<char, 64> > s;
+	for(int i = 0; i != 200; ++i)
+	{
+		s.push_back('a');
+		ASSERT_TRUE( is_aligned(s.data(), 64) );
+	}
+}
+
+
+TEST(AlignedAllocator, dequeChunksAreAligned)
+{
+	dstd::deque< line, dstd::aligned_allocator<line, 64> > d;
+	for(int i = 0; i != 100; ++i)
+	{
+		d.push_back( line('b') );
+		d.push_front( line('f') );
+	}
+	for(size_t i = 0; i != d.size(); ++i) ASSERT_TRUE( is_aligned(&d[i], 64) );
+}
+
+
+TEST(AlignedAllocator, listNodesUseTheReboundAllocator)
+{
+	dstd::list< int, dstd::aligned_allocator<int, 64> > l;
+	for(int i = 0; i != 10; ++i) l.push_back(i);
+	for(dstd::list< int, dstd::aligned_allocator<int, 64> >::iterator it = l.begin(); it != l.end(); ++it)
+	{
+		ASSERT_EQ( 0, reinterpret_cast<size_t>(&(*it)) % alignof(int) );
+	}
+	ASSERT_EQ( 9, l.back() );
+}
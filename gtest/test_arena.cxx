@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include "../src/arena.hxx"
+#include "../src/deque.hxx"
+#include "../src/list.hxx"
+#include "../src/map.hxx"
+#include "../src/string.hxx"
+#include "../src/vector.hxx"
+
+
+
+typedef dstd::basic_string< char, dstd::char_traits<char>, dstd::arena_allocator<char> > arena_string;
+
+
+
+TEST(Arena, allocationsAreAlignedAndDistinct)
+{
+	dstd::arena arena(256);
+	char* c = static_cast<char*>( arena.allocate(1, 1) );
+	double* d = static_cast<double*>( arena.allocate(sizeof(double), alignof(double)) );
+	char* e = static_cast<char*>( arena.allocate(3, 1) );
+
+	ASSERT_EQ( 0, reinterpret_cast<size_t>(d) % alignof(double) );
+	ASSERT_LT( c, reinterpret_cast<char*>(d) );
+	ASSERT_LE( reinterpret_cast<char*>(d + 1), e );
+}
+
+
+TEST(Arena, allocationLargerThanChunkGetsItsOwnChunk)
+{
+	dstd::arena arena(64);
+	arena.allocate(16, 8);
+	char* big = static_cast<char*>( arena.allocate(1000, 8) );
+	big[0] = 'a';
+	big[999] = 'z';
+	ASSERT_LE( 64 + 1000, arena.capacity() );
+}
+
+
+TEST(Arena, resetKeepsFirstChunkAndReusesIt)
+{
+	dstd::arena arena(128);
+	void* first = arena.allocate(8, 8);
+	for(int i = 0; i < 100; ++i)
+	{
+		arena.allocate(64, 8);
+	}
+	ASSERT_LT( 128, arena.capacity() );
+
+	arena.reset();
+
+	ASSERT_EQ( 128, arena.capacity() );
+	ASSERT_EQ( first, arena.allocate(8, 8) );
+}
+
+
+TEST(ArenaAllocator, reboundAllocatorsShareTheArena)
+{
+	dstd::arena a1;
+	dstd::arena a2;
+	dstd::arena_allocator<int> x(a1);
+	dstd::arena_allocator<int>::rebind<double>::other y(x);
+	dstd::arena_allocator<int> z(a2);
+
+	ASSERT_TRUE( x == y );
+	ASSERT_TRUE( x != z );
+	ASSERT_EQ( &a1, &y.get_arena() );
+}
+
+
+TEST(ArenaAllocator, vectorAllocatesFromArena)
+{
+	dstd::arena arena;
+	dstd::vector< int, dstd::arena_allocator<int> > v( (dstd::arena_allocator<int>(arena)) );
+	for(int i = 0; i < 1000; ++i)
+	{
+		v.push_back(i);
+	}
+	ASSERT_EQ( 999, v[999] );
+	ASSERT_LT( 0, arena.capacity() );
+
+	dstd::vector< int, dstd::arena_allocator<int> > copy(v);
+	ASSERT_TRUE( copy.get_allocator() == v.get_allocator() );
+	ASSERT_EQ( 1000, copy.size() );
+}
+
+
+TEST(ArenaAllocator, copyAssignmentKeepsOwnAllocatorAndSwapExchangesThem)
+{
+	dstd::arena a1;
+	dstd::arena a2;
+	dstd::vector< int, dstd::arena_allocator<int> > v1( (dstd::arena_allocator<int>(a1)) );
+	dstd::vector< int, dstd::arena_allocator<int> > v2( (dstd::arena_allocator<int>(a2)) );
+	v1.push_back(1);
+	v2.push_back(2);
+	v2.push_back(3);
+
+	v1 = v2;
+	ASSERT_EQ( &a1, &v1.get_allocator().get_arena() );
+	ASSERT_EQ( 2, v1.size() );
+
+	v1.push_back(4);
+	v1.swap(v2);
+	ASSERT_EQ( &a2, &v1.get_allocator().get_arena() );
+	ASSERT_EQ( &a1, &v2.get_allocator().get_arena() );
+	ASSERT_EQ( 2, v1.size() );
+	ASSERT_EQ( 4, v2.back() );
+}
+
+
+TEST(ArenaAllocator, stringAllocatesFromArena)
+{
+	dstd::arena arena;
+	arena_string s( "hello", dstd::arena_allocator<char>(arena) );
+	for(int i = 0; i < 100; ++i)
+	{
+		s.push_back('!');
+	}
+	ASSERT_EQ( 105, s.size() );
+
+	arena_string copy(s);
+	ASSERT_TRUE( copy.get_allocator() == s.get_allocator() );
+	ASSERT_EQ( 'h', copy[0] );
+}
+
+
+TEST(ArenaAllocator, lastAllocationGrowsAndShrinksInPlace)
+{
+	dstd::arena arena;
+	dstd::vector< int, dstd::arena_allocator<int> > v( (dstd::arena_allocator<int>(arena)) );
+	v.push_back(1);
+	const int* data = &v[0];
+	
+	for(int i = 0; i < 1000; ++i) v.push_back(i);
+	ASSERT_EQ( data, &v[0] );
+	
+	v.resize(10);
+	v.shrink_to_fit();
+	ASSERT_EQ( 10, v.capacity() );
+	
+	int* next = static_cast<int*>( arena.allocate(sizeof(int), alignof(int)) );
+	ASSERT_EQ( data + 10, next );
+}
+
+
+TEST(ArenaAllocator, stringGrowsInPlace)
+{
+	dstd::arena arena;
+	arena_string s( "hello", dstd::arena_allocator<char>(arena) );
+	const char* data = s.data();
+	for(int i = 0; i < 1000; ++i)
+	{
+		s.push_back('!');
+	}
+	ASSERT_EQ( data, s.data() );
+	ASSERT_EQ( 1005, s.size() );
+	
+	s.erase(5);
+	s.shrink_to_fit();
+	ASSERT_EQ( 5, s.capacity() );
+	ASSERT_EQ( 0, s.c_str()[5] );
+}
+
+
+TEST(ArenaAllocator, mapListAndDequeAllocateFromArena)
+{
+	dstd::arena arena;
+
+	const dstd::less<int> compare;
+	const dstd::arena_allocator< dstd::pair<int,int> > alloc(arena);
+	dstd::map< int, int, dstd::less<int>, dstd::arena_allocator< dstd::pair<int,int> > > m(compare, alloc);
+	dstd::list< int, dstd::arena_allocator<int> > l( (dstd::arena_allocator<int>(arena)) );
+	dstd::deque< int, dstd::arena_allocator<int> > d( (dstd::arena_allocator<int>(arena)) );
+	for(int i = 0; i < 1000; ++i)
+	{
+		m[i] = i;
+		l.push_back(i);
+		d.push_front(i);
+	}
+	ASSERT_EQ( 1000, m.size() );
+	ASSERT_EQ( 999, l.back() );
+	ASSERT_EQ( 999, d.front() );
+
+	dstd::map< int, int, dstd::less<int>, dstd::arena_allocator< dstd::pair<int,int> > > map_copy(m);
+	dstd::list< int, dstd::arena_allocator<int> > list_copy(l);
+	dstd::deque< int, dstd::arena_allocator<int> > deque_copy(d);
+	ASSERT_TRUE( map_copy.get_allocator() == m.get_allocator() );
+	ASSERT_TRUE( list_copy.get_allocator() == l.get_allocator() );
+	ASSERT_TRUE( deque_copy.get_allocator() == d.get_allocator() );
+	ASSERT_EQ( 1000, map_copy.size() );
+	ASSERT_EQ( 1000, list_copy.size() );
+	ASSERT_EQ( 1000, deque_copy.size() );
+}
@@ -0,0 +1,325 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <map>
+#include "../src/btree_map.hxx"
+#include "../src/btree_set.hxx"
+#include "../src/string.hxx"
+#include "../src/tracking_allocator.hxx"
+
+
+
+/// Checks a btree_map against a std::map holding the same elements, in both directions of iteration
+template <class Key, class T>
+::testing::AssertionResult same_contents(const dstd::btree_map<Key,T>& test_map, const std::map<Key,T>& expected)
+{
+	if( test_map.size() != expected.size() ) return ::testing::AssertionFailure() << "size " << test_map.size() << " != " << expected.size();
+
+	typename dstd::btree_map<Key,T>::const_iterator it = test_map.begin();
+	for(typename std::map<Key,T>::const_iterator e = expected.begin(); e != expected.end(); ++e, ++it)
+	{
+		if( it == test_map.end() || it->first != e->first || it->second != e->second )
+		{
+			return ::testing::AssertionFailure() << "mismatch at key " << e->first;
+		}
+	}
+	if( it != test_map.end() ) return ::testing::AssertionFailure() << "too many elements";
+
+	typename dstd::btree_map<Key,T>::const_iterator back = test_map.end();
+	for(typename std::map<Key,T>::const_reverse_iterator e = expected.rbegin(); e != expected.rend(); ++e)
+	{
+		--back;
+		if( back->first != e->first ) return ::testing::AssertionFailure() << "reverse mismatch at key " << e->first;
+	}
+	return ::testing::AssertionSuccess();
+}
+
+
+
+class BtreeMap : public ::testing::Test
+{
+	protected:
+
+		void SetUp()
+		{
+			for(int i = 0; i < 1000; ++i)
+			{
+				thousand_squares[i] = i*i;
+			}
+		}
+
+		dstd::btree_map<int, int> empty;
+		dstd::btree_map<int, int> thousand_squares;
+};
+
+
+
+TEST_F(BtreeMap, constructorDefaultCreatesEmptyMap)
+{
+	ASSERT_TRUE( empty.empty() );
+	ASSERT_EQ( 0, empty.size() );
+	ASSERT_TRUE( empty.begin() == empty.end() );
+}
+
+
+TEST_F(BtreeMap, constructorCopyCreatesIdenticalMap)
+{
+	dstd::btree_map<int, int> test_map(thousand_squares);
+	ASSERT_TRUE( test_map == thousand_squares );
+}
+
+
+TEST_F(BtreeMap, assignmentOperatorCopiesValue)
+{
+	empty = thousand_squares;
+	ASSERT_TRUE( empty == thousand_squares );
+}
+
+
+TEST_F(BtreeMap, operatorSQBReturnsExistingValueForExistingKey)
+{
+	ASSERT_EQ( 49, thousand_squares[7] );
+	ASSERT_EQ( 1000, thousand_squares.size() );
+}
+
+
+TEST_F(BtreeMap, insertValueDoesNotInsertForExistingKey)
+{
+	dstd::pair<dstd::btree_map<int,int>::iterator, bool> result = thousand_squares.insert( dstd::pair<int,int>(10, -1) );
+	ASSERT_FALSE( result.second );
+	ASSERT_EQ( 100, result.first->second );
+}
+
+
+TEST_F(BtreeMap, iterationVisitsKeysInOrder)
+{
+	int expected = 0;
+	for(dstd::btree_map<int,int>::const_iterator it = thousand_squares.begin(); it != thousand_squares.end(); ++it, ++expected)
+	{
+		ASSERT_EQ( expected, it->first );
+	}
+	ASSERT_EQ( 1000, expected );
+	ASSERT_EQ( 999, thousand_squares.rbegin()->first );
+}
+
+
+TEST_F(BtreeMap, findReturnsEndForNonExistantKey)
+{
+	ASSERT_TRUE( thousand_squares.find(-1) == thousand_squares.end() );
+	ASSERT_TRUE( thousand_squares.find(1000) == thousand_squares.end() );
+	ASSERT_EQ( 250000, thousand_squares.find(500)->second );
+}
+
+
+TEST_F(BtreeMap, lowerAndUpperBoundFindNeighbouringKeys)
+{
+	dstd::btree_map<int, int> evens;
+	for(int i = 0; i < 1000; i += 2)
+	{
+		evens[i] = i;
+	}
+	ASSERT_EQ( 502, evens.lower_bound(501)->first );
+	ASSERT_EQ( 500, evens.lower_bound(500)->first );
+	ASSERT_EQ( 502, evens.upper_bound(500)->first );
+	ASSERT_TRUE( evens.upper_bound(998) == evens.end() );
+	ASSERT_EQ( 0, evens.upper_bound(-5)->first );
+
+	dstd::pair<dstd::btree_map<int,int>::iterator, dstd::btree_map<int,int>::iterator> range = evens.equal_range(501);
+	ASSERT_TRUE( range.first == range.second );
+}
+
+
+TEST_F(BtreeMap, eraseKeyRemovesOnlyThatElement)
+{
+	ASSERT_EQ( 1, thousand_squares.erase(500) );
+	ASSERT_EQ( 0, thousand_squares.erase(500) );
+	ASSERT_EQ( 999, thousand_squares.size() );
+	ASSERT_EQ( 0, thousand_squares.count(500) );
+	ASSERT_EQ( 1, thousand_squares.count(501) );
+}
+
+
+TEST_F(BtreeMap, eraseIteratorIteratorRemovesOnlyElementsInRange)
+{
+	dstd::btree_map<int,int>::iterator next = thousand_squares.erase( thousand_squares.find(100), thousand_squares.find(900) );
+	ASSERT_EQ( 900, next->first );
+	ASSERT_EQ( 200, thousand_squares.size() );
+	ASSERT_EQ( 99, (--thousand_squares.find(900))->first );
+}
+
+
+TEST_F(BtreeMap, eraseAllLeavesMapEmpty)
+{
+	for(int i = 0; i < 1000; ++i)
+	{
+		thousand_squares.erase( thousand_squares.begin() );
+	}
+	ASSERT_TRUE( thousand_squares.empty() );
+	ASSERT_TRUE( thousand_squares.begin() == thousand_squares.end() );
+}
+
+
+TEST_F(BtreeMap, swapExchangesMapContents)
+{
+	dstd::btree_map<int,int> copy(thousand_squares);
+	empty[1] = 2;
+	dstd::swap(empty, thousand_squares);
+	ASSERT_TRUE( empty == copy );
+	ASSERT_EQ( 1, thousand_squares.size() );
+	ASSERT_EQ( 2, thousand_squares.begin()->second );
+}
+
+
+TEST_F(BtreeMap, randomInsertAndEraseMatchesStdMap)
+{
+	dstd::btree_map<int, int> test_map;
+	std::map<int, int> expected;
+
+	std::srand(3);
+	for(int i = 0; i < 20000; ++i)
+	{
+		const int k = std::rand() % 3000;
+		if( std::rand() % 3 == 0 )
+		{
+			ASSERT_EQ( expected.erase(k), test_map.erase(k) );
+		}
+		else
+		{
+			expected[k] = i;
+			test_map[k] = i;
+		}
+	}
+	ASSERT_TRUE( same_contents(test_map, expected) );
+
+	while( ! expected.empty() )
+	{
+		const int k = expected.begin()->first + std::rand() % 50;
+		std::map<int,int>::iterator e = expected.lower_bound(k);
+		if( e == expected.end() ) continue;
+		dstd::btree_map<int,int>::iterator next = test_map.erase( test_map.find(e->first) );
+		expected.erase(e++);
+		ASSERT_TRUE( (e == expected.end() && next == test_map.end()) || next->first == e->first );
+	}
+	ASSERT_TRUE( test_map.empty() );
+}
+
+
+
+TEST(BtreeMultimap, insertKeepsEqualKeysInInsertionOrder)
+{
+	dstd::btree_multimap<int, int> test_map;
+	for(int i = 0; i < 600; ++i)
+	{
+		test_map.insert( dstd::pair<int,int>(i % 3, i) );
+	}
+	ASSERT_EQ( 600, test_map.size() );
+	ASSERT_EQ( 200, test_map.count(1) );
+
+	int previous = -1;
+	dstd::pair<dstd::btree_multimap<int,int>::iterator, dstd::btree_multimap<int,int>::iterator> range = test_map.equal_range(1);
+	for( ; range.first != range.second; ++range.first)
+	{
+		ASSERT_EQ( 1, range.first->first );
+		ASSERT_LT( previous, range.first->second );
+		previous = range.first->second;
+	}
+
+	ASSERT_EQ( 200, test_map.erase(1) );
+	ASSERT_EQ( 400, test_map.size() );
+	ASSERT_EQ( 0, test_map.count(1) );
+}
+
+
+
+TEST(BtreeSet, insertAndEraseKeepOrder)
+{
+	dstd::btree_set<int> s;
+	for(int i = 999; i >= 0; --i)
+	{
+		ASSERT_TRUE( s.insert(i).second );
+	}
+	ASSERT_FALSE( s.insert(3).second );
+
+	for(int i = 0; i < 1000; i += 2)
+	{
+		ASSERT_EQ( 1, s.erase(i) );
+	}
+
+	int expected = 1;
+	for(dstd::btree_set<int>::const_iterator it = s.begin(); it != s.end(); ++it, expected += 2)
+	{
+		ASSERT_EQ( expected, *it );
+	}
+	ASSERT_EQ( 1001, expected );
+}
+
+
+TEST(BtreeMultiset, countReturnsNumberOfEqualKeys)
+{
+	dstd::btree_multiset<int> s;
+	for(int i = 0; i < 300; ++i)
+	{
+		s.insert(i % 7);
+	}
+	ASSERT_EQ( 43, s.count(0) );
+	ASSERT_EQ( 42, s.count(6) );
+	ASSERT_EQ( 0, s.count(7) );
+}
+
+
+TEST(BtreeSet, keysInsertedInOrderFillTheLeaves)
+{
+	const size_t leaf_capacity = dstd::impl::btree_node_capacity<int>::value;
+	const int n = 100000;
+	dstd::allocation_stats stats;
+	{
+		typedef dstd::btree_set< int, dstd::less<int>, dstd::tracking_allocator<int> > tracked_set;
+		tracked_set s( (dstd::less<int>()), dstd::tracking_allocator<int>(stats) );
+		for(int i = 0; i != n; ++i) s.insert(i);
+		ASSERT_EQ( n, s.size() );
+
+		// Half full leaves would take twice as many nodes
+		ASSERT_GE( n / leaf_capacity + n / leaf_capacity / 4, stats.allocations() );
+
+		int expected = 0;
+		for(tracked_set::const_iterator it = s.begin(); it != s.end(); ++it) ASSERT_EQ( expected++, *it );
+
+		for(int i = 0; i < n; i += 3) ASSERT_EQ( 1, s.erase(i) );
+		ASSERT_TRUE( s.find(3) == s.end() );
+		ASSERT_TRUE( s.find(4) != s.end() );
+	}
+	ASSERT_EQ( stats.allocations(), stats.deallocations() );
+}
+
+
+TEST(BtreeSet, swapExchangesTheAllocators)
+{
+	typedef dstd::btree_set< int, dstd::less<int>, dstd::tracking_allocator<int> > tracked_set;
+	dstd::allocation_stats stats_a;
+	dstd::allocation_stats stats_b;
+	{
+		tracked_set a( (dstd::less<int>()), dstd::tracking_allocator<int>(stats_a) );
+		tracked_set b( (dstd::less<int>()), dstd::tracking_allocator<int>(stats_b) );
+		for(int i = 0; i < 1000; ++i) a.insert(i);
+		b.insert(-1);
+
+		a.swap(b);
+		for(int i = 0; i < 1000; ++i) a.insert(-2 - i);
+		b.clear();
+	}
+	ASSERT_EQ( stats_a.allocations(), stats_a.deallocations() );
+	ASSERT_EQ( 0, stats_a.live_bytes() );
+	ASSERT_EQ( stats_b.allocations(), stats_b.deallocations() );
+	ASSERT_EQ( 0, stats_b.live_bytes() );
+}
+
+
+TEST_F(BtreeMap, operatorSQBInsertsWithOneSearch)
+{
+	dstd::btree_map<int, dstd::string> m;
+	for(int i = 0; i != 1000; ++i) m[(i * 7919) % 1000] = "x";
+	ASSERT_EQ( 1000, m.size() );
+	m[500] += "y";
+	ASSERT_EQ( dstd::string("xy"), m[500] );
+	ASSERT_TRUE( m[1000].empty() );
+	ASSERT_EQ( 1001, m.size() );
+}
@@ -0,0 +1,587 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include "../src/algorithm.hxx"
+#include "../src/deque.hxx"
+#include "../src/list.hxx"
+#include "../src/queue.hxx"
+#include "../src/tracking_allocator.hxx"
+#include "../src/vector.hxx"
+
+
+
+typedef dstd::deque< int, dstd::tracking_allocator<int> > tracked_deque;
+
+
+/// Asserts that d holds the same elements as v, in the same order.
+template <class Deque>
+void assert_same(const dstd::vector<int>& v, const Deque& d)
+{
+	ASSERT_EQ( v.size(), d.size() );
+	for(size_t i = 0; i != v.size(); ++i) ASSERT_EQ( v[i], d[i] ) << "at " << i;
+}
+
+
+/// Sums the values it is called with, to check for_each visits every element once, in order.
+class summer
+{
+	public:
+
+		summer() : sum(0), previous(-1), in_order(true) {}
+
+		void operator() (int x)
+		{
+			if( x <= previous ) in_order = false;
+			previous = x;
+			sum += x;
+		}
+
+		long sum;
+		int previous;
+		bool in_order;
+};
+
+
+static bool is_odd(int x)
+{
+	return ( x % 2 ) != 0;
+}
+
+
+/// Asserts that d holds the same elements as the std::deque expected, reached both by index and by walking from begin to end.
+template <class Deque>
+void assert_same(const std::deque<int>& expected, const Deque& d)
+{
+	ASSERT_EQ( expected.size(), d.size() );
+	typename Deque::const_iterator it = d.begin();
+	for(size_t i = 0; i != expected.size(); ++i, ++it)
+	{
+		ASSERT_EQ( expected[i], d[i] ) << "at " << i;
+		ASSERT_EQ( expected[i], *it ) << "at " << i;
+	}
+	ASSERT_TRUE( it == d.end() );
+}
+
+
+/// Applies the same random inserts and erases to a deque and to a std::deque, and compares them after each.
+template <class Deque>
+void insert_and_erase_like_std_deque()
+{
+	Deque d;
+	std::deque<int> expected;
+	unsigned int seed = 12345;
+
+	for(int round = 0; round != 400; ++round)
+	{
+		seed = seed * 1103515245 + 12345;
+		const unsigned int r = seed >> 8;
+		const size_t at = expected.empty() ? 0 : r % (expected.size() + 1);
+		const size_t n = (r >> 12) % 40;
+
+		if( r % 3 != 0 || expected.size() < n )
+		{
+			d.insert(d.begin() + at, n, round);
+			expected.insert(expected.begin() + at, n, round);
+		}
+		else
+		{
+			const size_t from = (at + n > expected.size()) ? expected.size() - n : at;
+			d.erase(d.begin() + from, d.begin() + from + n);
+			expected.erase(expected.begin() + from, expected.begin() + from + n);
+		}
+		assert_same(expected, d);
+		if( ::testing::Test::HasFatalFailure() ) return;
+
+		d.push_back(-round);
+		expected.push_back(-round);
+	}
+}
+
+
+
+TEST(Deque, pushAndPopAtBothEnds)
+{
+	dstd::deque<int> d;
+	for(int i = 0; i != 1000; ++i)
+	{
+		d.push_back(i);
+		d.push_front(-i - 1);
+	}
+	ASSERT_EQ( 2000, d.size() );
+	for(int i = 0; i != 2000; ++i) ASSERT_EQ( i - 1000, d[i] );
+
+	for(int i = 0; i != 600; ++i) d.pop_front();
+	for(int i = 0; i != 600; ++i) d.pop_back();
+	ASSERT_EQ( 800, d.size() );
+	ASSERT_EQ( -400, d.front() );
+	ASSERT_EQ( 399, d.back() );
+
+	for(int i = 0; i != 5000; ++i) d.push_front(i);
+	ASSERT_EQ( 4999, d.front() );
+	ASSERT_EQ( 399, d.back() );
+}
+
+
+TEST(Deque, destructorFreesEveryChunkAndTheMap)
+{
+	dstd::allocation_stats stats;
+	{
+		tracked_deque d( (dstd::tracking_allocator<int>(stats)) );
+		for(int i = 0; i != 10000; ++i)
+		{
+			d.push_back(i);
+			d.push_front(i);
+		}
+		d.clear();
+		for(int i = 0; i != 100; ++i) d.push_back(i);
+	}
+	ASSERT_EQ( stats.allocations(), stats.deallocations() );
+	ASSERT_EQ( 0, stats.live_bytes() );
+}
+
+
+TEST(Deque, moveTakesTheChunksWithoutAllocating)
+{
+	dstd::allocation_stats stats;
+	{
+		tracked_deque d( (dstd::tracking_allocator<int>(stats)) );
+		for(int i = 0; i != 1000; ++i) d.push_back(i);
+		const dstd::allocation_stats::size_type allocations = stats.allocations();
+		
+		tracked_deque moved( dstd::move(d) );
+		d = dstd::move(moved);
+		moved = dstd::move(d);
+		
+		ASSERT_TRUE( dstd::is_nothrow_move_constructible<tracked_deque>::value );
+		ASSERT_EQ( allocations, stats.allocations() );
+		ASSERT_EQ( 1000, moved.size() );
+		ASSERT_EQ( 999, moved.back() );
+		
+		// the moved-from deque has no chunks until it is used again
+		ASSERT_TRUE( d.empty() );
+		ASSERT_EQ( d.begin(), d.end() );
+		d.clear();
+		d.shrink_to_fit();
+		d.insert( d.begin(), 3, 7 );
+		d.push_front(6);
+		ASSERT_EQ( 4, d.size() );
+		ASSERT_EQ( 6, d.front() );
+		ASSERT_EQ( 7, d.back() );
+		
+		tracked_deque empty( dstd::move(moved) );
+		moved.push_back(1);
+		ASSERT_EQ( 1, moved.size() );
+	}
+	ASSERT_EQ( stats.allocations(), stats.deallocations() );
+	ASSERT_EQ( 0, stats.live_bytes() );
+}
+
+
+TEST(Deque, queueInSteadyStateDoesNotAllocate)
+{
+	dstd::allocation_stats stats;
+	tracked_deque d( (dstd::tracking_allocator<int>(stats)) );
+
+	// A backlog of about 1000 elements, which grows and shrinks by up to 300 at a time.
+	// The bursts start at a different place in a chunk each time, so warm up until each has needed the most chunks.
+	int next = 0;
+	int expected = 0;
+	for(int i = 0; i != 1000; ++i) d.push_back(next++);
+	for(int round = 0; round != 32; ++round)
+	{
+		for(int i = 0; i != 300; ++i) d.push_back(next++);
+		for(int i = 0; i != 300; ++i, ++expected) d.pop_front();
+	}
+
+	const size_t allocations = stats.allocations();
+	const size_t live_bytes = stats.live_bytes();
+
+	for(int round = 0; round != 1000; ++round)
+	{
+		for(int i = 0; i != 300; ++i) d.push_back(next++);
+		for(int i = 0; i != 300; ++i)
+		{
+			ASSERT_EQ( expected++, d.front() );
+			d.pop_front();
+		}
+	}
+
+	ASSERT_EQ( 1000, d.size() );
+	ASSERT_EQ( allocations, stats.allocations() );
+	ASSERT_EQ( live_bytes, stats.live_bytes() );
+}
+
+
+TEST(Deque, stackAtTheFrontReusesChunksFromTheBack)
+{
+	dstd::allocation_stats stats;
+	tracked_deque d( (dstd::tracking_allocator<int>(stats)) );
+	for(int i = 0; i != 1000; ++i) d.push_front(i);
+	for(int round = 0; round != 32; ++round)
+	{
+		for(int i = 0; i != 300; ++i) d.push_front(i);
+		for(int i = 0; i != 300; ++i) d.pop_back();
+	}
+
+	const size_t allocations = stats.allocations();
+	for(int round = 0; round != 1000; ++round)
+	{
+		for(int i = 0; i != 300; ++i) d.push_front(i);
+		for(int i = 0; i != 300; ++i) d.pop_back();
+	}
+	ASSERT_EQ( allocations, stats.allocations() );
+	ASSERT_EQ( 1000, d.size() );
+}
+
+
+TEST(Deque, drainingFreesAllButAFewChunks)
+{
+	dstd::allocation_stats stats;
+	tracked_deque d( (dstd::tracking_allocator<int>(stats)) );
+	for(int i = 0; i != 100000; ++i) d.push_back(i);
+	const size_t full = stats.live_bytes();
+
+	while( d.size() > 1 ) d.pop_front();
+	ASSERT_EQ( 99999, d.front() );
+	ASSERT_LT( stats.live_bytes(), full / 10 );
+
+	for(int i = 0; i != 100000; ++i) d.push_front(i);
+	while( d.size() > 1 ) d.pop_back();
+	ASSERT_EQ( 99999, d.front() );
+	ASSERT_LT( stats.live_bytes(), full / 10 );
+}
+
+
+TEST(Deque, queueAdaptorRecyclesChunks)
+{
+	dstd::allocation_stats::global().reset();
+	dstd::queue< int, tracked_deque > q;
+	for(int i = 0; i != 1000; ++i) q.push(i);
+	for(int i = 0; i != 1000; ++i) q.pop();
+
+	const size_t allocations = dstd::allocation_stats::global().allocations();
+	for(int i = 0; i != 100000; ++i)
+	{
+		q.push(i);
+		if( q.size() > 500 ) q.pop();
+	}
+	ASSERT_EQ( allocations, dstd::allocation_stats::global().allocations() );
+	ASSERT_EQ( 99500, q.front() );
+}
+
+
+TEST(Deque, chunkSizeDependsOnElementSize)
+{
+	class record { public: char bytes[4096]; };
+	class medium { public: char bytes[100]; };
+
+	ASSERT_EQ( 128, (dstd::impl::deque_chunk_size<int, 0>()) );
+	ASSERT_EQ( 40, (dstd::impl::deque_chunk_size<medium, 0>()) );
+	ASSERT_EQ( 16, (dstd::impl::deque_chunk_size<record, 0>()) );
+	ASSERT_EQ( 1024, (dstd::impl::deque_chunk_size<int, 4096>()) );
+	ASSERT_EQ( 1, (dstd::impl::deque_chunk_size<record, 512>()) );
+}
+
+
+TEST(Deque, chunkBytesIsATemplateParameter)
+{
+	dstd::allocation_stats stats;
+	{
+		dstd::deque< int, dstd::tracking_allocator<int>, 65536 > d( (dstd::tracking_allocator<int>(stats)) );
+		stats.reset();
+		for(int i = 0; i != 100000; ++i) d.push_back(i);
+		for(int i = 0; i != 100000; ++i) d.push_front(-i);
+		// 800KB of elements in 64KiB chunks, plus a few chunk maps, where 512 byte chunks would take some 1600 allocations.
+		ASSERT_GT( 40, stats.allocations() );
+		ASSERT_LT( 0, stats.histogram(16) );
+
+		typedef dstd::deque< int, dstd::tracking_allocator<int>, 65536 >::const_iterator const_iterator;
+		int i = 0;
+		for(const_iterator it = d.begin(); it != d.end(); ++it, ++i)
+		{
+			ASSERT_EQ( (i < 100000) ? (i - 99999) : (i - 100000), *it );
+		}
+		ASSERT_EQ( 200000, d.end() - d.begin() );
+	}
+	ASSERT_EQ( 0, stats.live_bytes() );
+}
+
+
+TEST(Deque, shrinkToFitFreesSpareChunksAndTheMap)
+{
+	dstd::allocation_stats stats;
+	tracked_deque d( (dstd::tracking_allocator<int>(stats)) );
+	for(int i = 0; i != 100000; ++i) d.push_back(i);
+	d.clear();
+	for(int i = 0; i != 10; ++i) d.push_back(i);
+	const size_t before = stats.live_bytes();
+
+	d.shrink_to_fit();
+	ASSERT_LT( stats.live_bytes(), before );
+	ASSERT_GE( 4 * 512 + 4 * sizeof(int*), stats.live_bytes() );
+	for(int i = 0; i != 10; ++i) ASSERT_EQ( i, d[i] );
+
+	for(int i = 0; i != 1000; ++i)
+	{
+		d.push_back(i);
+		d.push_front(i);
+	}
+	ASSERT_EQ( 2010, d.size() );
+	ASSERT_EQ( 999, d.front() );
+	ASSERT_EQ( 999, d.back() );
+}
+
+
+TEST(Deque, findAndCountWorkChunkByChunk)
+{
+	dstd::deque<int> d;
+	for(int i = 0; i != 1000; ++i) d.push_back(i);
+	for(int i = 1; i != 100; ++i) d.push_front(-i);
+	const dstd::deque<int>& c = d;
+
+	ASSERT_TRUE( dstd::find(d.begin(), d.end(), 700) == d.begin() + 799 );
+	ASSERT_TRUE( dstd::find(d.begin(), d.end(), -99) == d.begin() );
+	ASSERT_TRUE( dstd::find(d.begin(), d.end(), 999) == d.end() - 1 );
+	ASSERT_TRUE( dstd::find(d.begin(), d.end(), 1000) == d.end() );
+	ASSERT_TRUE( dstd::find(d.begin() + 10, d.begin() + 500, 600) == d.begin() + 500 );
+	ASSERT_TRUE( dstd::find(d.begin() + 3, d.begin() + 3, 3) == d.begin() + 3 );
+	ASSERT_TRUE( dstd::find(c.begin() + 130, c.begin() + 140, -99 + 135) == c.begin() + 135 );
+	ASSERT_TRUE( dstd::find_if(c.begin() + 100, c.end(), is_odd) == c.begin() + 100 );
+	ASSERT_EQ( 7, *dstd::find_if(d.begin() + 106, d.end(), is_odd) );
+
+	ASSERT_EQ( 1, dstd::count(c.begin(), c.end(), 500) );
+	ASSERT_EQ( 0, dstd::count(c.begin() + 1, c.end(), -99) );
+	ASSERT_EQ( 550, dstd::count_if(c.begin(), c.end(), is_odd) );
+	ASSERT_EQ( 250, dstd::count_if(d.begin() + 99, d.begin() + 599, is_odd) );
+}
+
+
+TEST(Deque, forEachCopyAndFillWorkChunkByChunk)
+{
+	dstd::deque<int> d;
+	for(int i = 0; i != 1000; ++i) d.push_back(i);
+
+	summer s = dstd::for_each(d.begin(), d.end(), summer());
+	ASSERT_TRUE( s.in_order );
+	ASSERT_EQ( 999 * 1000 / 2, s.sum );
+	ASSERT_EQ( 10 + 11 + 12, dstd::for_each(d.begin() + 10, d.begin() + 13, summer()).sum );
+
+	dstd::vector<int> v(1000, -1);
+	ASSERT_TRUE( dstd::copy(d.begin() + 100, d.end(), v.begin()) == v.begin() + 900 );
+	ASSERT_EQ( 100, v[0] );
+	ASSERT_EQ( 999, v[899] );
+	ASSERT_EQ( -1, v[900] );
+
+	int a[300];
+	ASSERT_EQ( a + 300, dstd::copy(d.begin() + 120, d.begin() + 420, a) );
+	for(int i = 0; i != 300; ++i) ASSERT_EQ( 120 + i, a[i] );
+
+	dstd::fill(d.begin() + 50, d.begin() + 950, 7);
+	ASSERT_EQ( 49, d[49] );
+	ASSERT_EQ( 900, dstd::count(d.begin() + 50, d.begin() + 950, 7) );
+	ASSERT_EQ( 950, d[950] );
+}
+
+
+TEST(Deque, copyIntoADequeFillsItChunkByChunk)
+{
+	typedef dstd::deque<int, dstd::allocator<int>, 4 * sizeof(int)> small_deque;
+	dstd::vector<int> v;
+	for(int i = 0; i != 100; ++i) v.push_back(i);
+	small_deque d(30, -1);
+	small_deque e(30, -1);
+
+	// ending inside a chunk, at the end of one, and at the end of the deque
+	ASSERT_TRUE( dstd::copy(v.begin(), v.begin() + 5, d.begin() + 1) == d.begin() + 6 );
+	ASSERT_TRUE( dstd::copy(v.begin(), v.begin() + 6, d.begin() + 6) == d.begin() + 12 );
+	ASSERT_TRUE( dstd::copy(v.begin(), v.begin() + 18, d.begin() + 12) == d.end() );
+	ASSERT_TRUE( dstd::copy(v.begin(), v.begin(), d.begin() + 3) == d.begin() + 3 );
+	ASSERT_EQ( -1, d[0] );
+	for(int i = 1; i != 6; ++i) ASSERT_EQ( i - 1, d[i] );
+	for(int i = 6; i != 12; ++i) ASSERT_EQ( i - 6, d[i] );
+	for(int i = 12; i != 30; ++i) ASSERT_EQ( i - 12, d[i] );
+
+	// from one deque to another, whose chunks are not in step
+	ASSERT_TRUE( dstd::copy(d.begin() + 1, d.begin() + 28, e.begin() + 2) == e.begin() + 29 );
+	ASSERT_EQ( -1, e[1] );
+	for(int i = 2; i != 29; ++i) ASSERT_EQ( d[i - 1], e[i] );
+	ASSERT_EQ( -1, e[29] );
+}
+
+
+TEST(Deque, algorithmsOnOtherIteratorsAreUnchanged)
+{
+	dstd::vector<int> v;
+	for(int i = 0; i != 100; ++i) v.push_back(i);
+	ASSERT_TRUE( dstd::find(v.begin(), v.end(), 42) == v.begin() + 42 );
+	ASSERT_EQ( 50, dstd::count_if(v.begin(), v.end(), is_odd) );
+
+	dstd::deque<int> d( v.begin(), v.end() );
+	ASSERT_TRUE( dstd::find(d.rbegin(), d.rend(), 42) == d.rbegin() + 57 );
+	ASSERT_EQ( 4950, dstd::for_each(v.begin(), v.end(), summer()).sum );
+}
+
+
+TEST(Deque, insertInTheMiddleShiftsTheNearerEnd)
+{
+	dstd::vector<int> v;
+	for(int i = 0; i != 1000; ++i) v.push_back(i);
+	tracked_deque d( v.begin(), v.end() );
+
+	d.insert(d.begin() + 500, 300, -1);
+	v.insert(v.begin() + 500, 300, -1);
+	assert_same(v, d);
+
+	d.insert(d.begin() + 10, 700, -2);
+	v.insert(v.begin() + 10, 700, -2);
+	assert_same(v, d);
+
+	d.insert(d.end() - 5, 2, -3);
+	v.insert(v.end() - 5, 2, -3);
+	assert_same(v, d);
+
+	dstd::list<int> l;
+	for(int i = 0; i != 600; ++i) l.push_back(5000 + i);
+	d.insert(d.begin() + 3, l.begin(), l.end());
+	dstd::vector<int> from_list;
+	for(int i = 0; i != 600; ++i) from_list.push_back(5000 + i);
+	v.insert(v.begin() + 3, from_list.begin(), from_list.end());
+	assert_same(v, d);
+
+	dstd::vector<int> w(100, -4);
+	d.insert(d.end() - 900, w.begin(), w.end());
+	v.insert(v.end() - 900, w.begin(), w.end());
+	assert_same(v, d);
+
+	tracked_deque::iterator it = d.insert(d.begin() + 1234, 42);
+	ASSERT_TRUE( it == d.begin() + 1234 );
+	ASSERT_EQ( 42, d[1234] );
+}
+
+
+TEST(Deque, insertingAnElementOfTheDequeCopiesItFirst)
+{
+	dstd::deque<int> d;
+	for(int i = 0; i != 100; ++i) d.push_back(i);
+
+	d.insert(d.begin() + 10, 50, d[11]);
+	for(int i = 10; i != 60; ++i) ASSERT_EQ( 11, d[i] );
+	ASSERT_EQ( 10, d[60] );
+
+	d.insert(d.begin() + 120, 3, d[140]);
+	for(int i = 120; i != 123; ++i) ASSERT_EQ( 140 - 50, d[i] );
+
+	const int x = d[71];
+	d.emplace(d.begin() + 70, d[71]);
+	ASSERT_EQ( x, d[70] );
+	ASSERT_EQ( x, d[72] );
+}
+
+
+TEST(Deque, emplaceInTheMiddleMovesTheElements)
+{
+	dstd::deque< dstd::vector<int> > d;
+	for(int i = 0; i != 100; ++i) d.emplace_back(3, i);
+
+	dstd::deque< dstd::vector<int> >::iterator it = d.emplace(d.begin() + 30, 2, -1);
+	ASSERT_TRUE( it == d.begin() + 30 );
+	it = d.emplace(d.begin() + 80, 4, -2);
+	ASSERT_TRUE( it == d.begin() + 80 );
+	ASSERT_EQ( 102, d.size() );
+	ASSERT_EQ( 2, d[30].size() );
+	ASSERT_EQ( -1, d[30][0] );
+	ASSERT_EQ( 4, d[80].size() );
+	ASSERT_EQ( 29, d[29][2] );
+	ASSERT_EQ( 30, d[31][0] );
+	ASSERT_EQ( 79, d[81][1] );
+	ASSERT_EQ( 99, d[101][0] );
+}
+
+
+TEST(Deque, eraseShiftsTheNearerEnd)
+{
+	dstd::vector<int> v;
+	for(int i = 0; i != 3000; ++i) v.push_back(i);
+	tracked_deque d( v.begin(), v.end() );
+
+	tracked_deque::iterator it = d.erase(d.begin() + 100, d.begin() + 900);
+	ASSERT_TRUE( it == d.begin() + 100 );
+	v.erase(v.begin() + 100, v.begin() + 900);
+	assert_same(v, d);
+
+	it = d.erase(d.end() - 300, d.end() - 10);
+	ASSERT_TRUE( it == d.end() - 10 );
+	v.erase(v.end() - 300, v.end() - 10);
+	assert_same(v, d);
+
+	it = d.erase(d.begin() + 5);
+	ASSERT_TRUE( it == d.begin() + 5 );
+	v.erase(v.begin() + 5);
+	assert_same(v, d);
+
+	d.erase(d.begin(), d.end());
+	ASSERT_TRUE( d.empty() );
+	// At most the spare chunks at each end, the chunk first is in, the two kept ready for emplace_back, and the map.
+	ASSERT_GE( 4 + 4 + 1 + 2 + 1, d.get_allocator().get_stats().allocations() - d.get_allocator().get_stats().deallocations() );
+}
+
+
+TEST(Deque, insertAndEraseWholeChunksFromTheBack)
+{
+	std::deque<int> expected;
+	dstd::deque<int> d;
+	for(int i = 0; i != 320; ++i)
+	{
+		d.push_back(i);
+		expected.push_back(i);
+	}
+
+	// 128 ints to a chunk, so the erase steps end back exactly one chunk
+	d.erase(d.begin() + 192, d.end());
+	expected.erase(expected.begin() + 192, expected.end());
+	assert_same(expected, d);
+	d.push_back(-1);
+	expected.push_back(-1);
+	assert_same(expected, d);
+
+	dstd::deque< int, dstd::allocator<int>, 8 > small;
+	std::deque<int> small_expected;
+	small.insert(small.begin(), 5, 1);
+	small_expected.insert(small_expected.begin(), 5, 1);
+	small.insert(small.begin() + 2, 3, 2);
+	small_expected.insert(small_expected.begin() + 2, 3, 2);
+	assert_same(small_expected, small);
+	ASSERT_EQ( 8, small.end() - small.begin() );
+	ASSERT_TRUE( small.end() - 8 == small.begin() );
+}
+
+
+TEST(Deque, insertAndEraseAgreeWithStdDeque)
+{
+	insert_and_erase_like_std_deque< dstd::deque<int> >();
+	insert_and_erase_like_std_deque< dstd::deque< int, dstd::allocator<int>, 1 > >();
+	insert_and_erase_like_std_deque< dstd::deque< int, dstd::allocator<int>, 8 > >();
+	insert_and_erase_like_std_deque< dstd::deque< int, dstd::allocator<int>, 64 > >();
+}
+
+
+TEST(Deque, assignAndResizeReuseTheInsertAndErasePaths)
+{
+	dstd::vector<int> v;
+	for(int i = 0; i != 2000; ++i) v.push_back(i);
+
+	dstd::deque<int> d;
+	d.assign( v.begin(), v.end() );
+	assert_same(v, d);
+
+	d.resize(700);
+	v.resize(700);
+	assert_same(v, d);
+
+	d.resize(1500, 9);
+	v.resize(1500, 9);
+	assert_same(v, d);
+
+	d.assign(10, 3);
+	ASSERT_EQ( 10, d.size() );
+	ASSERT_EQ( 3, d[9] );
+}
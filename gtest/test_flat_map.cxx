@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <map>
+#include "../src/flat_map.hxx"
+#include "../src/flat_set.hxx"
+#include "../src/vector.hxx"
+
+
+
+class FlatMap : public ::testing::Test
+{
+	protected:
+
+		void SetUp()
+		{
+			for(int i = 0; i < 100; ++i)
+			{
+				squares.push_back( dstd::pair<int,int>(i, i*i) );
+			}
+			hundred_squares = dstd::flat_map<int,int>( dstd::sorted_unique, squares.begin(), squares.end() );
+		}
+
+		dstd::vector< dstd::pair<int,int> > squares;
+		dstd::flat_map<int, int> empty;
+		dstd::flat_map<int, int> hundred_squares;
+};
+
+
+
+TEST_F(FlatMap, constructorDefaultCreatesEmptyMap)
+{
+	ASSERT_TRUE( empty.empty() );
+	ASSERT_EQ( 0, empty.size() );
+	ASSERT_TRUE( empty.begin() == empty.end() );
+	ASSERT_TRUE( empty.find(3) == empty.end() );
+}
+
+
+TEST_F(FlatMap, constructorSortedCopiesRange)
+{
+	ASSERT_EQ( 100, hundred_squares.size() );
+	ASSERT_EQ( 0, hundred_squares.begin()->first );
+	ASSERT_EQ( 99, hundred_squares.rbegin()->first );
+	ASSERT_EQ( 81, hundred_squares.at(9) );
+}
+
+
+TEST_F(FlatMap, constructorRangeSortsAndKeepsFirstOfEqualKeys)
+{
+	const dstd::pair<int,int> values[] = {
+		dstd::pair<int,int>(5, 0), dstd::pair<int,int>(3, 1), dstd::pair<int,int>(5, 2),
+		dstd::pair<int,int>(1, 3), dstd::pair<int,int>(3, 4), dstd::pair<int,int>(9, 5)
+	};
+	dstd::flat_map<int,int> test_map(values, values + 6);
+	ASSERT_EQ( 4, test_map.size() );
+
+	const int keys[] = { 1, 3, 5, 9 };
+	const int mapped[] = { 3, 1, 0, 5 };
+	int i = 0;
+	for(dstd::flat_map<int,int>::const_iterator it = test_map.begin(); it != test_map.end(); ++it, ++i)
+	{
+		ASSERT_EQ( keys[i], it->first );
+		ASSERT_EQ( mapped[i], it->second );
+	}
+}
+
+
+TEST_F(FlatMap, constructorCopyCreatesIdenticalMap)
+{
+	dstd::flat_map<int, int> test_map(hundred_squares);
+	ASSERT_TRUE( test_map == hundred_squares );
+}
+
+
+TEST_F(FlatMap, operatorSQBInsertsMissingKeyInOrder)
+{
+	dstd::flat_map<int, int> test_map;
+	test_map[5] = 25;
+	test_map[1] = 1;
+	test_map[3] = 9;
+	ASSERT_EQ( 3, test_map.size() );
+	ASSERT_EQ( 9, test_map[3] );
+	ASSERT_EQ( 3, test_map.size() );
+	ASSERT_EQ( 1, test_map.begin()->first );
+}
+
+
+TEST_F(FlatMap, atThrowsForNonExistantKey)
+{
+	ASSERT_THROW( hundred_squares.at(100), dstd::out_of_range );
+}
+
+
+TEST_F(FlatMap, insertValueDoesNotInsertForExistingKey)
+{
+	dstd::pair<dstd::flat_map<int,int>::iterator, bool> result = hundred_squares.insert( dstd::pair<int,int>(10, -1) );
+	ASSERT_FALSE( result.second );
+	ASSERT_EQ( 100, result.first->second );
+}
+
+
+TEST_F(FlatMap, insertHintAtCorrectPositionInserts)
+{
+	hundred_squares.erase(50);
+	dstd::flat_map<int,int>::iterator it = hundred_squares.insert( hundred_squares.find(51), dstd::pair<int,int>(50, -50) );
+	ASSERT_EQ( 50, it->first );
+	ASSERT_EQ( 49, (it - 1)->first );
+
+	it = hundred_squares.insert( hundred_squares.begin(), dstd::pair<int,int>(200, 0) );
+	ASSERT_EQ( 200, it->first );
+	ASSERT_EQ( 200, hundred_squares.rbegin()->first );
+}
+
+
+TEST_F(FlatMap, insertRangeMergesWithExistingElements)
+{
+	dstd::vector< dstd::pair<int,int> > more;
+	for(int i = 195; i >= 0; i -= 5)
+	{
+		more.push_back( dstd::pair<int,int>(i, -1) );
+	}
+	hundred_squares.insert(more.begin(), more.end());
+
+	ASSERT_EQ( 120, hundred_squares.size() );
+	ASSERT_EQ( 25, hundred_squares[5] );
+	ASSERT_EQ( -1, hundred_squares[105] );
+
+	int previous = -1;
+	for(dstd::flat_map<int,int>::const_iterator it = hundred_squares.begin(); it != hundred_squares.end(); ++it)
+	{
+		ASSERT_LT( previous, it->first );
+		previous = it->first;
+	}
+}
+
+
+TEST_F(FlatMap, lowerAndUpperBoundFindNeighbouringKeys)
+{
+	hundred_squares.erase(50);
+	ASSERT_EQ( 51, hundred_squares.lower_bound(50)->first );
+	ASSERT_EQ( 49, hundred_squares.lower_bound(49)->first );
+	ASSERT_EQ( 49, hundred_squares.upper_bound(48)->first );
+	ASSERT_TRUE( hundred_squares.upper_bound(99) == hundred_squares.end() );
+	ASSERT_TRUE( hundred_squares.lower_bound(-1) == hundred_squares.begin() );
+
+	dstd::pair<dstd::flat_map<int,int>::iterator, dstd::flat_map<int,int>::iterator> range = hundred_squares.equal_range(50);
+	ASSERT_TRUE( range.first == range.second );
+	ASSERT_EQ( 0, hundred_squares.count(50) );
+	ASSERT_EQ( 1, hundred_squares.count(51) );
+}
+
+
+TEST_F(FlatMap, eraseIteratorIteratorRemovesOnlyElementsInRange)
+{
+	dstd::flat_map<int,int>::iterator next = hundred_squares.erase( hundred_squares.find(10), hundred_squares.find(90) );
+	ASSERT_EQ( 90, next->first );
+	ASSERT_EQ( 20, hundred_squares.size() );
+	ASSERT_EQ( 9, (next - 1)->first );
+}
+
+
+TEST_F(FlatMap, swapExchangesMapContents)
+{
+	dstd::flat_map<int,int> copy(hundred_squares);
+	empty[1] = 2;
+	dstd::swap(empty, hundred_squares);
+	ASSERT_TRUE( empty == copy );
+	ASSERT_EQ( 1, hundred_squares.size() );
+}
+
+
+TEST_F(FlatMap, randomInsertAndEraseMatchesStdMap)
+{
+	dstd::flat_map<int, int> test_map;
+	std::map<int, int> expected;
+
+	std::srand(11);
+	for(int i = 0; i < 5000; ++i)
+	{
+		const int k = std::rand() % 500;
+		if( std::rand() % 3 == 0 )
+		{
+			ASSERT_EQ( expected.erase(k), test_map.erase(k) );
+		}
+		else
+		{
+			expected[k] = i;
+			test_map[k] = i;
+		}
+	}
+
+	ASSERT_EQ( expected.size(), test_map.size() );
+	dstd::flat_map<int,int>::const_iterator it = test_map.begin();
+	for(std::map<int,int>::const_iterator e = expected.begin(); e != expected.end(); ++e, ++it)
+	{
+		ASSERT_EQ( e->first, it->first );
+		ASSERT_EQ( e->second, it->second );
+	}
+}
+
+
+
+TEST(FlatMultimap, insertRangeKeepsEqualKeysInInsertionOrder)
+{
+	dstd::vector< dstd::pair<int,int> > values;
+	for(int i = 0; i < 300; ++i)
+	{
+		values.push_back( dstd::pair<int,int>((i * 7) % 3, i) );
+	}
+	dstd::flat_multimap<int,int> test_map(values.begin(), values.end());
+	ASSERT_EQ( 300, test_map.size() );
+	ASSERT_EQ( 100, test_map.count(2) );
+
+	int previous = -1;
+	dstd::pair<dstd::flat_multimap<int,int>::iterator, dstd::flat_multimap<int,int>::iterator> range = test_map.equal_range(2);
+	for( ; range.first != range.second; ++range.first)
+	{
+		ASSERT_LT( previous, range.first->second );
+		previous = range.first->second;
+	}
+
+	test_map.insert( dstd::pair<int,int>(2, 1000) );
+	ASSERT_EQ( 1000, (test_map.upper_bound(2) - 1)->second );
+	ASSERT_EQ( 101, test_map.erase(2) );
+}
+
+
+
+TEST(FlatSet, rangeConstructorDropsDuplicates)
+{
+	const int values[] = { 3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5 };
+	dstd::flat_set<int> s(values, values + 11);
+	ASSERT_EQ( 7, s.size() );
+
+	const int expected[] = { 1, 2, 3, 4, 5, 6, 9 };
+	int i = 0;
+	for(dstd::flat_set<int>::const_iterator it = s.begin(); it != s.end(); ++it, ++i)
+	{
+		ASSERT_EQ( expected[i], *it );
+	}
+
+	ASSERT_FALSE( s.insert(4).second );
+	ASSERT_TRUE( s.insert(7).second );
+	ASSERT_EQ( 1, s.erase(1) );
+	ASSERT_EQ( 2, *s.begin() );
+}
@@ -1168,3 +1168,66 @@ TEST_F(List, reverseReversesOrder)
 /////
 /////template <class T, class Allocator>
 /////void dstd::swap(dstd::list<T,Allocator>& l1, dstd::list<T,Allocator>& l2)
+
+
+
+//
+// Move semantics and emplace
+
+
+/// Can be constructed from two values and moved, but not copied
+class move_only
+{
+	public:
+		
+		move_only(int a, int b) : value(a + b) {}
+		move_only(move_only&& x) noexcept : value(x.value) { x.value = -1; }
+		
+		move_only(const move_only&) = delete;
+		move_only& operator= (const move_only&) = delete;
+		
+		int value;
+};
+
+
+TEST_F(List, moveConstructorTakesNodesAndLeavesSourceEmpty)
+{
+	const int* first = &one_to_ten.front();
+	
+	dstd::list<int> moved( dstd::move(one_to_ten) );
+	
+	ASSERT_TRUE( one_to_ten.empty() );
+	ASSERT_EQ( 10, moved.size() );
+	ASSERT_EQ( first, &moved.front() );
+	
+	one_to_ten.push_back(1);
+	ASSERT_EQ( 1, one_to_ten.size() );
+}
+
+
+TEST_F(List, moveAssignmentReplacesElements)
+{
+	dstd::list<int> copy(one_to_ten);
+	
+	ntimesn = dstd::move(copy);
+	
+	ASSERT_TRUE( copy.empty() );
+	ASSERT_EQ( one_to_ten, ntimesn );
+}
+
+
+TEST_F(List, emplaceConstructsElementsInPlace)
+{
+	dstd::list<move_only> l;
+	l.emplace_back(1, 1);
+	l.emplace_front(0, 1);
+	l.emplace( ++l.begin(), 1, 0 );
+	l.push_back( move_only(3, 0) );
+	
+	ASSERT_EQ( 4, l.size() );
+	dstd::list<move_only>::iterator it = l.begin();
+	ASSERT_EQ( 1, (it++)->value );
+	ASSERT_EQ( 1, (it++)->value );
+	ASSERT_EQ( 2, (it++)->value );
+	ASSERT_EQ( 3, (it++)->value );
+}
@@ -38,6 +38,72 @@ bool equals(const dstd::pair<Key, T>& p1, const dstd::pair<Key, T>& p2)
 
 
 
+int counting_allocations = 0;
+
+
+/// An allocator which counts its allocations, to check which operations allocate
+template <class T>
+class counting_allocator : public dstd::allocator<T>
+{
+	public:
+		
+		template <class OtherType>
+		struct rebind
+		{
+			typedef counting_allocator< OtherType > other;
+		};
+		
+		counting_allocator() {}
+		
+		template <class U>
+		counting_allocator(const counting_allocator<U>& /*a*/) {}
+		
+		T* allocate(size_t n)
+		{
+			++counting_allocations;
+			return dstd::allocator<T>::allocate(n);
+		}
+};
+
+
+
+int counting_comparisons = 0;
+
+
+/// A comparator which counts how often it is called, to check how much an operation searches
+class counting_less
+{
+	public:
+		
+		bool operator() (int a, int b) const
+		{
+			++counting_comparisons;
+			return a < b;
+		}
+};
+
+
+
+/// A type which can be moved but not copied, to check that elements are moved or built in place
+class move_only
+{
+	public:
+		
+		explicit move_only(int v = 0) : value(v) {}
+		move_only(int a, int b) : value(a + b) {}
+		move_only(move_only&& x) noexcept : value(x.value) { x.value = -1; }
+		move_only& operator= (move_only&& x) noexcept { value = x.value; x.value = -1; return *this; }
+		
+		move_only(const move_only&) = delete;
+		move_only& operator= (const move_only&) = delete;
+		
+		int value;
+};
+
+
+
+
+
 class Map : public ::testing::Test
 {
 	protected:
@@ -289,6 +355,194 @@ TEST_F(Map, insertValueDoesNotInsertForExistingKey)
 }
 
 
+TEST_F(Map, insertValueDoesNotAllocateForExistingKey)
+{
+	dstd::map< int, int, dstd::less<int>, counting_allocator<int> > test_map;
+	test_map[1] = 1;
+	const int allocations_before = counting_allocations;
+	
+	dstd::pair< dstd::map< int, int, dstd::less<int>, counting_allocator<int> >::iterator, bool > result = test_map.insert( dstd::pair<int,int>(1, 2) );
+	test_map[1] = 3;
+	
+	ASSERT_EQ( allocations_before, counting_allocations );
+	ASSERT_FALSE( result.second );
+	ASSERT_EQ( 3, test_map[1] );
+}
+
+
+TEST_F(Map, tryEmplaceDoesNotChangeExistingElement)
+{
+	dstd::pair< dstd::map<int,int>::iterator, bool > result = twenty_squares.try_emplace(4, 99);
+	
+	ASSERT_FALSE( result.second );
+	ASSERT_EQ( 16, result.first->second );
+	ASSERT_EQ( 20, twenty_squares.size() );
+}
+
+
+TEST_F(Map, tryEmplaceInsertsForNewKey)
+{
+	dstd::pair< dstd::map<int,int>::iterator, bool > result = twenty_squares.try_emplace(40, 1600);
+	
+	ASSERT_TRUE( result.second );
+	ASSERT_EQ( 40, result.first->first );
+	ASSERT_EQ( 1600, twenty_squares[40] );
+	ASSERT_EQ( 21, twenty_squares.size() );
+	ASSERT_EQ( 19, (--result.first)->first );
+}
+
+
+TEST_F(Map, tryEmplaceConstructsMappedValueFromArguments)
+{
+	dstd::map<int, move_only> test_map;
+	
+	test_map.try_emplace(1, 2, 3);
+	test_map.try_emplace(2);
+	dstd::pair< dstd::map<int, move_only>::iterator, bool > result = test_map.try_emplace(1, 99);
+	
+	ASSERT_FALSE( result.second );
+	ASSERT_EQ( 5, test_map.find(1)->second.value );
+	ASSERT_EQ( 0, test_map.find(2)->second.value );
+}
+
+
+// dstd::pair<iterator,bool> emplace(Args&&... args)
+// iterator emplace_hint(iterator position, Args&&... args)
+
+
+TEST_F(Map, emplaceConstructsElementFromArguments)
+{
+	dstd::map<int, move_only> test_map;
+	
+	dstd::pair< dstd::map<int, move_only>::iterator, bool > result = test_map.emplace( 3, move_only(9) );
+	
+	ASSERT_TRUE( result.second );
+	ASSERT_EQ( 3, result.first->first );
+	ASSERT_EQ( 9, result.first->second.value );
+}
+
+
+TEST_F(Map, emplaceDoesNotInsertForExistingKey)
+{
+	dstd::pair< dstd::map<int,int>::iterator, bool > result = twenty_squares.emplace(4, 99);
+	
+	ASSERT_FALSE( result.second );
+	ASSERT_EQ( 16, result.first->second );
+	ASSERT_EQ( 20, twenty_squares.size() );
+}
+
+
+TEST_F(Map, emplaceHintInsertsEveryValueInOrder)
+{
+	dstd::map<int, move_only> test_map;
+	for(int i = 0; i < 100; ++i)
+	{
+		test_map.emplace_hint( test_map.end(), 99 - i, move_only(i) );
+		test_map.emplace_hint( test_map.begin(), -i, move_only(i) );
+	}
+	
+	ASSERT_EQ( 199, test_map.size() );
+	int expected = -99;
+	for(dstd::map<int, move_only>::const_iterator it = test_map.begin(); it != test_map.end(); ++it, ++expected)
+	{
+		ASSERT_EQ( expected, it->first );
+	}
+}
+
+
+// dstd::pair<iterator,bool> insert(value_type&& value)
+
+
+TEST_F(Map, insertRvalueMovesValueIntoMap)
+{
+	dstd::map<int, move_only> test_map;
+	dstd::pair<int, move_only> value( 1, move_only(7) );
+	
+	test_map.insert( dstd::move(value) );
+	test_map.insert( test_map.end(), dstd::pair<int, move_only>(2, move_only(8)) );
+	
+	ASSERT_EQ( 7, test_map.find(1)->second.value );
+	ASSERT_EQ( 8, test_map.find(2)->second.value );
+	ASSERT_EQ( -1, value.second.value );
+}
+
+
+// map(map&& x)
+// map& operator= (map&& x)
+
+
+TEST_F(Map, moveConstructorTakesElementsAndLeavesSourceEmpty)
+{
+	dstd::map<int,int> copy(twenty_squares);
+	dstd::map<int,int>::iterator it = copy.find(5);
+	
+	dstd::map<int,int> moved( dstd::move(copy) );
+	
+	ASSERT_TRUE( copy.empty() );
+	ASSERT_EQ( twenty_squares, moved );
+	ASSERT_EQ( moved.find(5), it );
+	
+	copy[1] = 1;
+	ASSERT_EQ( 1, copy.size() );
+}
+
+
+TEST_F(Map, moveAssignmentReplacesElementsAndLeavesSourceEmpty)
+{
+	dstd::map<int,int> copy(twenty_squares);
+	
+	negative_squares = dstd::move(copy);
+	
+	ASSERT_TRUE( copy.empty() );
+	ASSERT_EQ( twenty_squares, negative_squares );
+}
+
+
+TEST_F(Map, moveAndSwapRelinkTheNodesToTheirNewTree)
+{
+	ASSERT_TRUE(( dstd::is_nothrow_move_constructible< dstd::map<int,int> >::value ));
+	
+	dstd::map<int,int> one;
+	one[7] = 49;
+	dstd::map<int,int> none;
+	
+	one.swap(twenty_squares);
+	none.swap(twenty_squares);
+	
+	ASSERT_EQ( 20, one.size() );
+	ASSERT_EQ( 1, none.size() );
+	ASSERT_TRUE( twenty_squares.empty() );
+	ASSERT_EQ( twenty_squares.begin(), twenty_squares.end() );
+	ASSERT_EQ( 49, none.begin()->second );
+	ASSERT_EQ( none.end(), ++none.begin() );
+	ASSERT_EQ( 361, (--one.end())->second );
+	
+	int count = 0;
+	for(dstd::map<int,int>::reverse_iterator it = one.rbegin(); it != one.rend(); ++it) ++count;
+	ASSERT_EQ( 20, count );
+	
+	twenty_squares = dstd::move(one);
+	twenty_squares[20] = 400;
+	ASSERT_EQ( 400, (--twenty_squares.end())->second );
+	ASSERT_EQ( 0, twenty_squares.begin()->second );
+}
+
+
+TEST_F(Map, insertOrAssignAssignsExistingElement)
+{
+	dstd::pair< dstd::map<int,int>::iterator, bool > result = twenty_squares.insert_or_assign(4, 99);
+	
+	ASSERT_FALSE( result.second );
+	ASSERT_EQ( 99, twenty_squares[4] );
+	ASSERT_EQ( 20, twenty_squares.size() );
+	
+	result = twenty_squares.insert_or_assign(-4, 16);
+	ASSERT_TRUE( result.second );
+	ASSERT_EQ( 21, twenty_squares.size() );
+	ASSERT_EQ( -4, twenty_squares.begin()->first );
+}
+
+
 TEST_F(Map, insertValueDoesInsertForNewKey)
 {
 	const size_t size_before = twenty_squares.size();
@@ -338,6 +592,105 @@ TEST_F(Map, insertIteratorValueDoesInsertForNewKey)
 }
 
 
+TEST_F(Map, insertIteratorValueAtEndInOrderComparesAConstantNumberOfTimes)
+{
+	dstd::map< int, int, counting_less > test_map;
+	counting_comparisons = 0;
+	
+	for(int i = 0; i < 1000; ++i)
+	{
+		test_map.insert( test_map.end(), dstd::pair<int,int>(i, i) );
+	}
+	
+	ASSERT_EQ( 1000, test_map.size() );
+	ASSERT_GE( 3*1000, counting_comparisons );
+	int expected = 0;
+	for(dstd::map< int, int, counting_less >::const_iterator it = test_map.begin(); it != test_map.end(); ++it, ++expected)
+	{
+		ASSERT_EQ( expected, it->first );
+	}
+}
+
+
+TEST_F(Map, insertIteratorValueBeforeHintDoesInsertForNewKey)
+{
+	const dstd::map<int,int>::iterator hint = twenty_squares.find(10);
+	twenty_squares.erase(9);
+	
+	const dstd::map<int,int>::iterator result = twenty_squares.insert( hint, dstd::pair<int,int>(9, 99) );
+	
+	ASSERT_EQ( 20, twenty_squares.size() );
+	ASSERT_EQ( 9, result->first );
+	ASSERT_EQ( 99, result->second );
+	dstd::map<int,int>::iterator next = result;
+	ASSERT_EQ( hint, ++next );
+}
+
+
+TEST_F(Map, insertIteratorValueWithDistantHintInsertsInOrder)
+{
+	for(int i = 100; i > 20; --i)
+	{
+		twenty_squares.insert( twenty_squares.begin(), dstd::pair<int,int>(i, i*i) );
+		twenty_squares.insert( twenty_squares.end(), dstd::pair<int,int>(-i, i*i) );
+	}
+	
+	ASSERT_EQ( 20 + 2*80, twenty_squares.size() );
+	int previous = -101;
+	for(dstd::map<int,int>::const_iterator it = twenty_squares.begin(); it != twenty_squares.end(); ++it)
+	{
+		ASSERT_LT( previous, it->first );
+		previous = it->first;
+	}
+}
+
+
+TEST(Multimap, insertIteratorValueInsertsBeforeHint)
+{
+	dstd::multimap<int,int> test_map;
+	test_map.insert( dstd::pair<int,int>(1, 0) );
+	test_map.insert( dstd::pair<int,int>(1, 1) );
+	
+	dstd::multimap<int,int>::iterator second = ++test_map.begin();
+	dstd::multimap<int,int>::iterator result = test_map.insert( second, dstd::pair<int,int>(1, 2) );
+	test_map.insert( test_map.end(), dstd::pair<int,int>(1, 3) );
+	test_map.insert( test_map.begin(), dstd::pair<int,int>(1, 4) );
+	
+	ASSERT_EQ( second, ++result );
+	const int expected[] = { 4, 0, 2, 1, 3 };
+	int i = 0;
+	for(dstd::multimap<int,int>::const_iterator it = test_map.begin(); it != test_map.end(); ++it, ++i)
+	{
+		ASSERT_EQ( expected[i], it->second );
+	}
+	ASSERT_EQ( 5, i );
+}
+
+
+TEST(Multimap, insertWithDistantHintGoesAsNearTheHintAsEqualKeysAllow)
+{
+	dstd::multimap<int,int> test_map;
+	test_map.insert( dstd::pair<int,int>(3, 25) );
+	test_map.emplace_hint( test_map.begin(), 3, 7 );
+	test_map.insert( dstd::pair<int,int>(1, 0) );
+	test_map.insert( dstd::pair<int,int>(2, 0) );
+	test_map.insert( dstd::pair<int,int>(5, 0) );
+	test_map.insert( dstd::pair<int,int>(6, 0) );
+	
+	// a hint before the equal keys puts the new element first among them, and a hint after them puts it last
+	test_map.insert( test_map.begin(), dstd::pair<int,int>(3, 1) );
+	test_map.emplace_hint( --test_map.end(), 3, 9 );
+	
+	const int expected[] = { 0, 0, 1, 7, 25, 9, 0, 0 };
+	int i = 0;
+	for(dstd::multimap<int,int>::const_iterator it = test_map.begin(); it != test_map.end(); ++it, ++i)
+	{
+		ASSERT_EQ( expected[i], it->second );
+	}
+	ASSERT_EQ( 8, i );
+}
+
+
 // template <class InputIterator> void insert(InputIterator first, InputIterator last)
 
 
@@ -365,6 +718,87 @@ TEST_F(Map, insertIteratorIteratorInsertsEntireRange)
 }
 
 
+TEST_F(Map, insertIteratorIteratorFromSortedRangeComparesEachKeyOnce)
+{
+	dstd::pair<int,int> sorted[1000];
+	for(int i = 0; i < 1000; ++i) sorted[i] = dstd::pair<int,int>(i, i*i);
+	dstd::map< int, int, counting_less > test_map;
+	counting_comparisons = 0;
+	
+	test_map.insert( sorted, sorted + 1000 );
+	
+	ASSERT_EQ( 999, counting_comparisons );
+	ASSERT_EQ( 1000, test_map.size() );
+	int expected = 0;
+	for(dstd::map< int, int, counting_less >::const_iterator it = test_map.begin(); it != test_map.end(); ++it, ++expected)
+	{
+		ASSERT_EQ( expected, it->first );
+		ASSERT_EQ( expected*expected, it->second );
+	}
+	ASSERT_EQ( 999, (--test_map.end())->first );
+}
+
+
+TEST_F(Map, insertIteratorIteratorFromPartlySortedRangeInsertsEntireRange)
+{
+	const int keys[] = { 1, 3, 5, 5, 7, 2, 9, 0, 4 };
+	dstd::pair<int,int> values[9];
+	for(int i = 0; i < 9; ++i) values[i] = dstd::pair<int,int>(keys[i], i);
+	dstd::map<int,int> test_map;
+	
+	test_map.insert( values, values + 9 );
+	
+	ASSERT_EQ( 8, test_map.size() );
+	ASSERT_EQ( 2, test_map[5] );
+	int previous = -1;
+	for(dstd::map<int,int>::const_iterator it = test_map.begin(); it != test_map.end(); ++it)
+	{
+		ASSERT_LT( previous, it->first );
+		previous = it->first;
+	}
+	
+	test_map.erase(5);
+	test_map[6] = 6;
+	ASSERT_EQ( 8, test_map.size() );
+}
+
+
+TEST(Multimap, insertIteratorIteratorFromSortedRangeKeepsEqualKeysInOrder)
+{
+	dstd::pair<int,int> sorted[100];
+	for(int i = 0; i < 100; ++i) sorted[i] = dstd::pair<int,int>(i / 10, i);
+	dstd::multimap<int,int> test_map( sorted, sorted + 100 );
+	
+	ASSERT_EQ( 100, test_map.size() );
+	ASSERT_EQ( 10, test_map.count(3) );
+	int expected = 0;
+	for(dstd::multimap<int,int>::const_iterator it = test_map.begin(); it != test_map.end(); ++it, ++expected)
+	{
+		ASSERT_EQ( expected, it->second );
+	}
+}
+
+
+TEST(Multimap, emplaceInsertsAfterEqualKeys)
+{
+	dstd::multimap<int, move_only> test_map;
+	test_map.emplace( 1, move_only(1) );
+	test_map.emplace( 2, move_only(2) );
+	test_map.emplace( 1, move_only(3) );
+	test_map.emplace_hint( test_map.begin(), 1, move_only(4) );
+	
+	dstd::multimap<int, move_only> moved( dstd::move(test_map) );
+	
+	ASSERT_TRUE( test_map.empty() );
+	ASSERT_EQ( 4, moved.size() );
+	dstd::multimap<int, move_only>::const_iterator it = moved.begin();
+	ASSERT_EQ( 4, (it++)->second.value );
+	ASSERT_EQ( 1, (it++)->second.value );
+	ASSERT_EQ( 3, (it++)->second.value );
+	ASSERT_EQ( 2, (it++)->second.value );
+}
+
+
 // void erase(iterator position)
 
 
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include "../src/list.hxx"
+#include "../src/map.hxx"
+#include "../src/memory_resource.hxx"
+#include "../src/string.hxx"
+#include "../src/vector.hxx"
+
+
+
+typedef dstd::pair<const int, int> value_type;
+typedef dstd::map< int, int, dstd::less<int>, dstd::polymorphic_allocator<value_type> > pmr_map;
+
+
+/// Counts what is allocated through it, and passes everything on to new_delete_resource.
+class counting_resource : public dstd::memory_resource
+{
+	public:
+
+		counting_resource() : allocations(0), live_bytes(0) {}
+
+		size_type allocations;
+		size_type live_bytes;
+
+	private:
+
+		void* do_allocate(size_type bytes, size_type alignment)
+		{
+			++allocations;
+			live_bytes += bytes;
+			return dstd::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* p, size_type bytes, size_type alignment)
+		{
+			live_bytes -= bytes;
+			dstd::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+
+		bool do_is_equal(const memory_resource& other) const
+		{
+			return ( this == &other );
+		}
+};
+
+
+static void fill(pmr_map& m)
+{
+	for(int i = 0; i != 1000; ++i) m[i] = i * i;
+	for(int i = 0; i < 1000; i += 2) m.erase(i);
+}
+
+
+
+TEST(MemoryResource, oneMapTypeWithEachStrategy)
+{
+	dstd::monotonic_resource monotonic;
+	dstd::pool_resource pool;
+
+	pmr_map heap_map;
+	pmr_map monotonic_map( (dstd::less<int>()), &monotonic );
+	pmr_map pool_map( (dstd::less<int>()), &pool );
+
+	fill(heap_map);
+	fill(monotonic_map);
+	fill(pool_map);
+
+	ASSERT_EQ( dstd::new_delete_resource(), heap_map.get_allocator().resource() );
+	ASSERT_EQ( &monotonic, monotonic_map.get_allocator().resource() );
+	ASSERT_EQ( &pool, pool_map.get_allocator().resource() );
+	ASSERT_LT( 0, monotonic.get_arena().capacity() );
+
+	ASSERT_EQ( 500, heap_map.size() );
+	ASSERT_EQ( 500, monotonic_map.size() );
+	ASSERT_EQ( 500, pool_map.size() );
+	for(int i = 1; i < 1000; i += 2)
+	{
+		ASSERT_EQ( i * i, heap_map[i] );
+		ASSERT_EQ( i * i, monotonic_map[i] );
+		ASSERT_EQ( i * i, pool_map[i] );
+	}
+}
+
+
+TEST(MemoryResource, nodesAndBuffersComeFromTheResource)
+{
+	counting_resource counter;
+	{
+		pmr_map m( (dstd::less<int>()), &counter );
+		dstd::list< int, dstd::polymorphic_allocator<int> > l( (dstd::polymorphic_allocator<int>(&counter)) );
+		dstd::vector< double, dstd::polymorphic_allocator<double> > v( (dstd::polymorphic_allocator<double>(&counter)) );
+		for(int i = 0; i != 100; ++i)
+		{
+			m[i] = i;
+			l.push_back(i);
+			v.push_back(i);
+		}
+		ASSERT_LE( 200, counter.allocations );
+		ASSERT_LT( 0, counter.live_bytes );
+	}
+	ASSERT_EQ( 0, counter.live_bytes );
+}
+
+
+TEST(MemoryResource, defaultResourceCanBeReplaced)
+{
+	counting_resource counter;
+	ASSERT_EQ( dstd::new_delete_resource(), dstd::set_default_resource(&counter) );
+	{
+		dstd::polymorphic_allocator<int> a;
+		ASSERT_EQ( &counter, a.resource() );
+		a.deallocate( a.allocate(10), 10 );
+		ASSERT_EQ( 1, counter.allocations );
+	}
+	ASSERT_EQ( &counter, dstd::set_default_resource(0) );
+	ASSERT_EQ( dstd::new_delete_resource(), dstd::get_default_resource() );
+}
+
+
+TEST(MemoryResource, poolResourceRecyclesBlocksBySize)
+{
+	counting_resource upstream;
+	dstd::pool_resource pool(&upstream);
+
+	void* a = pool.allocate(24);
+	pool.deallocate(a, 24);
+	ASSERT_EQ( a, pool.allocate(32) );
+	ASSERT_NE( a, pool.allocate(20) );
+
+	void* small = pool.allocate(1, 1);
+	void* aligned = pool.allocate(8, 16);
+	ASSERT_EQ( 0, reinterpret_cast<size_t>(aligned) % 16 );
+	pool.deallocate(small, 1, 1);
+	pool.deallocate(aligned, 8, 16);
+	ASSERT_EQ( 0, upstream.allocations );
+
+	void* large = pool.allocate(4096);
+	ASSERT_EQ( 1, upstream.allocations );
+	pool.deallocate(large, 4096);
+	ASSERT_EQ( 0, upstream.live_bytes );
+
+	void* over_aligned = pool.allocate(64, 64);
+	ASSERT_EQ( 0, reinterpret_cast<size_t>(over_aligned) % 64 );
+	ASSERT_EQ( 2, upstream.allocations );
+	pool.deallocate(over_aligned, 64, 64);
+}
+
+
+TEST(MemoryResource, monotonicResourceIsReleasedAtOnce)
+{
+	dstd::monotonic_resource monotonic(1024);
+	{
+		dstd::basic_string< char, dstd::char_traits<char>, dstd::polymorphic_allocator<char> > s( (dstd::polymorphic_allocator<char>(&monotonic)) );
+		for(int i = 0; i != 5000; ++i) s.push_back('m');
+		ASSERT_EQ( 5000, s.size() );
+	}
+	ASSERT_LT( 5000, monotonic.get_arena().capacity() );
+
+	monotonic.release();
+	void* p = monotonic.allocate(100, 8);
+	ASSERT_EQ( 0, reinterpret_cast<size_t>(p) % 8 );
+}
+
+
+TEST(MemoryResource, allocatorsCompareByResource)
+{
+	dstd::pool_resource first;
+	dstd::pool_resource second;
+	dstd::polymorphic_allocator<int> a(&first);
+	dstd::polymorphic_allocator<double> b(&first);
+	dstd::polymorphic_allocator<int> c(&second);
+
+	ASSERT_TRUE( a == b );
+	ASSERT_TRUE( a != c );
+	ASSERT_TRUE( (dstd::polymorphic_allocator<int>() == dstd::polymorphic_allocator<char>(dstd::new_delete_resource())) );
+
+	dstd::polymorphic_allocator<long>::rebind<char>::other rebound(a);
+	ASSERT_EQ( &first, rebound.resource() );
+}
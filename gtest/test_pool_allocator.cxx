@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "../src/pool_allocator.hxx"
+#include "../src/list.hxx"
+#include "../src/map.hxx"
+#include "../src/set.hxx"
+
+
+
+TEST(PoolAllocator, deallocatedObjectIsReused)
+{
+	dstd::pool_allocator<double> a;
+	double* first = a.allocate(1);
+	a.deallocate(first, 1);
+	double* second = a.allocate(1);
+	ASSERT_EQ( first, second );
+	a.deallocate(second, 1);
+}
+
+
+TEST(PoolAllocator, allocationsAcrossManySlabsAreDistinctAndAligned)
+{
+	dstd::pool_allocator<long long> a;
+	const int n = 20000;
+	long long* p[n];
+	for(int i = 0; i < n; ++i)
+	{
+		p[i] = a.allocate(1);
+		ASSERT_EQ( 0, reinterpret_cast<size_t>(p[i]) % sizeof(long long) );
+		*p[i] = i;
+	}
+	for(int i = 0; i < n; ++i)
+	{
+		ASSERT_EQ( i, *p[i] );
+	}
+	for(int i = 0; i < n; ++i)
+	{
+		a.deallocate(p[i], 1);
+	}
+}
+
+
+TEST(PoolAllocator, arrayAllocationIsNotTakenFromPool)
+{
+	dstd::pool_allocator<int> a;
+	int* array = a.allocate(100);
+	for(int i = 0; i < 100; ++i) array[i] = i;
+	ASSERT_EQ( 99, array[99] );
+	a.deallocate(array, 100);
+}
+
+
+TEST(PoolAllocator, eachThreadHasItsOwnPool)
+{
+	dstd::pool_allocator<double> a;
+	double* mine = a.allocate(1);
+	a.deallocate(mine, 1);
+	
+	double* theirs = 0;
+	std::thread other( [&theirs]()
+	{
+		dstd::pool_allocator<double> b;
+		theirs = b.allocate(1);
+		b.deallocate(theirs, 1);
+	});
+	other.join();
+	
+	ASSERT_NE( mine, theirs );
+	ASSERT_EQ( mine, a.allocate(1) );
+	a.deallocate(mine, 1);
+}
+
+
+TEST(PoolAllocator, listsOnSeveralThreadsAtOnce)
+{
+	const int n_threads = 4;
+	int sums[n_threads];
+	std::thread threads[n_threads];
+	for(int t = 0; t < n_threads; ++t)
+	{
+		threads[t] = std::thread( [t, &sums]()
+		{
+			dstd::list< int, dstd::pool_allocator<int> > l;
+			for(int round = 0; round < 10; ++round)
+			{
+				for(int i = 0; i < 1000; ++i) l.push_back(t * 1000 + i);
+				for(int i = 0; i < 1000; ++i) l.pop_front();
+			}
+			for(int i = 0; i < 1000; ++i) l.push_back(t * 1000 + i);
+			int sum = 0;
+			for(dstd::list< int, dstd::pool_allocator<int> >::const_iterator it = l.begin(); it != l.end(); ++it) sum += *it;
+			sums[t] = sum;
+		});
+	}
+	for(int t = 0; t < n_threads; ++t) threads[t].join();
+	
+	for(int t = 0; t < n_threads; ++t) ASSERT_EQ( t * 1000 * 1000 + 999 * 1000 / 2, sums[t] );
+}
+
+
+TEST(PoolAllocator, reboundAllocatorsCompareEqual)
+{
+	dstd::pool_allocator<int> a;
+	dstd::pool_allocator<int>::rebind<double>::other b(a);
+	ASSERT_TRUE( a == b );
+	ASSERT_FALSE( a != b );
+}
+
+
+TEST(PoolAllocator, listAllocatesNodesFromPool)
+{
+	dstd::list< int, dstd::pool_allocator<int> > l;
+	for(int i = 0; i < 1000; ++i)
+	{
+		l.push_back(i);
+	}
+	for(int i = 0; i < 500; ++i)
+	{
+		l.pop_front();
+	}
+	ASSERT_EQ( 500, l.size() );
+	ASSERT_EQ( 500, l.front() );
+	ASSERT_EQ( 999, l.back() );
+}
+
+
+TEST(PoolAllocator, mapAllocatesNodesFromPool)
+{
+	dstd::map< int, int, dstd::less<int>, dstd::pool_allocator< dstd::pair<int,int> > > m;
+	for(int i = 0; i < 1000; ++i)
+	{
+		m[i] = i*i;
+	}
+	for(int i = 0; i < 1000; i += 2)
+	{
+		m.erase(i);
+	}
+	ASSERT_EQ( 500, m.size() );
+	ASSERT_EQ( 81, m[9] );
+
+	dstd::map< int, int, dstd::less<int>, dstd::pool_allocator< dstd::pair<int,int> > > copy(m);
+	m.clear();
+	ASSERT_EQ( 500, copy.size() );
+	ASSERT_EQ( 1, copy.begin()->first );
+}
+
+
+TEST(PoolAllocator, multisetAllocatesNodesFromPool)
+{
+	dstd::multiset< int, dstd::less<int>, dstd::pool_allocator<int> > s;
+	for(int i = 0; i < 300; ++i)
+	{
+		s.insert(i % 10);
+	}
+	ASSERT_EQ( 30, s.count(7) );
+	s.erase(7);
+	ASSERT_EQ( 270, s.size() );
+}
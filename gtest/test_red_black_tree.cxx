@@ -0,0 +1,460 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include "../src/impl/red_black_tree.hxx"
+#include "../src/set.hxx"
+
+
+
+typedef dstd::impl::red_black_tree<int, dstd::less<int>, false> unique_tree;
+typedef dstd::impl::red_black_tree<int, dstd::less<int>, true> multi_tree;
+
+
+/// Returns the number of black nodes on every path from n down to a null child,
+/// or -1 if the paths do not agree or a red node has a red child.
+template <class Tree>
+int black_height(const Tree& tree, const typename Tree::node* n)
+{
+	if( tree.is_null(n) ) return 1;
+
+	const typename Tree::node* left = n->left_child();
+	const typename Tree::node* right = n->right_child();
+
+	if( n->colour == Tree::node::red )
+	{
+		if( ! tree.is_null(left) && left->colour == Tree::node::red ) return -1;
+		if( ! tree.is_null(right) && right->colour == Tree::node::red ) return -1;
+	}
+
+	const int left_height = black_height(tree, left);
+	const int right_height = black_height(tree, right);
+	if( left_height < 0 || left_height != right_height ) return -1;
+
+	return left_height + ( n->colour == Tree::node::black ? 1 : 0 );
+}
+
+
+template <class Tree>
+int depth(const Tree& tree, const typename Tree::node* n)
+{
+	if( tree.is_null(n) ) return 0;
+	const int left_depth = depth(tree, n->left_child());
+	const int right_depth = depth(tree, n->right_child());
+	return 1 + ( left_depth > right_depth ? left_depth : right_depth );
+}
+
+
+template <class Tree>
+bool is_valid(const Tree& tree)
+{
+	if( tree.empty() ) return true;
+	if( tree.root()->colour != Tree::node::black ) return false;
+	if( black_height(tree, tree.root()) < 0 ) return false;
+
+	// in-order traversal must be sorted and visit every node
+	typename Tree::size_type n = 0;
+	const typename Tree::node* prev = 0;
+	for(const typename Tree::node* it = tree.left_most(); ! tree.is_null(it); it = it->next())
+	{
+		if( prev != 0 && it->value < prev->value ) return false;
+		prev = it;
+		++n;
+	}
+	return ( n == tree.size() && prev == tree.right_most() );
+}
+
+
+template <class Tree>
+void delete_nodes(Tree& tree, typename Tree::node* n)
+{
+	if( ! tree.is_null(n) )
+	{
+		delete_nodes(tree, n->left_child());
+		delete_nodes(tree, n->right_child());
+		delete n;
+	}
+}
+
+
+class RedBlackTree : public ::testing::Test
+{
+	protected:
+
+		void TearDown()
+		{
+			delete_nodes(tree, tree.root());
+			delete_nodes(multi, multi.root());
+		}
+
+		unique_tree tree;
+		multi_tree multi;
+};
+
+
+
+TEST_F(RedBlackTree, insertAscendingKeepsTreeBalanced)
+{
+	const int n = 1023;
+	for(int i = 0; i < n; ++i)
+	{
+		tree.insert( new unique_tree::node(i) );
+		ASSERT_TRUE( is_valid(tree) );
+	}
+	ASSERT_EQ( n, tree.size() );
+	ASSERT_LE( depth(tree, tree.root()), 2*10 );
+}
+
+
+TEST_F(RedBlackTree, insertDescendingKeepsTreeBalanced)
+{
+	const int n = 1023;
+	for(int i = n; i > 0; --i)
+	{
+		tree.insert( new unique_tree::node(i) );
+	}
+	ASSERT_TRUE( is_valid(tree) );
+	ASSERT_LE( depth(tree, tree.root()), 2*10 );
+}
+
+
+TEST_F(RedBlackTree, insertExistingValueReturnsExistingNode)
+{
+	unique_tree::node* first = tree.insert( new unique_tree::node(7) );
+	unique_tree::node* duplicate = new unique_tree::node(7);
+	ASSERT_EQ( first, tree.insert(duplicate) );
+	ASSERT_EQ( 1, tree.size() );
+	delete duplicate;
+}
+
+
+TEST_F(RedBlackTree, insertEqualValuesIntoMultiTreeKeepsTreeBalanced)
+{
+	for(int i = 0; i < 500; ++i)
+	{
+		multi.insert( new multi_tree::node(i % 5) );
+	}
+	ASSERT_TRUE( is_valid(multi) );
+	ASSERT_EQ( 500, multi.size() );
+}
+
+
+TEST_F(RedBlackTree, removeKeepsTreeBalanced)
+{
+	const int n = 500;
+	for(int i = 0; i < n; ++i)
+	{
+		tree.insert( new unique_tree::node(i) );
+	}
+
+	std::srand(42);
+	for(int i = 0; i < n; ++i)
+	{
+		int value = std::rand() % n;
+		unique_tree::node* found = tree.find(value);
+		if( ! tree.is_null(found) )
+		{
+			tree.remove(found);
+			delete found;
+			ASSERT_TRUE( is_valid(tree) );
+		}
+	}
+}
+
+
+TEST_F(RedBlackTree, removeAllLeavesTreeEmpty)
+{
+	for(int i = 0; i < 100; ++i)
+	{
+		tree.insert( new unique_tree::node(i) );
+	}
+	while( ! tree.empty() )
+	{
+		unique_tree::node* n = tree.root();
+		tree.remove(n);
+		delete n;
+		ASSERT_TRUE( is_valid(tree) );
+	}
+	ASSERT_EQ( 0, tree.size() );
+}
+
+
+TEST_F(RedBlackTree, randomInsertAndRemoveKeepsTreeBalanced)
+{
+	std::srand(7);
+	for(int i = 0; i < 5000; ++i)
+	{
+		int value = std::rand() % 200;
+		if( std::rand() % 3 == 0 )
+		{
+			multi_tree::node* found = multi.find(value);
+			if( ! multi.is_null(found) )
+			{
+				multi.remove(found);
+				delete found;
+			}
+		}
+		else
+		{
+			multi.insert( new multi_tree::node(value) );
+		}
+	}
+	ASSERT_TRUE( is_valid(multi) );
+}
+
+
+
+TEST(RedBlackTreeBuild, assignBalancedBuildsValidTreeOfEverySize)
+{
+	for(int n = 0; n <= 300; ++n)
+	{
+		unique_tree tree;
+		unique_tree::node* first = 0;
+		unique_tree::node* last = 0;
+		for(int i = 0; i < n; ++i)
+		{
+			unique_tree::node* node = new unique_tree::node(i);
+			if( last == 0 ) first = node;
+			else last->right = node;
+			last = node;
+		}
+		
+		tree.assign_balanced(first, n);
+		
+		ASSERT_TRUE( is_valid(tree) );
+		ASSERT_EQ( n, tree.size() );
+		int max_depth = 0;
+		for(int i = n; i > 0; i /= 2) ++max_depth;
+		ASSERT_EQ( max_depth, depth(tree, tree.root()) );
+		
+		// the tree must stay valid as it is modified in the usual way
+		tree.insert( new unique_tree::node(n) );
+		ASSERT_TRUE( is_valid(tree) );
+		unique_tree::node* found = tree.find(n / 2);
+		tree.remove(found);
+		delete found;
+		ASSERT_TRUE( is_valid(tree) );
+		
+		delete_nodes(tree, tree.root());
+	}
+}
+
+
+
+/// Orders pairs by their first member only
+class first_less
+{
+	public:
+		
+		bool operator() (const dstd::pair<int,int>& a, const dstd::pair<int,int>& b) const { return a.first < b.first; }
+};
+
+
+int counting_comparisons = 0;
+
+
+/// A comparator which counts how often it is called, to check how much an operation searches
+class counting_less
+{
+	public:
+		
+		bool operator() (int a, int b) const { ++counting_comparisons; return a < b; }
+};
+
+
+
+TEST(Set, insertSortedKeysAndEraseKeepsOrder)
+{
+	dstd::set<int> s;
+	for(int i = 0; i < 1000; ++i)
+	{
+		ASSERT_TRUE( s.insert(i).second );
+	}
+	ASSERT_FALSE( s.insert(500).second );
+	ASSERT_EQ( 1000, s.size() );
+
+	for(int i = 0; i < 1000; i += 2)
+	{
+		ASSERT_EQ( 1, s.erase(i) );
+	}
+	ASSERT_EQ( 500, s.size() );
+
+	int expected = 1;
+	for(dstd::set<int>::const_iterator it = s.begin(); it != s.end(); ++it, expected += 2)
+	{
+		ASSERT_EQ( expected, *it );
+	}
+}
+
+
+TEST(Multiset, insertKeepsEqualValuesInInsertionOrder)
+{
+	dstd::multiset< dstd::pair<int,int>, first_less > s;
+	for(int i = 0; i < 20; ++i)
+	{
+		s.insert( dstd::pair<int,int>(i % 2, i) );
+	}
+	int previous = -1;
+	for(dstd::multiset< dstd::pair<int,int>, first_less >::const_iterator it = s.begin(); it != s.end() && it->first == 0; ++it)
+	{
+		ASSERT_LT( previous, it->second );
+		previous = it->second;
+	}
+}
+
+
+TEST(Set, constructFromSortedRangeWithDuplicatesKeepsOneOfEach)
+{
+	int values[200];
+	for(int i = 0; i < 200; ++i) values[i] = i / 2;
+	dstd::set<int> s( values, values + 200 );
+	
+	ASSERT_EQ( 100, s.size() );
+	int expected = 0;
+	for(dstd::set<int>::const_iterator it = s.begin(); it != s.end(); ++it, ++expected)
+	{
+		ASSERT_EQ( expected, *it );
+	}
+	
+	dstd::set<int> copy(s);
+	ASSERT_EQ( 100, copy.size() );
+	ASSERT_EQ( 1, copy.erase(50) );
+	ASSERT_TRUE( copy.insert(-1).second );
+	ASSERT_EQ( -1, *copy.begin() );
+}
+
+
+TEST(Multiset, constructFromSortedRangeKeepsEqualValuesInOrder)
+{
+	dstd::pair<int,int> values[60];
+	for(int i = 0; i < 60; ++i) values[i] = dstd::pair<int,int>(i / 20, i);
+	dstd::multiset< dstd::pair<int,int>, first_less > s( values, values + 60 );
+	
+	ASSERT_EQ( 60, s.size() );
+	int expected = 0;
+	for(dstd::multiset< dstd::pair<int,int>, first_less >::const_iterator it = s.begin(); it != s.end(); ++it, ++expected)
+	{
+		ASSERT_EQ( expected, it->second );
+	}
+}
+
+
+TEST(Set, insertWithHintInsertsEveryValueInOrder)
+{
+	dstd::set<int> s;
+	dstd::set<int>::iterator hint = s.end();
+	for(int i = 0; i < 500; ++i)
+	{
+		hint = s.insert(hint, 1000 - 2*i);
+		ASSERT_EQ( 1000 - 2*i, *hint );
+	}
+	for(int i = 0; i < 500; ++i)
+	{
+		s.insert(s.begin(), 2*i + 1);
+	}
+	ASSERT_EQ( 1000, *s.insert(s.end(), 1000) );
+	ASSERT_EQ( 1000, s.size() );
+	
+	int expected = 1;
+	for(dstd::set<int>::const_iterator it = s.begin(); it != s.end(); ++it, ++expected)
+	{
+		ASSERT_EQ( expected, *it );
+	}
+}
+
+
+TEST(Set, insertWithHintNextToItComparesAConstantNumberOfTimes)
+{
+	dstd::set<int, counting_less> s;
+	counting_comparisons = 0;
+	dstd::set<int, counting_less>::iterator hint = s.end();
+	for(int i = 0; i < 1000; ++i)
+	{
+		hint = s.insert(hint, 1000 - i);
+	}
+	ASSERT_GE( 3*1000, counting_comparisons );
+	
+	counting_comparisons = 0;
+	for(int i = 1; i <= 1000; ++i)
+	{
+		s.emplace_hint(s.end(), 1000 + i);
+	}
+	ASSERT_GE( 3*1000, counting_comparisons );
+	
+	dstd::multiset<int, counting_less> m;
+	counting_comparisons = 0;
+	for(int i = 0; i < 1000; ++i)
+	{
+		m.insert(m.end(), i / 10);
+	}
+	ASSERT_GE( 3*1000, counting_comparisons );
+	
+	ASSERT_EQ( 2000, s.size() );
+	int expected = 1;
+	for(dstd::set<int, counting_less>::const_iterator it = s.begin(); it != s.end(); ++it, ++expected)
+	{
+		ASSERT_EQ( expected, *it );
+	}
+	ASSERT_EQ( 10, m.count(42) );
+}
+
+
+TEST(Multiset, insertWithHintInsertsBeforeHint)
+{
+	dstd::multiset< dstd::pair<int,int>, first_less > s;
+	for(int i = 0; i < 10; ++i)
+	{
+		s.insert( s.begin(), dstd::pair<int,int>(0, i) );
+	}
+	int expected = 9;
+	for(dstd::multiset< dstd::pair<int,int>, first_less >::const_iterator it = s.begin(); it != s.end(); ++it, --expected)
+	{
+		ASSERT_EQ( expected, it->second );
+	}
+}
+
+
+TEST(Multiset, countReturnsNumberOfEqualKeys)
+{
+	dstd::multiset<int> s;
+	for(int i = 0; i < 30; ++i)
+	{
+		s.insert(i % 3);
+	}
+	ASSERT_EQ( 30, s.size() );
+	ASSERT_EQ( 10, s.count(1) );
+	ASSERT_EQ( 0, s.count(3) );
+	ASSERT_EQ( 10, s.erase(2) );
+	ASSERT_EQ( 20, s.size() );
+}
+
+
+TEST(Set, emplaceBuildsValueAndKeepsOneOfEach)
+{
+	dstd::set< dstd::pair<int,int>, first_less > s;
+	ASSERT_TRUE( s.emplace(2, 0).second );
+	ASSERT_TRUE( s.emplace_hint(s.begin(), 1, 0) != s.end() );
+	
+	dstd::pair< dstd::set< dstd::pair<int,int>, first_less >::iterator, bool > result = s.emplace(2, 1);
+	
+	ASSERT_FALSE( result.second );
+	ASSERT_EQ( 0, result.first->second );
+	ASSERT_EQ( 2, s.size() );
+	ASSERT_EQ( 1, s.begin()->first );
+}
+
+
+TEST(Multiset, moveConstructorAndAssignmentTakeElements)
+{
+	dstd::multiset<int> s;
+	for(int i = 0; i < 100; ++i) s.insert(i % 10);
+	
+	dstd::multiset<int> moved( dstd::move(s) );
+	ASSERT_TRUE( s.empty() );
+	ASSERT_EQ( 100, moved.size() );
+	
+	s = dstd::move(moved);
+	ASSERT_TRUE( moved.empty() );
+	ASSERT_EQ( 10, s.count(3) );
+	
+	moved.insert(1);
+	ASSERT_EQ( 1, moved.size() );
+}
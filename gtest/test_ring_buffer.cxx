@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include "../src/aligned_allocator.hxx"
+#include "../src/queue.hxx"
+#include "../src/ring_buffer.hxx"
+#include "../src/string.hxx"
+#include "../src/tracking_allocator.hxx"
+
+
+
+typedef dstd::ring_buffer<int, 8> ring8;
+typedef dstd::ring_buffer< int, 0, dstd::tracking_allocator<int> > tracked_ring;
+
+
+
+TEST(RingBuffer, isAFifoOfFixedCapacity)
+{
+	ring8 r;
+	ASSERT_EQ( 8, r.capacity() );
+	ASSERT_TRUE( r.empty() );
+
+	for(int round = 0; round != 10; ++round)
+	{
+		for(int i = 0; i != 5; ++i) r.push_back(round * 10 + i);
+		ASSERT_EQ( 5, r.size() );
+		ASSERT_EQ( round * 10, r.front() );
+		ASSERT_EQ( round * 10 + 4, r.back() );
+		for(int i = 0; i != 5; ++i)
+		{
+			ASSERT_EQ( round * 10 + i, r[0] );
+			r.pop_front();
+		}
+	}
+	ASSERT_TRUE( r.empty() );
+}
+
+
+TEST(RingBuffer, pushingWhenFullThrowsUnlessOverwriting)
+{
+	ring8 r;
+	for(int i = 0; i != 8; ++i) r.push_back(i);
+	ASSERT_TRUE( r.full() );
+	ASSERT_THROW( r.push_back(8), dstd::length_error );
+	ASSERT_THROW( r.push_front(-1), dstd::length_error );
+	ASSERT_EQ( 0, r.front() );
+	ASSERT_EQ( 7, r.back() );
+
+	r.set_full_policy(dstd::overwrite_oldest);
+	for(int i = 8; i != 20; ++i) r.push_back(i);
+	ASSERT_EQ( 8, r.size() );
+	for(int i = 0; i != 8; ++i) ASSERT_EQ( 12 + i, r[i] );
+
+	r.push_front(-1);
+	ASSERT_EQ( -1, r.front() );
+	ASSERT_EQ( 18, r.back() );
+	ASSERT_THROW( r.at(8), dstd::out_of_range );
+}
+
+
+TEST(RingBuffer, runtimeCapacityAllocatesOnce)
+{
+	dstd::allocation_stats stats;
+	{
+		tracked_ring r( 100, dstd::overwrite_oldest, dstd::tracking_allocator<int>(stats) );
+		ASSERT_EQ( 100, r.capacity() );
+		ASSERT_EQ( 1, stats.allocations() );
+		ASSERT_EQ( 128 * sizeof(int), stats.live_bytes() );
+
+		for(int i = 0; i != 10000; ++i)
+		{
+			r.push_back(i);
+			if( i % 3 == 1 ) r.pop_front();
+		}
+		ASSERT_EQ( 100, r.size() );
+		ASSERT_EQ( 9999, r.back() );
+		ASSERT_EQ( 1, stats.allocations() );
+	}
+	ASSERT_EQ( 0, stats.live_bytes() );
+}
+
+
+TEST(RingBuffer, iteratorsWrapRoundTheSlots)
+{
+	ring8 r;
+	for(int i = 0; i != 6; ++i) r.push_back(i);
+	for(int i = 0; i != 4; ++i) r.pop_front();
+	for(int i = 6; i != 12; ++i) r.push_back(i);
+
+	ASSERT_EQ( 8, r.end() - r.begin() );
+	int expected = 4;
+	for(ring8::const_iterator it = r.begin(); it != r.end(); ++it) ASSERT_EQ( expected++, *it );
+	ASSERT_EQ( 11, *r.rbegin() );
+	ASSERT_EQ( 7, r.begin()[3] );
+}
+
+
+TEST(RingBuffer, spansCoverTheElementsInOrder)
+{
+	ring8 r;
+	for(int i = 0; i != 5; ++i) r.push_back(i);
+	ASSERT_EQ( 5, r.first_span().second );
+	ASSERT_EQ( 0, r.second_span().second );
+
+	for(int i = 0; i != 4; ++i) r.pop_front();
+	for(int i = 5; i != 10; ++i) r.push_back(i);
+
+	dstd::pair<int*, size_t> one = r.first_span();
+	dstd::pair<int*, size_t> two = r.second_span();
+	ASSERT_EQ( 4, one.second );
+	ASSERT_EQ( 2, two.second );
+	ASSERT_EQ( &r.front(), one.first );
+	for(size_t i = 0; i != one.second; ++i) ASSERT_EQ( 4 + i, one.first[i] );
+	for(size_t i = 0; i != two.second; ++i) ASSERT_EQ( 8 + i, two.first[i] );
+}
+
+
+TEST(RingBuffer, readAndWriteInBulk)
+{
+	dstd::ring_buffer<int> r(10);
+	int in[25];
+	for(int i = 0; i != 25; ++i) in[i] = i;
+
+	ASSERT_EQ( 7, r.write(in, 7) );
+	int out[25];
+	ASSERT_EQ( 5, r.read(out, 5) );
+	ASSERT_EQ( 8, r.write(in + 7, 18) );
+	ASSERT_EQ( 10, r.size() );
+
+	ASSERT_EQ( 10, r.read(out + 5, 25) );
+	for(int i = 0; i != 15; ++i) ASSERT_EQ( i, out[i] );
+	ASSERT_TRUE( r.empty() );
+
+	r.set_full_policy(dstd::overwrite_oldest);
+	r.push_back(-1);
+	ASSERT_EQ( 25, r.write(in, 25) );
+	ASSERT_EQ( 10, r.size() );
+	ASSERT_EQ( 15, r.front() );
+	ASSERT_EQ( 24, r.back() );
+}
+
+
+TEST(RingBuffer, copyMoveAndSwap)
+{
+	dstd::ring_buffer<dstd::string, 4> a;
+	a.push_back("x");
+	a.push_back("y");
+	a.pop_front();
+	a.push_back("z");
+
+	dstd::ring_buffer<dstd::string, 4> b(a);
+	ASSERT_TRUE( a == b );
+	dstd::ring_buffer<dstd::string, 4> c( dstd::move(a) );
+	ASSERT_TRUE( a.empty() );
+	ASSERT_TRUE( b == c );
+
+	dstd::ring_buffer<dstd::string> d(3);
+	d.push_back("w");
+	dstd::ring_buffer<dstd::string> e(5);
+	e = d;
+	ASSERT_EQ( 3, e.capacity() );
+	ASSERT_EQ( "w", e.front() );
+
+	d.push_back("v");
+	dstd::swap(d, e);
+	ASSERT_EQ( 1, d.size() );
+	ASSERT_EQ( "v", e.back() );
+
+	dstd::circular_buffer<dstd::string> f( dstd::move(e) );
+	ASSERT_EQ( 2, f.size() );
+	ASSERT_EQ( 0, e.capacity() );
+	ASSERT_THROW( e.push_back("u"), dstd::length_error );
+}
+
+
+TEST(RingBuffer, movingAndSwappingKeepSlotsWithTheirAllocator)
+{
+	dstd::allocation_stats s1;
+	dstd::allocation_stats s2;
+	{
+		tracked_ring a( 10, dstd::reject_when_full, dstd::tracking_allocator<int>(s1) );
+		tracked_ring b( 20, dstd::reject_when_full, dstd::tracking_allocator<int>(s2) );
+		b.push_back(1);
+
+		a = dstd::move(b);
+		ASSERT_EQ( 1, s1.deallocations() );
+		ASSERT_EQ( &s2, &a.get_allocator().get_stats() );
+		ASSERT_EQ( 20, a.capacity() );
+
+		tracked_ring c( 5, dstd::reject_when_full, dstd::tracking_allocator<int>(s1) );
+		c.push_back(2);
+		dstd::swap(a, c);
+		ASSERT_EQ( &s1, &a.get_allocator().get_stats() );
+		ASSERT_EQ( &s2, &c.get_allocator().get_stats() );
+		ASSERT_EQ( 2, a.front() );
+		ASSERT_EQ( 1, c.front() );
+
+		tracked_ring d( dstd::move(c) );
+		ASSERT_EQ( &s2, &d.get_allocator().get_stats() );
+	}
+	ASSERT_EQ( s1.allocations(), s1.deallocations() );
+	ASSERT_EQ( s2.allocations(), s2.deallocations() );
+	ASSERT_EQ( 0, s1.live_bytes() );
+	ASSERT_EQ( 0, s2.live_bytes() );
+}
+
+
+TEST(RingBuffer, inlineSlotsAreAlignedAsTheAllocatorAligns)
+{
+	dstd::ring_buffer< float, 16, dstd::aligned_allocator<float, 64> > r;
+	r.push_back(1.0f);
+	ASSERT_EQ( 0, reinterpret_cast<size_t>( &r.front() ) % 64 );
+}
+
+
+TEST(RingBuffer, isAQueueContainer)
+{
+	dstd::queue< int, dstd::ring_buffer<int, 16> > q;
+	for(int i = 0; i != 10; ++i) q.push(i);
+	ASSERT_EQ( 10, q.size() );
+	ASSERT_EQ( 0, q.front() );
+	ASSERT_EQ( 9, q.back() );
+	q.pop();
+	ASSERT_EQ( 1, q.front() );
+
+	dstd::queue< int, dstd::ring_buffer<int> > bounded( dstd::ring_buffer<int>(3, dstd::overwrite_oldest) );
+	for(int i = 0; i != 10; ++i) bounded.push(i);
+	ASSERT_EQ( 3, bounded.size() );
+	ASSERT_EQ( 7, bounded.front() );
+}
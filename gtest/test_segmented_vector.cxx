@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "../src/segmented_vector.hxx"
+#include "../src/string.hxx"
+
+
+
+TEST(SegmentedVector, indexingAcrossBlocks)
+{
+	dstd::segmented_vector<int> v;
+	for(int i = 0; i != 10000; ++i) v.push_back(i);
+
+	ASSERT_EQ( 10000, v.size() );
+	ASSERT_LE( 10000, v.capacity() );
+	for(int i = 0; i != 10000; ++i) ASSERT_EQ( i, v[i] );
+	ASSERT_EQ( 0, v.front() );
+	ASSERT_EQ( 9999, v.back() );
+	ASSERT_THROW( v.at(10000), dstd::out_of_range );
+}
+
+
+TEST(SegmentedVector, growingNeverMovesElements)
+{
+	dstd::segmented_vector<dstd::string> v;
+	v.push_back("first");
+	const dstd::string* first = &v[0];
+
+	for(int i = 0; i != 5000; ++i) v.emplace_back(3, 'x');
+
+	ASSERT_EQ( first, &v[0] );
+	ASSERT_EQ( dstd::string("first"), v[0] );
+	ASSERT_EQ( dstd::string("xxx"), v[5000] );
+}
+
+
+TEST(SegmentedVector, capacityDoublesWithEachBlock)
+{
+	dstd::segmented_vector<int> v;
+	ASSERT_EQ( 0, v.capacity() );
+	v.push_back(0);
+	const size_t first_block = v.capacity();
+	ASSERT_LT( 0, first_block );
+
+	while( v.size() != v.capacity() ) v.push_back(0);
+	v.push_back(0);
+	ASSERT_EQ( 3 * first_block, v.capacity() );
+}
+
+
+TEST(SegmentedVector, iteratorsVisitElementsInOrder)
+{
+	dstd::segmented_vector<int> v;
+	for(int i = 0; i != 100; ++i) v.push_back(i);
+
+	int expected = 0;
+	for(dstd::segmented_vector<int>::const_iterator it = v.begin(); it != v.end(); ++it) ASSERT_EQ( expected++, *it );
+	ASSERT_EQ( 100, v.end() - v.begin() );
+	ASSERT_EQ( 99, *(v.rbegin()) );
+	ASSERT_EQ( 50, v.begin()[50] );
+}
+
+
+TEST(SegmentedVector, popResizeAndShrink)
+{
+	dstd::segmented_vector<dstd::string> v(1000, "abc");
+	ASSERT_EQ( 1000, v.size() );
+
+	v.resize(10);
+	ASSERT_EQ( 10, v.size() );
+	ASSERT_LE( 1000, v.capacity() );
+
+	v.shrink_to_fit();
+	ASSERT_LE( 10, v.capacity() );
+	ASSERT_GT( 1000, v.capacity() );
+	ASSERT_EQ( dstd::string("abc"), v.back() );
+
+	v.pop_back();
+	ASSERT_EQ( 9, v.size() );
+	v.clear();
+	v.shrink_to_fit();
+	ASSERT_EQ( 0, v.capacity() );
+}
+
+
+TEST(SegmentedVector, copyMoveAndSwap)
+{
+	dstd::segmented_vector<dstd::string> v;
+	for(int i = 0; i != 100; ++i) v.push_back( dstd::string(1, static_cast<char>('a' + i % 26)) );
+
+	dstd::segmented_vector<dstd::string> w(v);
+	ASSERT_TRUE( v == w );
+
+	const dstd::string* element = &w[50];
+	dstd::segmented_vector<dstd::string> x( dstd::move(w) );
+	ASSERT_TRUE( w.empty() );
+	ASSERT_EQ( element, &x[50] );
+
+	w.push_back("z");
+	dstd::swap(w, x);
+	ASSERT_EQ( 100, w.size() );
+	ASSERT_EQ( 1, x.size() );
+	ASSERT_TRUE( w == v );
+
+	x = v;
+	ASSERT_TRUE( x == v );
+	x[0] = "changed";
+	ASSERT_TRUE( x != v );
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include "../src/small_vector.hxx"
+#include "../src/string.hxx"
+
+
+
+static int n_allocations = 0;
+
+
+/// Counts the blocks it allocates, so the tests can tell when the elements leave the inline storage.
+template <class T>
+class counting_allocator : public dstd::allocator<T>
+{
+	public:
+
+		template <class OtherType>
+		struct rebind
+		{
+			typedef counting_allocator< OtherType > other;
+		};
+
+
+		T* allocate(size_t n)
+		{
+			++n_allocations;
+			return dstd::allocator<T>::allocate(n);
+		}
+};
+
+
+typedef dstd::small_vector< int, 4, counting_allocator<int> > small_ints;
+typedef dstd::small_vector< dstd::string, 3 > small_strings;
+
+
+
+TEST(SmallVector, staysInlineUpToN)
+{
+	n_allocations = 0;
+	small_ints v;
+	ASSERT_TRUE( v.is_inline() );
+	ASSERT_EQ( 4, v.capacity() );
+
+	for(int i = 0; i != 4; ++i) v.push_back(i);
+
+	ASSERT_EQ( 0, n_allocations );
+	ASSERT_TRUE( v.is_inline() );
+	ASSERT_EQ( 4, v.size() );
+	for(int i = 0; i != 4; ++i) ASSERT_EQ( i, v[i] );
+}
+
+
+TEST(SmallVector, spillsToAllocatorPastN)
+{
+	n_allocations = 0;
+	small_ints v;
+	for(int i = 0; i != 20; ++i) v.push_back(i);
+
+	ASSERT_FALSE( v.is_inline() );
+	ASSERT_LE( 20, v.capacity() );
+	ASSERT_LT( 0, n_allocations );
+	for(int i = 0; i != 20; ++i) ASSERT_EQ( i, v.at(i) );
+}
+
+
+TEST(SmallVector, insertAndEraseInline)
+{
+	small_ints v;
+	v.push_back(1);
+	v.push_back(3);
+	v.insert(v.begin() + 1, 2);
+	v.emplace(v.begin(), 0);
+	ASSERT_EQ( 4, v.size() );
+	for(int i = 0; i != 4; ++i) ASSERT_EQ( i, v[i] );
+
+	v.erase(v.begin() + 1);
+	ASSERT_EQ( 3, v.size() );
+	ASSERT_EQ( 0, v[0] );
+	ASSERT_EQ( 2, v[1] );
+	ASSERT_EQ( 3, v[2] );
+	ASSERT_TRUE( v.is_inline() );
+}
+
+
+TEST(SmallVector, shrinkToFitMovesBackInline)
+{
+	small_strings v;
+	for(int i = 0; i != 10; ++i) v.push_back( dstd::string(20, static_cast<char>('a' + i)) );
+	ASSERT_FALSE( v.is_inline() );
+
+	v.erase(v.begin() + 2, v.end());
+	v.shrink_to_fit();
+
+	ASSERT_TRUE( v.is_inline() );
+	ASSERT_EQ( 3, v.capacity() );
+	ASSERT_EQ( 2, v.size() );
+	ASSERT_EQ( dstd::string(20, 'a'), v[0] );
+	ASSERT_EQ( dstd::string(20, 'b'), v[1] );
+}
+
+
+TEST(SmallVector, copyAndCompare)
+{
+	small_strings v;
+	v.push_back("one");
+	v.push_back("two");
+	small_strings w(v);
+	ASSERT_TRUE( v == w );
+
+	for(int i = 0; i != 5; ++i) w.push_back("more");
+	ASSERT_TRUE( v != w );
+
+	v = w;
+	ASSERT_TRUE( v == w );
+	ASSERT_EQ( 7, v.size() );
+}
+
+
+TEST(SmallVector, ordersLikeAVector)
+{
+	dstd::small_vector<int, 2> v;
+	v.push_back(5);
+	dstd::small_vector<int, 2> w(v);
+	for(int i = 0; i != 3; ++i) w.push_back(i);
+
+	ASSERT_TRUE( v < w );
+	ASSERT_TRUE( v <= w );
+	ASSERT_TRUE( w > v );
+	ASSERT_FALSE( v >= w );
+
+	w[0] = 1;
+	ASSERT_TRUE( w < v );
+	ASSERT_FALSE( v <= w );
+}
+
+
+TEST(SmallVector, moveTakesAllocatedMemory)
+{
+	small_strings v;
+	for(int i = 0; i != 6; ++i) v.push_back("abcdefghijklmnopqrstuvwxyz");
+	const dstd::string* data = &v[0];
+
+	small_strings w( dstd::move(v) );
+
+	ASSERT_EQ( data, &w[0] );
+	ASSERT_EQ( 6, w.size() );
+	ASSERT_TRUE( v.empty() );
+	ASSERT_TRUE( v.is_inline() );
+
+	v.push_back("again");
+	ASSERT_EQ( dstd::string("again"), v[0] );
+}
+
+
+TEST(SmallVector, moveInlineMovesElements)
+{
+	small_strings v;
+	v.push_back("abcdefghijklmnopqrstuvwxyz");
+	v.push_back("b");
+
+	small_strings w;
+	w.push_back("old");
+	w = dstd::move(v);
+
+	ASSERT_TRUE( w.is_inline() );
+	ASSERT_EQ( 2, w.size() );
+	ASSERT_EQ( dstd::string("abcdefghijklmnopqrstuvwxyz"), w[0] );
+	ASSERT_EQ( dstd::string("b"), w[1] );
+	ASSERT_TRUE( v.empty() );
+}
+
+
+TEST(SmallVector, swapInlineWithAllocated)
+{
+	small_strings v;
+	v.push_back("x");
+	small_strings w;
+	for(int i = 0; i != 5; ++i) w.push_back( dstd::string(1, static_cast<char>('a' + i)) );
+
+	dstd::swap(v, w);
+
+	ASSERT_EQ( 5, v.size() );
+	ASSERT_FALSE( v.is_inline() );
+	ASSERT_EQ( dstd::string("e"), v.back() );
+	ASSERT_EQ( 1, w.size() );
+	ASSERT_TRUE( w.is_inline() );
+	ASSERT_EQ( dstd::string("x"), w.front() );
+
+	v.swap(w);
+	ASSERT_EQ( 1, v.size() );
+	ASSERT_EQ( 5, w.size() );
+}
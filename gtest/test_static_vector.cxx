@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "../src/list.hxx"
+#include "../src/static_vector.hxx"
+#include "../src/string.hxx"
+
+
+
+typedef dstd::static_vector<int, 4> static_ints;
+typedef dstd::static_vector<dstd::string, 3> static_strings;
+
+
+
+TEST(StaticVector, holdsUpToN)
+{
+	static_ints v;
+	ASSERT_EQ( 4, v.capacity() );
+	ASSERT_EQ( 4, v.max_size() );
+
+	for(int i = 0; i != 4; ++i) v.push_back(i);
+
+	ASSERT_TRUE( v.full() );
+	ASSERT_LE( reinterpret_cast<const char*>(&v), reinterpret_cast<const char*>(&v[0]) );
+	ASSERT_GE( reinterpret_cast<const char*>(&v + 1), reinterpret_cast<const char*>(&v[3] + 1) );
+	for(int i = 0; i != 4; ++i) ASSERT_EQ( i, v[i] );
+}
+
+
+TEST(StaticVector, insertPastCapacityThrowsAndLeavesVectorUnchanged)
+{
+	static_ints v(3, 7);
+	v.insert(v.begin(), 1);
+
+	ASSERT_THROW( v.push_back(2), dstd::length_error );
+	ASSERT_THROW( v.insert(v.begin() + 1, 2), dstd::length_error );
+	ASSERT_THROW( v.emplace(v.begin(), 2), dstd::length_error );
+	ASSERT_THROW( v.resize(5), dstd::length_error );
+	ASSERT_THROW( static_ints(5, 0), dstd::length_error );
+
+	ASSERT_EQ( 4, v.size() );
+	ASSERT_EQ( 1, v[0] );
+	for(int i = 1; i != 4; ++i) ASSERT_EQ( 7, v[i] );
+}
+
+
+TEST(StaticVector, eraseMakesRoom)
+{
+	static_ints v;
+	for(int i = 0; i != 4; ++i) v.push_back(i);
+	v.erase(v.begin() + 1);
+	ASSERT_FALSE( v.full() );
+
+	v.insert(v.begin() + 1, 5);
+	ASSERT_EQ( 0, v[0] );
+	ASSERT_EQ( 5, v[1] );
+	ASSERT_EQ( 2, v[2] );
+	ASSERT_EQ( 3, v[3] );
+}
+
+
+TEST(StaticVector, copyMoveAndSwap)
+{
+	static_strings v;
+	v.push_back("abcdefghijklmnopqrstuvwxyz");
+	v.push_back("b");
+
+	static_strings w(v);
+	ASSERT_TRUE( v == w );
+
+	static_strings x( dstd::move(w) );
+	ASSERT_TRUE( w.empty() );
+	ASSERT_TRUE( x == v );
+
+	w.push_back("c");
+	dstd::swap(w, x);
+	ASSERT_EQ( 2, w.size() );
+	ASSERT_EQ( dstd::string("abcdefghijklmnopqrstuvwxyz"), w[0] );
+	ASSERT_EQ( 1, x.size() );
+	ASSERT_EQ( dstd::string("c"), x[0] );
+
+	x = v;
+	ASSERT_TRUE( x == v );
+}
+
+
+TEST(StaticVector, constructsFromAnyIteratorRange)
+{
+	int a[] = { 3, 1, 4 };
+	static_ints v(a, a + 3);
+	ASSERT_EQ( 3, v.size() );
+	ASSERT_EQ( 4, v[2] );
+
+	dstd::list<int> l;
+	for(int i = 0; i != 4; ++i) l.push_back(i);
+	static_ints w( l.begin(), l.end() );
+	ASSERT_EQ( 4, w.size() );
+	ASSERT_EQ( 3, w[3] );
+
+	l.push_back(4);
+	ASSERT_THROW( static_ints(l.begin(), l.end()), dstd::length_error );
+
+	static_ints x( v.begin(), v.end() );
+	ASSERT_TRUE( x == v );
+}
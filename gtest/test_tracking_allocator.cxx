@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "../src/arena.hxx"
+#include "../src/list.hxx"
+#include "../src/map.hxx"
+#include "../src/string.hxx"
+#include "../src/tracking_allocator.hxx"
+#include "../src/unordered_map.hxx"
+#include "../src/vector.hxx"
+
+
+
+TEST(TrackingAllocator, recordsAllocationsAndLiveBytes)
+{
+	dstd::allocation_stats stats;
+	dstd::tracking_allocator<int> a(stats);
+
+	int* p = a.allocate(10);
+	int* q = a.allocate(100);
+	ASSERT_EQ( 2, stats.allocations() );
+	ASSERT_EQ( 110 * sizeof(int), stats.live_bytes() );
+
+	a.deallocate(q, 100);
+	ASSERT_EQ( 1, stats.deallocations() );
+	ASSERT_EQ( 10 * sizeof(int), stats.live_bytes() );
+	ASSERT_EQ( 110 * sizeof(int), stats.peak_bytes() );
+	ASSERT_EQ( 110 * sizeof(int), stats.total_bytes() );
+
+	a.deallocate(p, 10);
+	ASSERT_EQ( 0, stats.live_bytes() );
+}
+
+
+TEST(TrackingAllocator, histogramCountsPowersOfTwo)
+{
+	dstd::allocation_stats stats;
+	dstd::tracking_allocator<char> a(stats);
+
+	a.deallocate( a.allocate(1), 1 );
+	a.deallocate( a.allocate(5), 5 );
+	a.deallocate( a.allocate(7), 7 );
+	a.deallocate( a.allocate(4096), 4096 );
+
+	ASSERT_EQ( 1, stats.histogram(0) );
+	ASSERT_EQ( 2, stats.histogram(2) );
+	ASSERT_EQ( 1, stats.histogram(12) );
+	ASSERT_EQ( 0, stats.histogram(3) );
+
+	stats.reset();
+	ASSERT_EQ( 0, stats.allocations() );
+	ASSERT_EQ( 0, stats.histogram(2) );
+}
+
+
+TEST(TrackingAllocator, vectorReleasesEverythingItAllocates)
+{
+	dstd::allocation_stats stats;
+	{
+		dstd::vector< double, dstd::tracking_allocator<double> > v( (dstd::tracking_allocator<double>(stats)) );
+		for(int i = 0; i != 1000; ++i) v.push_back(i);
+		ASSERT_LE( 1000 * sizeof(double), stats.live_bytes() );
+		ASSERT_EQ( stats.allocations(), stats.deallocations() + 1 );
+		ASSERT_EQ( &stats, &v.get_allocator().get_stats() );
+	}
+	ASSERT_EQ( stats.allocations(), stats.deallocations() );
+	ASSERT_EQ( 0, stats.live_bytes() );
+	ASSERT_LE( 1000 * sizeof(double), stats.peak_bytes() );
+}
+
+
+TEST(TrackingAllocator, nodeContainersReportThroughRebind)
+{
+	typedef dstd::pair<const int, int> value_type;
+	dstd::allocation_stats map_stats;
+	dstd::allocation_stats list_stats;
+	{
+		dstd::map< int, int, dstd::less<int>, dstd::tracking_allocator<value_type> > m( (dstd::less<int>()), dstd::tracking_allocator<value_type>(map_stats) );
+		dstd::list< int, dstd::tracking_allocator<int> > l( (dstd::tracking_allocator<int>(list_stats)) );
+		for(int i = 0; i != 100; ++i)
+		{
+			m[i] = i;
+			l.push_back(i);
+		}
+		ASSERT_LE( 100, map_stats.allocations() );
+		ASSERT_LE( 100, list_stats.allocations() );
+		ASSERT_LT( 0, map_stats.live_bytes() );
+
+		m.erase(5);
+		ASSERT_LE( 1, map_stats.deallocations() );
+	}
+	ASSERT_EQ( 0, map_stats.live_bytes() );
+	ASSERT_EQ( 0, list_stats.live_bytes() );
+	ASSERT_EQ( map_stats.allocations(), map_stats.deallocations() );
+}
+
+
+TEST(TrackingAllocator, unorderedMapAndStringAreTracked)
+{
+	typedef dstd::pair<int, int> value_type;
+	dstd::allocation_stats stats;
+	{
+		dstd::unordered_map< int, int, dstd::hash<int>, dstd::equal_to<int>, dstd::tracking_allocator<value_type> > m( 0, dstd::hash<int>(), dstd::equal_to<int>(), dstd::tracking_allocator<value_type>(stats) );
+		for(int i = 0; i != 100; ++i) m[i] = i;
+
+		dstd::basic_string< char, dstd::char_traits<char>, dstd::tracking_allocator<char> > s( (dstd::tracking_allocator<char>(stats)) );
+		for(int i = 0; i != 100; ++i) s.push_back('x');
+
+		ASSERT_LT( 0, stats.live_bytes() );
+	}
+	ASSERT_EQ( 0, stats.live_bytes() );
+}
+
+
+TEST(TrackingAllocator, wrapsOtherAllocatorsAndRecordsGrowthInPlace)
+{
+	dstd::arena arena;
+	dstd::allocation_stats stats;
+	typedef dstd::tracking_allocator< int, dstd::arena_allocator<int> > tracked;
+
+	dstd::vector<int, tracked> v( tracked(stats, dstd::arena_allocator<int>(arena)) );
+	v.set_growth_policy(dstd::grow_exact);
+	for(int i = 0; i != 100; ++i) v.push_back(i);
+
+	ASSERT_EQ( 1, stats.allocations() );
+	ASSERT_EQ( 100 * sizeof(int), stats.live_bytes() );
+}
+
+
+TEST(TrackingAllocator, defaultStatsAreGlobal)
+{
+	dstd::allocation_stats::global().reset();
+	{
+		dstd::vector< int, dstd::tracking_allocator<int> > v;
+		v.push_back(1);
+	}
+	ASSERT_EQ( 1, dstd::allocation_stats::global().allocations() );
+	ASSERT_EQ( 1, dstd::allocation_stats::global().deallocations() );
+}
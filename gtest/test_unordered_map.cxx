@@ -0,0 +1,321 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <map>
+#include "../src/string.hxx"
+#include "../src/tracking_allocator.hxx"
+#include "../src/unordered_map.hxx"
+#include "../src/unordered_set.hxx"
+
+
+
+/// Checks an unordered_map against a std::map holding the same elements
+template <class Key, class T>
+::testing::AssertionResult same_contents(const dstd::unordered_map<Key,T>& test_map, const std::map<Key,T>& expected)
+{
+	if( test_map.size() != expected.size() ) return ::testing::AssertionFailure() << "size " << test_map.size() << " != " << expected.size();
+
+	size_t visited = 0;
+	for(typename dstd::unordered_map<Key,T>::const_iterator it = test_map.begin(); it != test_map.end(); ++it, ++visited)
+	{
+		typename std::map<Key,T>::const_iterator e = expected.find(it->first);
+		if( e == expected.end() || e->second != it->second ) return ::testing::AssertionFailure() << "unexpected key " << it->first;
+	}
+	if( visited != expected.size() ) return ::testing::AssertionFailure() << "iteration visited " << visited << " elements";
+
+	for(typename std::map<Key,T>::const_iterator e = expected.begin(); e != expected.end(); ++e)
+	{
+		if( test_map.count(e->first) != 1 ) return ::testing::AssertionFailure() << "missing key " << e->first;
+	}
+	return ::testing::AssertionSuccess();
+}
+
+
+
+/// Hashes every key to the same value, so that every key shares a probe sequence.
+class constant_hash
+{
+	public:
+
+		size_t operator() (int) const { return 42; }
+};
+
+
+
+class UnorderedMap : public ::testing::Test
+{
+	protected:
+
+		void SetUp()
+		{
+			for(int i = 0; i < 1000; ++i)
+			{
+				thousand_squares[i] = i*i;
+			}
+		}
+
+		dstd::unordered_map<int, int> empty;
+		dstd::unordered_map<int, int> thousand_squares;
+};
+
+
+
+TEST_F(UnorderedMap, constructorDefaultCreatesEmptyMap)
+{
+	ASSERT_TRUE( empty.empty() );
+	ASSERT_EQ( 0, empty.size() );
+	ASSERT_EQ( 0, empty.bucket_count() );
+	ASSERT_TRUE( empty.begin() == empty.end() );
+	ASSERT_TRUE( empty.find(1) == empty.end() );
+	ASSERT_EQ( 0, empty.erase(1) );
+}
+
+
+TEST_F(UnorderedMap, constructorCopyCreatesIdenticalMap)
+{
+	dstd::unordered_map<int, int> test_map(thousand_squares);
+	ASSERT_TRUE( test_map == thousand_squares );
+}
+
+
+TEST_F(UnorderedMap, assignmentOperatorCopiesValue)
+{
+	empty[-1] = 1;
+	empty = thousand_squares;
+	ASSERT_TRUE( empty == thousand_squares );
+}
+
+
+TEST_F(UnorderedMap, operatorSQBReturnsExistingValueForExistingKey)
+{
+	ASSERT_EQ( 49, thousand_squares[7] );
+	ASSERT_EQ( 1000, thousand_squares.size() );
+	ASSERT_EQ( 0, thousand_squares[1000] );
+	ASSERT_EQ( 1001, thousand_squares.size() );
+}
+
+
+TEST_F(UnorderedMap, atThrowsForNonExistantKey)
+{
+	ASSERT_EQ( 81, thousand_squares.at(9) );
+	ASSERT_THROW( thousand_squares.at(-9), dstd::out_of_range );
+}
+
+
+TEST_F(UnorderedMap, insertValueDoesNotInsertForExistingKey)
+{
+	dstd::pair<dstd::unordered_map<int,int>::iterator, bool> result = thousand_squares.insert( dstd::pair<int,int>(10, -1) );
+	ASSERT_FALSE( result.second );
+	ASSERT_EQ( 100, result.first->second );
+}
+
+
+TEST_F(UnorderedMap, tableStaysBelowMaximumLoadFactor)
+{
+	ASSERT_LE( thousand_squares.load_factor(), thousand_squares.max_load_factor() );
+	ASSERT_EQ( 0, thousand_squares.bucket_count() % 16 );
+}
+
+
+TEST_F(UnorderedMap, reserveDoesNotRehashOnInsert)
+{
+	empty.reserve(500);
+	const size_t buckets = empty.bucket_count();
+	for(int i = 0; i < 500; ++i)
+	{
+		empty[i] = i;
+	}
+	ASSERT_EQ( buckets, empty.bucket_count() );
+}
+
+
+TEST_F(UnorderedMap, eraseIteratorReturnsFollowingElement)
+{
+	size_t erased = 0;
+	for(dstd::unordered_map<int,int>::iterator it = thousand_squares.begin(); it != thousand_squares.end(); )
+	{
+		if( it->first % 2 == 0 )
+		{
+			it = thousand_squares.erase(it);
+			++erased;
+		}
+		else
+		{
+			++it;
+		}
+	}
+	ASSERT_EQ( 500, erased );
+	ASSERT_EQ( 500, thousand_squares.size() );
+	ASSERT_EQ( 0, thousand_squares.count(2) );
+	ASSERT_EQ( 9, thousand_squares.find(3)->second );
+}
+
+
+TEST_F(UnorderedMap, clearKeepsCapacity)
+{
+	const size_t buckets = thousand_squares.bucket_count();
+	thousand_squares.clear();
+	ASSERT_TRUE( thousand_squares.empty() );
+	ASSERT_TRUE( thousand_squares.begin() == thousand_squares.end() );
+	ASSERT_EQ( buckets, thousand_squares.bucket_count() );
+}
+
+
+TEST_F(UnorderedMap, swapExchangesMapContents)
+{
+	dstd::unordered_map<int,int> copy(thousand_squares);
+	empty[1] = 2;
+	dstd::swap(empty, thousand_squares);
+	ASSERT_TRUE( empty == copy );
+	ASSERT_EQ( 1, thousand_squares.size() );
+	ASSERT_EQ( 2, thousand_squares.begin()->second );
+}
+
+
+TEST_F(UnorderedMap, randomInsertAndEraseMatchesStdMap)
+{
+	dstd::unordered_map<int, int> test_map;
+	std::map<int, int> expected;
+
+	std::srand(5);
+	for(int i = 0; i < 50000; ++i)
+	{
+		const int k = std::rand() % 4000;
+		if( std::rand() % 2 == 0 )
+		{
+			ASSERT_EQ( expected.erase(k), test_map.erase(k) );
+		}
+		else
+		{
+			expected[k] = i;
+			test_map[k] = i;
+		}
+	}
+	ASSERT_TRUE( same_contents(test_map, expected) );
+}
+
+
+TEST_F(UnorderedMap, collidingHashesAreStillFound)
+{
+	dstd::unordered_map<int, int, constant_hash> test_map;
+	for(int i = 0; i < 100; ++i)
+	{
+		test_map[i] = -i;
+	}
+	for(int i = 0; i < 100; i += 3)
+	{
+		ASSERT_EQ( 1, test_map.erase(i) );
+	}
+	for(int i = 0; i < 100; ++i)
+	{
+		ASSERT_EQ( (i % 3 == 0) ? 0 : 1, test_map.count(i) );
+	}
+}
+
+
+TEST_F(UnorderedMap, churnAtFixedSizeDoesNotKeepGrowingTable)
+{
+	for(int i = 0; i < 100; ++i)
+	{
+		empty[i] = i;
+	}
+	const size_t buckets = empty.bucket_count();
+	for(int i = 100; i < 100000; ++i)
+	{
+		empty.erase(i - 100);
+		empty[i] = i;
+	}
+	ASSERT_EQ( 100, empty.size() );
+	ASSERT_LE( empty.bucket_count(), 2 * buckets );
+}
+
+
+
+TEST(UnorderedSet, insertAndEraseStrings)
+{
+	dstd::unordered_set<dstd::string> s;
+	ASSERT_TRUE( s.insert("apple").second );
+	ASSERT_TRUE( s.insert("banana").second );
+	ASSERT_FALSE( s.insert("apple").second );
+	ASSERT_EQ( 2, s.size() );
+	ASSERT_EQ( 1, s.count("banana") );
+	ASSERT_EQ( 0, s.count("cherry") );
+	ASSERT_EQ( 1, s.erase("apple") );
+	ASSERT_EQ( 0, s.count("apple") );
+}
+
+
+TEST(UnorderedSet, growingMovesTheElements)
+{
+	dstd::unordered_set<dstd::string> test_set;
+	test_set.insert( dstd::string("first") );
+	const char* first = test_set.find( dstd::string("first") )->c_str();
+
+	for(int i = 0; i < 1000; ++i) test_set.insert( dstd::string(1 + i % 50, static_cast<char>('a' + i / 50)) );
+
+	ASSERT_EQ( 1001, test_set.size() );
+	ASSERT_EQ( first, test_set.find( dstd::string("first") )->c_str() );
+}
+
+
+TEST(UnorderedSet, swapExchangesTheAllocators)
+{
+	typedef dstd::unordered_set< int, dstd::hash<int>, dstd::equal_to<int>, dstd::tracking_allocator<int> > tracked_set;
+	dstd::allocation_stats stats_a;
+	dstd::allocation_stats stats_b;
+	{
+		tracked_set a( 0, dstd::hash<int>(), dstd::equal_to<int>(), dstd::tracking_allocator<int>(stats_a) );
+		tracked_set b( 0, dstd::hash<int>(), dstd::equal_to<int>(), dstd::tracking_allocator<int>(stats_b) );
+		for(int i = 0; i < 100; ++i) a.insert(i);
+		b.insert(-1);
+
+		a.swap(b);
+		for(int i = 0; i < 100; ++i) a.insert(-2 - i);
+		b.clear();
+	}
+	ASSERT_EQ( stats_a.allocations(), stats_a.deallocations() );
+	ASSERT_EQ( 0, stats_a.live_bytes() );
+	ASSERT_EQ( stats_b.allocations(), stats_b.deallocations() );
+	ASSERT_EQ( 0, stats_b.live_bytes() );
+}
+
+
+TEST(UnorderedSet, rangeConstructorDropsDuplicates)
+{
+	const int values[] = { 3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5 };
+	dstd::unordered_set<int> s(values, values + 11);
+	ASSERT_EQ( 7, s.size() );
+
+	dstd::unordered_set<int> copy(s);
+	ASSERT_TRUE( copy == s );
+	copy.erase(9);
+	ASSERT_TRUE( copy != s );
+}
+
+
+TEST(Hash, floatingPointHashesItsBitsNotItsTruncatedValue)
+{
+	dstd::hash<double> h;
+	ASSERT_NE( h(0.1), h(0.2) );
+	ASSERT_NE( h(0.2), h(0.7) );
+	ASSERT_EQ( h(0.0), h(-0.0) );
+	ASSERT_NE( dstd::hash<float>()(0.5f), dstd::hash<float>()(0.25f) );
+
+	dstd::unordered_map<double, int> m;
+	for(int i = 0; i != 1000; ++i) m[i / 1000.0] = i;
+	ASSERT_EQ( 1000, m.size() );
+	ASSERT_EQ( 700, m[0.7] );
+	m[-0.0] = -1;
+	ASSERT_EQ( -1, m[0.0] );
+	ASSERT_EQ( 1000, m.size() );
+}
+
+
+TEST_F(UnorderedMap, tryEmplaceConstructsOnlyOnAMiss)
+{
+	dstd::unordered_map<int, dstd::string> m;
+	ASSERT_TRUE( m.try_emplace(1, "one").second );
+	ASSERT_FALSE( m.try_emplace(1, "uno").second );
+	ASSERT_EQ( dstd::string("one"), m[1] );
+	ASSERT_TRUE( m[2].empty() );
+	ASSERT_EQ( 2, m.size() );
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "../src/vector.hxx"
+#include "../src/string.hxx"
+#include "../src/tracking_allocator.hxx"
 
 
 // Google test cannot deal with class and operators being in different namespaces
@@ -265,6 +267,63 @@ TEST_F(Vector, reserveDoesNothingIfLessThanCapacity)
 }
 
 
+TEST_F(Vector, reserveGrowsAccordingToGrowthPolicy)
+{
+	dstd::vector<int> doubling;
+	dstd::vector<int> half;
+	dstd::vector<int> exact;
+	dstd::vector<char> page;
+	half.set_growth_policy(dstd::grow_half);
+	exact.set_growth_policy(dstd::grow_exact);
+	page.set_growth_policy(dstd::grow_page);
+	
+	doubling.reserve(10);
+	half.reserve(10);
+	exact.reserve(10);
+	page.reserve(5000);
+	
+	ASSERT_EQ( dstd::grow_double, doubling.get_growth_policy() );
+	ASSERT_EQ( 16, doubling.capacity() );
+	ASSERT_EQ( 13, half.capacity() );
+	ASSERT_EQ( 10, exact.capacity() );
+	ASSERT_EQ( 8192, page.capacity() );
+	
+	for(int i = 0; i < 11; ++i) exact.push_back(i);
+	ASSERT_EQ( 11, exact.capacity() );
+}
+
+
+TEST_F(Vector, reserveBeyondMaxSizeThrowsInsteadOfWrapping)
+{
+	dstd::vector<double> v;
+	ASSERT_EQ( static_cast<size_t>(-1) / sizeof(double), v.max_size() );
+	ASSERT_THROW( v.reserve( v.max_size() + 1 ), dstd::length_error );
+	ASSERT_THROW( dstd::allocator<double>().allocate( static_cast<size_t>(1) << 62 ), dstd::bad_alloc );
+	ASSERT_TRUE( v.empty() );
+}
+
+
+// void shrink_to_fit()
+
+
+TEST_F(Vector, shrinkToFitReleasesUnusedCapacity)
+{
+	fifty_times_pi.reserve(1000);
+	fifty_times_pi.shrink_to_fit();
+	
+	ASSERT_EQ( 50, fifty_times_pi.capacity() );
+	ASSERT_EQ( 50, fifty_times_pi.size() );
+	ASSERT_EQ( 49 * pi, fifty_times_pi.back() );
+	
+	fifty_times_pi.clear();
+	fifty_times_pi.shrink_to_fit();
+	ASSERT_EQ( 0, fifty_times_pi.capacity() );
+	
+	fifty_times_pi.push_back(pi);
+	ASSERT_EQ( pi, fifty_times_pi[0] );
+}
+
+
 //
 // Modifiers
 //
@@ -824,6 +883,13 @@ TEST_F(VectorOperators, lessthanReturnsFalseForABCDEandEmpty)
 }
 
 
+TEST_F(VectorOperators, lessthanReturnsFalseForABDDDandABCDE)
+{
+	ASSERT_FALSE( abddd < abcde );
+	ASSERT_FALSE( abddd <= abcde );
+}
+
+
 // operator<=
 
 
@@ -929,3 +995,466 @@ TEST(VectorSwap, swapExchangesContents)
 	ASSERT_EQ(ref_one_to_ten, thirty_to_forty);
 	ASSERT_EQ(ref_thirty_to_forty, one_to_ten);
 }
+
+
+//
+// Relocation
+//
+
+
+/// Counts its live instances, to check that relocating elements neither leaks nor double-destroys them
+class counted
+{
+	public:
+		
+		counted(int v = 0) : value(v) { ++live; }
+		counted(const counted& x) : value(x.value) { ++live; }
+		~counted() { --live; }
+		counted& operator= (const counted& x) { value = x.value; return *this; }
+		
+		int value;
+		static int live;
+};
+int counted::live = 0;
+
+
+/// Owns heap memory, but holds no pointers into itself, so it can be relocated by copying its bytes
+class owning
+{
+	public:
+		
+		owning(int v = 0) : p(new int(v)) {}
+		owning(const owning& x) : p(new int(*x.p)) {}
+		~owning() { delete p; }
+		owning& operator= (const owning& x) { *p = *x.p; return *this; }
+		
+		int* p;
+};
+
+
+namespace dstd
+{
+	template <> class is_trivially_relocatable<owning> { public: static const bool value = true; };
+}
+
+
+TEST(VectorRelocation, trivialElementsKeepTheirValuesThroughGrowthInsertAndErase)
+{
+	dstd::vector<double> v;
+	for(int i = 0; i < 1000; ++i)
+	{
+		v.push_back(i * 0.5);
+	}
+	v.insert(v.begin() + 10, 3, -1.0);
+	v.erase(v.begin(), v.begin() + 5);
+	
+	ASSERT_EQ( 998, v.size() );
+	ASSERT_EQ( 2.5, v[0] );
+	ASSERT_EQ( -1.0, v[5] );
+	ASSERT_EQ( -1.0, v[7] );
+	ASSERT_EQ( 5.0, v[8] );
+	ASSERT_EQ( 499.5, v.back() );
+}
+
+
+TEST(VectorRelocation, nonTrivialElementsAreCopiedAndDestroyedOnce)
+{
+	{
+		dstd::vector<counted> v;
+		for(int i = 0; i < 100; ++i)
+		{
+			v.push_back( counted(i) );
+		}
+		v.insert(v.begin() + 1, 2, counted(-1));
+		v.erase(v.begin() + 50, v.begin() + 60);
+		
+		ASSERT_EQ( 92, counted::live );
+		ASSERT_EQ( 0, v[0].value );
+		ASSERT_EQ( -1, v[2].value );
+		ASSERT_EQ( 1, v[3].value );
+		ASSERT_EQ( 58, v[50].value );
+		ASSERT_EQ( 99, v.back().value );
+	}
+	ASSERT_EQ( 0, counted::live );
+}
+
+
+TEST(VectorRelocation, specialisedRelocatableElementsAreMovedByTheirBytes)
+{
+	dstd::vector<owning> v;
+	for(int i = 0; i < 100; ++i)
+	{
+		v.push_back( owning(i) );
+	}
+	const int* first = v[0].p;
+	v.reserve(1000);
+	v.insert(v.begin(), owning(-1));
+	v.erase(v.begin() + 10);
+	
+	ASSERT_EQ( 100, v.size() );
+	ASSERT_EQ( first, v[1].p );
+	ASSERT_EQ( -1, *v[0].p );
+	ASSERT_EQ( 10, *v[10].p );
+	ASSERT_EQ( 99, *v.back().p );
+}
+
+
+
+//
+// Move semantics and emplace
+
+
+/// Counts how often it is copied and moved, to check that elements are moved rather than copied
+class movable
+{
+	public:
+		
+		movable(int v = 0) : value(v) {}
+		movable(const movable& x) : value(x.value) { ++copies; }
+		movable(movable&& x) noexcept : value(x.value) { x.value = -1; ++moves; }
+		movable& operator= (const movable& x) { value = x.value; ++copies; return *this; }
+		movable& operator= (movable&& x) noexcept { value = x.value; x.value = -1; ++moves; return *this; }
+		
+		int value;
+		static int copies;
+		static int moves;
+};
+int movable::copies = 0;
+int movable::moves = 0;
+
+
+/// Can be constructed from two values and moved, but not copied
+class move_only
+{
+	public:
+		
+		move_only(int a, int b) : value(a + b) {}
+		move_only(move_only&& x) noexcept : value(x.value) { x.value = -1; }
+		move_only& operator= (move_only&& x) noexcept { value = x.value; x.value = -1; return *this; }
+		
+		move_only(const move_only&) = delete;
+		move_only& operator= (const move_only&) = delete;
+		
+		int value;
+};
+
+
+TEST(VectorMove, moveConstructorTakesElementsWithoutCopying)
+{
+	dstd::vector<int> v;
+	for(int i = 0; i < 10; ++i) v.push_back(i);
+	const int* data = &v[0];
+	
+	dstd::vector<int> moved( dstd::move(v) );
+	
+	ASSERT_TRUE( v.empty() );
+	ASSERT_EQ( 10, moved.size() );
+	ASSERT_EQ( data, &moved[0] );
+	
+	v.push_back(1);
+	ASSERT_EQ( 1, v.size() );
+}
+
+
+TEST(VectorMove, moveAssignmentReplacesElements)
+{
+	dstd::vector<int> v(5, 1);
+	dstd::vector<int> w(3, 2);
+	const int* data = &v[0];
+	
+	w = dstd::move(v);
+	
+	ASSERT_TRUE( v.empty() );
+	ASSERT_EQ( 5, w.size() );
+	ASSERT_EQ( data, &w[0] );
+}
+
+
+TEST(VectorMove, pushBackRvalueAndGrowthDoNotCopyElements)
+{
+	movable::copies = 0;
+	dstd::vector<movable> v;
+	for(int i = 0; i < 100; ++i)
+	{
+		v.push_back( movable(i) );
+	}
+	v.insert( v.begin() + 50, movable(-1) );
+	
+	ASSERT_EQ( 0, movable::copies );
+	ASSERT_EQ( 101, v.size() );
+	ASSERT_EQ( 49, v[49].value );
+	ASSERT_EQ( -1, v[50].value );
+	ASSERT_EQ( 50, v[51].value );
+	ASSERT_EQ( 99, v.back().value );
+}
+
+
+TEST(VectorMove, emplaceConstructsElementsInPlace)
+{
+	dstd::vector<move_only> v;
+	for(int i = 0; i < 10; ++i)
+	{
+		v.emplace_back(i, 0);
+	}
+	dstd::vector<move_only>::iterator it = v.emplace(v.begin() + 3, 100, 1);
+	
+	ASSERT_EQ( 11, v.size() );
+	ASSERT_EQ( v.begin() + 3, it );
+	ASSERT_EQ( 2, v[2].value );
+	ASSERT_EQ( 101, v[3].value );
+	ASSERT_EQ( 3, v[4].value );
+	ASSERT_EQ( 9, v.back().value );
+}
+
+
+TEST(VectorMove, emplaceFromOwnElementWhileGrowing)
+{
+	dstd::vector<movable> v;
+	v.push_back( movable(0) );
+	v.push_back( movable(1) );
+	while( v.size() < v.capacity() ) v.push_back( movable(v.size()) );
+	const int n = v.size();
+	
+	v.emplace( v.begin(), v.back() );
+	v.emplace( v.begin(), v[2] );
+	
+	ASSERT_EQ( n + 2, v.size() );
+	ASSERT_EQ( 1, v[0].value );
+	ASSERT_EQ( n - 1, v[1].value );
+	ASSERT_EQ( 0, v[2].value );
+	ASSERT_EQ( 1, v[3].value );
+	ASSERT_EQ( n - 1, v.back().value );
+}
+
+
+TEST(VectorMove, insertingAnElementOfTheVectorCopiesItFirst)
+{
+	dstd::vector<dstd::string> v;
+	v.push_back( dstd::string("first") );
+	v.push_back( dstd::string("second") );
+	while( v.size() < v.capacity() ) v.push_back( dstd::string("more") );
+	const size_t n = v.size();
+	
+	v.push_back( v[0] );
+	v.insert( v.begin(), v[1] );
+	while( v.size() < v.capacity() ) v.push_back( dstd::string("more") );
+	v.insert( v.begin(), 3, v[2] );
+	
+	ASSERT_EQ( dstd::string("second"), v[0] );
+	ASSERT_EQ( dstd::string("second"), v[2] );
+	ASSERT_EQ( dstd::string("second"), v[3] );
+	ASSERT_EQ( dstd::string("first"), v[4] );
+	ASSERT_EQ( dstd::string("second"), v[5] );
+	ASSERT_EQ( dstd::string("first"), v[n + 4] );
+}
+
+
+TEST(VectorMove, insertingNoElementsLeavesTheOthersIntact)
+{
+	dstd::vector<dstd::string> v;
+	v.push_back( dstd::string("first") );
+	v.push_back( dstd::string("second") );
+	
+	v.insert( v.begin(), 0, dstd::string("x") );
+	v.insert( v.begin() + 1, v.begin(), v.begin() );
+	
+	ASSERT_EQ( 2, v.size() );
+	ASSERT_EQ( dstd::string("first"), v[0] );
+	ASSERT_EQ( dstd::string("second"), v[1] );
+}
+
+
+TEST(VectorMove, growingAVectorOfStringsMovesTheirCharacters)
+{
+	typedef dstd::basic_string< char, dstd::char_traits<char>, dstd::tracking_allocator<char> > tracked_string;
+	dstd::allocation_stats stats;
+	const dstd::tracking_allocator<char> a(stats);
+	
+	ASSERT_TRUE( dstd::is_nothrow_move_constructible<tracked_string>::value );
+	
+	dstd::vector<tracked_string> v;
+	for(int i = 0; i < 16; ++i) v.push_back( tracked_string(16, static_cast<char>('a' + i), a) );
+	const char* first = v[0].c_str();
+	stats.reset();
+	
+	v.reserve( v.capacity() + 1 );
+	
+	ASSERT_EQ( 0, stats.allocations() );
+	ASSERT_EQ( first, v[0].c_str() );
+	for(int i = 0; i < 16; ++i) ASSERT_EQ( tracked_string(16, static_cast<char>('a' + i), a), v[i] );
+}
+
+
+TEST(VectorMove, movedFromStringIsEmptyAndUsable)
+{
+	typedef dstd::basic_string< char, dstd::char_traits<char>, dstd::tracking_allocator<char> > tracked_string;
+	dstd::allocation_stats stats;
+	tracked_string s( "characters", dstd::tracking_allocator<char>(stats) );
+	stats.reset();
+	
+	tracked_string t( dstd::move(s) );
+	s = dstd::move(t);
+	t = dstd::move(s);
+	
+	ASSERT_EQ( 0, stats.allocations() );
+	ASSERT_EQ( tracked_string("characters"), t );
+	ASSERT_TRUE( s.empty() );
+	ASSERT_STREQ( "", s.c_str() );
+	
+	s.clear();
+	s.shrink_to_fit();
+	s += "again";
+	ASSERT_EQ( tracked_string("again"), s );
+}
+
+
+
+//
+// Vector of bool
+//
+
+
+TEST(VectorBool, elementsArePackedIntoBits)
+{
+	dstd::vector<bool> v;
+	for(int i = 0; i != 200; ++i) v.push_back( i % 3 == 0 );
+
+	ASSERT_EQ( 200, v.size() );
+	ASSERT_EQ( 0, v.capacity() % (CHAR_BIT * sizeof(unsigned long)) );
+	for(int i = 0; i != 200; ++i) ASSERT_EQ( i % 3 == 0, v[i] );
+
+	v[1] = true;
+	v[0].flip();
+	ASSERT_TRUE( v.at(1) );
+	ASSERT_FALSE( v.front() );
+	ASSERT_THROW( v.at(200), dstd::out_of_range );
+}
+
+
+TEST(VectorBool, countAndFindSkipWholeWords)
+{
+	dstd::vector<bool> v(300, false);
+	ASSERT_EQ( 0, v.count(true) );
+	ASSERT_EQ( 300, v.count(false) );
+	ASSERT_TRUE( v.find(true) == v.end() );
+
+	v[130] = true;
+	v[299] = true;
+	ASSERT_EQ( 2, v.count() );
+	ASSERT_EQ( 130, v.find(true) - v.begin() );
+	ASSERT_EQ( 299, v.find(true, v.begin() + 131) - v.begin() );
+
+	v.flip();
+	ASSERT_EQ( 298, v.count() );
+	ASSERT_EQ( 130, v.find(false) - v.begin() );
+
+	// bits beyond the size are not counted
+	v.pop_back();
+	v.flip();
+	ASSERT_EQ( 1, v.count() );
+}
+
+
+TEST(VectorBool, assignAndResizeFillRanges)
+{
+	dstd::vector<bool> v;
+	v.assign(70, true);
+	ASSERT_EQ( 70, v.count() );
+
+	v.resize(200, false);
+	ASSERT_EQ( 70, v.count() );
+	ASSERT_EQ( 130, v.count(false) );
+	ASSERT_TRUE( v[69] );
+	ASSERT_FALSE( v[70] );
+
+	v.insert(v.begin() + 10, 100, false);
+	ASSERT_EQ( 300, v.size() );
+	ASSERT_EQ( 70, v.count() );
+	ASSERT_TRUE( v[9] );
+	ASSERT_FALSE( v[10] );
+	ASSERT_FALSE( v[109] );
+	ASSERT_TRUE( v[110] );
+}
+
+
+TEST(VectorBool, insertAndEraseShiftTheFollowingElements)
+{
+	dstd::vector<bool> v;
+	for(int i = 0; i != 100; ++i) v.push_back( i % 2 == 0 );
+
+	v.insert(v.begin() + 1, true);
+	ASSERT_EQ( 101, v.size() );
+	ASSERT_TRUE( v[0] );
+	ASSERT_TRUE( v[1] );
+	ASSERT_FALSE( v[2] );
+	ASSERT_TRUE( v[100] == false );
+
+	v.erase(v.begin(), v.begin() + 2);
+	ASSERT_EQ( 99, v.size() );
+	for(int i = 0; i != 99; ++i) ASSERT_EQ( i % 2 == 1, v[i] );
+}
+
+
+TEST(VectorBool, shiftsAcrossWordBoundariesAtAnyOffset)
+{
+	const int size = 300;
+	bool expected[size + 200];
+
+	for(int at = 0; at <= size; at += 13)
+	{
+		for(int count = 1; count <= 150; count += 37)
+		{
+			dstd::vector<bool> v;
+			for(int i = 0; i != size; ++i)
+			{
+				expected[i] = (i * 7) % 5 < 2;
+				v.push_back( expected[i] );
+			}
+
+			v.insert(v.begin() + at, count, true);
+			ASSERT_EQ( size + count, v.size() );
+			for(int i = 0; i != at; ++i) ASSERT_EQ( expected[i], v[i] );
+			for(int i = at; i != at + count; ++i) ASSERT_TRUE( v[i] );
+			for(int i = at; i != size; ++i) ASSERT_EQ( expected[i], v[i + count] );
+
+			v.erase(v.begin() + at, v.begin() + at + count);
+			ASSERT_EQ( size, v.size() );
+			for(int i = 0; i != size; ++i) ASSERT_EQ( expected[i], v[i] );
+		}
+	}
+}
+
+
+TEST(VectorBool, copyMoveAndCompare)
+{
+	dstd::vector<bool> v;
+	for(int i = 0; i != 130; ++i) v.push_back( i % 5 == 0 );
+
+	dstd::vector<bool> w(v);
+	ASSERT_TRUE( v == w );
+	w[129] = ! w[129];
+	ASSERT_TRUE( v != w );
+
+	dstd::vector<bool> x( dstd::move(w) );
+	ASSERT_TRUE( w.empty() );
+	ASSERT_EQ( 130, x.size() );
+
+	w = v;
+	ASSERT_TRUE( w == v );
+
+	dstd::vector<bool> from_iterators(v.begin(), v.end());
+	ASSERT_TRUE( from_iterators == v );
+
+	bool reversed_first = *(v.rbegin());
+	ASSERT_EQ( v.back(), reversed_first );
+}
+
+
+TEST(VectorBool, shrinkToFitKeepsWholeWords)
+{
+	dstd::vector<bool> v(1000, true);
+	v.resize(10);
+	v.shrink_to_fit();
+	ASSERT_EQ( CHAR_BIT * sizeof(unsigned long), v.capacity() );
+	ASSERT_EQ( 10, v.count() );
+}
@@ -3,6 +3,8 @@
 
 
 
+#include "impl/bool_type.hxx"
+#include "impl/segmented_iterator.hxx"
 #include "iterator.hxx"
 #include "utility.hxx"
 
@@ -21,15 +23,60 @@ namespace dstd
 		
 		template <class RandomIterator> void make_heap(RandomIterator first, RandomIterator last, RandomIterator parent);
 		template <class RandomIterator, class Compare> void make_heap(RandomIterator first, RandomIterator last, RandomIterator parent, Compare comp);
+		
+		template <class RandomIterator, class Compare> void insertion_sort(RandomIterator first, RandomIterator last, Compare comp);
+		
+		// Each of these algorithms has a version for plain iterators (FalseType), and one for segmented iterators (TrueType),
+		// which runs the plain version on the contiguous range in each segment.
+		template <class ForwardIterator, class UnaryFunction> UnaryFunction for_each(ForwardIterator first, ForwardIterator last, UnaryFunction f, dstd::impl::FalseType);
+		template <class ForwardIterator, class UnaryFunction> UnaryFunction for_each(ForwardIterator first, ForwardIterator last, UnaryFunction f, dstd::impl::TrueType);
+		template <class InputIterator, class T> typename iterator_traits<InputIterator>::difference_type count(InputIterator first, InputIterator last, const T& value, dstd::impl::FalseType);
+		template <class InputIterator, class T> typename iterator_traits<InputIterator>::difference_type count(InputIterator first, InputIterator last, const T& value, dstd::impl::TrueType);
+		template <class InputIterator, class UnaryPredicate> typename iterator_traits<InputIterator>::difference_type count_if(InputIterator first, InputIterator last, UnaryPredicate p, dstd::impl::FalseType);
+		template <class InputIterator, class UnaryPredicate> typename iterator_traits<InputIterator>::difference_type count_if(InputIterator first, InputIterator last, UnaryPredicate p, dstd::impl::TrueType);
+		template <class InputIterator, class T> InputIterator find(InputIterator first, InputIterator last, const T& value, dstd::impl::FalseType);
+		template <class InputIterator, class T> InputIterator find(InputIterator first, InputIterator last, const T& value, dstd::impl::TrueType);
+		template <class InputIterator, class UnaryPredicate> InputIterator find_if(InputIterator first, InputIterator last, UnaryPredicate p, dstd::impl::FalseType);
+		template <class InputIterator, class UnaryPredicate> InputIterator find_if(InputIterator first, InputIterator last, UnaryPredicate p, dstd::impl::TrueType);
+		template <class InputIterator, class OutputIterator> OutputIterator copy(InputIterator first, InputIterator last, OutputIterator out, dstd::impl::FalseType);
+		template <class InputIterator, class OutputIterator> OutputIterator copy(InputIterator first, InputIterator last, OutputIterator out, dstd::impl::TrueType);
+		// Once the input is plain, copy_into picks a version in the same way for the output iterator.
+		template <class InputIterator, class OutputIterator> OutputIterator copy_into(InputIterator first, InputIterator last, OutputIterator out, dstd::impl::FalseType);
+		template <class InputIterator, class OutputIterator> OutputIterator copy_into(InputIterator first, InputIterator last, OutputIterator out, dstd::impl::TrueType);
+		template <class ForwardIterator, class T> void fill(ForwardIterator first, ForwardIterator last, const T& value, dstd::impl::FalseType);
+		template <class ForwardIterator, class T> void fill(ForwardIterator first, ForwardIterator last, const T& value, dstd::impl::TrueType);
+		
+		
+		/// Compares any two values with operator<, for the algorithms which take an optional comparison.
+		class less_than
+		{
+			public:
+			
+				template <class T1, class T2>
+				bool operator() (const T1& a, const T2& b) const
+				{
+					return (a < b);
+				}
+		};
 	}
 	
+	template <class RandomIterator, class Compare> void inplace_merge(RandomIterator first, RandomIterator middle, RandomIterator last, Compare comp);
+	
+	template <class ForwardIterator, class UnaryFunction> UnaryFunction for_each(ForwardIterator first, ForwardIterator last, UnaryFunction f);
+	template <class InputIterator, class T> typename iterator_traits<InputIterator>::difference_type count(InputIterator first, InputIterator last, const T& value);
+	template <class InputIterator, class UnaryPredicate> typename iterator_traits<InputIterator>::difference_type count_if(InputIterator first, InputIterator last, const UnaryPredicate p);
+	template <class InputIterator, class T> InputIterator find(InputIterator first, InputIterator last, const T& value);
+	template <class InputIterator, class UnaryPredicate> InputIterator find_if(InputIterator first, InputIterator last, UnaryPredicate p);
+	template <class InputIterator, class OutputIterator> OutputIterator copy(InputIterator first, InputIterator last, OutputIterator out);
+	template <class ForwardIterator, class T> void fill(ForwardIterator first, ForwardIterator last, const T& value);
+	
 	
 	//
 	// Non-modifying sequence operations
 	
 	
 	template <class ForwardIterator, class UnaryFunction>
-	UnaryFunction for_each(ForwardIterator first, ForwardIterator last, UnaryFunction f)
+	UnaryFunction impl::for_each(ForwardIterator first, ForwardIterator last, UnaryFunction f, dstd::impl::FalseType)
 	{
 		for( ; first != last; ++first)
 		{
@@ -39,8 +86,27 @@ namespace dstd
 	}
 	
 	
+	template <class ForwardIterator, class UnaryFunction>
+	UnaryFunction impl::for_each(ForwardIterator first, ForwardIterator last, UnaryFunction f, dstd::impl::TrueType)
+	{
+		for(dstd::impl::segment_walker<ForwardIterator> w(first, last); ! w.done(); w.next())
+		{
+			f = dstd::for_each(w.begin(), w.end(), f);
+		}
+		return f;
+	}
+	
+	
+	template <class ForwardIterator, class UnaryFunction>
+	UnaryFunction for_each(ForwardIterator first, ForwardIterator last, UnaryFunction f)
+	{
+		typedef typename dstd::impl::segmented_iterator_traits<ForwardIterator>::is_segmented is_segmented;
+		return dstd::impl::for_each(first, last, f, is_segmented());
+	}
+	
+	
 	template <class InputIterator, class T>
-	typename iterator_traits<InputIterator>::difference_type count(InputIterator first, InputIterator last, const T& value)
+	typename iterator_traits<InputIterator>::difference_type impl::count(InputIterator first, InputIterator last, const T& value, dstd::impl::FalseType)
 	{
 		typename iterator_traits<InputIterator>::difference_type n = 0;
 		for( ; first != last; ++first )
@@ -51,8 +117,28 @@ namespace dstd
 	}
 	
 	
+	template <class InputIterator, class T>
+	typename iterator_traits<InputIterator>::difference_type impl::count(InputIterator first, InputIterator last, const T& value, dstd::impl::TrueType)
+	{
+		typename iterator_traits<InputIterator>::difference_type n = 0;
+		for(dstd::impl::segment_walker<InputIterator> w(first, last); ! w.done(); w.next())
+		{
+			n += dstd::count(w.begin(), w.end(), value);
+		}
+		return n;
+	}
+	
+	
+	template <class InputIterator, class T>
+	typename iterator_traits<InputIterator>::difference_type count(InputIterator first, InputIterator last, const T& value)
+	{
+		typedef typename dstd::impl::segmented_iterator_traits<InputIterator>::is_segmented is_segmented;
+		return dstd::impl::count(first, last, value, is_segmented());
+	}
+	
+	
 	template <class InputIterator, class UnaryPredicate>
-	typename iterator_traits<InputIterator>::difference_type count_if(InputIterator first, InputIterator last, const UnaryPredicate p)
+	typename iterator_traits<InputIterator>::difference_type impl::count_if(InputIterator first, InputIterator last, UnaryPredicate p, dstd::impl::FalseType)
 	{
 		typename iterator_traits<InputIterator>::difference_type n = 0;
 		for( ; first != last; ++first )
@@ -63,6 +149,26 @@ namespace dstd
 	}
 	
 	
+	template <class InputIterator, class UnaryPredicate>
+	typename iterator_traits<InputIterator>::difference_type impl::count_if(InputIterator first, InputIterator last, UnaryPredicate p, dstd::impl::TrueType)
+	{
+		typename iterator_traits<InputIterator>::difference_type n = 0;
+		for(dstd::impl::segment_walker<InputIterator> w(first, last); ! w.done(); w.next())
+		{
+			n += dstd::count_if(w.begin(), w.end(), p);
+		}
+		return n;
+	}
+	
+	
+	template <class InputIterator, class UnaryPredicate>
+	typename iterator_traits<InputIterator>::difference_type count_if(InputIterator first, InputIterator last, const UnaryPredicate p)
+	{
+		typedef typename dstd::impl::segmented_iterator_traits<InputIterator>::is_segmented is_segmented;
+		return dstd::impl::count_if(first, last, p, is_segmented());
+	}
+	
+	
 	template <class InputIterator1, class InputIterator2>
 	dstd::pair<InputIterator1, InputIterator2> mismatch(InputIterator1 first_1, InputIterator1 last_1, InputIterator2 first_2)
 	{
@@ -108,7 +214,7 @@ namespace dstd
 	
 	
 	template <class InputIterator, class T>
-	InputIterator find(InputIterator first, InputIterator last, const T& value)
+	InputIterator impl::find(InputIterator first, InputIterator last, const T& value, dstd::impl::FalseType)
 	{
 		for( ; first != last; ++first)
 		{
@@ -118,8 +224,28 @@ namespace dstd
 	}
 	
 	
+	template <class InputIterator, class T>
+	InputIterator impl::find(InputIterator first, InputIterator last, const T& value, dstd::impl::TrueType)
+	{
+		for(dstd::impl::segment_walker<InputIterator> w(first, last); ! w.done(); w.next())
+		{
+			typename dstd::impl::segment_walker<InputIterator>::local_iterator it = dstd::find(w.begin(), w.end(), value);
+			if( it != w.end() ) return w.at(it);
+		}
+		return last;
+	}
+	
+	
+	template <class InputIterator, class T>
+	InputIterator find(InputIterator first, InputIterator last, const T& value)
+	{
+		typedef typename dstd::impl::segmented_iterator_traits<InputIterator>::is_segmented is_segmented;
+		return dstd::impl::find(first, last, value, is_segmented());
+	}
+	
+	
 	template <class InputIterator, class UnaryPredicate>
-	InputIterator find_if(InputIterator first, InputIterator last, UnaryPredicate p)
+	InputIterator impl::find_if(InputIterator first, InputIterator last, UnaryPredicate p, dstd::impl::FalseType)
 	{
 		for( ; first != last; ++first)
 		{
@@ -129,6 +255,26 @@ namespace dstd
 	}
 	
 	
+	template <class InputIterator, class UnaryPredicate>
+	InputIterator impl::find_if(InputIterator first, InputIterator last, UnaryPredicate p, dstd::impl::TrueType)
+	{
+		for(dstd::impl::segment_walker<InputIterator> w(first, last); ! w.done(); w.next())
+		{
+			typename dstd::impl::segment_walker<InputIterator>::local_iterator it = dstd::find_if(w.begin(), w.end(), p);
+			if( it != w.end() ) return w.at(it);
+		}
+		return last;
+	}
+	
+	
+	template <class InputIterator, class UnaryPredicate>
+	InputIterator find_if(InputIterator first, InputIterator last, UnaryPredicate p)
+	{
+		typedef typename dstd::impl::segmented_iterator_traits<InputIterator>::is_segmented is_segmented;
+		return dstd::impl::find_if(first, last, p, is_segmented());
+	}
+	
+	
 	template <class ForwardIterator1, class ForwardIterator2>
 	ForwardIterator1 find_first_of(ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 set_first, ForwardIterator2 set_last)
 	{
@@ -334,8 +480,74 @@ namespace dstd
 // Modifying sequence operations
 //
 
-//copy
-//Copy range of elements (function template )
+	template <class InputIterator, class OutputIterator>
+	OutputIterator impl::copy(InputIterator first, InputIterator last, OutputIterator out, dstd::impl::FalseType)
+	{
+		typedef typename dstd::impl::segmented_iterator_traits<OutputIterator>::is_segmented is_segmented;
+		return dstd::impl::copy_into(first, last, out, is_segmented());
+	}
+	
+	
+	template <class InputIterator, class OutputIterator>
+	OutputIterator impl::copy_into(InputIterator first, InputIterator last, OutputIterator out, dstd::impl::FalseType)
+	{
+		for( ; first != last; ++first, ++out)
+		{
+			*out = *first;
+		}
+		return out;
+	}
+	
+	
+	/// Fills each segment of the output in turn through a plain pointer.
+	template <class InputIterator, class OutputIterator>
+	OutputIterator impl::copy_into(InputIterator first, InputIterator last, OutputIterator out, dstd::impl::TrueType)
+	{
+		if( first == last ) return out;
+		
+		typename OutputIterator::segment_iterator s = out.segment();
+		typename OutputIterator::local_iterator l = out.local();
+		while( true )
+		{
+			const typename OutputIterator::local_iterator end = OutputIterator::segment_end(s);
+			for( ; l != end && first != last; ++l, ++first)
+			{
+				*l = *first;
+			}
+			if( first == last )
+			{
+				// the iterator's own increment steps past the end of a segment to the start of the next
+				OutputIterator result = OutputIterator::compose(s, l - 1);
+				return ++result;
+			}
+			++s;
+			l = OutputIterator::segment_begin(s);
+		}
+	}
+	
+	
+	template <class InputIterator, class OutputIterator>
+	OutputIterator impl::copy(InputIterator first, InputIterator last, OutputIterator out, dstd::impl::TrueType)
+	{
+		for(dstd::impl::segment_walker<InputIterator> w(first, last); ! w.done(); w.next())
+		{
+			out = dstd::copy(w.begin(), w.end(), out);
+		}
+		return out;
+	}
+	
+	
+	/// Copies [first,last) to the range starting at out, which must not start within [first,last).
+	/// If either range is segmented, such as a range of a deque, it is visited a segment at a time.
+	/// @returns The end of the copied range.
+	template <class InputIterator, class OutputIterator>
+	OutputIterator copy(InputIterator first, InputIterator last, OutputIterator out)
+	{
+		typedef typename dstd::impl::segmented_iterator_traits<InputIterator>::is_segmented is_segmented;
+		return dstd::impl::copy(first, last, out, is_segmented());
+	}
+	
+	
 //copy_backward
 //Copy range of elements backward (function template )
 //swap
@@ -359,8 +571,34 @@ namespace dstd
 //Copy range replacing value (function template )
 //replace_copy_if
 //Copy range replacing value (function template )
-//fill
-//Fill range with value (function template )
+	template <class ForwardIterator, class T>
+	void impl::fill(ForwardIterator first, ForwardIterator last, const T& value, dstd::impl::FalseType)
+	{
+		for( ; first != last; ++first)
+		{
+			*first = value;
+		}
+	}
+	
+	
+	template <class ForwardIterator, class T>
+	void impl::fill(ForwardIterator first, ForwardIterator last, const T& value, dstd::impl::TrueType)
+	{
+		for(dstd::impl::segment_walker<ForwardIterator> w(first, last); ! w.done(); w.next())
+		{
+			dstd::fill(w.begin(), w.end(), value);
+		}
+	}
+	
+	
+	template <class ForwardIterator, class T>
+	void fill(ForwardIterator first, ForwardIterator last, const T& value)
+	{
+		typedef typename dstd::impl::segmented_iterator_traits<ForwardIterator>::is_segmented is_segmented;
+		dstd::impl::fill(first, last, value, is_segmented());
+	}
+	
+	
 //fill_n
 //Fill sequence with value (function template )
 //generate
@@ -379,12 +617,29 @@ namespace dstd
 //Remove consecutive duplicates in range (function template )
 //unique_copy
 //Copy range removing duplicates (function template )
-//reverse
-//Reverse range (function template )
+	template <class BidirectionalIterator>
+	void reverse(BidirectionalIterator first, BidirectionalIterator last)
+	{
+		while( first != last && first != --last )
+		{
+			dstd::iter_swap(first, last);
+			++first;
+		}
+	}
+	
+	
 //reverse_copy
 //Copy range reversed (function template )
-//rotate
-//Rotate left the elements in range (function template )
+	/// Rotates the elements in [first,last) so that middle becomes the first element.
+	template <class BidirectionalIterator>
+	void rotate(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last)
+	{
+		dstd::reverse(first, middle);
+		dstd::reverse(middle, last);
+		dstd::reverse(first, last);
+	}
+	
+	
 //rotate_copy
 //Copy range rotated left (function template )
 //random_shuffle
@@ -409,8 +664,32 @@ namespace dstd
 
 //sort
 //Sort elements in range (function template )
-//stable_sort
-//Sort elements preserving order of equivalents (function template )
+	/// Sorts the elements in [first,last), preserving the order of equivalent elements.
+	/// Short runs are insertion sorted, and then merged in place without an extra buffer.
+	template <class RandomIterator, class Compare>
+	void stable_sort(RandomIterator first, RandomIterator last, Compare comp)
+	{
+		typedef typename iterator_traits<RandomIterator>::difference_type difference_type;
+		const difference_type n = last - first;
+		if( n <= 16 )
+		{
+			dstd::impl::insertion_sort(first, last, comp);
+			return;
+		}
+		RandomIterator middle = first + n / 2;
+		dstd::stable_sort(first, middle, comp);
+		dstd::stable_sort(middle, last, comp);
+		dstd::inplace_merge(first, middle, last, comp);
+	}
+	
+	
+	template <class RandomIterator>
+	void stable_sort(RandomIterator first, RandomIterator last)
+	{
+		dstd::stable_sort(first, last, dstd::impl::less_than());
+	}
+	
+	
 //partial_sort
 //Partially sort elements in range (function template )
 //partial_sort_copy
@@ -424,10 +703,68 @@ namespace dstd
 // Binary search (operating on partitioned/sorted ranges)
 //
 
-//lower_bound
-//Return iterator to lower bound (function template )
-//upper_bound
-//Return iterator to upper bound (function template )
+	/// Returns the first element in the sorted range [first,last) which does not compare less than value.
+	template <class RandomIterator, class T, class Compare>
+	RandomIterator lower_bound(RandomIterator first, RandomIterator last, const T& value, Compare comp)
+	{
+		typedef typename iterator_traits<RandomIterator>::difference_type difference_type;
+		difference_type n = last - first;
+		while( n > 0 )
+		{
+			const difference_type half = n / 2;
+			RandomIterator middle = first + half;
+			if( comp(*middle, value) )
+			{
+				first = middle + 1;
+				n -= half + 1;
+			}
+			else
+			{
+				n = half;
+			}
+		}
+		return first;
+	}
+	
+	
+	template <class RandomIterator, class T>
+	RandomIterator lower_bound(RandomIterator first, RandomIterator last, const T& value)
+	{
+		return dstd::lower_bound(first, last, value, dstd::impl::less_than());
+	}
+	
+	
+	/// Returns the first element in the sorted range [first,last) which compares greater than value.
+	template <class RandomIterator, class T, class Compare>
+	RandomIterator upper_bound(RandomIterator first, RandomIterator last, const T& value, Compare comp)
+	{
+		typedef typename iterator_traits<RandomIterator>::difference_type difference_type;
+		difference_type n = last - first;
+		while( n > 0 )
+		{
+			const difference_type half = n / 2;
+			RandomIterator middle = first + half;
+			if( comp(value, *middle) )
+			{
+				n = half;
+			}
+			else
+			{
+				first = middle + 1;
+				n -= half + 1;
+			}
+		}
+		return first;
+	}
+	
+	
+	template <class RandomIterator, class T>
+	RandomIterator upper_bound(RandomIterator first, RandomIterator last, const T& value)
+	{
+		return dstd::upper_bound(first, last, value, dstd::impl::less_than());
+	}
+	
+	
 //equal_range
 //Get subrange of equal elements (function template )
 //binary_search
@@ -441,8 +778,50 @@ namespace dstd
 
 //merge
 //Merge sorted ranges (function template )
-//inplace_merge
-//Merge consecutive sorted ranges (function template )
+	/// Merges the consecutive sorted ranges [first,middle) and [middle,last), preserving the order of equivalent elements.
+	/// No extra buffer is used: the larger range is split in half, the other range is split at the matching bound,
+	/// and the two inner parts are rotated past each other before merging each side recursively.
+	template <class RandomIterator, class Compare>
+	void inplace_merge(RandomIterator first, RandomIterator middle, RandomIterator last, Compare comp)
+	{
+		typedef typename iterator_traits<RandomIterator>::difference_type difference_type;
+		const difference_type n_1 = middle - first;
+		const difference_type n_2 = last - middle;
+		if( n_1 == 0 || n_2 == 0 ) return;
+		if( ! comp(*middle, *(middle - 1)) ) return; // already in order
+		if( n_1 + n_2 == 2 )
+		{
+			if( comp(*middle, *first) ) dstd::iter_swap(first, middle);
+			return;
+		}
+
+		RandomIterator cut_1;
+		RandomIterator cut_2;
+		if( n_1 > n_2 )
+		{
+			cut_1 = first + n_1 / 2;
+			cut_2 = dstd::lower_bound(middle, last, *cut_1, comp);
+		}
+		else
+		{
+			cut_2 = middle + n_2 / 2;
+			cut_1 = dstd::upper_bound(first, middle, *cut_2, comp);
+		}
+		dstd::rotate(cut_1, middle, cut_2);
+
+		RandomIterator new_middle = cut_1 + (cut_2 - middle);
+		dstd::inplace_merge(first, cut_1, new_middle, comp);
+		dstd::inplace_merge(new_middle, cut_2, last, comp);
+	}
+	
+	
+	template <class RandomIterator>
+	void inplace_merge(RandomIterator first, RandomIterator middle, RandomIterator last)
+	{
+		dstd::inplace_merge(first, middle, last, dstd::impl::less_than());
+	}
+	
+	
 //includes
 //Test whether sorted range includes another sorted range (function template )
 //set_union
@@ -515,6 +894,24 @@ namespace dstd
 	}
 	
 	
+	/// Sorts a short range, preserving the order of equivalent elements.
+	template <class RandomIterator, class Compare>
+	void impl::insertion_sort(RandomIterator first, RandomIterator last, Compare comp)
+	{
+		if( first == last ) return;
+		for(RandomIterator it = first + 1; it != last; ++it)
+		{
+			typename iterator_traits<RandomIterator>::value_type value = *it;
+			RandomIterator hole = it;
+			for( ; hole != first && comp(value, *(hole - 1)); --hole)
+			{
+				*hole = *(hole - 1);
+			}
+			*hole = value;
+		}
+	}
+	
+	
 	template <class RandomIterator>
 	RandomIterator impl::heap_max_child(RandomIterator first, RandomIterator last, RandomIterator parent)
 	{
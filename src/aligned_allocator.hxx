@@ -0,0 +1,141 @@
+#ifndef DSTD_ALIGNED_ALLOCATOR_HXX
+#define DSTD_ALIGNED_ALLOCATOR_HXX
+
+#include <new>
+
+#include "cstddef.hxx"
+#include "exception.hxx"
+#include "limits.hxx"
+#include "utility.hxx"
+
+
+
+namespace dstd
+{
+	template <class T, size_t Alignment> class aligned_allocator;
+}
+
+
+
+//
+// dstd::aligned_allocator
+//
+// An allocator whose blocks start on a multiple of Alignment bytes (or of alignof(T), if that is larger),
+// such as a cache line or the width of a SIMD register. The elements of a vector or string using it,
+// and the chunks of a deque, can then be read with aligned loads and never straddle a cache line needlessly.
+// Alignment must be a power of two. Rebinding keeps the alignment, and all aligned_allocators compare equal.
+
+template <class T, size_t Alignment = 64>
+class dstd::aligned_allocator
+{
+	public:
+
+		typedef T value_type;
+		typedef T* pointer;
+		typedef T& reference;
+		typedef const T* const_pointer;
+		typedef const T& const_reference;
+
+		template <class OtherType>
+		struct rebind
+		{
+			typedef aligned_allocator< OtherType, Alignment > other;
+		};
+
+
+		/// The alignment of every block, in bytes.
+		static constexpr size_t alignment = ( Alignment > alignof(T) ) ? Alignment : alignof(T);
+
+		static_assert( (Alignment & (Alignment - 1)) == 0, "dstd::aligned_allocator: Alignment must be a power of two" );
+
+
+		aligned_allocator(){}
+
+
+		template <class U>
+		aligned_allocator(const dstd::aligned_allocator<U, Alignment>& /*a*/){}
+
+
+		~aligned_allocator(){}
+
+
+		T* address(T& obj) const
+		{
+			return &obj;
+		}
+
+
+		const T* address(const T& obj) const
+		{
+			return &obj;
+		}
+
+
+		/// Returns the largest n which may be passed to allocate.
+		/// There must be room to round the size in bytes up to a multiple of the alignment without it wrapping around.
+		size_t max_size() const
+		{
+			return (dstd::numeric_limits<size_t>::max() - alignment) / sizeof(T);
+		}
+
+
+		/// Allocates storage for n objects of type T, starting on a multiple of alignment bytes.
+		/// Throws bad_alloc if the storage cannot be allocated.
+		T* allocate(size_t n)
+		{
+			if( n > this->max_size() ) throw dstd::bad_alloc();
+
+			try
+			{
+				return static_cast<T*>( ::operator new(n * sizeof(T), std::align_val_t(alignment)) );
+			}
+			catch( std::bad_alloc& )
+			{
+				throw dstd::bad_alloc();
+			}
+		}
+
+
+		/// Releases storage for n objects, previously allocated with allocate(n). An n of 0 means the size is not known.
+		/// The objects are not destroyed by a call to this member function.
+		void deallocate(T* p, size_t n = 0)
+		{
+			if( n == 0 ) ::operator delete( p, std::align_val_t(alignment) );
+			else ::operator delete( p, n * sizeof(T), std::align_val_t(alignment) );
+		}
+
+
+		/// Constructs an object on the location pointed by p, passing args on to its constructor.
+		template <class U, class... Args>
+		void construct(U* p, Args&&... args)
+		{
+			new(p) U( dstd::forward<Args>(args)... );
+		}
+
+
+		/// Destroys in-place the object pointed by p.
+		void destroy(T* p)
+		{
+			p->~T();
+		}
+};
+
+
+
+template <class T, size_t A, class U, size_t B>
+bool operator==(const dstd::aligned_allocator<T, A>& /*a*/, const dstd::aligned_allocator<U, B>& /*b*/)
+{
+	return ( A == B );
+}
+
+
+
+template <class T, size_t A, class U, size_t B>
+bool operator!=(const dstd::aligned_allocator<T, A>& a, const dstd::aligned_allocator<U, B>& b)
+{
+	return ! (a == b);
+}
+
+
+
+#endif
@@ -0,0 +1,287 @@
+#ifndef DSTD_ARENA_HXX
+#define DSTD_ARENA_HXX
+
+#include <new>
+
+#include "cstddef.hxx"
+#include "exception.hxx"
+#include "limits.hxx"
+#include "memory.hxx"
+#include "utility.hxx"
+
+
+
+namespace dstd
+{
+	class arena;
+	template <class T> class arena_allocator;
+}
+
+
+
+//
+// dstd::arena
+//
+// A monotonic allocator, which hands out memory by bumping a pointer through large chunks.
+// Individual allocations are never freed. Instead, reset releases everything allocated from the arena at once,
+// which suits containers whose lifetimes all end together, such as those built while handling a single request.
+// The arena is not thread safe.
+
+class dstd::arena
+{
+	public:
+
+		typedef size_t size_type;
+
+
+		/// Constructs an arena which allocates chunks of at least chunk_size bytes.
+		/// No memory is allocated until the first allocation from the arena.
+		explicit arena(size_type chunk_size = 65536)
+			: chunks(0), current(0), current_end(0), min_chunk_size(chunk_size)
+		{}
+
+
+		/// Releases all memory allocated from the arena.
+		~arena()
+		{
+			this->release(0);
+		}
+
+
+		/// Returns a block of n bytes, aligned to alignment, which must be a power of two.
+		/// Throws bad_alloc if a new chunk is needed and cannot be allocated.
+		void* allocate(size_type n, size_type alignment)
+		{
+			char* p = this->align(this->current, alignment);
+			if( p == 0 || p > this->current_end || n > static_cast<size_type>(this->current_end - p) )
+			{
+				if( n > dstd::numeric_limits<size_type>::max() - alignment ) throw dstd::bad_alloc();
+				this->add_chunk(n + alignment);
+				p = this->align(this->current, alignment);
+			}
+			this->current = p + n;
+			return p;
+		}
+
+
+		/// Resizes the block at p, which holds old_n bytes, to new_n bytes, if it is the most recent allocation
+		/// and the current chunk has room. Growing a block this way costs nothing, and shrinking one returns its tail to the arena.
+		/// @returns Whether the block was resized.
+		bool resize_in_place(void* p, size_type old_n, size_type new_n)
+		{
+			char* block = static_cast<char*>(p);
+			if( block + old_n != this->current ) return false;
+			if( new_n > static_cast<size_type>(this->current_end - block) ) return false;
+			this->current = block + new_n;
+			return true;
+		}
+		
+		
+		/// Releases everything allocated from the arena.
+		/// The first chunk is kept, so that an arena reused for similar work does not allocate again.
+		void reset()
+		{
+			chunk* first = this->chunks;
+			while( first != 0 && first->next != 0 ) first = first->next;
+			this->release(first);
+
+			this->chunks = first;
+			this->current = ( first == 0 ) ? 0 : first->data();
+			this->current_end = ( first == 0 ) ? 0 : first->data() + first->size;
+		}
+
+
+		/// Returns the total size of the chunks the arena holds.
+		size_type capacity() const
+		{
+			size_type n = 0;
+			for(const chunk* c = this->chunks; c != 0; c = c->next) n += c->size;
+			return n;
+		}
+
+
+	private:
+
+		/// The header at the start of each chunk. The chunk's memory follows it.
+		class chunk
+		{
+			public:
+
+				char* data() { return reinterpret_cast<char*>(this) + header_size; }
+
+				chunk* next;
+				size_type size;
+		};
+
+
+		/// The header is padded so that the memory after it is as aligned as the chunk itself.
+		static const size_type header_size = ( (sizeof(chunk) + 2*sizeof(void*) - 1) / (2*sizeof(void*)) ) * (2*sizeof(void*));
+
+
+		arena(const arena&);
+		arena& operator= (const arena&);
+
+
+		/// Returns p rounded up to a multiple of alignment, or 0 if there is no current chunk.
+		static char* align(char* p, size_type alignment)
+		{
+			if( p == 0 ) return 0;
+			const size_t address = reinterpret_cast<size_t>(p);
+			return p + ( (alignment - address % alignment) % alignment );
+		}
+
+
+		/// Allocates a chunk with room for at least n bytes, and makes it the current chunk.
+		void add_chunk(size_type n)
+		{
+			const size_type size = ( n > this->min_chunk_size ) ? n : this->min_chunk_size;
+			if( size > dstd::numeric_limits<size_type>::max() - header_size ) throw dstd::bad_alloc();
+
+			chunk* c = reinterpret_cast<chunk*>( dstd::allocator<char>().allocate(header_size + size) );
+			c->next = this->chunks;
+			c->size = size;
+			this->chunks = c;
+			this->current = c->data();
+			this->current_end = c->data() + size;
+		}
+
+
+		/// Frees every chunk, newest first, until kept (which is not freed) or the end of the list.
+		void release(chunk* kept)
+		{
+			while( this->chunks != kept )
+			{
+				chunk* c = this->chunks;
+				this->chunks = c->next;
+				dstd::allocator<char>().deallocate( reinterpret_cast<char*>(c), header_size + c->size );
+			}
+			this->current = 0;
+			this->current_end = 0;
+		}
+
+
+		chunk* chunks;
+		char* current;
+		char* current_end;
+		size_type min_chunk_size;
+};
+
+
+
+//
+// dstd::arena_allocator
+//
+// An allocator which takes its memory from an arena. deallocate does nothing; the memory is reclaimed by arena::reset.
+// Copies of an arena_allocator, including those obtained through rebind, share the same arena,
+// and two arena_allocators compare equal if they use the same arena.
+
+template <class T>
+class dstd::arena_allocator
+{
+	public:
+
+		typedef T value_type;
+		typedef T* pointer;
+		typedef T& reference;
+		typedef const T* const_pointer;
+		typedef const T& const_reference;
+
+		template <class OtherType>
+		struct rebind
+		{
+			typedef arena_allocator< OtherType > other;
+		};
+
+
+		arena_allocator(dstd::arena& a)
+			: ar(&a)
+		{}
+
+
+		template <class U>
+		arena_allocator(const dstd::arena_allocator<U>& a)
+			: ar( &a.get_arena() )
+		{}
+
+
+		~arena_allocator(){}
+
+
+		T* address(T& obj) const
+		{
+			return &obj;
+		}
+
+
+		const T* address(const T& obj) const
+		{
+			return &obj;
+		}
+
+
+		/// Allocates storage for n objects of type T from the arena.
+		/// Throws bad_alloc if the storage cannot be allocated.
+		T* allocate(size_t n)
+		{
+			if( n > dstd::numeric_limits<size_t>::max() / sizeof(T) ) throw dstd::bad_alloc();
+			return static_cast<T*>( this->ar->allocate(n * sizeof(T), alignof(T)) );
+		}
+
+
+		/// Does nothing. The storage is released when the arena is reset or destroyed.
+		void deallocate(T* /*p*/, size_t /*n*/ = 0)
+		{}
+		
+		
+		/// Resizes the storage at p from old_n to new_n objects without moving it, if it was the last allocation from the arena.
+		/// Containers use this to grow without copying their elements.
+		bool resize_in_place(T* p, size_t old_n, size_t new_n)
+		{
+			if( new_n > dstd::numeric_limits<size_t>::max() / sizeof(T) ) return false;
+			return this->ar->resize_in_place(p, old_n * sizeof(T), new_n * sizeof(T));
+		}
+
+
+		/// Constructs an object on the location pointed by p, passing args on to its constructor.
+		template <class U, class... Args>
+		void construct(U* p, Args&&... args)
+		{
+			new(p) U( dstd::forward<Args>(args)... );
+		}
+
+
+		/// Destroys in-place the object pointed by p.
+		void destroy(T* p)
+		{
+			p->~T();
+		}
+
+
+		/// Returns the arena which this allocator takes its memory from.
+		dstd::arena& get_arena() const { return *(this->ar); }
+
+
+	private:
+
+		dstd::arena* ar;
+};
+
+
+
+template <class T, class U>
+bool operator==(const dstd::arena_allocator<T>& a, const dstd::arena_allocator<U>& b)
+{
+	return ( &a.get_arena() == &b.get_arena() );
+}
+
+
+
+template <class T, class U>
+bool operator!=(const dstd::arena_allocator<T>& a, const dstd::arena_allocator<U>& b)
+{
+	return ! (a == b);
+}
+
+
+
+#endif
@@ -8,6 +8,8 @@
 #include <limits>
 #include <string>
 
+#include "impl/bit_ops.hxx"
+
 #include "algorithm.hxx"
 #include "exception.hxx"
 
@@ -137,10 +139,15 @@ class dstd::bitset
 		
 		size_t count() const
 		{
+			const size_t size = bitset::data_size();
+			unsigned char mask = static_cast<unsigned char>(-1);
+			if( (N % CHAR_BIT) != 0 ) mask >>= (CHAR_BIT - (N % CHAR_BIT));
 			size_t n = 0;
-			for(size_t i = 0; i < N; ++i)
+			for(size_t i = 0; i < size; ++i)
 			{
-				if( this->get_bit(i) ) ++n;
+				n += dstd::impl::popcount( static_cast<unsigned char>(this->data[i] & mask) );
+				
+				if( i == 0 ) mask = -1;
 			}
 			return n;
 		}
@@ -0,0 +1,283 @@
+#ifndef DSTD_BTREE_MAP_HXX
+#define DSTD_BTREE_MAP_HXX
+
+
+
+#include "impl/btree.hxx"
+
+#include "functional.hxx"
+#include "iterator.hxx"
+#include "memory.hxx"
+#include "utility.hxx"
+
+
+
+namespace dstd
+{
+	template < class Key, class T, class Compare = dstd::less<Key>, class Allocator = dstd::allocator< dstd::pair<Key, T> > > class btree_map;
+	template < class Key, class T, class Compare = dstd::less<Key>, class Allocator = dstd::allocator< dstd::pair<Key, T> > > class btree_multimap;
+
+	template <class Key, class T, class Compare, class Allocator> void swap(btree_map<Key, T, Compare, Allocator>& lhs, btree_map<Key, T, Compare, Allocator>& rhs);
+	template <class Key, class T, class Compare, class Allocator> void swap(btree_multimap<Key, T, Compare, Allocator>& lhs, btree_multimap<Key, T, Compare, Allocator>& rhs);
+}
+
+
+
+//
+// dstd::btree_map
+//
+// An ordered map with the same interface as dstd::map, which stores many elements per node
+// in contiguous arrays. This uses far less memory than one node per element, and a lookup
+// touches only a few cache lines per level of a much shallower tree.
+// Unlike dstd::map, inserting or erasing an element invalidates all iterators.
+
+template < class Key, class T, class Compare, class Allocator >
+class dstd::btree_map : public dstd::impl::btree<Key, dstd::pair<Key, T>, dstd::impl::select_first< dstd::pair<Key, T> >, Compare, Allocator, false>
+{
+	private:
+
+		typedef dstd::impl::btree<Key, dstd::pair<Key, T>, dstd::impl::select_first< dstd::pair<Key, T> >, Compare, Allocator, false> btree;
+
+	public:
+
+		typedef typename btree::key_type key_type;
+		typedef T mapped_type;
+		typedef typename btree::value_type value_type;
+		typedef typename btree::key_compare key_compare;
+		typedef typename btree::value_compare value_compare;
+		typedef typename btree::size_type size_type;
+		typedef typename btree::difference_type difference_type;
+		typedef typename btree::allocator_type allocator_type;
+		typedef typename btree::iterator iterator;
+		typedef typename btree::const_iterator const_iterator;
+		typedef typename btree::reverse_iterator reverse_iterator;
+		typedef typename btree::const_reverse_iterator const_reverse_iterator;
+
+
+		//
+		// Contructors
+
+
+		/// Constructs an empty map with no elements.
+		explicit btree_map(const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: btree(compare, alloc)
+		{}
+
+
+		/// Constructs a map with as many elements as the range [first,last),
+		/// with each element constructed from its corresponding element in that range.
+		template <class InputIterator>
+		btree_map(InputIterator first, InputIterator last, const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: btree(compare, alloc)
+		{
+			this->insert(first, last);
+		}
+
+
+		/// Copy constructor. Constructs a map with a copy of each of the elements in x.
+		btree_map(const btree_map& x)
+			: btree(x)
+		{}
+
+
+		virtual ~btree_map() {}
+
+
+		btree_map& operator= (const btree_map& x)
+		{
+			btree::operator=(x);
+			return *this;
+		}
+
+
+		//
+		// Element Access
+
+
+		/// Access the mapped value of an element with key k.
+		/// If k does not match the key of any element in the container,
+		/// the function inserts a new element with that key and returns a reference to its mapped value.
+		mapped_type& operator[] (const key_type& k)
+		{
+			return this->emplace_unique( k, k, mapped_type() ).first->second;
+		}
+
+
+		//
+		// Modifiers
+
+
+		/// Extends the container by inserting a new element, if no element with an equivalent key already exists.
+		/// @returns A pair, with its first member an iterator pointing to either the newly inserted
+		/// element or to the element with an equivalent key already in the map,
+		/// and its second member set to true if a new element was inserted.
+		dstd::pair<iterator, bool> insert(const value_type& value)
+		{
+			return this->insert_unique(value);
+		}
+
+
+		/// Extends the container by inserting a new element, if no element with an equivalent key already exists.
+		/// Inserting after the last element does not search the tree.
+		iterator insert(iterator position, const value_type& value)
+		{
+			return this->insert_unique(value).first;
+		}
+
+
+		/// Extends the container by copying elements in the range [first,last).
+		template <class InputIterator>
+		void insert(InputIterator first, InputIterator last)
+		{
+			for( ; first != last; ++first)
+			{
+				this->insert_unique(*first);
+			}
+		}
+
+
+		/// Exchanges the content of the container by the content of x.
+		void swap(btree_map& x) { btree::swap(x); }
+};
+
+
+
+//
+// dstd::btree_multimap
+
+template < class Key, class T, class Compare, class Allocator >
+class dstd::btree_multimap : public dstd::impl::btree<Key, dstd::pair<Key, T>, dstd::impl::select_first< dstd::pair<Key, T> >, Compare, Allocator, true>
+{
+	private:
+
+		typedef dstd::impl::btree<Key, dstd::pair<Key, T>, dstd::impl::select_first< dstd::pair<Key, T> >, Compare, Allocator, true> btree;
+
+	public:
+
+		typedef typename btree::key_type key_type;
+		typedef T mapped_type;
+		typedef typename btree::value_type value_type;
+		typedef typename btree::key_compare key_compare;
+		typedef typename btree::value_compare value_compare;
+		typedef typename btree::size_type size_type;
+		typedef typename btree::difference_type difference_type;
+		typedef typename btree::allocator_type allocator_type;
+		typedef typename btree::iterator iterator;
+		typedef typename btree::const_iterator const_iterator;
+		typedef typename btree::reverse_iterator reverse_iterator;
+		typedef typename btree::const_reverse_iterator const_reverse_iterator;
+
+
+		//
+		// Contructors
+
+
+		/// Constructs an empty map with no elements.
+		explicit btree_multimap(const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: btree(compare, alloc)
+		{}
+
+
+		/// Constructs a map with as many elements as the range [first,last),
+		/// with each element constructed from its corresponding element in that range.
+		template <class InputIterator>
+		btree_multimap(InputIterator first, InputIterator last, const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: btree(compare, alloc)
+		{
+			this->insert(first, last);
+		}
+
+
+		/// Copy constructor. Constructs a map with a copy of each of the elements in x.
+		btree_multimap(const btree_multimap& x)
+			: btree(x)
+		{}
+
+
+		virtual ~btree_multimap() {}
+
+
+		btree_multimap& operator= (const btree_multimap& x)
+		{
+			btree::operator=(x);
+			return *this;
+		}
+
+
+		//
+		// Modifiers
+
+
+		/// Extends the container by inserting a new element after any elements with an equivalent key.
+		/// @returns An iterator to the newly inserted element.
+		iterator insert(const value_type& value)
+		{
+			return this->insert_equal(value);
+		}
+
+
+		/// Extends the container by inserting a new element after any elements with an equivalent key.
+		/// Inserting after the last element does not search the tree.
+		iterator insert(iterator position, const value_type& value)
+		{
+			return this->insert_equal(value);
+		}
+
+
+		/// Extends the container by copying elements in the range [first,last).
+		template <class InputIterator>
+		void insert(InputIterator first, InputIterator last)
+		{
+			for( ; first != last; ++first)
+			{
+				this->insert_equal(*first);
+			}
+		}
+
+
+		/// Exchanges the content of the container by the content of x.
+		void swap(btree_multimap& x) { btree::swap(x); }
+};
+
+
+
+template <class Key, class T, class Compare, class Allocator>
+bool operator==(const dstd::btree_map<Key, T, Compare, Allocator>& a, const dstd::btree_map<Key, T, Compare, Allocator>& b)
+{
+	if( a.size() != b.size() ) return false;
+	typename dstd::btree_map<Key, T, Compare, Allocator>::const_iterator a_it = a.begin();
+	typename dstd::btree_map<Key, T, Compare, Allocator>::const_iterator b_it = b.begin();
+	for( ; a_it != a.end(); ++a_it, ++b_it)
+	{
+		if( *a_it != *b_it ) return false;
+	}
+	return true;
+}
+
+
+
+template <class Key, class T, class Compare, class Allocator>
+bool operator!=(const dstd::btree_map<Key, T, Compare, Allocator>& a, const dstd::btree_map<Key, T, Compare, Allocator>& b)
+{
+	return ! (a == b);
+}
+
+
+
+template <class Key, class T, class Compare, class Allocator>
+void dstd::swap(dstd::btree_map<Key, T, Compare, Allocator>& lhs, dstd::btree_map<Key, T, Compare, Allocator>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+
+
+template <class Key, class T, class Compare, class Allocator>
+void dstd::swap(dstd::btree_multimap<Key, T, Compare, Allocator>& lhs, dstd::btree_multimap<Key, T, Compare, Allocator>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+
+
+#endif
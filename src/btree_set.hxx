@@ -0,0 +1,219 @@
+#ifndef DSTD_BTREE_SET_HXX
+#define DSTD_BTREE_SET_HXX
+
+
+
+#include "impl/btree.hxx"
+
+#include "functional.hxx"
+#include "iterator.hxx"
+#include "memory.hxx"
+#include "utility.hxx"
+
+
+
+namespace dstd
+{
+	template < class T, class Compare = dstd::less<T>, class Allocator = dstd::allocator<T> > class btree_set;
+	template < class T, class Compare = dstd::less<T>, class Allocator = dstd::allocator<T> > class btree_multiset;
+
+	template <class T, class Compare, class Allocator> void swap(btree_set<T, Compare, Allocator>& lhs, btree_set<T, Compare, Allocator>& rhs);
+	template <class T, class Compare, class Allocator> void swap(btree_multiset<T, Compare, Allocator>& lhs, btree_multiset<T, Compare, Allocator>& rhs);
+}
+
+
+
+//
+// dstd::btree_set
+//
+// An ordered set with the same interface as dstd::set, which stores many elements per node
+// in contiguous arrays. Unlike dstd::set, inserting or erasing an element invalidates all iterators.
+
+template <class T, class Compare, class Allocator>
+class dstd::btree_set : public dstd::impl::btree<T, T, dstd::impl::identity<T>, Compare, Allocator, false>
+{
+	private:
+
+		typedef dstd::impl::btree<T, T, dstd::impl::identity<T>, Compare, Allocator, false> btree;
+
+	public:
+
+		typedef typename btree::key_type key_type;
+		typedef typename btree::value_type value_type;
+		typedef typename btree::key_compare key_compare;
+		typedef typename btree::value_compare value_compare;
+		typedef typename btree::size_type size_type;
+		typedef typename btree::difference_type difference_type;
+		typedef typename btree::allocator_type allocator_type;
+		typedef typename btree::iterator iterator;
+		typedef typename btree::const_iterator const_iterator;
+		typedef typename btree::reverse_iterator reverse_iterator;
+		typedef typename btree::const_reverse_iterator const_reverse_iterator;
+
+
+		//
+		// Constructors
+
+
+		/// Constructs an empty set with no elements.
+		explicit btree_set(const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: btree(compare, alloc)
+		{}
+
+
+		/// Constructs a set with as many elements as the range [first,last),
+		/// with each element constructed from its corresponding element in that range.
+		template <class InputIterator>
+		btree_set(InputIterator first, InputIterator last, const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: btree(compare, alloc)
+		{
+			this->insert(first, last);
+		}
+
+
+		/// Copy constructor. Constructs a set with a copy of each of the elements in x.
+		btree_set(const btree_set& x)
+			: btree(x)
+		{}
+
+
+		virtual ~btree_set() {}
+
+
+		btree_set& operator= (const btree_set& x)
+		{
+			btree::operator=(x);
+			return *this;
+		}
+
+
+		//
+		// Modifiers
+
+
+		dstd::pair<iterator, bool> insert(const value_type& value) { return this->insert_unique(value); }
+
+
+		/// Inserting after the last element does not search the tree.
+		iterator insert(iterator hint, const value_type& value) { return this->insert_unique(value).first; }
+
+
+		template <class InputIterator>
+		void insert(InputIterator first, InputIterator last)
+		{
+			for( ; first != last; ++first)
+			{
+				this->insert_unique(*first);
+			}
+		}
+
+
+		void swap(btree_set& x) { btree::swap(x); }
+};
+
+
+
+//
+// dstd::btree_multiset
+
+template <class T, class Compare, class Allocator>
+class dstd::btree_multiset : public dstd::impl::btree<T, T, dstd::impl::identity<T>, Compare, Allocator, true>
+{
+	private:
+
+		typedef dstd::impl::btree<T, T, dstd::impl::identity<T>, Compare, Allocator, true> btree;
+
+	public:
+
+		typedef typename btree::key_type key_type;
+		typedef typename btree::value_type value_type;
+		typedef typename btree::key_compare key_compare;
+		typedef typename btree::value_compare value_compare;
+		typedef typename btree::size_type size_type;
+		typedef typename btree::difference_type difference_type;
+		typedef typename btree::allocator_type allocator_type;
+		typedef typename btree::iterator iterator;
+		typedef typename btree::const_iterator const_iterator;
+		typedef typename btree::reverse_iterator reverse_iterator;
+		typedef typename btree::const_reverse_iterator const_reverse_iterator;
+
+
+		//
+		// Constructors
+
+
+		/// Constructs an empty multiset with no elements.
+		explicit btree_multiset(const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: btree(compare, alloc)
+		{}
+
+
+		/// Constructs a multiset with as many elements as the range [first,last),
+		/// with each element constructed from its corresponding element in that range.
+		template <class InputIterator>
+		btree_multiset(InputIterator first, InputIterator last, const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: btree(compare, alloc)
+		{
+			this->insert(first, last);
+		}
+
+
+		/// Copy constructor. Constructs a multiset with a copy of each of the elements in x.
+		btree_multiset(const btree_multiset& x)
+			: btree(x)
+		{}
+
+
+		virtual ~btree_multiset() {}
+
+
+		btree_multiset& operator= (const btree_multiset& x)
+		{
+			btree::operator=(x);
+			return *this;
+		}
+
+
+		//
+		// Modifiers
+
+
+		iterator insert(const value_type& value) { return this->insert_equal(value); }
+
+
+		/// Inserting after the last element does not search the tree.
+		iterator insert(iterator hint, const value_type& value) { return this->insert_equal(value); }
+
+
+		template <class InputIterator>
+		void insert(InputIterator first, InputIterator last)
+		{
+			for( ; first != last; ++first)
+			{
+				this->insert_equal(*first);
+			}
+		}
+
+
+		void swap(btree_multiset& x) { btree::swap(x); }
+};
+
+
+
+template <class T, class Compare, class Allocator>
+void dstd::swap(dstd::btree_set<T, Compare, Allocator>& lhs, dstd::btree_set<T, Compare, Allocator>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+
+
+template <class T, class Compare, class Allocator>
+void dstd::swap(dstd::btree_multiset<T, Compare, Allocator>& lhs, dstd::btree_multiset<T, Compare, Allocator>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+
+
+#endif
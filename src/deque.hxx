@@ -8,6 +8,7 @@
 #include <iostream>
 
 #include "impl/bool_type.hxx"
+#include "impl/segmented_iterator.hxx"
 #include "iterator.hxx"
 #include "memory.hxx"
 #include "utility.hxx"
@@ -16,24 +17,33 @@
 
 namespace dstd
 {
-	template <class T, class Allocator> class deque;
+	template <class T, class Allocator, size_t ChunkBytes> class deque;
 	
-	template <class T, class Allocator> void swap(dstd::deque<T,Allocator>& d1, dstd::deque<T,Allocator>& d2);
+	template <class T, class Allocator, size_t ChunkBytes> void swap(dstd::deque<T,Allocator,ChunkBytes>& d1, dstd::deque<T,Allocator,ChunkBytes>& d2);
 	
 	namespace impl
 	{
-		/// Returns the number of elements stored in a single chunk in the deque
-		template <class T>
-		inline size_t deque_chunk_size()
+		/// Returns the number of elements stored in a single chunk of a deque whose chunks are ChunkBytes long.
+		/// A chunk always holds at least one element.
+		/// If ChunkBytes is 0, small elements get 512 byte chunks, the size used in GCC's STL implementation.
+		/// Elements of more than 32 bytes get chunks of a 4KiB page, or of 16 elements if that is larger, so that large
+		/// elements do not end up one to a chunk, with a chunk map entry and an allocation for every element.
+		template <class T, size_t ChunkBytes>
+		constexpr size_t deque_chunk_size()
 		{
-			return (512 > sizeof(T)) ? (512 / sizeof(T)) : 1; // 512 is the number used in GCC's STL implementation
+			return ( ChunkBytes != 0 ) ? ( (ChunkBytes > sizeof(T)) ? (ChunkBytes / sizeof(T)) : 1 )
+				: ( sizeof(T) <= 32 ) ? (512 / sizeof(T))
+				: ( sizeof(T) <= 256 ) ? (4096 / sizeof(T))
+				: 16;
 		}
 	}
 }
 
 
 
-template < class T, class Allocator = dstd::allocator<T> >
+/// ChunkBytes is the size of the chunks the elements are stored in, or 0 to choose one from the size of T (see deque_chunk_size).
+/// Larger chunks mean fewer allocations and longer runs of contiguous elements, at the cost of more memory held by a small deque.
+template < class T, class Allocator = dstd::allocator<T>, size_t ChunkBytes = 0 >
 class dstd::deque
 {
 	public:
@@ -87,14 +97,25 @@ class dstd::deque
 		}
 		
 		
+		/// Move constructor. Takes x's elements, chunks and allocator without allocating, leaving x empty.
+		/// x is left with no chunks at all, and allocates them again when an element is next added to it.
+		deque(deque&& x) noexcept
+			: a(x.get_allocator()), chunks(0), chunks_capacity(0), chunks_first(0), chunks_last(0), first(), last()
+		{
+			this->swap(x);
+		}
+		
+		
 		//
 		// Destructor
 		
 		~deque()
 		{
+			if( this->chunks == 0 ) return; // moved from
 			this->clear();
-			typename Allocator::template rebind<pointer>::other a_chunks;
-			a_chunks.deallocate( this->chunks );
+			this->chunks_pop_back( this->chunks_last - this->chunks_first );
+			typename Allocator::template rebind<pointer>::other a_chunks(this->a);
+			a_chunks.deallocate( this->chunks, this->chunks_capacity );
 		}
 		
 		
@@ -108,6 +129,15 @@ class dstd::deque
 		}
 		
 		
+		/// Takes x's elements, together with the allocator which owns them, leaving x empty.
+		deque& operator= (deque&& x) noexcept
+		{
+			deque temp( dstd::move(x) );
+			this->swap(temp);
+			return *this;
+		}
+		
+		
 		//
 		// Iterators
 		
@@ -145,14 +175,9 @@ class dstd::deque
 		
 		void resize(size_type n, const T& value = T())
 		{
-			while( this->size() > n )
-			{
-				this->pop_back();
-			}
-			while( this->size() < n )
-			{
-				this->push_back(value);
-			}
+			const size_type size = this->size();
+			if( n < size ) this->erase( this->begin() + n, this->end() );
+			else if( n > size ) this->insert( this->end(), n - size, value );
 		}
 		
 		
@@ -231,8 +256,22 @@ class dstd::deque
 		
 		void push_back(const T& value)
 		{
-			
-			this->a.construct(this->last.p, value);
+			this->emplace_back(value);
+		}
+		
+		
+		void push_back(T&& value)
+		{
+			this->emplace_back( dstd::move(value) );
+		}
+		
+		
+		/// Appends an element constructed in place from args.
+		template <class... Args>
+		void emplace_back(Args&&... args)
+		{
+			if( this->chunks == 0 ) this->initialise();
+			this->a.construct(this->last.p, dstd::forward<Args>(args)...);
 			++(this->last);
 			if( this->last.c == (this->chunks_last - 2) )
 			{
@@ -243,32 +282,58 @@ class dstd::deque
 		
 		void push_front(const T& value)
 		{
+			this->emplace_front(value);
+		}
+		
+		
+		void push_front(T&& value)
+		{
+			this->emplace_front( dstd::move(value) );
+		}
+		
+		
+		/// Prepends an element constructed in place from args.
+		template <class... Args>
+		void emplace_front(Args&&... args)
+		{
+			if( this->chunks == 0 ) this->initialise();
 			if( this->first.p == this->first.first && this->first.c == this->chunks_first )
 			{
 				this->chunks_push_front(1);
 			}
-			--(this->first);
-			this->a.construct(this->first.p, value);
+			iterator new_first = this->first - 1;
+			this->a.construct(new_first.p, dstd::forward<Args>(args)...);
+			this->first = new_first;
 		}
 		
 		
+		/// Leaving a chunk keeps it for later pushes, unless max_spare_chunks are already kept, in which case it is freed.
 		void pop_back()
 		{
 			if( ! this->empty() )
 			{
 				--(this->last);
 				this->a.destroy(this->last.p);
+				if( this->last.p + 1 == this->last.last && this->spare_chunks_back() > max_spare_chunks )
+				{
+					this->chunks_pop_back(1);
+				}
 			}
 		}
 		
 		
 		/// All iterators are invalidated
+		/// Leaving a chunk keeps it for later pushes, unless max_spare_chunks are already kept, in which case it is freed.
 		void pop_front()
 		{
 			if( ! this->empty() )
 			{
 				this->a.destroy( this->first.p );
 				++(this->first);
+				if( this->first.p == this->first.first && this->spare_chunks_front() > max_spare_chunks )
+				{
+					this->chunks_pop_front(1);
+				}
 			}
 		}
 		
@@ -277,139 +342,78 @@ class dstd::deque
 		
 		iterator insert_fix(iterator position, const size_type n, const value_type& value, dstd::impl::TrueType)
 		{
-			if( position == this->begin() )
-			{
-				for(size_type i = 0; i < n; ++i)
-				{
-					this->push_front(value);
-				}
-				return this->begin();
-			}
-			else if( position == this->end() )
-			{
-				for(size_type i = 0; i < n; ++i)
-				{
-					this->push_back(value);
-				}
-				return this->end() - 1;
-			}
-			else
+			if( position != this->begin() && position != this->end() )
 			{
-				// Ensure any allocation requried is done here.
-				// Then, if an exception is thrown, the deque is left in a valid state.
-				if( this->last.p + n > this->last.last )
-				{
-					// Iterators can be invalidated if allocations occur.
-					// So save the iterator's offset from the start, and restore position
-					// to a valid iterator afterwards.
-					const difference_type offset = position - this->begin();
-					
-					const size_type chunk_size = dstd::impl::deque_chunk_size<value_type>();
-					
-					// Allocation of new chunks occurs when the penultimate allocated chunk is full.
-					//     penulatimate_allocated_chunk = this->chunks_last - 2;
-					// Number of elements remaining before this->last goes into a new chunk:
-					//     current_chunk_capacity = this->last.p - this->last.last;
-					// Number of elements available before allocation:
-					//     n_remaining = current_chunk_capacity + (penultimate_allocated_chunk - this->last.c)*chunk_size
-					size_type n_remaining = (this->last.p - this->last.last) + (((this->chunks_last - 2) - this->last.c)*chunk_size);
-					
-					if( n_remaining < n )
-					{
-						this->chunks_push_back( 1 + ((n - n_remaining)/chunk_size) );
-					}
-					
-					position = this->begin() + offset;
-				}
-				
-				// Can now proceed, safe in the knowledge that no allocations will occur,
-				// and therefore, this will definitely all succeed.
-				iterator it;
-				const iterator old_end = this->end();
-				for(it = old_end - n; it != old_end; ++it)
-				{
-					this->push_back( *it );
-				}
-				for(it = old_end - 1; it >= position + n; --it)
-				{
-					*it = it[-n];
-				}
-				for(size_type i = 0; i < n; ++i)
-				{
-					position[i] = value;
-				}
-				
-				return position;
+				// The value may be an element of this deque, which is about to move.
+				const value_type copy(value);
+				return this->insert_n( position, repeat_iterator(copy), n, dstd::impl::FalseType() );
 			}
+			return this->insert_n( position, repeat_iterator(value), n, dstd::impl::FalseType() );
 		}
-
+		
+		
 		template <class InputIterator>
 		void insert_fix(iterator position, InputIterator first, InputIterator last, dstd::impl::FalseType)
 		{
-			if( position == this->begin() )
+			this->insert_n( position, first, dstd::distance(first, last), dstd::impl::FalseType() );
+		}
+		
+		
+		/// Inserts n elements, taken in turn from src, before position, and returns an iterator to the first of them.
+		/// The elements on the shorter side of position are moved out of the way, a chunk at a time, so that inserting
+		/// in the middle moves at most half the deque, and inserting at either end moves nothing.
+		/// Every chunk needed is reserved first, so that if an allocation fails the deque is unchanged.
+		/// Move is TrueType to move the elements out of src, or FalseType to copy them.
+		template <class InputIterator, class Move>
+		iterator insert_n(iterator position, InputIterator src, const size_type n, Move move)
+		{
+			const size_type before = position - this->begin();
+			const size_type after = this->size() - before;
+			if( this->chunks == 0 ) this->initialise();
+			
+			if( before < after )
 			{
-				while( first != last )
+				this->reserve_front(n);
+				const iterator old_first = this->first;
+				const iterator pos = old_first + before;
+				if( before < n )
 				{
-					--last;
-					this->push_front(*last);
+					// The elements before position move into new space, followed by the first n - before elements inserted.
+					InputIterator rest = src;
+					dstd::advance(rest, n - before);
+					this->construct_front( src, n - before, move );
+					this->construct_front( old_first, before, dstd::impl::TrueType() );
+					this->assign_n( old_first, rest, before, move );
 				}
-			}
-			else if( position == this->end() )
-			{
-				while( first != last )
+				else
 				{
-					this->push_back(*first);
-					++first;
+					this->construct_front( old_first, n, dstd::impl::TrueType() );
+					this->move_down( old_first + n, pos, old_first );
+					this->assign_n( pos - n, src, n, move );
 				}
 			}
 			else
 			{
-				const size_type n = last - first;
-				
-				// Ensure any allocation requried is done here.
-				// Then, if an exception is thrown, the deque is left in a valid state.
-				if( this->last.p + n > this->last.last )
+				this->reserve_back(n);
+				const iterator old_last = this->last;
+				const iterator pos = this->begin() + before;
+				if( after < n )
 				{
-					// Iterators can be invalidated if allocations occur.
-					// So save the iterator's offset from the start, and restore position
-					// to a valid iterator afterwards.
-					const difference_type offset = position - this->begin();
-					
-					const size_type chunk_size = dstd::impl::deque_chunk_size<value_type>();
-					
-					// Allocation of new chunks occurs when the penultimate allocated chunk is full.
-					//     penulatimate_allocated_chunk = this->chunks_last - 2;
-					// Number of elements remaining before this->last goes into a new chunk:
-					//     current_chunk_capacity = this->last.p - this->last.last;
-					// Number of elements available before allocation:
-					//     n_remaining = current_chunk_capacity + (penultimate_allocated_chunk - this->last.c)*chunk_size
-					size_type n_remaining = (this->last.p - this->last.last) + (((this->chunks_last - 2) - this->last.c)*chunk_size);
-					
-					if( n_remaining < n )
-					{
-						this->chunks_push_back( 1 + ((n - n_remaining)/chunk_size) );
-					}
-					
-					position = this->begin() + offset;
-				}
-				
-				// Can now proceed, safe in the knowledge that no allocations will occur,
-				// and therefore, this will definitely all succeed.
-				iterator it;
-				const iterator old_end = this->end();
-				for(it = old_end - n; it != old_end; ++it)
-				{
-					this->push_back( *it );
-				}
-				for(it = old_end - 1; it >= position + n; --it)
-				{
-					*it = it[-n];
+					// The last n - after elements inserted go into new space, followed by the elements after position.
+					InputIterator rest = src;
+					dstd::advance(rest, after);
+					this->construct_back( rest, n - after, move );
+					this->construct_back( pos, after, dstd::impl::TrueType() );
+					this->assign_n( pos, src, after, move );
 				}
-				for(it = position; first != last; ++first, ++it)
+				else
 				{
-					*it = *first;
+					this->construct_back( old_last - n, n, dstd::impl::TrueType() );
+					this->move_up( pos, old_last - n, old_last );
+					this->assign_n( pos, src, n, move );
 				}
 			}
+			return this->begin() + before;
 		}
 		
 	public:
@@ -421,12 +425,41 @@ class dstd::deque
 		}
 		
 		
+		iterator insert(iterator position, value_type&& value)
+		{
+			return this->emplace( position, dstd::move(value) );
+		}
+		
+		
+		/// Inserts an element constructed from args before position.
+		/// At either end the element is constructed in place; elsewhere, the elements on the shorter side of position move by one.
+		template <class... Args>
+		iterator emplace(iterator position, Args&&... args)
+		{
+			if( position == this->begin() )
+			{
+				this->emplace_front( dstd::forward<Args>(args)... );
+				return this->begin();
+			}
+			else if( position == this->end() )
+			{
+				this->emplace_back( dstd::forward<Args>(args)... );
+				return this->end() - 1;
+			}
+			
+			// The arguments may refer to elements of this deque, which are about to move.
+			value_type value( dstd::forward<Args>(args)... );
+			return this->insert_n( position, &value, 1, dstd::impl::TrueType() );
+		}
+		
+		
 		void insert(iterator position, size_type n, const value_type& value)
 		{
 			this->insert_fix( position, n, value, dstd::impl::TrueType() );
 		}
 		
 		
+		/// Inserts copies of the elements in [first,last) before position, constructing them a chunk at a time.
 		template <class InputIterator>
 		void insert (iterator position, InputIterator first, InputIterator last)
 		{
@@ -439,67 +472,34 @@ class dstd::deque
 		/// @returns An iterator pointing to the new location of the element that followed the last element erased by the function call. This is the container end if the operation erased the last element in the sequence.
 		iterator erase(iterator position)
 		{
-			if( position == this->begin() )
-			{
-				this->pop_front();
-				return this->begin();
-			}
-			else if( position == this->end() - 1 )
-			{
-				this->pop_back();
-				return this->end();
-			}
-			else
-			{
-				iterator temp(position);
-				while(position != this->end())
-				{
-					*position = position[1];
-					++position;
-				}
-				this->pop_back();
-				return temp;
-			}
+			return this->erase( position, position + 1 );
 		}
 		
 		
 		/// Removes elements in the range [first,last) from the deque.
+		/// The elements on the shorter side of the range are moved to close the gap, a chunk at a time.
 		/// @returns An iterator pointing to the new location of the element that followed the last element erased by the function call. This is the container end if the operation erased the last element in the sequence.
 		iterator erase(iterator first, iterator last)
 		{
-			if( last == this->end() )
-			{
-				while( last != first )
-				{
-					--last;
-					this->pop_back();
-				}
-				return this->end();
-			}
-			else if( first == this->begin() )
+			const size_type before = first - this->begin();
+			const size_type n = last - first;
+			const size_type after = this->end() - last;
+			if( n == 0 ) return first;
+			
+			if( before < after )
 			{
-				while( last != first )
-				{
-					++first;
-					this->pop_front();
-				}
-				return this->begin();
+				this->move_up( this->begin(), first, last );
+				this->destroy_range( this->first, this->first + n );
+				this->first += n;
 			}
 			else
 			{
-				iterator it = first;
-				while( last != this->end() )
-				{
-					*first = *last;
-					++first;
-					++last;
-				}
-				while( first != this->end() )
-				{
-					this->pop_back();
-				}
-				return it;
+				this->move_down( last, this->end(), first );
+				this->destroy_range( this->last - n, this->last );
+				this->last -= n;
 			}
+			this->release_spare_chunks();
+			return this->begin() + before;
 		}
 		
 		
@@ -511,17 +511,30 @@ class dstd::deque
 			dstd::swap( this->chunks_last, x.chunks_last );
 			dstd::swap( this->first, x.first );
 			dstd::swap( this->last, x.last );
+			dstd::swap( this->a, x.a );
 		}
 		
 		
 		void clear()
 		{
-			for(iterator it = this->begin(); it != this->end(); ++it)
-			{
-				this->a.destroy(it.p);
-			}
+			if( this->chunks == 0 ) return;
+			this->destroy_range( this->first, this->last );
 			// TODO: leave first/last in the middle of the available chunks
 			this->last = this->first;
+			this->release_spare_chunks();
+		}
+		
+		
+		/// Frees the empty chunks kept at either end, and shrinks the chunk map to hold just the chunks that remain.
+		/// Use it to return the memory taken by a burst of elements once they have been removed.
+		void shrink_to_fit()
+		{
+			if( this->chunks == 0 ) return;
+			this->chunks_pop_front( this->spare_chunks_front() );
+			this->chunks_pop_back( this->spare_chunks_back() );
+			
+			const size_type used = this->chunks_last - this->chunks_first;
+			if( used != this->chunks_capacity ) this->chunks_move(used, 0);
 		}
 		
 		
@@ -536,9 +549,9 @@ class dstd::deque
 		void initialise()
 		{
 			const size_type n_chunks = 5;
-			const size_type chunk_size = dstd::impl::deque_chunk_size<value_type>();
+			const size_type chunk_size = dstd::impl::deque_chunk_size<value_type, ChunkBytes>();
 			
-			typename Allocator::template rebind<pointer>::other a_chunks;
+			typename Allocator::template rebind<pointer>::other a_chunks(this->a);
 			this->chunks = a_chunks.allocate(n_chunks);
 			
 			for(size_type i = 0; i < n_chunks; ++i)
@@ -557,78 +570,278 @@ class dstd::deque
 		}
 		
 		
-		void chunks_expand_back()
+		class repeat_iterator;
+		
+		
+		/// Makes sure there are chunks for n more elements before the first, so that inserting them does not allocate.
+		void reserve_front(size_type n)
 		{
-			const size_type new_capacity = 2 * this->chunks_capacity;
-			
-			typename Allocator::template rebind<pointer>::other a_chunks;
-			pointer* new_chunks = a_chunks.allocate(new_capacity);
-			pointer* new_first = new_chunks + (this->chunks_first - this->chunks);
-			
-			pointer* new_p = new_first;
-			for(pointer* old_p = this->chunks_first; old_p != this->chunks_last; ++old_p)
+			const size_type chunk_size = dstd::impl::deque_chunk_size<value_type, ChunkBytes>();
+			const size_type room = (this->first.p - this->first.first) + this->spare_chunks_front() * chunk_size;
+			if( n > room ) this->chunks_push_front( (n - room + chunk_size - 1) / chunk_size );
+		}
+		
+		
+		/// Makes sure there are chunks for n more elements after the last, including the two which emplace_back keeps ready.
+		void reserve_back(size_type n)
+		{
+			const size_type chunk_size = dstd::impl::deque_chunk_size<value_type, ChunkBytes>();
+			const size_type needed = ( (this->last.p - this->last.first) + n ) / chunk_size + 3;
+			const size_type have = this->chunks_last - this->last.c;
+			if( needed > have ) this->chunks_push_back(needed - have);
+		}
+		
+		
+		template <class InputIterator>
+		void construct_from(pointer p, InputIterator& src, dstd::impl::FalseType)
+		{
+			this->a.construct( p, *src );
+		}
+		
+		
+		template <class InputIterator>
+		void construct_from(pointer p, InputIterator& src, dstd::impl::TrueType)
+		{
+			this->a.construct( p, dstd::move(*src) );
+		}
+		
+		
+		/// Constructs n elements before the first, in reserved chunks, taken in turn from src.
+		/// If a constructor throws, the new elements are destroyed and the deque is unchanged.
+		template <class InputIterator, class Move>
+		void construct_front(InputIterator src, size_type n, Move move)
+		{
+			const iterator new_first = this->first - n;
+			for(dstd::impl::segment_walker<iterator> w(new_first, this->first); ! w.done(); w.next())
 			{
-				*new_p = *old_p;
-				if( this->first.c == old_p ) this->first.c = new_p;
-				if( this->last.c  == old_p ) this->last.c  = new_p;
-				++new_p;
+				pointer p = w.begin();
+				try
+				{
+					for( ; p != w.end(); ++p, ++src) this->construct_from(p, src, move);
+				}
+				catch(...)
+				{
+					this->destroy_range( new_first, w.at(p) );
+					throw;
+				}
 			}
+			this->first = new_first;
+		}
+		
+		
+		/// Constructs n elements after the last, in reserved chunks, taken in turn from src.
+		/// If a constructor throws, the new elements are destroyed and the deque is unchanged.
+		template <class InputIterator, class Move>
+		void construct_back(InputIterator src, size_type n, Move move)
+		{
+			const iterator new_last = this->last + n;
+			for(dstd::impl::segment_walker<iterator> w(this->last, new_last); ! w.done(); w.next())
+			{
+				pointer p = w.begin();
+				try
+				{
+					for( ; p != w.end(); ++p, ++src) this->construct_from(p, src, move);
+				}
+				catch(...)
+				{
+					this->destroy_range( this->last, w.at(p) );
+					throw;
+				}
+			}
+			this->last = new_last;
+		}
+		
+		
+		/// Assigns n elements, taken in turn from src, to the elements starting at dest.
+		template <class InputIterator>
+		void assign_n(iterator dest, InputIterator src, size_type n, dstd::impl::FalseType)
+		{
+			for(dstd::impl::segment_walker<iterator> w(dest, dest + n); ! w.done(); w.next())
+			{
+				for(pointer p = w.begin(); p != w.end(); ++p, ++src) *p = *src;
+			}
+		}
+		
+		
+		template <class InputIterator>
+		void assign_n(iterator dest, InputIterator src, size_type n, dstd::impl::TrueType)
+		{
+			for(dstd::impl::segment_walker<iterator> w(dest, dest + n); ! w.done(); w.next())
+			{
+				for(pointer p = w.begin(); p != w.end(); ++p, ++src) *p = dstd::move(*src);
+			}
+		}
+		
+		
+		/// Moves the elements of [from,to) to the range starting at dest, which is not after from, first element first.
+		/// Each step moves the longest run which is contiguous in both ranges.
+		void move_down(iterator from, iterator to, iterator dest)
+		{
+			difference_type n = to - from;
+			while( n > 0 )
+			{
+				difference_type run = n;
+				if( from.last - from.p < run ) run = from.last - from.p;
+				if( dest.last - dest.p < run ) run = dest.last - dest.p;
+				for(difference_type i = 0; i != run; ++i) dest.p[i] = dstd::move( from.p[i] );
+				from += run;
+				dest += run;
+				n -= run;
+			}
+		}
+		
+		
+		/// Moves the elements of [from,to) to the range ending at dest_end, which is not before to, last element first.
+		/// Each step moves the longest run which is contiguous in both ranges.
+		void move_up(iterator from, iterator to, iterator dest_end)
+		{
+			difference_type n = to - from;
+			while( n > 0 )
+			{
+				const iterator src = to - 1;
+				const iterator dest = dest_end - 1;
+				difference_type run = n;
+				if( src.p - src.first + 1 < run ) run = src.p - src.first + 1;
+				if( dest.p - dest.first + 1 < run ) run = dest.p - dest.first + 1;
+				for(difference_type i = 0; i != run; ++i) dest.p[-i] = dstd::move( src.p[-i] );
+				to -= run;
+				dest_end -= run;
+				n -= run;
+			}
+		}
+		
+		
+		/// Destroys the elements of [from,to), a chunk at a time.
+		void destroy_range(iterator from, iterator to)
+		{
+			for(dstd::impl::segment_walker<iterator> w(from, to); ! w.done(); w.next())
+			{
+				for(pointer p = w.begin(); p != w.end(); ++p) this->a.destroy(p);
+			}
+		}
+		
+		
+		/// Frees the empty chunks at either end beyond the max_spare_chunks kept for reuse.
+		void release_spare_chunks()
+		{
+			const size_type front = this->spare_chunks_front();
+			if( front > max_spare_chunks ) this->chunks_pop_front(front - max_spare_chunks);
+			const size_type back = this->spare_chunks_back();
+			if( back > max_spare_chunks ) this->chunks_pop_back(back - max_spare_chunks);
+		}
+		
+		
+		/// The number of empty chunks kept at each end, so that a deque used as a queue reuses
+		/// the chunks it leaves at one end for the elements pushed at the other, rather than allocating new ones.
+		static const size_type max_spare_chunks = 4;
+		
+		
+		/// Returns the number of empty chunks before the first element's chunk.
+		size_type spare_chunks_front() const
+		{
+			return this->first.c - this->chunks_first;
+		}
+		
+		
+		/// Returns the number of empty chunks after the last element's chunk, beyond the two which emplace_back keeps ready.
+		size_type spare_chunks_back() const
+		{
+			const size_type after_last = this->chunks_last - this->last.c - 1;
+			return ( after_last > 2 ) ? (after_last - 2) : 0;
+		}
+		
+		
+		/// Makes room in the chunk map for n more chunks at the back, or at the front.
+		/// If the chunks in use fill no more than half of the map, they are moved to its middle. Otherwise the map grows.
+		/// Either way, the old map is freed, so a deque used as a queue keeps a map of bounded size however far its elements travel.
+		void chunks_make_room(size_type n, bool at_back)
+		{
+			const size_type used = this->chunks_last - this->chunks_first;
 			
-			this->chunks = new_chunks;
-			this->chunks_capacity = new_capacity;
-			this->chunks_first = new_first;
-			this->chunks_last = new_p;
+			size_type new_capacity = this->chunks_capacity;
+			while( used + n > new_capacity / 2 ) new_capacity *= 2;
+			
+			this->chunks_move( new_capacity, (new_capacity - used - n) / 2 + ( at_back ? 0 : n ) );
 		}
 		
 		
-		void chunks_expand_front()
+		/// Moves the chunks in use to position offset of a chunk map of new_capacity, which is the current map if its capacity is the same.
+		void chunks_move(size_type new_capacity, size_type offset)
 		{
-			const size_type new_capacity = 2 * this->chunks_capacity;
-			const difference_type offset = new_capacity - this->chunks_capacity;
+			const size_type used = this->chunks_last - this->chunks_first;
 			
-			typename Allocator::template rebind<pointer>::other a_chunks;
-			pointer* new_chunks = a_chunks.allocate(new_capacity);
-			pointer* new_first = new_chunks + offset + (this->chunks_first - this->chunks);
+			typename Allocator::template rebind<pointer>::other a_chunks(this->a);
+			pointer* new_chunks = ( new_capacity == this->chunks_capacity ) ? this->chunks : a_chunks.allocate(new_capacity);
+			pointer* new_first = new_chunks + offset;
 			
-			pointer* new_p = new_first;
-			for(pointer* old_p = this->chunks_first; old_p != this->chunks_last; ++old_p)
+			// Within the same map the old and new ranges may overlap, so copy away from the direction of travel.
+			if( new_chunks != this->chunks || new_first < this->chunks_first )
+			{
+				for(size_type i = 0; i != used; ++i) new_first[i] = this->chunks_first[i];
+			}
+			else
 			{
-				*new_p = *old_p;
-				if( this->first.c == old_p ) this->first.c = new_p;
-				if( this->last.c  == old_p ) this->last.c  = new_p;
-				++new_p;
+				for(size_type i = used; i != 0; --i) new_first[i - 1] = this->chunks_first[i - 1];
 			}
 			
-			this->chunks = new_chunks;
+			this->first.c = new_first + (this->first.c - this->chunks_first);
+			this->last.c  = new_first + (this->last.c - this->chunks_first);
+			
+			if( new_chunks != this->chunks )
+			{
+				a_chunks.deallocate( this->chunks, this->chunks_capacity );
+				this->chunks = new_chunks;
+				this->chunks_capacity = new_capacity;
+			}
 			this->chunks_first = new_first;
-			this->chunks_last = new_p;
-			this->chunks_capacity = new_capacity;
+			this->chunks_last = new_first + used;
 		}
 		
+		
+		/// Adds n chunks at the back, taking spare chunks from the front before allocating new ones.
 		void chunks_push_back(size_type n)
 		{
-			while( (this->chunks_last - this->chunks) + n > this->chunks_capacity )
+			if( (this->chunks_last - this->chunks) + n > this->chunks_capacity )
 			{
-				this->chunks_expand_back();
+				this->chunks_make_room(n, true);
 			}
 			
 			for(size_type i = 0; i < n; ++i)
 			{
-				*(this->chunks_last) = this->a.allocate( dstd::impl::deque_chunk_size<value_type>() );
+				if( this->spare_chunks_front() > 0 )
+				{
+					*(this->chunks_last) = *(this->chunks_first);
+					++(this->chunks_first);
+				}
+				else
+				{
+					*(this->chunks_last) = this->a.allocate( dstd::impl::deque_chunk_size<value_type, ChunkBytes>() );
+				}
 				++(this->chunks_last);
 			}
 		}
 		
+		
+		/// Adds n chunks at the front, taking spare chunks from the back before allocating new ones.
 		void chunks_push_front(size_type n)
 		{
-			while( this->chunks + n > this->chunks_first )
+			if( static_cast<size_type>(this->chunks_first - this->chunks) < n )
 			{
-				this->chunks_expand_front();
+				this->chunks_make_room(n, false);
 			}
 			
 			for(size_type i = 0; i < n; ++i)
 			{
-				pointer new_chunk = this->a.allocate( dstd::impl::deque_chunk_size<value_type>() );
+				pointer new_chunk;
+				if( this->spare_chunks_back() > 0 )
+				{
+					--(this->chunks_last);
+					new_chunk = *(this->chunks_last);
+				}
+				else
+				{
+					new_chunk = this->a.allocate( dstd::impl::deque_chunk_size<value_type, ChunkBytes>() );
+				}
 				--(this->chunks_first);
 				*(this->chunks_first) = new_chunk;
 			}
@@ -639,7 +852,7 @@ class dstd::deque
 			for(size_type i = 0; i < n; ++i)
 			{
 				--(this->chunks_last);
-				this->a.deallocate( this->chunks_last );
+				this->a.deallocate( *(this->chunks_last), dstd::impl::deque_chunk_size<value_type, ChunkBytes>() );
 			}
 		}
 		
@@ -648,7 +861,7 @@ class dstd::deque
 		{
 			for(size_type i = 0; i < n; ++i)
 			{
-				this->a.deallocate( this->chunks_first );
+				this->a.deallocate( *(this->chunks_first), dstd::impl::deque_chunk_size<value_type, ChunkBytes>() );
 				++(this->chunks_first);
 			}
 		}
@@ -667,14 +880,14 @@ class dstd::deque
 //
 // Deque: Relational Operators
 
-template <class T>
-bool operator== (const dstd::deque<T>& lhs, const dstd::deque<T>& rhs)
+template <class T, class Allocator, size_t ChunkBytes>
+bool operator== (const dstd::deque<T, Allocator, ChunkBytes>& lhs, const dstd::deque<T, Allocator, ChunkBytes>& rhs)
 {
 	if( lhs.size() != rhs.size() ) return false;
-	typename dstd::deque<T>::const_iterator lhs_it = lhs.begin();
-	typename dstd::deque<T>::const_iterator rhs_it = rhs.begin();
-	typename dstd::deque<T>::const_iterator lhs_end = lhs.end();
-	typename dstd::deque<T>::const_iterator rhs_end = rhs.end();
+	typename dstd::deque<T, Allocator, ChunkBytes>::const_iterator lhs_it = lhs.begin();
+	typename dstd::deque<T, Allocator, ChunkBytes>::const_iterator rhs_it = rhs.begin();
+	typename dstd::deque<T, Allocator, ChunkBytes>::const_iterator lhs_end = lhs.end();
+	typename dstd::deque<T, Allocator, ChunkBytes>::const_iterator rhs_end = rhs.end();
 	while( lhs_it != lhs_end )
 	{
 		if( *lhs_it != *rhs_it ) return false;
@@ -685,20 +898,20 @@ bool operator== (const dstd::deque<T>& lhs, const dstd::deque<T>& rhs)
 }
 
 
-template <class T>
-bool operator!= (const dstd::deque<T>& lhs, const dstd::deque<T>& rhs)
+template <class T, class Allocator, size_t ChunkBytes>
+bool operator!= (const dstd::deque<T, Allocator, ChunkBytes>& lhs, const dstd::deque<T, Allocator, ChunkBytes>& rhs)
 {
 	return ! (lhs == rhs);
 }
 
 
-template <class T>
-bool operator< (const dstd::deque<T>& lhs, const dstd::deque<T>& rhs)
+template <class T, class Allocator, size_t ChunkBytes>
+bool operator< (const dstd::deque<T, Allocator, ChunkBytes>& lhs, const dstd::deque<T, Allocator, ChunkBytes>& rhs)
 {
-	typename dstd::deque<T>::const_iterator lhs_it = lhs.begin();
-	typename dstd::deque<T>::const_iterator rhs_it = rhs.begin();
-	typename dstd::deque<T>::const_iterator lhs_end = lhs.end();
-	typename dstd::deque<T>::const_iterator rhs_end = rhs.end();
+	typename dstd::deque<T, Allocator, ChunkBytes>::const_iterator lhs_it = lhs.begin();
+	typename dstd::deque<T, Allocator, ChunkBytes>::const_iterator rhs_it = rhs.begin();
+	typename dstd::deque<T, Allocator, ChunkBytes>::const_iterator lhs_end = lhs.end();
+	typename dstd::deque<T, Allocator, ChunkBytes>::const_iterator rhs_end = rhs.end();
 	while( lhs_it != lhs_end && rhs_it != rhs_end )
 	{
 		if( *lhs_it < *rhs_it ) return true;
@@ -712,13 +925,13 @@ bool operator< (const dstd::deque<T>& lhs, const dstd::deque<T>& rhs)
 }
 
 
-template <class T>
-bool operator<= (const dstd::deque<T>& lhs, const dstd::deque<T>& rhs)
+template <class T, class Allocator, size_t ChunkBytes>
+bool operator<= (const dstd::deque<T, Allocator, ChunkBytes>& lhs, const dstd::deque<T, Allocator, ChunkBytes>& rhs)
 {
-	typename dstd::deque<T>::const_iterator lhs_it = lhs.begin();
-	typename dstd::deque<T>::const_iterator rhs_it = rhs.begin();
-	typename dstd::deque<T>::const_iterator lhs_end = lhs.end();
-	typename dstd::deque<T>::const_iterator rhs_end = rhs.end();
+	typename dstd::deque<T, Allocator, ChunkBytes>::const_iterator lhs_it = lhs.begin();
+	typename dstd::deque<T, Allocator, ChunkBytes>::const_iterator rhs_it = rhs.begin();
+	typename dstd::deque<T, Allocator, ChunkBytes>::const_iterator lhs_end = lhs.end();
+	typename dstd::deque<T, Allocator, ChunkBytes>::const_iterator rhs_end = rhs.end();
 	while( lhs_it != lhs_end && rhs_it != rhs_end )
 	{
 		if( *lhs_it < *rhs_it ) return true;
@@ -731,15 +944,15 @@ bool operator<= (const dstd::deque<T>& lhs, const dstd::deque<T>& rhs)
 }
 
 
-template <class T>
-bool operator> (const dstd::deque<T>& lhs, const dstd::deque<T>& rhs)
+template <class T, class Allocator, size_t ChunkBytes>
+bool operator> (const dstd::deque<T, Allocator, ChunkBytes>& lhs, const dstd::deque<T, Allocator, ChunkBytes>& rhs)
 {
 	return ! (lhs <= rhs);
 }
 
 
-template <class T>
-bool operator>= (const dstd::deque<T>& lhs, const dstd::deque<T>& rhs)
+template <class T, class Allocator, size_t ChunkBytes>
+bool operator>= (const dstd::deque<T, Allocator, ChunkBytes>& lhs, const dstd::deque<T, Allocator, ChunkBytes>& rhs)
 {
 	return ! (lhs < rhs);
 }
@@ -749,8 +962,8 @@ bool operator>= (const dstd::deque<T>& lhs, const dstd::deque<T>& rhs)
 //
 // Deque: Swap
 
-template <class T, class Allocator>
-void dstd::swap(dstd::deque<T,Allocator>& d1, dstd::deque<T,Allocator>& d2)
+template <class T, class Allocator, size_t ChunkBytes>
+void dstd::swap(dstd::deque<T,Allocator,ChunkBytes>& d1, dstd::deque<T,Allocator,ChunkBytes>& d2)
 {
 	d1.swap(d2);
 }
@@ -761,16 +974,16 @@ void dstd::swap(dstd::deque<T,Allocator>& d1, dstd::deque<T,Allocator>& d2)
 // Iterators
 
 
-template <class T, class Allocator>
-class dstd::deque<T, Allocator>::iterator
+template <class T, class Allocator, size_t ChunkBytes>
+class dstd::deque<T, Allocator, ChunkBytes>::iterator
 {
 	public:
 		
-		typedef typename dstd::deque<T, Allocator>::value_type value_type;
-		typedef typename dstd::deque<T, Allocator>::reference reference;
-		typedef typename dstd::deque<T, Allocator>::pointer pointer;
-		typedef typename dstd::deque<T, Allocator>::size_type size_type;
-		typedef typename dstd::deque<T, Allocator>::difference_type difference_type;
+		typedef typename dstd::deque<T, Allocator, ChunkBytes>::value_type value_type;
+		typedef typename dstd::deque<T, Allocator, ChunkBytes>::reference reference;
+		typedef typename dstd::deque<T, Allocator, ChunkBytes>::pointer pointer;
+		typedef typename dstd::deque<T, Allocator, ChunkBytes>::size_type size_type;
+		typedef typename dstd::deque<T, Allocator, ChunkBytes>::difference_type difference_type;
 		
 		// constructors
 		iterator() : c(0), first(0), last(0), p(0) {}
@@ -808,7 +1021,7 @@ class dstd::deque<T, Allocator>::iterator
 			}
 			else
 			{
-				const size_type chunk_size = dstd::impl::deque_chunk_size<value_type>();
+				const size_type chunk_size = dstd::impl::deque_chunk_size<value_type, ChunkBytes>();
 				
 				if( n > 0 )
 				{
@@ -820,8 +1033,17 @@ class dstd::deque<T, Allocator>::iterator
 				{
 					n = -n;
 					n -= (this->p - this->first);
-					this->set_chunk( this->c - (1 + (n / chunk_size)) );
-					this->p = this->last - (n % chunk_size);
+					if( n % chunk_size == 0 )
+					{
+						// a whole number of chunks back lands on the first element of a chunk, not past the end of the one before
+						this->set_chunk( this->c - (n / chunk_size) );
+						this->p = this->first;
+					}
+					else
+					{
+						this->set_chunk( this->c - (1 + (n / chunk_size)) );
+						this->p = this->last - (n % chunk_size);
+					}
 				}
 			}
 			return *this;
@@ -832,7 +1054,7 @@ class dstd::deque<T, Allocator>::iterator
 		// addition/subtraction with iterators
 		difference_type operator- (const iterator& x) const
 		{
-			return ((this->c - x.c)*dstd::impl::deque_chunk_size<value_type>()) + (this->p - this->first) - (x.p - x.first);
+			return ((this->c - x.c)*dstd::impl::deque_chunk_size<value_type, ChunkBytes>()) + (this->p - this->first) - (x.p - x.first);
 		}
 		// comparison operators
 		bool operator== (const iterator& x) const { return (this->p == x.p); }
@@ -841,6 +1063,15 @@ class dstd::deque<T, Allocator>::iterator
 		bool operator>  (const iterator& x) const { return ( (this->c >= x.c) && ( (this->c > x.c) || (this->p > x.p) ) ); }
 		bool operator<= (const iterator& x) const { return ! ( *this > x ); }
 		bool operator>= (const iterator& x) const { return ! ( *this < x ); }
+
+		// segmented iteration, for the algorithms (see impl::segmented_iterator_traits)
+		typedef pointer* segment_iterator;
+		typedef pointer local_iterator;
+		segment_iterator segment() const { return this->c; }
+		local_iterator local() const { return this->p; }
+		static local_iterator segment_begin(segment_iterator s) { return *s; }
+		static local_iterator segment_end(segment_iterator s) { return *s + dstd::impl::deque_chunk_size<value_type, ChunkBytes>(); }
+		static iterator compose(segment_iterator s, local_iterator l) { iterator it; it.set_chunk(s); it.p = l; return it; }
 	
 	
 	private:
@@ -849,7 +1080,7 @@ class dstd::deque<T, Allocator>::iterator
 		{
 			this->c = new_chunk;
 			this->first = *(this->c);
-			this->last = this->first + dstd::impl::deque_chunk_size<value_type>();
+			this->last = this->first + dstd::impl::deque_chunk_size<value_type, ChunkBytes>();
 		}
 		
 		pointer* c; // pointer to current chunk
@@ -858,21 +1089,21 @@ class dstd::deque<T, Allocator>::iterator
 		pointer p; // current element in current chunk
 	
 	
-	friend class dstd::deque<T, Allocator>;
+	friend class dstd::deque<T, Allocator, ChunkBytes>;
 };
 
 
 
-template <class T, class Allocator>
-class dstd::deque<T, Allocator>::const_iterator
+template <class T, class Allocator, size_t ChunkBytes>
+class dstd::deque<T, Allocator, ChunkBytes>::const_iterator
 {	
 	public:
 		
-		typedef const typename dstd::deque<T, Allocator>::value_type value_type;
-		typedef typename dstd::deque<T, Allocator>::const_reference reference;
-		typedef typename dstd::deque<T, Allocator>::const_pointer pointer;
-		typedef typename dstd::deque<T, Allocator>::size_type size_type;
-		typedef typename dstd::deque<T, Allocator>::difference_type difference_type;
+		typedef const typename dstd::deque<T, Allocator, ChunkBytes>::value_type value_type;
+		typedef typename dstd::deque<T, Allocator, ChunkBytes>::const_reference reference;
+		typedef typename dstd::deque<T, Allocator, ChunkBytes>::const_pointer pointer;
+		typedef typename dstd::deque<T, Allocator, ChunkBytes>::size_type size_type;
+		typedef typename dstd::deque<T, Allocator, ChunkBytes>::difference_type difference_type;
 		
 		// constructors
 		const_iterator() : c(0), first(0), last(0), p(0) {}
@@ -916,7 +1147,7 @@ class dstd::deque<T, Allocator>::const_iterator
 			}
 			else
 			{
-				const size_type chunk_size = dstd::impl::deque_chunk_size<value_type>();
+				const size_type chunk_size = dstd::impl::deque_chunk_size<value_type, ChunkBytes>();
 				
 				if( n > 0 )
 				{
@@ -928,8 +1159,17 @@ class dstd::deque<T, Allocator>::const_iterator
 				{
 					n = -n;
 					n -= (this->p - this->first);
-					this->set_chunk( this->c - (1 + (n / chunk_size)) );
-					this->p = this->last - (n % chunk_size);
+					if( n % chunk_size == 0 )
+					{
+						// a whole number of chunks back lands on the first element of a chunk, not past the end of the one before
+						this->set_chunk( this->c - (n / chunk_size) );
+						this->p = this->first;
+					}
+					else
+					{
+						this->set_chunk( this->c - (1 + (n / chunk_size)) );
+						this->p = this->last - (n % chunk_size);
+					}
 				}
 			}
 			return *this;
@@ -940,7 +1180,7 @@ class dstd::deque<T, Allocator>::const_iterator
 		// addition/subtraction with iterators
 		difference_type operator- (const const_iterator& x) const
 		{
-			return ((this->c - x.c)*dstd::impl::deque_chunk_size<value_type>()) + (this->p - this->first) - (x.p - x.first);
+			return ((this->c - x.c)*dstd::impl::deque_chunk_size<value_type, ChunkBytes>()) + (this->p - this->first) - (x.p - x.first);
 		}
 		// comparison operators
 		bool operator== (const const_iterator& x) const { return (this->p == x.p); }
@@ -949,6 +1189,15 @@ class dstd::deque<T, Allocator>::const_iterator
 		bool operator>  (const const_iterator& x) const { return ( (this->c >= x.c) && ( (this->c > x.c) || (this->p > x.p) ) ); }
 		bool operator<= (const const_iterator& x) const { return ! ( *this > x ); }
 		bool operator>= (const const_iterator& x) const { return ! ( *this < x ); }
+
+		// segmented iteration, for the algorithms (see impl::segmented_iterator_traits)
+		typedef pointer const* segment_iterator;
+		typedef pointer local_iterator;
+		segment_iterator segment() const { return this->c; }
+		local_iterator local() const { return this->p; }
+		static local_iterator segment_begin(segment_iterator s) { return *s; }
+		static local_iterator segment_end(segment_iterator s) { return *s + dstd::impl::deque_chunk_size<value_type, ChunkBytes>(); }
+		static const_iterator compose(segment_iterator s, local_iterator l) { const_iterator it; it.set_chunk(s); it.p = l; return it; }
 	
 	
 	private:
@@ -957,7 +1206,7 @@ class dstd::deque<T, Allocator>::const_iterator
 		{
 			this->c = new_chunk;
 			this->first = *(this->c);
-			this->last = this->first + dstd::impl::deque_chunk_size<value_type>();
+			this->last = this->first + dstd::impl::deque_chunk_size<value_type, ChunkBytes>();
 		}
 		
 		pointer const* c; // pointer to current chunk
@@ -966,7 +1215,30 @@ class dstd::deque<T, Allocator>::const_iterator
 		pointer p; // current element in current chunk
 	
 	
-	friend class dstd::deque<T, Allocator>;
+	friend class dstd::deque<T, Allocator, ChunkBytes>;
+};
+
+
+
+/// An endless sequence of copies of one value, so that inserting n copies of a value shares the code which inserts a range.
+template <class T, class Allocator, size_t ChunkBytes>
+class dstd::deque<T, Allocator, ChunkBytes>::repeat_iterator
+{
+	public:
+		
+		explicit repeat_iterator(const value_type& x) : v(&x) {}
+		
+		const value_type& operator* () const { return *(this->v); }
+		repeat_iterator& operator++ () { return *this; }
+		repeat_iterator& operator+= (difference_type /*n*/) { return *this; }
+		difference_type operator- (const repeat_iterator& /*x*/) const { return 0; }
+	
+	
+	private:
+		
+		const value_type* v;
 };
 
+
+
 #endif
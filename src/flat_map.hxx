@@ -0,0 +1,337 @@
+#ifndef DSTD_FLAT_MAP_HXX
+#define DSTD_FLAT_MAP_HXX
+
+
+
+#include "impl/flat_tree.hxx"
+
+#include "exception.hxx"
+#include "functional.hxx"
+#include "memory.hxx"
+#include "utility.hxx"
+
+
+
+namespace dstd
+{
+	template < class Key, class T, class Compare = dstd::less<Key>, class Allocator = dstd::allocator< dstd::pair<Key, T> > > class flat_map;
+	template < class Key, class T, class Compare = dstd::less<Key>, class Allocator = dstd::allocator< dstd::pair<Key, T> > > class flat_multimap;
+
+	template <class Key, class T, class Compare, class Allocator> void swap(flat_map<Key, T, Compare, Allocator>& lhs, flat_map<Key, T, Compare, Allocator>& rhs);
+	template <class Key, class T, class Compare, class Allocator> void swap(flat_multimap<Key, T, Compare, Allocator>& lhs, flat_multimap<Key, T, Compare, Allocator>& rhs);
+}
+
+
+
+//
+// dstd::flat_map
+//
+// An ordered map with the same lookup interface as dstd::map, stored as a sorted vector of pairs.
+// It is best built in one go, from a range or with the sorted_unique constructor, and then only read.
+// Inserting or erasing an element invalidates all iterators after it, or all of them if the vector grows.
+
+template < class Key, class T, class Compare, class Allocator >
+class dstd::flat_map : public dstd::impl::flat_tree<Key, dstd::pair<Key, T>, dstd::impl::select_first< dstd::pair<Key, T> >, Compare, Allocator, false>
+{
+	private:
+
+		typedef dstd::impl::flat_tree<Key, dstd::pair<Key, T>, dstd::impl::select_first< dstd::pair<Key, T> >, Compare, Allocator, false> flat_tree;
+
+	public:
+
+		typedef typename flat_tree::key_type key_type;
+		typedef T mapped_type;
+		typedef typename flat_tree::value_type value_type;
+		typedef typename flat_tree::key_compare key_compare;
+		typedef typename flat_tree::value_compare value_compare;
+		typedef typename flat_tree::size_type size_type;
+		typedef typename flat_tree::difference_type difference_type;
+		typedef typename flat_tree::allocator_type allocator_type;
+		typedef typename flat_tree::iterator iterator;
+		typedef typename flat_tree::const_iterator const_iterator;
+		typedef typename flat_tree::reverse_iterator reverse_iterator;
+		typedef typename flat_tree::const_reverse_iterator const_reverse_iterator;
+
+
+		//
+		// Contructors
+
+
+		/// Constructs an empty map with no elements.
+		explicit flat_map(const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: flat_tree(compare, alloc)
+		{}
+
+
+		/// Constructs a map with as many elements as the range [first,last),
+		/// with each element constructed from its corresponding element in that range.
+		/// Of elements with equivalent keys, only the first is inserted.
+		template <class RandomIterator>
+		flat_map(RandomIterator first, RandomIterator last, const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: flat_tree(compare, alloc)
+		{
+			this->insert_bulk(first, last);
+		}
+
+
+		/// Constructs a map from the range [first,last), which must be sorted and hold no equivalent keys.
+		/// The elements are copied without any comparisons.
+		template <class RandomIterator>
+		flat_map(dstd::sorted_unique_t, RandomIterator first, RandomIterator last, const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: flat_tree(compare, alloc)
+		{
+			this->insert_bulk_sorted(first, last);
+		}
+
+
+		/// Copy constructor. Constructs a map with a copy of each of the elements in x.
+		flat_map(const flat_map& x)
+			: flat_tree(x)
+		{}
+
+
+		virtual ~flat_map() {}
+
+
+		flat_map& operator= (const flat_map& x)
+		{
+			flat_tree::operator=(x);
+			return *this;
+		}
+
+
+		//
+		// Element Access
+
+
+		/// Access the mapped value of an element with key k.
+		/// If k does not match the key of any element in the container,
+		/// the function inserts a new element with that key and returns a reference to its mapped value.
+		mapped_type& operator[] (const key_type& k)
+		{
+			iterator it = this->lower_bound(k);
+			if( it == this->end() || this->key_comp()(k, it->first) )
+			{
+				it = this->insert_value( it, 1, value_type(k, mapped_type()) );
+			}
+			return it->second;
+		}
+
+
+		/// Access the mapped value of the element with key k.
+		/// Throws out_of_range if there is no such element.
+		mapped_type& at(const key_type& k)
+		{
+			iterator it = this->find(k);
+			if( it == this->end() ) throw dstd::out_of_range();
+			return it->second;
+		}
+		const mapped_type& at(const key_type& k) const
+		{
+			const_iterator it = this->find(k);
+			if( it == this->end() ) throw dstd::out_of_range();
+			return it->second;
+		}
+
+
+		//
+		// Modifiers
+
+
+		/// Extends the container by inserting a new element, if no element with an equivalent key already exists.
+		/// @returns A pair, with its first member an iterator pointing to either the newly inserted
+		/// element or to the element with an equivalent key already in the map,
+		/// and its second member set to true if a new element was inserted.
+		dstd::pair<iterator, bool> insert(const value_type& value)
+		{
+			return this->insert_unique(value);
+		}
+
+
+		/// Extends the container by inserting a new element, if no element with an equivalent key already exists.
+		/// If the element belongs immediately before position, the map is not searched.
+		iterator insert(iterator position, const value_type& value)
+		{
+			return this->insert_unique(position, value);
+		}
+
+
+		/// Extends the container by copying elements in the range [first,last),
+		/// which are sorted and merged into the map in bulk.
+		template <class RandomIterator>
+		void insert(RandomIterator first, RandomIterator last)
+		{
+			this->insert_bulk(first, last);
+		}
+
+
+		/// Extends the container by merging in the elements in the range [first,last),
+		/// which must be sorted and hold no equivalent keys.
+		template <class RandomIterator>
+		void insert(dstd::sorted_unique_t, RandomIterator first, RandomIterator last)
+		{
+			this->insert_bulk_sorted(first, last);
+		}
+
+
+		/// Exchanges the content of the container by the content of x.
+		void swap(flat_map& x) { flat_tree::swap(x); }
+};
+
+
+
+//
+// dstd::flat_multimap
+
+template < class Key, class T, class Compare, class Allocator >
+class dstd::flat_multimap : public dstd::impl::flat_tree<Key, dstd::pair<Key, T>, dstd::impl::select_first< dstd::pair<Key, T> >, Compare, Allocator, true>
+{
+	private:
+
+		typedef dstd::impl::flat_tree<Key, dstd::pair<Key, T>, dstd::impl::select_first< dstd::pair<Key, T> >, Compare, Allocator, true> flat_tree;
+
+	public:
+
+		typedef typename flat_tree::key_type key_type;
+		typedef T mapped_type;
+		typedef typename flat_tree::value_type value_type;
+		typedef typename flat_tree::key_compare key_compare;
+		typedef typename flat_tree::value_compare value_compare;
+		typedef typename flat_tree::size_type size_type;
+		typedef typename flat_tree::difference_type difference_type;
+		typedef typename flat_tree::allocator_type allocator_type;
+		typedef typename flat_tree::iterator iterator;
+		typedef typename flat_tree::const_iterator const_iterator;
+		typedef typename flat_tree::reverse_iterator reverse_iterator;
+		typedef typename flat_tree::const_reverse_iterator const_reverse_iterator;
+
+
+		//
+		// Contructors
+
+
+		/// Constructs an empty map with no elements.
+		explicit flat_multimap(const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: flat_tree(compare, alloc)
+		{}
+
+
+		/// Constructs a map with as many elements as the range [first,last),
+		/// with each element constructed from its corresponding element in that range.
+		template <class RandomIterator>
+		flat_multimap(RandomIterator first, RandomIterator last, const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: flat_tree(compare, alloc)
+		{
+			this->insert_bulk(first, last);
+		}
+
+
+		/// Constructs a map from the range [first,last), which must be sorted.
+		/// The elements are copied without any comparisons.
+		template <class RandomIterator>
+		flat_multimap(dstd::sorted_equivalent_t, RandomIterator first, RandomIterator last, const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: flat_tree(compare, alloc)
+		{
+			this->insert_bulk_sorted(first, last);
+		}
+
+
+		/// Copy constructor. Constructs a map with a copy of each of the elements in x.
+		flat_multimap(const flat_multimap& x)
+			: flat_tree(x)
+		{}
+
+
+		virtual ~flat_multimap() {}
+
+
+		flat_multimap& operator= (const flat_multimap& x)
+		{
+			flat_tree::operator=(x);
+			return *this;
+		}
+
+
+		//
+		// Modifiers
+
+
+		/// Extends the container by inserting a new element after any elements with an equivalent key.
+		/// @returns An iterator to the newly inserted element.
+		iterator insert(const value_type& value)
+		{
+			return this->insert_equal(value);
+		}
+
+
+		/// Extends the container by inserting a new element.
+		/// If the element belongs immediately before position, the map is not searched.
+		iterator insert(iterator position, const value_type& value)
+		{
+			return this->insert_equal(position, value);
+		}
+
+
+		/// Extends the container by copying elements in the range [first,last),
+		/// which are sorted and merged into the map in bulk.
+		template <class RandomIterator>
+		void insert(RandomIterator first, RandomIterator last)
+		{
+			this->insert_bulk(first, last);
+		}
+
+
+		/// Extends the container by merging in the elements in the sorted range [first,last).
+		template <class RandomIterator>
+		void insert(dstd::sorted_equivalent_t, RandomIterator first, RandomIterator last)
+		{
+			this->insert_bulk_sorted(first, last);
+		}
+
+
+		/// Exchanges the content of the container by the content of x.
+		void swap(flat_multimap& x) { flat_tree::swap(x); }
+};
+
+
+
+template <class Key, class T, class Compare, class Allocator>
+bool operator==(const dstd::flat_map<Key, T, Compare, Allocator>& a, const dstd::flat_map<Key, T, Compare, Allocator>& b)
+{
+	if( a.size() != b.size() ) return false;
+	typename dstd::flat_map<Key, T, Compare, Allocator>::const_iterator a_it = a.begin();
+	typename dstd::flat_map<Key, T, Compare, Allocator>::const_iterator b_it = b.begin();
+	for( ; a_it != a.end(); ++a_it, ++b_it)
+	{
+		if( *a_it != *b_it ) return false;
+	}
+	return true;
+}
+
+
+
+template <class Key, class T, class Compare, class Allocator>
+bool operator!=(const dstd::flat_map<Key, T, Compare, Allocator>& a, const dstd::flat_map<Key, T, Compare, Allocator>& b)
+{
+	return ! (a == b);
+}
+
+
+
+template <class Key, class T, class Compare, class Allocator>
+void dstd::swap(dstd::flat_map<Key, T, Compare, Allocator>& lhs, dstd::flat_map<Key, T, Compare, Allocator>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+
+
+template <class Key, class T, class Compare, class Allocator>
+void dstd::swap(dstd::flat_multimap<Key, T, Compare, Allocator>& lhs, dstd::flat_multimap<Key, T, Compare, Allocator>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef DSTD_FLAT_SET_HXX
+#define DSTD_FLAT_SET_HXX
+
+
+
+#include "impl/flat_tree.hxx"
+
+#include "functional.hxx"
+#include "memory.hxx"
+#include "utility.hxx"
+
+
+
+namespace dstd
+{
+	template < class T, class Compare = dstd::less<T>, class Allocator = dstd::allocator<T> > class flat_set;
+
+	template <class T, class Compare, class Allocator> void swap(flat_set<T, Compare, Allocator>& lhs, flat_set<T, Compare, Allocator>& rhs);
+}
+
+
+
+//
+// dstd::flat_set
+//
+// An ordered set with the same lookup interface as dstd::set, stored as a sorted vector.
+// Inserting or erasing an element invalidates all iterators after it, or all of them if the vector grows.
+
+template <class T, class Compare, class Allocator>
+class dstd::flat_set : public dstd::impl::flat_tree<T, T, dstd::impl::identity<T>, Compare, Allocator, false>
+{
+	private:
+
+		typedef dstd::impl::flat_tree<T, T, dstd::impl::identity<T>, Compare, Allocator, false> flat_tree;
+
+	public:
+
+		typedef typename flat_tree::key_type key_type;
+		typedef typename flat_tree::value_type value_type;
+		typedef typename flat_tree::key_compare key_compare;
+		typedef typename flat_tree::value_compare value_compare;
+		typedef typename flat_tree::size_type size_type;
+		typedef typename flat_tree::difference_type difference_type;
+		typedef typename flat_tree::allocator_type allocator_type;
+		typedef typename flat_tree::iterator iterator;
+		typedef typename flat_tree::const_iterator const_iterator;
+		typedef typename flat_tree::reverse_iterator reverse_iterator;
+		typedef typename flat_tree::const_reverse_iterator const_reverse_iterator;
+
+
+		//
+		// Constructors
+
+
+		/// Constructs an empty set with no elements.
+		explicit flat_set(const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: flat_tree(compare, alloc)
+		{}
+
+
+		/// Constructs a set with as many elements as the range [first,last),
+		/// with each element constructed from its corresponding element in that range.
+		template <class RandomIterator>
+		flat_set(RandomIterator first, RandomIterator last, const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: flat_tree(compare, alloc)
+		{
+			this->insert_bulk(first, last);
+		}
+
+
+		/// Constructs a set from the range [first,last), which must be sorted and hold no equivalent values.
+		template <class RandomIterator>
+		flat_set(dstd::sorted_unique_t, RandomIterator first, RandomIterator last, const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: flat_tree(compare, alloc)
+		{
+			this->insert_bulk_sorted(first, last);
+		}
+
+
+		/// Copy constructor. Constructs a set with a copy of each of the elements in x.
+		flat_set(const flat_set& x)
+			: flat_tree(x)
+		{}
+
+
+		virtual ~flat_set() {}
+
+
+		flat_set& operator= (const flat_set& x)
+		{
+			flat_tree::operator=(x);
+			return *this;
+		}
+
+
+		//
+		// Modifiers
+
+
+		dstd::pair<iterator, bool> insert(const value_type& value) { return this->insert_unique(value); }
+
+
+		/// If value belongs immediately before position, the set is not searched.
+		iterator insert(iterator position, const value_type& value) { return this->insert_unique(position, value); }
+
+
+		template <class RandomIterator>
+		void insert(RandomIterator first, RandomIterator last) { this->insert_bulk(first, last); }
+
+
+		template <class RandomIterator>
+		void insert(dstd::sorted_unique_t, RandomIterator first, RandomIterator last) { this->insert_bulk_sorted(first, last); }
+
+
+		void swap(flat_set& x) { flat_tree::swap(x); }
+};
+
+
+
+template <class T, class Compare, class Allocator>
+bool operator==(const dstd::flat_set<T, Compare, Allocator>& a, const dstd::flat_set<T, Compare, Allocator>& b)
+{
+	if( a.size() != b.size() ) return false;
+	typename dstd::flat_set<T, Compare, Allocator>::const_iterator a_it = a.begin();
+	typename dstd::flat_set<T, Compare, Allocator>::const_iterator b_it = b.begin();
+	for( ; a_it != a.end(); ++a_it, ++b_it)
+	{
+		if( *a_it != *b_it ) return false;
+	}
+	return true;
+}
+
+
+
+template <class T, class Compare, class Allocator>
+bool operator!=(const dstd::flat_set<T, Compare, Allocator>& a, const dstd::flat_set<T, Compare, Allocator>& b)
+{
+	return ! (a == b);
+}
+
+
+
+template <class T, class Compare, class Allocator>
+void dstd::swap(dstd::flat_set<T, Compare, Allocator>& lhs, dstd::flat_set<T, Compare, Allocator>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+
+
+#endif
@@ -3,6 +3,14 @@
 
 
 
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "cstddef.hxx"
+
+
+
 namespace dstd
 {
 	//
@@ -24,8 +32,138 @@ namespace dstd
 				return (a < b);
 			}
 	};
-	
-	
+
+
+	template <class T>
+	class equal_to
+	{
+		public:
+
+			bool operator() (const T& a, const T& b) const
+			{
+				return (a == b);
+			}
+	};
+
+
+	//
+	// Hash functions
+
+
+	/// Hashes integral and enumeration types by their value.
+	/// The hashed containers mix the bits of the result themselves, so this need not be well distributed.
+	/// Other types need a specialisation of their own.
+	template <class T>
+	class hash
+	{
+		public:
+
+			static_assert( std::is_integral<T>::value || std::is_enum<T>::value, "dstd::hash: no hash is defined for this type; specialise dstd::hash for it" );
+
+			size_t operator() (const T& x) const
+			{
+				return static_cast<size_t>(x);
+			}
+	};
+
+
+	namespace impl
+	{
+		/// Hashes a floating point value by its bits, rather than by its truncated value.
+		/// 0.0 and -0.0 compare equal, so both hash to 0.
+		template <class Float>
+		class float_hash
+		{
+			public:
+
+				size_t operator() (Float x) const
+				{
+					if( x == 0 ) return 0;
+					unsigned char bytes[sizeof(Float)];
+					std::memcpy(bytes, &x, sizeof(Float));
+					// long double may have padding bytes, so only the bytes of its value are hashed
+					const size_t n = ( sizeof(Float) > 10 && std::numeric_limits<Float>::digits == 64 ) ? 10 : sizeof(Float);
+					size_t h = 0;
+					for(size_t i = 0; i < n; i += sizeof(size_t))
+					{
+						size_t word = 0;
+						std::memcpy(&word, bytes + i, ( n - i < sizeof(size_t) ) ? n - i : sizeof(size_t));
+						h = h * 31 + word;
+					}
+					return h;
+				}
+		};
+	}
+
+
+	template <>
+	class hash<float> : public dstd::impl::float_hash<float>
+	{};
+
+
+	template <>
+	class hash<double> : public dstd::impl::float_hash<double>
+	{};
+
+
+	template <>
+	class hash<long double> : public dstd::impl::float_hash<long double>
+	{};
+
+
+	/// Strings are hashed by their characters; the specialisation is defined in string.hxx.
+	template <class Character, class Traits, class Allocator> class basic_string;
+	template <class Character, class Traits, class Allocator> class hash< basic_string<Character, Traits, Allocator> >;
+
+
+	/// Hashes pointers by their address.
+	template <class T>
+	class hash<T*>
+	{
+		public:
+
+			size_t operator() (T* p) const
+			{
+				return reinterpret_cast<size_t>(p);
+			}
+	};
+
+
+	namespace impl
+	{
+		//
+		// Key extraction, used by containers which store their keys inside their values
+		
+		
+		/// Returns the first member of a pair, i.e. the key of a map's value_type.
+		template <class Pair>
+		class select_first
+		{
+			public:
+			
+				typedef typename Pair::first_type result_type;
+				
+				const result_type& operator() (const Pair& p) const
+				{
+					return p.first;
+				}
+		};
+		
+		
+		/// Returns its argument, i.e. the key of a set's value_type.
+		template <class T>
+		class identity
+		{
+			public:
+			
+				typedef T result_type;
+				
+				const result_type& operator() (const T& x) const
+				{
+					return x;
+				}
+		};
+	}
 }
 
 
@@ -5,6 +5,7 @@
 
 #include "binary_tree.hxx"
 #include "../functional.hxx"
+#include "../utility.hxx"
 
 
 
@@ -29,17 +30,16 @@ class dstd::impl::binary_search_tree
 		
 		
 		binary_search_tree(const Compare& compare = Compare())
-			: tree( new dstd::impl::binary_tree() ), comp( compare )
+			: tree(), comp( compare )
 		{}
 		
 		
-		~binary_search_tree()
-		{
-			delete( this->tree );
-		}
+		/// Makes an empty tree hold the count nodes chained from first through their right pointers,
+		/// which must already be in order, arranged as a perfectly balanced tree.
+		void assign_balanced(node* first, size_type count) { this->tree.assign_balanced(first, count); }
 		
 		
-		bool empty() const { return this->tree->empty(); }
+		bool empty() const { return this->tree.empty(); }
 		
 		
 		node* find(const value_type& value)
@@ -62,7 +62,7 @@ class dstd::impl::binary_search_tree
 			}
 			
 			// we didn't find it
-			return this->header();
+			return static_cast<node*>( this->header() );
 		}
 		const node* find(const value_type& value) const
 		{
@@ -84,12 +84,12 @@ class dstd::impl::binary_search_tree
 			}
 			
 			// we didn't find it
-			return this->header();
+			return static_cast<const node*>( this->header() );
 		}
 		
 		
-		binary_tree::node* header() { return this->tree->header(); }
-		const binary_tree::node* header() const { return this->tree->header(); }
+		binary_tree::node* header() { return this->tree.header(); }
+		const binary_tree::node* header() const { return this->tree.header(); }
 		
 		
 		node* insert(node* n, node* parent = 0)
@@ -98,7 +98,7 @@ class dstd::impl::binary_search_tree
 			
 			if( this->is_null(parent) )
 			{
-				this->tree->insert_left(n, parent);
+				this->tree.insert_left(n, parent);
 				return n;
 			}
 			else
@@ -109,7 +109,7 @@ class dstd::impl::binary_search_tree
 					{
 						if( this->is_null(parent->right) )
 						{
-							this->tree->insert_right(n, parent);
+							this->tree.insert_right(n, parent);
 							return n;
 						}
 						parent = parent->right_child();
@@ -118,7 +118,7 @@ class dstd::impl::binary_search_tree
 					{
 						if( this->is_null(parent->left) )
 						{
-							this->tree->insert_left(n, parent);
+							this->tree.insert_left(n, parent);
 							return n;
 						}
 						parent = parent->left_child();
@@ -132,11 +132,21 @@ class dstd::impl::binary_search_tree
 		}
 		
 		
-		bool is_null(const binary_tree::node* n) const { return this->tree->is_null(n); }
+		/// Attaches n as the left or right child of parent, which must have no child on that side,
+		/// or as the root if parent is null. The caller has already searched for this position,
+		/// so no values are compared.
+		void insert_at(node* n, node* parent, bool left)
+		{
+			if( left ) this->tree.insert_left(n, parent);
+			else this->tree.insert_right(n, parent);
+		}
+		
+		
+		bool is_null(const binary_tree::node* n) const { return this->tree.is_null(n); }
 		
 		
-		node* left_most() { return static_cast<node*>( this->tree->left_most() ); }
-		const node* left_most() const { return static_cast<const node*>( this->tree->left_most() ); }
+		node* left_most() { return static_cast<node*>( this->tree.left_most() ); }
+		const node* left_most() const { return static_cast<const node*>( this->tree.left_most() ); }
 		
 		
 		void remove(node* n)
@@ -145,27 +155,45 @@ class dstd::impl::binary_search_tree
 			{
 				this->swap(n, n->prev());
 			}
-			this->tree->remove(n);
+			this->tree.remove(n);
 		}
 		
 		
-		node* right_most() { return static_cast<node*>( this->tree->right_most() ); }
-		const node* right_most() const { return static_cast<const node*>( this->tree->right_most() ); }
+		node* right_most() { return static_cast<node*>( this->tree.right_most() ); }
+		const node* right_most() const { return static_cast<const node*>( this->tree.right_most() ); }
+		
+		
+		void rotate_left(node* n) { this->tree.rotate_left( static_cast<binary_tree::node*>(n) ); }
 		
 		
-		node* root() {return static_cast<node*>( this->tree->root() ); }
-		const node* root() const { return static_cast<const node*>( this->tree->root() ); }
+		void rotate_right(node* n) { this->tree.rotate_right( static_cast<binary_tree::node*>(n) ); }
 		
 		
-		size_type size() const { return this->tree->size(); }
+		node* root() {return static_cast<node*>( this->tree.root() ); }
+		const node* root() const { return static_cast<const node*>( this->tree.root() ); }
+		
+		
+		size_type size() const { return this->tree.size(); }
+		
+		
+		/// Forgets every node, leaving the tree empty. The nodes themselves belong to the caller.
+		void clear() { this->tree.clear(); }
+		
+		
+		/// Exchanges the nodes and comparison objects of the two trees.
+		void swap(binary_search_tree& x)
+		{
+			this->tree.swap(x.tree);
+			dstd::swap(this->comp, x.comp);
+		}
 		
 		
-		void swap(node* n1, node* n2) { this->tree->swap( static_cast<binary_tree::node*>(n1), static_cast<binary_tree::node*>(n2) ); }
+		void swap(node* n1, node* n2) { this->tree.swap( static_cast<binary_tree::node*>(n1), static_cast<binary_tree::node*>(n2) ); }
 	
 	
 	private:
 		
-		dstd::impl::binary_tree* tree;
+		dstd::impl::binary_tree tree;
 		Compare comp;
 };
 
@@ -179,8 +207,10 @@ class dstd::impl::binary_search_tree<T, Compare, AllowMultiple>::node : public d
 		typedef typename dstd::impl::binary_search_tree<T, Compare, AllowMultiple>::value_type value_type;
 		
 		
-		node(const value_type& node_value = value_type())
-			: binary_tree::node(), value( node_value )
+		/// Constructs the node's value from args, so that containers can build elements in place.
+		template <class... Args>
+		explicit node(Args&&... args)
+			: binary_tree::node(), value( dstd::forward<Args>(args)... )
 		{}
 		
 		
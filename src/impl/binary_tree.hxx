@@ -159,15 +159,53 @@ class dstd::impl::binary_tree
 		
 		
 		binary_tree()
-			: head( new node() ), n(0)
+			: head(), n(0)
 		{
 			reset();
 		}
 		
 		
-		~binary_tree()
+		/// Forgets every node, leaving the tree empty. The nodes themselves belong to the caller.
+		void clear()
 		{
-			delete(head);
+			reset();
+			this->n = 0;
+		}
+		
+		
+		/// Exchanges the nodes of this tree with those of x.
+		/// The header is kept inside each tree, so the nodes which point to it are relinked to their new header.
+		void swap(binary_tree& x)
+		{
+			node temp(head);
+			head = x.head;
+			x.head = temp;
+			
+			size_type temp_n = this->n;
+			this->n = x.n;
+			x.n = temp_n;
+			
+			relink_header();
+			x.relink_header();
+		}
+		
+		
+		/// Makes an empty tree hold the count nodes chained from first through their right pointers,
+		/// which must already be in order, arranged as a perfectly balanced tree.
+		/// No values are compared, and the whole tree is linked in O(count).
+		void assign_balanced(node* first, size_type count)
+		{
+			if( count == 0 ) return;
+			
+			node* next = first;
+			set_root( build_balanced(next, count) );
+			
+			node* last = root();
+			while( last->right != 0 ) last = last->right;
+			
+			set_left_most(first);
+			set_right_most(last);
+			this->n = count;
 		}
 		
 		
@@ -177,8 +215,8 @@ class dstd::impl::binary_tree
 		}
 		
 		
-		node* header() { return head; }
-		const node* header() const { return head; }
+		node* header() { return &head; }
+		const node* header() const { return &head; }
 		
 		
 		void insert_left(node* new_node, node* parent)
@@ -219,12 +257,12 @@ class dstd::impl::binary_tree
 		
 		bool is_null(const node* n) const
 		{
-			return( n == 0 || n == head );
+			return( n == 0 || n == &head );
 		}
 		
 		
-		node* left_most() { return head->right; }
-		const node* left_most() const { return head->right; }
+		node* left_most() { return head.right; }
+		const node* left_most() const { return head.right; }
 		
 		
 		/// Removes a node from the tree.
@@ -262,7 +300,7 @@ class dstd::impl::binary_tree
 					}
 				}
 				
-				--(n);
+				--(this->n);
 			}
 			else if( is_null(n->left) != is_null(n->right) ) // != behaves like xor
 			{
@@ -275,17 +313,51 @@ class dstd::impl::binary_tree
 				
 				if( child != root() ) n->up->attach_child(child, (n->up->left == n));
 				
-				--(n);
+				--(this->n);
 			}
 		}
 		
 		
-		node* right_most() { return head->left; }
-		const node* right_most() const { return head->left; }
+		node* right_most() { return head.left; }
+		const node* right_most() const { return head.left; }
 		
 		
-		node* root() { return head->up; }
-		const node* root() const { return head->up; }
+		/// Rotates the subtree rooted at n to the left, so that n's right child takes its place.
+		/// The in-order sequence of the tree is unchanged. n must have a right child.
+		void rotate_left(node* n)
+		{
+			node* pivot = n->right;
+			
+			// the pivot's left subtree can never contain the left-most node, so it is never the header
+			n->right = pivot->left;
+			if( ! is_null(pivot->left) ) pivot->left->up = n;
+			
+			if( n == root() ) set_root(pivot);
+			else n->up->attach_child(pivot, (n->up->left == n));
+			
+			pivot->attach_child(n, true);
+		}
+		
+		
+		/// Rotates the subtree rooted at n to the right, so that n's left child takes its place.
+		/// The in-order sequence of the tree is unchanged. n must have a left child.
+		void rotate_right(node* n)
+		{
+			node* pivot = n->left;
+			
+			// the pivot's right subtree can never contain the right-most node, so it is never the header
+			n->left = pivot->right;
+			if( ! is_null(pivot->right) ) pivot->right->up = n;
+			
+			if( n == root() ) set_root(pivot);
+			else n->up->attach_child(pivot, (n->up->left == n));
+			
+			pivot->attach_child(n, false);
+		}
+		
+		
+		node* root() { return head.up; }
+		const node* root() const { return head.up; }
 		
 		
 		size_type size() const { return n; }
@@ -358,46 +430,75 @@ class dstd::impl::binary_tree
 				
 				// sort out the header things which point to n1 or n2
 				
-				if     ( head->up == n1 ) head->up = n2;
-				else if( head->up == n2 ) head->up = n1;
+				if     ( head.up == n1 ) head.up = n2;
+				else if( head.up == n2 ) head.up = n1;
 				
-				if     ( head->left == n1 ) head->left = n2;
-				else if( head->left == n2 ) head->left = n1;
+				if     ( head.left == n1 ) head.left = n2;
+				else if( head.left == n2 ) head.left = n1;
 				
-				if     ( head->right == n1 ) head->right = n2;
-				else if( head->right == n2 ) head->right = n1;
+				if     ( head.right == n1 ) head.right = n2;
+				else if( head.right == n2 ) head.right = n1;
 			}
 		}
 	
 	
 	private:
 		
+		/// Links the next count nodes of the chain into a balanced subtree, and advances next past them.
+		/// The left subtree takes (count - 1) / 2 nodes and the right subtree count / 2,
+		/// so the depths of the subtree's leaves differ by at most one.
+		/// @returns The root of the subtree.
+		node* build_balanced(node*& next, size_type count)
+		{
+			if( count == 0 ) return 0;
+			
+			node* left = build_balanced(next, (count - 1) / 2);
+			node* middle = next;
+			next = next->right;
+			middle->attach_child(left, true);
+			middle->attach_child(build_balanced(next, count / 2), false);
+			return middle;
+		}
+		
 		void reset()
 		{
-			head->up = head;
-			head->left = head;
-			head->right = head;
+			head.up = &head;
+			head.left = &head;
+			head.right = &head;
+		}
+		
+		/// Points the root, left-most and right-most nodes back at this tree's header, after its fields were copied from another.
+		void relink_header()
+		{
+			if( this->n == 0 )
+			{
+				reset();
+				return;
+			}
+			set_root( head.up );
+			set_left_most( head.right );
+			set_right_most( head.left );
 		}
 		
 		void set_left_most(node* n)
 		{
-			head->right = n;
-			n->left = head;
+			head.right = n;
+			n->left = &head;
 		}
 		
 		void set_right_most(node* n)
 		{
-			head->left = n;
-			n->right = head;
+			head.left = n;
+			n->right = &head;
 		}
 		
 		void set_root(node* n)
 		{
-			head->up = n;
-			n->up = head;
+			head.up = n;
+			n->up = &head;
 		}
 		
-		node* head;
+		node head; ///< Its up is the root, its right the left-most node and its left the right-most node. It is end().
 		size_type n;
 };
 
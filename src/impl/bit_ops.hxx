@@ -0,0 +1,77 @@
+#ifndef DSTD_IMPL_BIT_OPS_HXX
+#define DSTD_IMPL_BIT_OPS_HXX
+
+#include <climits>
+
+#include "../cstddef.hxx"
+
+
+
+namespace dstd
+{
+	namespace impl
+	{
+		template <class Word> size_t popcount(Word w);
+		template <class Word> size_t count_trailing_zeros(Word w);
+		template <class Word> size_t highest_bit_index(Word w);
+		template <class Word> Word low_bits(size_t n);
+	}
+}
+
+
+
+/// Returns the number of bits set in w, which must be an unsigned integer no wider than unsigned long long.
+template <class Word>
+size_t dstd::impl::popcount(Word w)
+{
+#if defined(__GNUC__)
+	return static_cast<size_t>( __builtin_popcountll(w) );
+#else
+	size_t n = 0;
+	for(; w != 0; ++n) w &= w - 1; // clears the lowest set bit
+	return n;
+#endif
+}
+
+
+
+/// Returns the index of the lowest bit set in w, which must not be zero.
+template <class Word>
+size_t dstd::impl::count_trailing_zeros(Word w)
+{
+#if defined(__GNUC__)
+	return static_cast<size_t>( __builtin_ctzll(w) );
+#else
+	size_t n = 0;
+	for(; (w & 1) == 0; ++n) w >>= 1;
+	return n;
+#endif
+}
+
+
+
+/// Returns the index of the highest bit set in w, which must not be zero. This is the integer part of log2(w).
+template <class Word>
+size_t dstd::impl::highest_bit_index(Word w)
+{
+#if defined(__GNUC__)
+	return static_cast<size_t>( sizeof(unsigned long long) * CHAR_BIT - 1 - __builtin_clzll(w) );
+#else
+	size_t n = 0;
+	while( (w >>= 1) != 0 ) ++n;
+	return n;
+#endif
+}
+
+
+
+/// Returns a word with the lowest n bits set, where n is less than the number of bits in the word.
+template <class Word>
+Word dstd::impl::low_bits(size_t n)
+{
+	return static_cast<Word>( (static_cast<Word>(1) << n) - 1 );
+}
+
+
+
+#endif
@@ -0,0 +1,1278 @@
+#ifndef DSTD_IMPL_BTREE_HXX
+#define DSTD_IMPL_BTREE_HXX
+
+
+
+#include <new>
+
+#include "../cstddef.hxx"
+#include "../functional.hxx"
+#include "../iterator.hxx"
+#include "../limits.hxx"
+#include "../memory.hxx"
+#include "../utility.hxx"
+
+
+
+namespace dstd
+{
+	namespace impl
+	{
+		template <class T> class btree_node_capacity;
+		template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple> class btree;
+	}
+}
+
+
+
+/// The number of elements of type T stored in a single node of a btree.
+/// Nodes hold roughly 256 bytes of elements, so that a search within a node touches only a few cache lines,
+/// but never fewer than 4 elements.
+template <class T>
+class dstd::impl::btree_node_capacity
+{
+	public:
+
+		static const size_t value = (256 / sizeof(T) > 4) ? (256 / sizeof(T)) : 4;
+};
+
+
+
+/// A B+tree, which stores many values per node in contiguous arrays.
+/// Values are only stored in the leaves, which are linked together in order for iteration.
+/// The internal nodes store copies of keys which separate their children, such that every key in
+/// children[i] is not greater than keys[i], which in turn is not greater than every key in children[i+1].
+template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple>
+class dstd::impl::btree
+{
+	public:
+
+		typedef Key key_type;
+		typedef Value value_type;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+		typedef Compare key_compare;
+		class value_compare;
+		typedef Allocator allocator_type;
+		typedef value_type& reference;
+		typedef const value_type& const_reference;
+		typedef value_type* pointer;
+		typedef const value_type* const_pointer;
+		class iterator;
+		class const_iterator;
+		typedef dstd::reverse_iterator<iterator> reverse_iterator;
+		typedef dstd::reverse_iterator<const_iterator> const_reverse_iterator;
+
+
+	protected:
+
+		static const size_type leaf_capacity = dstd::impl::btree_node_capacity<value_type>::value;
+		static const size_type leaf_minimum = leaf_capacity / 2;
+		static const size_type internal_capacity = dstd::impl::btree_node_capacity<key_type>::value;
+		static const size_type internal_minimum = (internal_capacity - 1) / 2;
+
+		class node_base;
+		class leaf_base;
+		class leaf_node;
+		class internal_node;
+
+		typedef typename Allocator::template rebind<value_type>::other value_allocator_type;
+		typedef typename Allocator::template rebind<key_type>::other key_allocator_type;
+		typedef typename Allocator::template rebind<leaf_node>::other leaf_allocator_type;
+		typedef typename Allocator::template rebind<internal_node>::other internal_allocator_type;
+
+
+	public:
+
+
+		/// Constructs an empty tree with no elements.
+		explicit btree(const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: a(alloc), a_key(alloc), a_leaf(alloc), a_internal(alloc), comp(compare), root(0), header(), n(0)
+		{}
+
+
+		/// Constructs a tree with a copy of each of the elements in x.
+		btree(const btree& x)
+			: a(x.a), a_key(x.a_key), a_leaf(x.a_leaf), a_internal(x.a_internal), comp(x.comp), root(0), header(), n(0)
+		{
+			this->insert_sorted(x.begin(), x.end());
+		}
+
+
+		/// Destroys the tree including all its elements
+		virtual ~btree()
+		{
+			this->clear();
+		}
+
+
+		btree& operator= (const btree& x)
+		{
+			if( this != &x )
+			{
+				this->clear();
+				this->insert_sorted(x.begin(), x.end());
+			}
+			return *this;
+		}
+
+
+		//
+		// Iterators
+
+
+		/// Returns an iterator referring to the first element in the container.
+		iterator begin() { return iterator(this->header.next, 0); }
+		const_iterator begin() const { return const_iterator(this->header.next, 0); }
+
+
+		/// Returns an iterator referring to the past-the-end element in the container.
+		iterator end() { return iterator(&(this->header), 0); }
+		const_iterator end() const { return const_iterator(&(this->header), 0); }
+
+
+		reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+
+
+		reverse_iterator rend() { return reverse_iterator(this->begin()); }
+		const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+
+		//
+		// Capacity
+
+
+		/// Returns whether the container is empty (i.e. whether its size is 0).
+		bool empty() const { return (this->n == 0); }
+
+
+		/// Returns the number of elements in the container.
+		size_type size() const { return this->n; }
+
+
+		/// Returns the maximum number of elements that the container can hold.
+		size_type max_size() const { return dstd::numeric_limits<size_type>::max(); }
+
+
+		//
+		// Modifiers
+
+
+		/// Removes and destroys an element from the container.
+		/// All iterators are invalidated, since removing an element may move its neighbours between nodes.
+		/// @returns An iterator to the element which followed the removed element.
+		iterator erase(iterator position)
+		{
+			return this->erase_value( static_cast<leaf_node*>(position.n), position.i );
+		}
+
+
+		/// Removes and destroys the elements with key k.
+		/// @returns The number of elements erased
+		size_type erase(const key_type& k)
+		{
+			dstd::pair<iterator,iterator> range = this->equal_range(k);
+			size_type n = this->size();
+			this->erase(range.first, range.second);
+			return (n - this->size());
+		}
+
+
+		/// Removes and destroys the elements in the range [first,last).
+		/// @returns An iterator to the element which followed the last removed element.
+		iterator erase(iterator first, iterator last)
+		{
+			if( first == this->begin() && last == this->end() )
+			{
+				this->clear();
+				return this->end();
+			}
+
+			// erasing rebalances the tree, which invalidates last, so count the elements instead
+			size_type count = 0;
+			for(iterator it = first; it != last; ++it)
+			{
+				++count;
+			}
+
+			for( ; count != 0; --count)
+			{
+				first = this->erase(first);
+			}
+			return first;
+		}
+
+
+		/// Removes all elements from the container (which are destroyed), leaving the container with a size of 0.
+		void clear()
+		{
+			if( this->root != 0 )
+			{
+				this->delete_nodes(this->root);
+			}
+			this->root = 0;
+			this->n = 0;
+			this->header.next = &(this->header);
+			this->header.prev = &(this->header);
+		}
+
+
+		/// Exchanges the content of the container by the content of x.
+		void swap(btree& x)
+		{
+			dstd::swap(this->root, x.root);
+			dstd::swap(this->n, x.n);
+			dstd::swap(this->comp, x.comp);
+			dstd::swap(this->header.next, x.header.next);
+			dstd::swap(this->header.prev, x.header.prev);
+			this->relink_header();
+			x.relink_header();
+
+			// the nodes are exchanged, so the allocators which own them must be too
+			dstd::swap(this->a, x.a);
+			dstd::swap(this->a_key, x.a_key);
+			dstd::swap(this->a_leaf, x.a_leaf);
+			dstd::swap(this->a_internal, x.a_internal);
+		}
+
+
+		//
+		// Observers
+
+
+		/// Returns a copy of the comparison object used by the container to compare keys.
+		key_compare key_comp() const { return this->comp; }
+
+
+		/// Returns a comparison object that can be used to compare two elements to get whether the key of the first one goes before the second.
+		value_compare value_comp() const { return value_compare(this->comp); }
+
+
+		//
+		// Lookup
+
+
+		/// Searches the container for an element with a key equivalent to k and returns an iterator to it if found,
+		/// otherwise it returns an iterator to end.
+		iterator find(const key_type& k)
+		{
+			iterator it = this->lower_bound(k);
+			return ( it == this->end() || this->comp(k, KeyOfValue()(*it)) ) ? this->end() : it;
+		}
+		const_iterator find(const key_type& k) const
+		{
+			const_iterator it = this->lower_bound(k);
+			return ( it == this->end() || this->comp(k, KeyOfValue()(*it)) ) ? this->end() : it;
+		}
+
+
+		/// Returns the number of elements with a key equivalent to k.
+		size_type count(const key_type& k) const
+		{
+			dstd::pair<const_iterator,const_iterator> range = this->equal_range(k);
+			size_type n = 0;
+			for( ; range.first != range.second; ++range.first)
+			{
+				++n;
+			}
+			return n;
+		}
+
+
+		dstd::pair<iterator,iterator> equal_range(const key_type& k)
+		{
+			return dstd::pair<iterator,iterator>( this->lower_bound(k), this->upper_bound(k) );
+		}
+		dstd::pair<const_iterator,const_iterator> equal_range(const key_type& k) const
+		{
+			return dstd::pair<const_iterator,const_iterator>( this->lower_bound(k), this->upper_bound(k) );
+		}
+
+
+		/// Returns an iterator pointing to the first element in the container whose key is not considered to go before k
+		/// (i.e., either it is equivalent or goes after).
+		iterator lower_bound(const key_type& k)
+		{
+			leaf_node* leaf = this->descend(k, false);
+			return this->make_iterator( leaf, (leaf == 0) ? 0 : this->leaf_lower_bound(leaf, k) );
+		}
+		const_iterator lower_bound(const key_type& k) const
+		{
+			return const_cast<btree*>(this)->lower_bound(k);
+		}
+
+
+		/// Returns an iterator pointing to the first element in the container whose key is considered to go after k.
+		iterator upper_bound(const key_type& k)
+		{
+			leaf_node* leaf = this->descend(k, true);
+			return this->make_iterator( leaf, (leaf == 0) ? 0 : this->leaf_upper_bound(leaf, k) );
+		}
+		const_iterator upper_bound(const key_type& k) const
+		{
+			return const_cast<btree*>(this)->upper_bound(k);
+		}
+
+
+		//
+		// Allocator
+
+
+		/// Returns a copy of the allocator object associated with the container.
+		allocator_type get_allocator() const
+		{
+			return allocator_type(this->a);
+		}
+
+
+	protected:
+
+
+		/// Inserts value if no element with an equivalent key exists.
+		dstd::pair<iterator,bool> insert_unique(const value_type& value)
+		{
+			return this->emplace_unique( KeyOfValue()(value), value );
+		}
+
+
+		/// Inserts an element constructed in place from args, whose key must be k, if no element with an equivalent key exists.
+		/// The tree is searched once, and nothing is constructed if k already exists.
+		template <class... Args>
+		dstd::pair<iterator,bool> emplace_unique(const key_type& k, Args&&... args)
+		{
+			if( this->root == 0 )
+			{
+				return dstd::pair<iterator,bool>( this->insert_first( dstd::forward<Args>(args)... ), true );
+			}
+
+			// Appending in order does not need to search the tree
+			leaf_node* last = static_cast<leaf_node*>( this->header.prev );
+			if( this->comp(KeyOfValue()(last->values()[last->count - 1]), k) )
+			{
+				return dstd::pair<iterator,bool>( this->insert_value( last, last->count, dstd::forward<Args>(args)... ), true );
+			}
+
+			leaf_node* leaf = this->descend(k, false);
+			const size_type i = this->leaf_lower_bound(leaf, k);
+			iterator existing = this->make_iterator(leaf, i);
+			if( existing != this->end() && ! this->comp(k, KeyOfValue()(*existing)) )
+			{
+				return dstd::pair<iterator,bool>( existing, false );
+			}
+			return dstd::pair<iterator,bool>( this->insert_value( leaf, i, dstd::forward<Args>(args)... ), true );
+		}
+
+
+		/// Inserts value after any elements with an equivalent key.
+		iterator insert_equal(const value_type& value)
+		{
+			const key_type& k = KeyOfValue()(value);
+
+			if( this->root == 0 )
+			{
+				return this->insert_first(value);
+			}
+
+			// Appending in order does not need to search the tree
+			leaf_node* last = static_cast<leaf_node*>( this->header.prev );
+			if( ! this->comp(k, KeyOfValue()(last->values()[last->count - 1])) )
+			{
+				return this->insert_value(last, last->count, value);
+			}
+
+			leaf_node* leaf = this->descend(k, true);
+			return this->insert_value(leaf, this->leaf_upper_bound(leaf, k), value);
+		}
+
+
+		/// Inserts the elements [first,last) which are already in order
+		template <class InputIterator>
+		void insert_sorted(InputIterator first, InputIterator last)
+		{
+			for( ; first != last; ++first)
+			{
+				if( AllowMultiple ) this->insert_equal(*first);
+				else this->insert_unique(*first);
+			}
+		}
+
+
+	private:
+
+
+		//
+		// Search
+
+
+		/// Returns the leaf in which k, or the position k would be inserted at, can be found.
+		/// If upper is true, the leaf is found for an insertion after all elements equivalent to k.
+		leaf_node* descend(const key_type& k, bool upper) const
+		{
+			if( this->root == 0 ) return 0;
+
+			node_base* x = this->root;
+			while( ! x->leaf )
+			{
+				internal_node* internal = static_cast<internal_node*>(x);
+				const key_type* keys = internal->keys();
+
+				// find the first key which k goes before (upper), or the first key k does not go after (lower)
+				size_type first = 0;
+				size_type count = internal->count;
+				while( count > 0 )
+				{
+					const size_type half = count / 2;
+					const bool go_right = upper ? ! this->comp(k, keys[first + half]) : this->comp(keys[first + half], k);
+					if( go_right )
+					{
+						first += half + 1;
+						count -= half + 1;
+					}
+					else
+					{
+						count = half;
+					}
+				}
+				x = internal->children[first];
+			}
+			return static_cast<leaf_node*>(x);
+		}
+
+
+		/// Returns the index of the first value in leaf whose key does not go before k
+		size_type leaf_lower_bound(const leaf_node* leaf, const key_type& k) const
+		{
+			const value_type* values = leaf->values();
+			size_type first = 0;
+			size_type count = leaf->count;
+			while( count > 0 )
+			{
+				const size_type half = count / 2;
+				if( this->comp(KeyOfValue()(values[first + half]), k) )
+				{
+					first += half + 1;
+					count -= half + 1;
+				}
+				else
+				{
+					count = half;
+				}
+			}
+			return first;
+		}
+
+
+		/// Returns the index of the first value in leaf whose key goes after k
+		size_type leaf_upper_bound(const leaf_node* leaf, const key_type& k) const
+		{
+			const value_type* values = leaf->values();
+			size_type first = 0;
+			size_type count = leaf->count;
+			while( count > 0 )
+			{
+				const size_type half = count / 2;
+				if( ! this->comp(k, KeyOfValue()(values[first + half])) )
+				{
+					first += half + 1;
+					count -= half + 1;
+				}
+				else
+				{
+					count = half;
+				}
+			}
+			return first;
+		}
+
+
+		/// Returns an iterator to position i of leaf, moving to the next leaf if i is past its last value
+		iterator make_iterator(leaf_base* leaf, size_type i)
+		{
+			if( leaf == 0 ) return this->end();
+			if( i == leaf->count ) return iterator(leaf->next, 0);
+			return iterator(leaf, i);
+		}
+
+
+		//
+		// Insertion
+
+
+		template <class... Args>
+		iterator insert_first(Args&&... args)
+		{
+			leaf_node* leaf = this->new_leaf();
+			leaf->prev = &(this->header);
+			leaf->next = &(this->header);
+			this->header.next = leaf;
+			this->header.prev = leaf;
+			this->root = leaf;
+			return this->insert_value( leaf, 0, dstd::forward<Args>(args)... );
+		}
+
+
+		/// Inserts a value constructed from args at position i of leaf, splitting the leaf first if it is full
+		template <class... Args>
+		iterator insert_value(leaf_node* leaf, size_type i, Args&&... args)
+		{
+			if( leaf->count == leaf_capacity )
+			{
+				if( i == leaf->count && leaf->next == &(this->header) )
+				{
+					return this->append_leaf( leaf, dstd::forward<Args>(args)... );
+				}
+
+				leaf_node* right = this->split_leaf(leaf);
+				if( i > leaf->count )
+				{
+					i -= leaf->count;
+					leaf = right;
+				}
+			}
+
+			value_type* values = leaf->values();
+			for(size_type j = leaf->count; j > i; --j)
+			{
+				this->a.construct(values + j, dstd::move(values[j - 1]));
+				this->a.destroy(values + j - 1);
+			}
+			this->a.construct( values + i, dstd::forward<Args>(args)... );
+			++(leaf->count);
+			++(this->n);
+
+			return iterator(leaf, i);
+		}
+
+
+		/// Starts a new last leaf holding just a value constructed from args, to follow the full last leaf.
+		/// Splitting the full leaf in half instead would leave every leaf half empty when keys are inserted in order,
+		/// whereas this way each leaf fills up before the next is started.
+		template <class... Args>
+		iterator append_leaf(leaf_node* leaf, Args&&... args)
+		{
+			leaf_node* right = this->new_leaf();
+			try
+			{
+				this->a.construct( right->values(), dstd::forward<Args>(args)... );
+			}
+			catch(...)
+			{
+				this->delete_leaf(right);
+				throw;
+			}
+			right->count = 1;
+			++(this->n);
+
+			right->next = leaf->next;
+			right->prev = leaf;
+			leaf->next->prev = right;
+			leaf->next = right;
+
+			this->insert_parent(leaf, KeyOfValue()(right->values()[0]), right);
+			return iterator(right, 0);
+		}
+
+
+		/// Moves the upper half of a full leaf into a new leaf which follows it
+		/// @returns The new leaf
+		leaf_node* split_leaf(leaf_node* leaf)
+		{
+			leaf_node* right = this->new_leaf();
+
+			const size_type half = leaf->count / 2;
+			this->move_values(leaf->values() + half, leaf->count - half, right->values());
+			right->count = leaf->count - half;
+			leaf->count = half;
+
+			right->next = leaf->next;
+			right->prev = leaf;
+			leaf->next->prev = right;
+			leaf->next = right;
+
+			this->insert_parent(leaf, KeyOfValue()(right->values()[0]), right);
+			return right;
+		}
+
+
+		/// Inserts the separator k and the node right, which has just been split from left, into left's parent
+		void insert_parent(node_base* left, const key_type& k, node_base* right)
+		{
+			internal_node* parent = left->parent;
+
+			if( parent == 0 )
+			{
+				// left is the root, so the tree grows by one level
+				parent = this->new_internal();
+				parent->children[0] = left;
+				left->parent = parent;
+				left->position = 0;
+				this->insert_child(parent, 0, k, right);
+				this->root = parent;
+				return;
+			}
+
+			size_type i = left->position;
+
+			if( parent->count == internal_capacity )
+			{
+				// Split the parent. The middle key moves up into the grandparent.
+				internal_node* sibling = this->new_internal();
+				const size_type middle = parent->count / 2;
+
+				key_type* keys = parent->keys();
+				for(size_type j = middle + 1; j < parent->count; ++j)
+				{
+					this->a_key.construct(sibling->keys() + (j - middle - 1), dstd::move(keys[j]));
+					this->a_key.destroy(keys + j);
+				}
+				for(size_type j = middle + 1; j <= parent->count; ++j)
+				{
+					this->set_child(sibling, j - middle - 1, parent->children[j]);
+				}
+				sibling->count = parent->count - middle - 1;
+
+				key_type up( dstd::move(keys[middle]) );
+				this->a_key.destroy(keys + middle);
+				parent->count = middle;
+
+				if( i > middle )
+				{
+					this->insert_child(sibling, i - middle - 1, k, right);
+				}
+				else
+				{
+					this->insert_child(parent, i, k, right);
+				}
+
+				this->insert_parent(parent, up, sibling);
+			}
+			else
+			{
+				this->insert_child(parent, i, k, right);
+			}
+		}
+
+
+		/// Inserts key k at keys[i] and child at children[i+1] of a non-full internal node
+		void insert_child(internal_node* parent, size_type i, const key_type& k, node_base* child)
+		{
+			key_type* keys = parent->keys();
+			for(size_type j = parent->count; j > i; --j)
+			{
+				this->a_key.construct(keys + j, dstd::move(keys[j - 1]));
+				this->a_key.destroy(keys + j - 1);
+			}
+			for(size_type j = parent->count + 1; j > i + 1; --j)
+			{
+				this->set_child(parent, j, parent->children[j - 1]);
+			}
+			this->a_key.construct(keys + i, k);
+			this->set_child(parent, i + 1, child);
+			++(parent->count);
+		}
+
+
+		//
+		// Removal
+
+
+		/// Removes the value at position i of leaf, rebalancing the tree if the leaf becomes too small.
+		/// @returns An iterator to the value which followed the removed value.
+		iterator erase_value(leaf_node* leaf, size_type i)
+		{
+			value_type* values = leaf->values();
+			this->a.destroy(values + i);
+			for(size_type j = i + 1; j < leaf->count; ++j)
+			{
+				this->a.construct(values + j - 1, dstd::move(values[j]));
+				this->a.destroy(values + j);
+			}
+			--(leaf->count);
+			--(this->n);
+
+			if( leaf == this->root )
+			{
+				if( leaf->count == 0 )
+				{
+					this->clear();
+					return this->end();
+				}
+				return this->make_iterator(leaf, i);
+			}
+
+			// track the following value, which may move while rebalancing
+			leaf_base* next = leaf;
+			if( i == leaf->count )
+			{
+				next = leaf->next;
+				i = 0;
+			}
+
+			if( leaf->count < leaf_minimum )
+			{
+				this->rebalance_leaf(leaf, next, i);
+			}
+
+			return iterator(next, i);
+		}
+
+
+		/// Refills a leaf which has too few values, by borrowing from or merging with a sibling.
+		/// (next, i) is updated if the value it refers to moves.
+		void rebalance_leaf(leaf_node* leaf, leaf_base*& next, size_type& i)
+		{
+			internal_node* parent = leaf->parent;
+			const size_type position = leaf->position;
+			leaf_node* left = (position > 0) ? static_cast<leaf_node*>(parent->children[position - 1]) : 0;
+			leaf_node* right = (position < parent->count) ? static_cast<leaf_node*>(parent->children[position + 1]) : 0;
+
+			if( left != 0 && left->count > leaf_minimum )
+			{
+				// move the last value of left to the front of leaf
+				value_type* values = leaf->values();
+				for(size_type j = leaf->count; j > 0; --j)
+				{
+					this->a.construct(values + j, dstd::move(values[j - 1]));
+					this->a.destroy(values + j - 1);
+				}
+				this->move_values(left->values() + left->count - 1, 1, values);
+				--(left->count);
+				++(leaf->count);
+				parent->keys()[position - 1] = KeyOfValue()(values[0]);
+
+				if( next == leaf ) ++i;
+			}
+			else if( right != 0 && right->count > leaf_minimum )
+			{
+				// move the first value of right to the back of leaf
+				value_type* values = right->values();
+				this->move_values(values, 1, leaf->values() + leaf->count);
+				for(size_type j = 1; j < right->count; ++j)
+				{
+					this->a.construct(values + j - 1, dstd::move(values[j]));
+					this->a.destroy(values + j);
+				}
+				--(right->count);
+				++(leaf->count);
+				parent->keys()[position] = KeyOfValue()(values[0]);
+
+				if( next == right )
+				{
+					if( i == 0 )
+					{
+						next = leaf;
+						i = leaf->count - 1;
+					}
+					else
+					{
+						--i;
+					}
+				}
+			}
+			else if( left != 0 )
+			{
+				this->merge_leaves(left, leaf, next, i);
+			}
+			else
+			{
+				this->merge_leaves(leaf, right, next, i);
+			}
+		}
+
+
+		/// Moves all the values of right into left, its preceding sibling, and removes right from the tree.
+		void merge_leaves(leaf_node* left, leaf_node* right, leaf_base*& next, size_type& i)
+		{
+			if( next == right )
+			{
+				next = left;
+				i += left->count;
+			}
+
+			this->move_values(right->values(), right->count, left->values() + left->count);
+			left->count += right->count;
+			right->count = 0;
+
+			left->next = right->next;
+			right->next->prev = left;
+
+			internal_node* parent = left->parent;
+			this->remove_child(parent, left->position);
+			this->delete_leaf(right);
+			this->rebalance_internal(parent);
+		}
+
+
+		/// Refills an internal node which has too few keys, by borrowing from or merging with a sibling.
+		void rebalance_internal(internal_node* node)
+		{
+			if( node == this->root )
+			{
+				if( node->count == 0 )
+				{
+					// the root has a single child, so the tree shrinks by one level
+					this->root = node->children[0];
+					this->root->parent = 0;
+					this->root->position = 0;
+					this->delete_internal(node);
+				}
+				return;
+			}
+
+			if( node->count >= internal_minimum ) return;
+
+			internal_node* parent = node->parent;
+			const size_type position = node->position;
+			internal_node* left = (position > 0) ? static_cast<internal_node*>(parent->children[position - 1]) : 0;
+			internal_node* right = (position < parent->count) ? static_cast<internal_node*>(parent->children[position + 1]) : 0;
+
+			if( left != 0 && left->count > internal_minimum )
+			{
+				// rotate the separator down into node, and the last key of left up into the parent
+				key_type* keys = node->keys();
+				for(size_type j = node->count; j > 0; --j)
+				{
+					this->a_key.construct(keys + j, dstd::move(keys[j - 1]));
+					this->a_key.destroy(keys + j - 1);
+				}
+				for(size_type j = node->count + 1; j > 0; --j)
+				{
+					this->set_child(node, j, node->children[j - 1]);
+				}
+				this->a_key.construct(keys, parent->keys()[position - 1]);
+				this->set_child(node, 0, left->children[left->count]);
+				++(node->count);
+
+				parent->keys()[position - 1] = left->keys()[left->count - 1];
+				this->a_key.destroy(left->keys() + left->count - 1);
+				--(left->count);
+			}
+			else if( right != 0 && right->count > internal_minimum )
+			{
+				// rotate the separator down into node, and the first key of right up into the parent
+				this->a_key.construct(node->keys() + node->count, parent->keys()[position]);
+				this->set_child(node, node->count + 1, right->children[0]);
+				++(node->count);
+
+				key_type* keys = right->keys();
+				parent->keys()[position] = keys[0];
+				this->a_key.destroy(keys);
+				for(size_type j = 1; j < right->count; ++j)
+				{
+					this->a_key.construct(keys + j - 1, dstd::move(keys[j]));
+					this->a_key.destroy(keys + j);
+				}
+				for(size_type j = 1; j <= right->count; ++j)
+				{
+					this->set_child(right, j - 1, right->children[j]);
+				}
+				--(right->count);
+			}
+			else
+			{
+				if( left == 0 )
+				{
+					left = node;
+					node = right;
+				}
+
+				// merge node into left, with the separator between them
+				key_type* keys = left->keys();
+				this->a_key.construct(keys + left->count, parent->keys()[left->position]);
+				for(size_type j = 0; j < node->count; ++j)
+				{
+					this->a_key.construct(keys + left->count + 1 + j, dstd::move(node->keys()[j]));
+					this->a_key.destroy(node->keys() + j);
+				}
+				for(size_type j = 0; j <= node->count; ++j)
+				{
+					this->set_child(left, left->count + 1 + j, node->children[j]);
+				}
+				left->count += node->count + 1;
+				node->count = 0;
+
+				this->remove_child(parent, left->position);
+				this->delete_internal(node);
+				this->rebalance_internal(parent);
+			}
+		}
+
+
+		/// Removes keys[i] and children[i+1] from an internal node
+		void remove_child(internal_node* parent, size_type i)
+		{
+			key_type* keys = parent->keys();
+			this->a_key.destroy(keys + i);
+			for(size_type j = i + 1; j < parent->count; ++j)
+			{
+				this->a_key.construct(keys + j - 1, dstd::move(keys[j]));
+				this->a_key.destroy(keys + j);
+			}
+			for(size_type j = i + 2; j <= parent->count; ++j)
+			{
+				this->set_child(parent, j - 1, parent->children[j]);
+			}
+			--(parent->count);
+		}
+
+
+		//
+		// Nodes
+
+
+		void set_child(internal_node* parent, size_type i, node_base* child)
+		{
+			parent->children[i] = child;
+			child->parent = parent;
+			child->position = i;
+		}
+
+
+		/// Moves count values from first into the uninitialised memory at dest
+		void move_values(value_type* first, size_type count, value_type* dest)
+		{
+			for(size_type j = 0; j < count; ++j)
+			{
+				this->a.construct(dest + j, dstd::move(first[j]));
+				this->a.destroy(first + j);
+			}
+		}
+
+
+		/// Points the first and last leaves back at this tree's header
+		void relink_header()
+		{
+			if( this->root == 0 )
+			{
+				this->header.next = &(this->header);
+				this->header.prev = &(this->header);
+			}
+			else
+			{
+				this->header.next->prev = &(this->header);
+				this->header.prev->next = &(this->header);
+			}
+		}
+
+
+		leaf_node* new_leaf()
+		{
+			leaf_node* leaf = this->a_leaf.allocate(1);
+			new(leaf) leaf_node();
+			return leaf;
+		}
+
+
+		internal_node* new_internal()
+		{
+			internal_node* internal = this->a_internal.allocate(1);
+			new(internal) internal_node();
+			return internal;
+		}
+
+
+		void delete_leaf(leaf_node* leaf)
+		{
+			for(size_type j = 0; j < leaf->count; ++j)
+			{
+				this->a.destroy(leaf->values() + j);
+			}
+			this->a_leaf.destroy(leaf);
+			this->a_leaf.deallocate(leaf, 1);
+		}
+
+
+		void delete_internal(internal_node* internal)
+		{
+			for(size_type j = 0; j < internal->count; ++j)
+			{
+				this->a_key.destroy(internal->keys() + j);
+			}
+			this->a_internal.destroy(internal);
+			this->a_internal.deallocate(internal, 1);
+		}
+
+
+		void delete_nodes(node_base* x)
+		{
+			if( x->leaf )
+			{
+				this->delete_leaf( static_cast<leaf_node*>(x) );
+			}
+			else
+			{
+				internal_node* internal = static_cast<internal_node*>(x);
+				for(size_type j = 0; j <= internal->count; ++j)
+				{
+					this->delete_nodes(internal->children[j]);
+				}
+				this->delete_internal(internal);
+			}
+		}
+
+
+		value_allocator_type a;
+		key_allocator_type a_key;
+		leaf_allocator_type a_leaf;
+		internal_allocator_type a_internal;
+		key_compare comp;
+		node_base* root;
+		leaf_base header;
+		size_type n;
+};
+
+
+
+//
+// Nodes
+
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple>
+class dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::node_base
+{
+	public:
+
+		explicit node_base(bool is_leaf)
+			: parent(0), position(0), count(0), leaf(is_leaf)
+		{}
+
+		internal_node* parent;
+		size_type position; // index of this node in parent->children
+		size_type count; // number of values (leaves) or keys (internal nodes)
+		bool leaf;
+};
+
+
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple>
+class dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::leaf_base : public node_base
+{
+	public:
+
+		leaf_base()
+			: node_base(true), prev(this), next(this)
+		{}
+
+		leaf_base* prev;
+		leaf_base* next;
+
+
+	private:
+
+		/// Not implemented
+		leaf_base(const leaf_base&);
+
+		/// Not implemented
+		leaf_base& operator= (const leaf_base&);
+};
+
+
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple>
+class dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::leaf_node : public leaf_base
+{
+	public:
+
+		value_type* values() { return reinterpret_cast<value_type*>(this->storage); }
+		const value_type* values() const { return reinterpret_cast<const value_type*>(this->storage); }
+
+
+	private:
+
+		alignas(value_type) unsigned char storage[leaf_capacity * sizeof(value_type)];
+};
+
+
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple>
+class dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::internal_node : public node_base
+{
+	public:
+
+		internal_node()
+			: node_base(false)
+		{}
+
+		key_type* keys() { return reinterpret_cast<key_type*>(this->storage); }
+		const key_type* keys() const { return reinterpret_cast<const key_type*>(this->storage); }
+
+		node_base* children[internal_capacity + 1];
+
+
+	private:
+
+		alignas(key_type) unsigned char storage[internal_capacity * sizeof(key_type)];
+};
+
+
+
+//
+// Value Compare
+
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple>
+class dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::value_compare
+{
+	public:
+
+		bool operator() (const value_type& a, const value_type& b) const
+		{
+			return comp( KeyOfValue()(a), KeyOfValue()(b) );
+		}
+
+
+	protected:
+
+		value_compare(const key_compare& c)
+			: comp(c)
+		{}
+
+		key_compare comp;
+
+
+	friend class dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>;
+};
+
+
+
+//
+// Iterators
+
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple>
+class dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::iterator
+{
+	private:
+
+		typedef typename dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::leaf_base leaf_base;
+		typedef typename dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::leaf_node leaf_node;
+
+
+	public:
+
+		typedef typename dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::value_type value_type;
+		typedef value_type* pointer;
+		typedef value_type& reference;
+		typedef typename dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::size_type size_type;
+		typedef typename dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::difference_type difference_type;
+
+
+		iterator() : n(0), i(0) {}
+		iterator(leaf_base* leaf, size_type index) : n(leaf), i(index) {}
+		iterator(const iterator& it) : n(it.n), i(it.i) {}
+		~iterator(){}
+
+		iterator& operator= (const iterator& it) { this->n = it.n; this->i = it.i; return *this; }
+
+		bool operator== (const iterator& it) const { return (this->n == it.n && this->i == it.i); }
+		bool operator!= (const iterator& it) const { return ! (*this == it); }
+
+		reference operator*() const { return static_cast<leaf_node*>(this->n)->values()[this->i]; }
+		pointer operator->() const { return &( static_cast<leaf_node*>(this->n)->values()[this->i] ); }
+
+		iterator& operator++()
+		{
+			if( ++(this->i) == this->n->count )
+			{
+				this->n = this->n->next;
+				this->i = 0;
+			}
+			return *this;
+		}
+		iterator operator++(int) { iterator temp(*this); ++(*this); return temp; }
+
+		iterator& operator--()
+		{
+			if( this->i == 0 )
+			{
+				this->n = this->n->prev;
+				this->i = this->n->count;
+			}
+			--(this->i);
+			return *this;
+		}
+		iterator operator--(int) { iterator temp(*this); --(*this); return temp; }
+
+
+	private:
+
+		leaf_base* n;
+		size_type i;
+
+
+	friend class btree;
+	friend class const_iterator;
+};
+
+
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple>
+class dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::const_iterator
+{
+	private:
+
+		typedef const typename dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::leaf_base leaf_base;
+		typedef const typename dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::leaf_node leaf_node;
+
+
+	public:
+
+		typedef const typename dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::value_type value_type;
+		typedef const value_type* pointer;
+		typedef const value_type& reference;
+		typedef typename dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::size_type size_type;
+		typedef typename dstd::impl::btree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::difference_type difference_type;
+
+
+		const_iterator() : n(0), i(0) {}
+		const_iterator(leaf_base* leaf, size_type index) : n(leaf), i(index) {}
+		const_iterator(const const_iterator& it) : n(it.n), i(it.i) {}
+		const_iterator(const iterator& it) : n(it.n), i(it.i) {}
+		~const_iterator(){}
+
+		const_iterator& operator= (const const_iterator& it) { this->n = it.n; this->i = it.i; return *this; }
+		const_iterator& operator= (const iterator& it) { this->n = it.n; this->i = it.i; return *this; }
+
+		bool operator== (const const_iterator& it) const { return (this->n == it.n && this->i == it.i); }
+		bool operator!= (const const_iterator& it) const { return ! (*this == it); }
+
+		reference operator*() const { return static_cast<leaf_node*>(this->n)->values()[this->i]; }
+		pointer operator->() const { return &( static_cast<leaf_node*>(this->n)->values()[this->i] ); }
+
+		const_iterator& operator++()
+		{
+			if( ++(this->i) == this->n->count )
+			{
+				this->n = this->n->next;
+				this->i = 0;
+			}
+			return *this;
+		}
+		const_iterator operator++(int) { const_iterator temp(*this); ++(*this); return temp; }
+
+		const_iterator& operator--()
+		{
+			if( this->i == 0 )
+			{
+				this->n = this->n->prev;
+				this->i = this->n->count;
+			}
+			--(this->i);
+			return *this;
+		}
+		const_iterator operator--(int) { const_iterator temp(*this); --(*this); return temp; }
+
+
+	private:
+
+		leaf_base* n;
+		size_type i;
+
+
+	friend class btree;
+};
+
+
+
+#endif
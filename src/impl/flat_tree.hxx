@@ -0,0 +1,406 @@
+#ifndef DSTD_IMPL_FLAT_TREE_HXX
+#define DSTD_IMPL_FLAT_TREE_HXX
+
+
+
+#include "vector_impl.hxx"
+#include "vector_iterator.hxx"
+
+#include "../algorithm.hxx"
+#include "../cstddef.hxx"
+#include "../functional.hxx"
+#include "../memory.hxx"
+#include "../utility.hxx"
+
+
+
+namespace dstd
+{
+	/// Tags a range which is already sorted and holds no equivalent keys.
+	class sorted_unique_t { public: sorted_unique_t() {} };
+	const sorted_unique_t sorted_unique = sorted_unique_t();
+
+	/// Tags a range which is already sorted.
+	class sorted_equivalent_t { public: sorted_equivalent_t() {} };
+	const sorted_equivalent_t sorted_equivalent = sorted_equivalent_t();
+
+	namespace impl
+	{
+		template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple> class flat_tree;
+	}
+}
+
+
+
+/// An ordered associative container stored as a sorted vector of values.
+/// Lookups are binary searches over contiguous memory, and there are no per-element nodes or pointers,
+/// but inserting or erasing an element moves every element after it.
+/// This suits containers which are built once, ideally in bulk, and then mostly read.
+template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple>
+class dstd::impl::flat_tree : public dstd::impl::vector_impl<Value, Allocator>
+{
+	private:
+
+		typedef dstd::impl::vector_impl<Value, Allocator> vector_impl;
+
+	public:
+
+		typedef Key key_type;
+		typedef Value value_type;
+		typedef typename vector_impl::size_type size_type;
+		typedef typename vector_impl::difference_type difference_type;
+		typedef Compare key_compare;
+		class value_compare;
+		typedef Allocator allocator_type;
+		typedef typename vector_impl::reference reference;
+		typedef typename vector_impl::const_reference const_reference;
+		typedef typename vector_impl::pointer pointer;
+		typedef typename vector_impl::const_pointer const_pointer;
+		typedef typename vector_impl::iterator iterator;
+		typedef typename vector_impl::const_iterator const_iterator;
+		typedef typename vector_impl::reverse_iterator reverse_iterator;
+		typedef typename vector_impl::const_reverse_iterator const_reverse_iterator;
+
+
+		/// Constructs an empty container with no elements.
+		explicit flat_tree(const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: vector_impl(alloc), comp(compare)
+		{}
+
+
+		/// Constructs a container with a copy of each of the elements in x.
+		flat_tree(const flat_tree& x)
+			: vector_impl(x.a), comp(x.comp)
+		{
+			this->insert_range(this->end(), x.begin(), x.end());
+		}
+
+
+		virtual ~flat_tree() {}
+
+
+		flat_tree& operator= (const flat_tree& x)
+		{
+			if( this != &x )
+			{
+				this->clear();
+				this->insert_range(this->end(), x.begin(), x.end());
+			}
+			return *this;
+		}
+
+
+		//
+		// Modifiers
+
+
+		/// Removes and destroys an element from the container, moving the elements after it forward.
+		/// @returns An iterator to the element which followed the removed element.
+		iterator erase(iterator position)
+		{
+			return this->erase_range(position, position + 1);
+		}
+
+
+		/// Removes and destroys the elements with key k.
+		/// @returns The number of elements erased
+		size_type erase(const key_type& k)
+		{
+			dstd::pair<iterator,iterator> range = this->equal_range(k);
+			const size_type n = static_cast<size_type>(range.second - range.first);
+			this->erase_range(range.first, range.second);
+			return n;
+		}
+
+
+		/// Removes and destroys the elements in the range [first,last).
+		/// @returns An iterator to the element which followed the last removed element.
+		iterator erase(iterator first, iterator last)
+		{
+			return this->erase_range(first, last);
+		}
+
+
+		/// Removes and destroys all elements from the container, leaving the container with a size of 0.
+		/// The capacity is kept.
+		void clear()
+		{
+			this->erase_range(this->begin(), this->end());
+		}
+
+
+		/// Exchanges the content of the container by the content of x.
+		void swap(flat_tree& x)
+		{
+			dstd::swap(this->p, x.p);
+			dstd::swap(this->n_data, x.n_data);
+			dstd::swap(this->n_memory, x.n_memory);
+			dstd::swap(this->comp, x.comp);
+			dstd::swap(this->a, x.a);
+		}
+
+
+		//
+		// Observers
+
+
+		/// Returns a copy of the comparison object used by the container to compare keys.
+		key_compare key_comp() const { return this->comp; }
+
+
+		/// Returns a comparison object that can be used to compare two elements to get whether
+		/// the key of the first one goes before the second.
+		value_compare value_comp() const { return value_compare(this->comp); }
+
+
+		//
+		// Operations
+
+
+		/// Searches the container for an element with a key equivalent to k.
+		/// @returns An iterator to the element if found, otherwise end().
+		iterator find(const key_type& k)
+		{
+			iterator it = this->lower_bound(k);
+			return ( it == this->end() || this->comp(k, KeyOfValue()(*it)) ) ? this->end() : it;
+		}
+		const_iterator find(const key_type& k) const { return const_cast<flat_tree*>(this)->find(k); }
+
+
+		/// Searches the container for elements with a key equivalent to k and returns the number of matches.
+		size_type count(const key_type& k) const
+		{
+			dstd::pair<const_iterator,const_iterator> range = this->equal_range(k);
+			return static_cast<size_type>(range.second - range.first);
+		}
+
+
+		/// Returns an iterator pointing to the first element in the container whose key is not considered to go before k.
+		iterator lower_bound(const key_type& k)
+		{
+			iterator first = this->begin();
+			difference_type n = static_cast<difference_type>(this->size());
+			while( n > 0 )
+			{
+				const difference_type half = n / 2;
+				iterator middle = first + half;
+				if( this->comp(KeyOfValue()(*middle), k) )
+				{
+					first = middle + 1;
+					n -= half + 1;
+				}
+				else
+				{
+					n = half;
+				}
+			}
+			return first;
+		}
+		const_iterator lower_bound(const key_type& k) const { return const_cast<flat_tree*>(this)->lower_bound(k); }
+
+
+		/// Returns an iterator pointing to the first element in the container whose key is considered to go after k.
+		iterator upper_bound(const key_type& k)
+		{
+			iterator first = this->begin();
+			difference_type n = static_cast<difference_type>(this->size());
+			while( n > 0 )
+			{
+				const difference_type half = n / 2;
+				iterator middle = first + half;
+				if( this->comp(k, KeyOfValue()(*middle)) )
+				{
+					n = half;
+				}
+				else
+				{
+					first = middle + 1;
+					n -= half + 1;
+				}
+			}
+			return first;
+		}
+		const_iterator upper_bound(const key_type& k) const { return const_cast<flat_tree*>(this)->upper_bound(k); }
+
+
+		/// Returns the bounds of a range that includes all the elements in the container which have a key equivalent to k.
+		dstd::pair<iterator,iterator> equal_range(const key_type& k)
+		{
+			return dstd::pair<iterator,iterator>( this->lower_bound(k), this->upper_bound(k) );
+		}
+		dstd::pair<const_iterator,const_iterator> equal_range(const key_type& k) const
+		{
+			return dstd::pair<const_iterator,const_iterator>( this->lower_bound(k), this->upper_bound(k) );
+		}
+
+
+		//
+		// Allocator
+
+
+		/// Returns a copy of the allocator object associated with the container.
+		allocator_type get_allocator() const { return this->a; }
+
+
+	protected:
+
+
+		/// Inserts value, if no element with an equivalent key exists.
+		/// Inserting after the last element does not search the container.
+		dstd::pair<iterator,bool> insert_unique(const value_type& value)
+		{
+			const key_type& k = KeyOfValue()(value);
+			if( this->empty() || this->comp(KeyOfValue()(*(this->end() - 1)), k) )
+			{
+				return dstd::pair<iterator,bool>( this->insert_value(this->end(), 1, value), true );
+			}
+
+			iterator it = this->lower_bound(k);
+			if( it != this->end() && ! this->comp(k, KeyOfValue()(*it)) )
+			{
+				return dstd::pair<iterator,bool>(it, false);
+			}
+			return dstd::pair<iterator,bool>( this->insert_value(it, 1, value), true );
+		}
+
+
+		/// Inserts value, if no element with an equivalent key exists.
+		/// If value belongs immediately before hint, the container is not searched.
+		iterator insert_unique(iterator hint, const value_type& value)
+		{
+			const key_type& k = KeyOfValue()(value);
+			if( ( hint == this->end() || this->comp(k, KeyOfValue()(*hint)) )
+				&& ( hint == this->begin() || this->comp(KeyOfValue()(*(hint - 1)), k) ) )
+			{
+				return this->insert_value(hint, 1, value);
+			}
+			return this->insert_unique(value).first;
+		}
+
+
+		/// Inserts value after any elements with an equivalent key.
+		/// Inserting after the last element does not search the container.
+		iterator insert_equal(const value_type& value)
+		{
+			const key_type& k = KeyOfValue()(value);
+			if( this->empty() || ! this->comp(k, KeyOfValue()(*(this->end() - 1))) )
+			{
+				return this->insert_value(this->end(), 1, value);
+			}
+			return this->insert_value(this->upper_bound(k), 1, value);
+		}
+
+
+		/// Inserts value after any elements with an equivalent key.
+		/// If value belongs immediately before hint, the container is not searched.
+		iterator insert_equal(iterator hint, const value_type& value)
+		{
+			const key_type& k = KeyOfValue()(value);
+			if( ( hint == this->end() || ! this->comp(KeyOfValue()(*hint), k) )
+				&& ( hint == this->begin() || ! this->comp(k, KeyOfValue()(*(hint - 1))) ) )
+			{
+				return this->insert_value(hint, 1, value);
+			}
+			return this->insert_equal(value);
+		}
+
+
+		/// Inserts the elements in the range [first,last) in bulk.
+		/// The elements are appended, the new elements alone are sorted, and then the two sorted runs are merged,
+		/// rather than searching for and opening a gap for each element in turn.
+		/// Of several elements with equivalent keys, only the first (or the existing element) is kept, unless AllowMultiple.
+		template <class InputIterator>
+		void insert_bulk(InputIterator first, InputIterator last)
+		{
+			const size_type n_old = this->size();
+			this->insert_range(this->end(), first, last);
+			this->merge_appended(n_old, false);
+		}
+
+
+		/// Inserts the elements in the sorted range [first,last) in bulk.
+		/// If the container is empty and the range holds no equivalent keys, this only copies the elements.
+		template <class InputIterator>
+		void insert_bulk_sorted(InputIterator first, InputIterator last)
+		{
+			const size_type n_old = this->size();
+			this->insert_range(this->end(), first, last);
+			if( n_old != 0 ) this->merge_appended(n_old, true);
+		}
+
+
+	private:
+
+
+		/// Restores the order of the container after the elements from n_old onwards have been appended.
+		void merge_appended(size_type n_old, bool appended_sorted)
+		{
+			const value_compare value_comp(this->comp);
+			iterator middle = this->begin() + static_cast<difference_type>(n_old);
+
+			if( ! appended_sorted )
+			{
+				dstd::stable_sort(middle, this->end(), value_comp);
+			}
+			dstd::inplace_merge(this->begin(), middle, this->end(), value_comp);
+
+			if( ! AllowMultiple )
+			{
+				this->erase_duplicates();
+			}
+		}
+
+
+		/// Removes all but the first of each run of elements with equivalent keys, from the sorted container.
+		void erase_duplicates()
+		{
+			if( this->empty() ) return;
+
+			iterator kept = this->begin();
+			for(iterator it = kept + 1; it != this->end(); ++it)
+			{
+				if( this->comp(KeyOfValue()(*kept), KeyOfValue()(*it)) )
+				{
+					++kept;
+					if( kept != it ) *kept = *it;
+				}
+			}
+			this->erase_range(kept + 1, this->end());
+		}
+
+
+		key_compare comp;
+};
+
+
+
+//
+// Value Compare
+
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple>
+class dstd::impl::flat_tree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::value_compare
+{
+	public:
+
+		bool operator() (const value_type& a, const value_type& b) const
+		{
+			return comp( KeyOfValue()(a), KeyOfValue()(b) );
+		}
+
+
+	protected:
+
+		value_compare(const key_compare& c)
+			: comp(c)
+		{}
+
+		key_compare comp;
+
+
+	friend class dstd::impl::flat_tree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>;
+};
+
+
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef DSTD_IMPL_GROWTH_POLICY_HXX
+#define DSTD_IMPL_GROWTH_POLICY_HXX
+
+#include "../cstddef.hxx"
+
+
+
+namespace dstd
+{
+	/// How a vector or string chooses its new capacity when it runs out of room.
+	enum growth_policy
+	{
+		grow_double,     ///< Double the capacity. Appending is amortized O(1), with up to half the memory unused.
+		grow_half,       ///< Grow the capacity by half. Appending is amortized O(1), with up to a third of the memory unused.
+		grow_exact,      ///< Allocate exactly what is needed. No memory is unused, but appending one at a time is O(n).
+		grow_page        ///< Double the capacity, then round blocks of a page or more up to a whole number of pages.
+	};
+
+	namespace impl
+	{
+		const size_t page_size = 4096;
+
+		inline size_t grown_capacity(growth_policy policy, size_t current, size_t required, size_t element_size, size_t max);
+
+		template <class Allocator, class T> bool resize_in_place(Allocator& a, T* p, size_t old_n, size_t new_n);
+	}
+}
+
+
+
+/// Returns the capacity a container should allocate, holding current elements of element_size bytes,
+/// so that it has room for at least required elements, which must be no more than max.
+inline size_t dstd::impl::grown_capacity(dstd::growth_policy policy, size_t current, size_t required, size_t element_size, size_t max)
+{
+	if( policy == dstd::grow_exact ) return required;
+
+	size_t n = ( current < 2 ) ? 2 : current;
+	while( n < required )
+	{
+		const size_t increase = ( policy == dstd::grow_half ) ? n / 2 : n;
+		n = ( increase > max - n ) ? max : n + increase;
+	}
+
+	if( policy == dstd::grow_page && n <= (max / element_size) && n * element_size >= page_size )
+	{
+		const size_t pages = (n * element_size + page_size - 1) / page_size;
+		const size_t rounded = (pages * page_size) / element_size;
+		if( rounded <= max ) n = rounded;
+	}
+
+	return n;
+}
+
+
+
+namespace dstd
+{
+	namespace impl
+	{
+		/// Used if the allocator has a resize_in_place member.
+		template <class Allocator, class T>
+		auto resize_in_place_member(Allocator& a, T* p, size_t old_n, size_t new_n, int) -> decltype( a.resize_in_place(p, old_n, new_n) )
+		{
+			return a.resize_in_place(p, old_n, new_n);
+		}
+
+		/// Used otherwise. The block cannot be resized.
+		template <class Allocator, class T>
+		bool resize_in_place_member(Allocator& /*a*/, T* /*p*/, size_t /*old_n*/, size_t /*new_n*/, long)
+		{
+			return false;
+		}
+	}
+}
+
+
+
+/// Asks a, if it is able, to resize the block at p from old_n to new_n objects without moving it.
+/// Allocators which can do this provide a member bool resize_in_place(T* p, size_t old_n, size_t new_n).
+/// @returns Whether the block now holds new_n objects. If not, the block is unchanged.
+template <class Allocator, class T>
+bool dstd::impl::resize_in_place(Allocator& a, T* p, size_t old_n, size_t new_n)
+{
+	return dstd::impl::resize_in_place_member(a, p, old_n, new_n, 0);
+}
+
+
+
+#endif
@@ -0,0 +1,782 @@
+#ifndef DSTD_IMPL_HASH_TABLE_HXX
+#define DSTD_IMPL_HASH_TABLE_HXX
+
+
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "../cstddef.hxx"
+#include "../functional.hxx"
+#include "../limits.hxx"
+#include "../memory.hxx"
+#include "../utility.hxx"
+
+
+
+namespace dstd
+{
+	namespace impl
+	{
+		class hash_group;
+		template <class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Allocator> class hash_table;
+	}
+}
+
+
+
+/// A group of consecutive control bytes of a hash_table, which are matched against a value all at once.
+/// With SSE2 the whole group is compared in a couple of instructions, otherwise byte by byte.
+/// Each match returns a bit mask, with bit i set if the i-th control byte of the group matched.
+class dstd::impl::hash_group
+{
+	public:
+
+		typedef signed char ctrl_type;
+
+		static const size_t width = 16;
+
+		// Control bytes of full slots hold the low 7 bits of their element's hash (0 to 127).
+		// The special values are negative, and ordered so that empty and deleted both compare less than sentinel.
+		static const ctrl_type empty = -128;
+		static const ctrl_type deleted = -2;
+		static const ctrl_type sentinel = -1;
+
+
+#ifdef __SSE2__
+
+		explicit hash_group(const ctrl_type* ctrl)
+			: ctrl( _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)) )
+		{}
+
+
+		/// Matches the slots whose control byte is h2.
+		unsigned int match(ctrl_type h2) const
+		{
+			return _mm_movemask_epi8( _mm_cmpeq_epi8(_mm_set1_epi8(h2), this->ctrl) );
+		}
+
+
+		/// Matches the slots which are empty.
+		unsigned int match_empty() const
+		{
+			return _mm_movemask_epi8( _mm_cmpeq_epi8(_mm_set1_epi8(empty), this->ctrl) );
+		}
+
+
+		/// Matches the slots which are empty or deleted, i.e. which are free for an insertion.
+		unsigned int match_free() const
+		{
+			return _mm_movemask_epi8( _mm_cmpgt_epi8(_mm_set1_epi8(sentinel), this->ctrl) );
+		}
+
+#else
+
+		explicit hash_group(const ctrl_type* ctrl)
+			: ctrl(ctrl)
+		{}
+
+
+		/// Matches the slots whose control byte is h2.
+		unsigned int match(ctrl_type h2) const
+		{
+			unsigned int mask = 0;
+			for(size_t i = 0; i < width; ++i)
+			{
+				if( this->ctrl[i] == h2 ) mask |= (1u << i);
+			}
+			return mask;
+		}
+
+
+		/// Matches the slots which are empty.
+		unsigned int match_empty() const
+		{
+			return this->match(empty);
+		}
+
+
+		/// Matches the slots which are empty or deleted, i.e. which are free for an insertion.
+		unsigned int match_free() const
+		{
+			unsigned int mask = 0;
+			for(size_t i = 0; i < width; ++i)
+			{
+				if( this->ctrl[i] < sentinel ) mask |= (1u << i);
+			}
+			return mask;
+		}
+
+#endif
+
+
+		/// Returns the index of the lowest set bit of a non-zero mask.
+		static size_t lowest(unsigned int mask)
+		{
+#ifdef __GNUC__
+			return __builtin_ctz(mask);
+#else
+			size_t i = 0;
+			for( ; (mask & 1u) == 0; mask >>= 1)
+			{
+				++i;
+			}
+			return i;
+#endif
+		}
+
+
+	private:
+
+#ifdef __SSE2__
+		__m128i ctrl;
+#else
+		const ctrl_type* ctrl;
+#endif
+};
+
+
+
+/// A hash table using open addressing, in the style of a "Swiss table".
+/// Elements are stored directly in a flat array of slots, alongside an array of one control byte per slot.
+/// A control byte records whether its slot is empty, deleted, or full, and for a full slot 7 bits of the element's hash.
+/// A lookup probes a group of 16 control bytes at a time, and only compares keys whose 7 hash bits match,
+/// so that most lookups read one group of control bytes and a single slot.
+/// The capacity is a power of two and a multiple of the group width, and the table is kept at most 7/8 full.
+template <class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Allocator>
+class dstd::impl::hash_table
+{
+	public:
+
+		typedef Key key_type;
+		typedef Value value_type;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+		typedef Hash hasher;
+		typedef KeyEqual key_equal;
+		typedef Allocator allocator_type;
+		typedef value_type& reference;
+		typedef const value_type& const_reference;
+		typedef value_type* pointer;
+		typedef const value_type* const_pointer;
+		class iterator;
+		class const_iterator;
+
+
+	protected:
+
+		typedef dstd::impl::hash_group::ctrl_type ctrl_type;
+		typedef typename Allocator::template rebind<value_type>::other value_allocator_type;
+		typedef typename Allocator::template rebind<ctrl_type>::other ctrl_allocator_type;
+
+		static const size_type group_width = dstd::impl::hash_group::width;
+
+
+	public:
+
+
+		/// Constructs an empty table with no elements.
+		/// No memory is allocated until the first element is inserted, unless a bucket count is given.
+		explicit hash_table(size_type bucket_count = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+			: a(alloc), a_ctrl(alloc), h(hash), eq(equal), ctrl(0), slots(0), capacity(0), n(0), growth_left(0)
+		{
+			this->rehash(bucket_count);
+		}
+
+
+		/// Constructs a table with a copy of each of the elements in x.
+		hash_table(const hash_table& x)
+			: a(x.a), a_ctrl(x.a_ctrl), h(x.h), eq(x.eq), ctrl(0), slots(0), capacity(0), n(0), growth_left(0)
+		{
+			this->copy_values(x);
+		}
+
+
+		/// Destroys the table including all its elements.
+		virtual ~hash_table()
+		{
+			this->clear();
+			this->deallocate(this->ctrl, this->slots, this->capacity);
+		}
+
+
+		hash_table& operator= (const hash_table& x)
+		{
+			if( this != &x )
+			{
+				this->clear();
+				this->copy_values(x);
+			}
+			return *this;
+		}
+
+
+		//
+		// Iterators
+
+
+		/// Returns an iterator referring to the first element in the container.
+		iterator begin()
+		{
+			iterator it(this->ctrl, this->slots);
+			if( this->ctrl != 0 ) it.skip_free();
+			return it;
+		}
+		const_iterator begin() const { return const_cast<hash_table*>(this)->begin(); }
+
+
+		/// Returns an iterator referring to the past-the-end element in the container.
+		iterator end() { return iterator(this->ctrl + this->capacity, this->slots + this->capacity); }
+		const_iterator end() const { return const_cast<hash_table*>(this)->end(); }
+
+
+		//
+		// Capacity
+
+
+		/// Returns whether the container is empty (i.e. whether its size is 0).
+		bool empty() const { return (this->n == 0); }
+
+
+		/// Returns the number of elements in the container.
+		size_type size() const { return this->n; }
+
+
+		/// Returns the maximum number of elements that the container can hold.
+		size_type max_size() const { return dstd::numeric_limits<size_type>::max() / sizeof(value_type); }
+
+
+		//
+		// Modifiers
+
+
+		/// Removes and destroys an element from the container.
+		/// Other iterators and references remain valid.
+		/// @returns An iterator to the element which followed the removed element.
+		iterator erase(const_iterator position)
+		{
+			iterator it(const_cast<ctrl_type*>(position.c), const_cast<value_type*>(position.p));
+			iterator next(it);
+			++next;
+			this->erase_index(it.c - this->ctrl);
+			return next;
+		}
+
+
+		/// Removes and destroys the element with key k, if there is one.
+		/// @returns The number of elements erased
+		size_type erase(const key_type& k)
+		{
+			size_type i = this->find_index(k, this->hash_of(k));
+			if( i == this->capacity ) return 0;
+			this->erase_index(i);
+			return 1;
+		}
+
+
+		/// Removes and destroys the elements in the range [first,last).
+		/// @returns An iterator to the element which followed the last removed element.
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			while( first != last )
+			{
+				first = this->erase(first);
+			}
+			return iterator(const_cast<ctrl_type*>(last.c), const_cast<value_type*>(last.p));
+		}
+
+
+		/// Removes and destroys all elements from the container, leaving the container with a size of 0.
+		/// The capacity of the table is kept.
+		void clear()
+		{
+			for(size_type i = 0; i < this->capacity; ++i)
+			{
+				if( this->ctrl[i] >= 0 )
+				{
+					this->a.destroy(this->slots + i);
+				}
+				this->ctrl[i] = dstd::impl::hash_group::empty;
+			}
+			this->n = 0;
+			this->growth_left = max_load(this->capacity);
+		}
+
+
+		/// Exchanges the content of the container by the content of x.
+		void swap(hash_table& x)
+		{
+			dstd::swap(this->h, x.h);
+			dstd::swap(this->eq, x.eq);
+			dstd::swap(this->ctrl, x.ctrl);
+			dstd::swap(this->slots, x.slots);
+			dstd::swap(this->capacity, x.capacity);
+			dstd::swap(this->n, x.n);
+			dstd::swap(this->growth_left, x.growth_left);
+
+			// the slots are exchanged, so the allocators which own them must be too
+			dstd::swap(this->a, x.a);
+			dstd::swap(this->a_ctrl, x.a_ctrl);
+		}
+
+
+		//
+		// Lookup
+
+
+		/// Searches the container for an element with a key equivalent to k.
+		/// @returns An iterator to the element if found, otherwise end().
+		iterator find(const key_type& k)
+		{
+			return this->make_iterator( this->find_index(k, this->hash_of(k)) );
+		}
+		const_iterator find(const key_type& k) const { return const_cast<hash_table*>(this)->find(k); }
+
+
+		/// Returns the number of elements with key k (either 0 or 1).
+		size_type count(const key_type& k) const
+		{
+			return ( this->find_index(k, this->hash_of(k)) == this->capacity ) ? 0 : 1;
+		}
+
+
+		/// Returns the range of elements with key k.
+		dstd::pair<iterator,iterator> equal_range(const key_type& k)
+		{
+			iterator first = this->find(k);
+			iterator last = first;
+			if( last != this->end() ) ++last;
+			return dstd::pair<iterator,iterator>(first, last);
+		}
+		dstd::pair<const_iterator,const_iterator> equal_range(const key_type& k) const
+		{
+			dstd::pair<iterator,iterator> range = const_cast<hash_table*>(this)->equal_range(k);
+			return dstd::pair<const_iterator,const_iterator>(range.first, range.second);
+		}
+
+
+		//
+		// Bucket interface
+
+
+		/// Returns the number of slots in the table.
+		size_type bucket_count() const { return this->capacity; }
+
+
+		//
+		// Hash policy
+
+
+		/// Returns the average number of elements per slot.
+		float load_factor() const
+		{
+			return ( this->capacity == 0 ) ? 0.0f : static_cast<float>(this->n) / static_cast<float>(this->capacity);
+		}
+
+
+		/// Returns the maximum load factor, above which the table grows.
+		float max_load_factor() const { return 0.875f; }
+
+
+		/// Sets the number of slots to at least count, and enough to hold the current elements.
+		void rehash(size_type count)
+		{
+			if( count < this->n ) count = this->n;
+			if( count == 0 && this->n == 0 ) return;
+
+			const size_type new_capacity = capacity_for(count);
+			if( new_capacity != this->capacity )
+			{
+				this->resize(new_capacity);
+			}
+		}
+
+
+		/// Makes room for at least count elements without rehashing.
+		void reserve(size_type count)
+		{
+			if( count > max_load(this->capacity) )
+			{
+				this->resize( capacity_for(count) );
+			}
+		}
+
+
+		//
+		// Observers
+
+
+		hasher hash_function() const { return this->h; }
+
+
+		key_equal key_eq() const { return this->eq; }
+
+
+		allocator_type get_allocator() const { return allocator_type(this->a); }
+
+
+	protected:
+
+
+		/// Inserts value, if no element with an equivalent key exists.
+		dstd::pair<iterator,bool> insert_unique(const value_type& value)
+		{
+			return this->emplace_unique( KeyOfValue()(value), value );
+		}
+
+
+		/// Inserts an element constructed in place from args, whose key must be k, if no element with an equivalent key exists.
+		/// k is hashed and the table probed once, and nothing is constructed if k already exists.
+		template <class... Args>
+		dstd::pair<iterator,bool> emplace_unique(const key_type& k, Args&&... args)
+		{
+			const size_type hash = this->hash_of(k);
+			size_type i = this->find_index(k, hash);
+			if( i != this->capacity )
+			{
+				return dstd::pair<iterator,bool>(this->make_iterator(i), false);
+			}
+
+			i = this->prepare_insert(hash);
+			this->a.construct( this->slots + i, dstd::forward<Args>(args)... );
+			this->set_full(i, hash);
+			return dstd::pair<iterator,bool>(this->make_iterator(i), true);
+		}
+
+
+	private:
+
+
+		/// The maximum number of elements held by a table of the given capacity.
+		static size_type max_load(size_type capacity)
+		{
+			return capacity - capacity / 8;
+		}
+
+
+		/// The smallest capacity which holds count elements.
+		static size_type capacity_for(size_type count)
+		{
+			size_type capacity = group_width;
+			while( max_load(capacity) < count )
+			{
+				capacity *= 2;
+			}
+			return capacity;
+		}
+
+
+		/// Mixes the bits of the user's hash, so that both the low 7 bits (stored in the control bytes)
+		/// and the higher bits (which choose the first group to probe) depend on every bit of the hash.
+		size_type hash_of(const key_type& k) const
+		{
+			size_type x = this->h(k) * static_cast<size_type>(0x9E3779B97F4A7C15ull);
+			return x ^ ( x >> (sizeof(size_type) * 4) );
+		}
+
+
+		static ctrl_type h2(size_type hash)
+		{
+			return static_cast<ctrl_type>(hash & 0x7F);
+		}
+
+
+		/// Returns the index of the slot holding key k, or capacity if there is none.
+		/// Groups are probed in a triangular sequence, which visits every group since their number is a power of two.
+		/// A key is never placed beyond a group with an empty slot, so the search stops at the first such group.
+		size_type find_index(const key_type& k, size_type hash) const
+		{
+			if( this->capacity == 0 ) return 0;
+
+			const size_type group_mask = this->capacity / group_width - 1;
+			const ctrl_type tag = h2(hash);
+			size_type g = (hash >> 7) & group_mask;
+			for(size_type step = 1; ; ++step)
+			{
+				const dstd::impl::hash_group group(this->ctrl + g * group_width);
+				for(unsigned int mask = group.match(tag); mask != 0; mask &= (mask - 1))
+				{
+					const size_type i = g * group_width + dstd::impl::hash_group::lowest(mask);
+					if( this->eq( k, KeyOfValue()(this->slots[i]) ) ) return i;
+				}
+				if( group.match_empty() != 0 ) return this->capacity;
+				g = (g + step) & group_mask;
+			}
+		}
+
+
+		/// Returns the index of the first free slot on the probe sequence of hash.
+		size_type find_free_index(size_type hash) const
+		{
+			const size_type group_mask = this->capacity / group_width - 1;
+			size_type g = (hash >> 7) & group_mask;
+			for(size_type step = 1; ; ++step)
+			{
+				const unsigned int mask = dstd::impl::hash_group(this->ctrl + g * group_width).match_free();
+				if( mask != 0 ) return g * group_width + dstd::impl::hash_group::lowest(mask);
+				g = (g + step) & group_mask;
+			}
+		}
+
+
+		/// Returns the index of the slot into which an element with the given hash should be inserted,
+		/// growing the table first if it is full.
+		/// A table full of deleted slots is rehashed at the same capacity, unless it is more than half full.
+		size_type prepare_insert(size_type hash)
+		{
+			if( this->capacity != 0 )
+			{
+				const size_type i = this->find_free_index(hash);
+				if( this->growth_left != 0 || this->ctrl[i] == dstd::impl::hash_group::deleted ) return i;
+			}
+
+			if( this->capacity == 0 ) this->resize(group_width);
+			else if( this->n * 2 < max_load(this->capacity) ) this->resize(this->capacity);
+			else this->resize(this->capacity * 2);
+
+			return this->find_free_index(hash);
+		}
+
+
+		/// Marks slot i, into which an element has just been constructed, as full.
+		void set_full(size_type i, size_type hash)
+		{
+			if( this->ctrl[i] == dstd::impl::hash_group::empty ) --(this->growth_left);
+			this->ctrl[i] = h2(hash);
+			++(this->n);
+		}
+
+
+		/// Destroys the element in slot i.
+		/// The slot can be marked empty if its group has another empty slot, since then no search has continued past it.
+		/// Otherwise it must be marked deleted, so that searches for keys placed beyond it do not stop there.
+		void erase_index(size_type i)
+		{
+			this->a.destroy(this->slots + i);
+			--(this->n);
+
+			const size_type group_start = i - (i % group_width);
+			if( dstd::impl::hash_group(this->ctrl + group_start).match_empty() != 0 )
+			{
+				this->ctrl[i] = dstd::impl::hash_group::empty;
+				++(this->growth_left);
+			}
+			else
+			{
+				this->ctrl[i] = dstd::impl::hash_group::deleted;
+			}
+		}
+
+
+		iterator make_iterator(size_type i)
+		{
+			return iterator(this->ctrl + i, this->slots + i);
+		}
+
+
+		/// Moves all elements into a new table of the given capacity, which drops all deleted slots.
+		void resize(size_type new_capacity)
+		{
+			ctrl_type* old_ctrl = this->ctrl;
+			value_type* old_slots = this->slots;
+			const size_type old_capacity = this->capacity;
+
+			this->allocate(new_capacity);
+			for(size_type i = 0; i < old_capacity; ++i)
+			{
+				if( old_ctrl[i] >= 0 )
+				{
+					const size_type hash = this->hash_of( KeyOfValue()(old_slots[i]) );
+					const size_type j = this->find_free_index(hash);
+					this->a.construct(this->slots + j, dstd::move_if_noexcept(old_slots[i]));
+					this->a.destroy(old_slots + i);
+					this->set_full(j, hash);
+				}
+			}
+
+			this->deallocate(old_ctrl, old_slots, old_capacity);
+		}
+
+
+		/// Copies the elements of x, which is known to hold no equivalent keys, into this empty table.
+		void copy_values(const hash_table& x)
+		{
+			if( x.n == 0 ) return;
+			this->reserve(x.n);
+			for(size_type i = 0; i < x.capacity; ++i)
+			{
+				if( x.ctrl[i] >= 0 )
+				{
+					const size_type hash = this->hash_of( KeyOfValue()(x.slots[i]) );
+					const size_type j = this->find_free_index(hash);
+					this->a.construct(this->slots + j, x.slots[i]);
+					this->set_full(j, hash);
+				}
+			}
+		}
+
+
+		/// Allocates empty arrays of the given capacity, leaving the table empty.
+		/// The control bytes are followed by a sentinel, at which iteration stops.
+		void allocate(size_type new_capacity)
+		{
+			this->ctrl = this->a_ctrl.allocate(new_capacity + 1);
+			this->slots = this->a.allocate(new_capacity);
+			for(size_type i = 0; i < new_capacity; ++i)
+			{
+				this->ctrl[i] = dstd::impl::hash_group::empty;
+			}
+			this->ctrl[new_capacity] = dstd::impl::hash_group::sentinel;
+			this->capacity = new_capacity;
+			this->n = 0;
+			this->growth_left = max_load(new_capacity);
+		}
+
+
+		void deallocate(ctrl_type* old_ctrl, value_type* old_slots, size_type old_capacity)
+		{
+			if( old_ctrl != 0 )
+			{
+				this->a_ctrl.deallocate(old_ctrl, old_capacity + 1);
+				this->a.deallocate(old_slots, old_capacity);
+			}
+		}
+
+
+		value_allocator_type a;
+		ctrl_allocator_type a_ctrl;
+		hasher h;
+		key_equal eq;
+		ctrl_type* ctrl;
+		value_type* slots;
+		size_type capacity;
+		size_type n;
+		size_type growth_left;
+};
+
+
+
+//
+// Iterators
+
+
+template <class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Allocator>
+class dstd::impl::hash_table<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::iterator
+{
+	private:
+
+		typedef dstd::impl::hash_group::ctrl_type ctrl_type;
+
+
+	public:
+
+		typedef typename dstd::impl::hash_table<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::value_type value_type;
+		typedef value_type* pointer;
+		typedef value_type& reference;
+		typedef typename dstd::impl::hash_table<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::size_type size_type;
+		typedef typename dstd::impl::hash_table<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::difference_type difference_type;
+
+
+		iterator() : c(0), p(0) {}
+		iterator(ctrl_type* ctrl, value_type* slot) : c(ctrl), p(slot) {}
+		iterator(const iterator& it) : c(it.c), p(it.p) {}
+		~iterator(){}
+
+		iterator& operator= (const iterator& it) { this->c = it.c; this->p = it.p; return *this; }
+
+		bool operator== (const iterator& it) const { return (this->c == it.c); }
+		bool operator!= (const iterator& it) const { return ! (*this == it); }
+
+		reference operator*() const { return *(this->p); }
+		pointer operator->() const { return this->p; }
+
+		iterator& operator++()
+		{
+			++(this->c);
+			++(this->p);
+			this->skip_free();
+			return *this;
+		}
+		iterator operator++(int) { iterator temp(*this); ++(*this); return temp; }
+
+
+	private:
+
+		/// Advances past empty and deleted slots, stopping at a full slot or the sentinel.
+		void skip_free()
+		{
+			while( *(this->c) < dstd::impl::hash_group::sentinel )
+			{
+				++(this->c);
+				++(this->p);
+			}
+		}
+
+		ctrl_type* c;
+		value_type* p;
+
+
+	friend class hash_table;
+	friend class const_iterator;
+};
+
+
+
+template <class Key, class Value, class KeyOfValue, class Hash, class KeyEqual, class Allocator>
+class dstd::impl::hash_table<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::const_iterator
+{
+	private:
+
+		typedef dstd::impl::hash_group::ctrl_type ctrl_type;
+
+
+	public:
+
+		typedef const typename dstd::impl::hash_table<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::value_type value_type;
+		typedef const value_type* pointer;
+		typedef const value_type& reference;
+		typedef typename dstd::impl::hash_table<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::size_type size_type;
+		typedef typename dstd::impl::hash_table<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::difference_type difference_type;
+
+
+		const_iterator() : c(0), p(0) {}
+		const_iterator(const const_iterator& it) : c(it.c), p(it.p) {}
+		const_iterator(const iterator& it) : c(it.c), p(it.p) {}
+		~const_iterator(){}
+
+		const_iterator& operator= (const const_iterator& it) { this->c = it.c; this->p = it.p; return *this; }
+		const_iterator& operator= (const iterator& it) { this->c = it.c; this->p = it.p; return *this; }
+
+		bool operator== (const const_iterator& it) const { return (this->c == it.c); }
+		bool operator!= (const const_iterator& it) const { return ! (*this == it); }
+
+		reference operator*() const { return *(this->p); }
+		pointer operator->() const { return this->p; }
+
+		const_iterator& operator++()
+		{
+			++(this->c);
+			++(this->p);
+			while( *(this->c) < dstd::impl::hash_group::sentinel )
+			{
+				++(this->c);
+				++(this->p);
+			}
+			return *this;
+		}
+		const_iterator operator++(int) { const_iterator temp(*this); ++(*this); return temp; }
+
+
+	private:
+
+		const ctrl_type* c;
+		value_type* p;
+
+
+	friend class hash_table;
+};
+
+
+
+#endif
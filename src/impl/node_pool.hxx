@@ -0,0 +1,142 @@
+#ifndef DSTD_IMPL_NODE_POOL_HXX
+#define DSTD_IMPL_NODE_POOL_HXX
+
+
+
+#include "../cstddef.hxx"
+#include "../memory.hxx"
+
+
+
+namespace dstd
+{
+	namespace impl
+	{
+		template <class T> class node_pool_block_size;
+		template <size_t BlockSize> class node_pool;
+	}
+}
+
+
+
+/// The size of the blocks in the node_pool which holds objects of type T.
+/// Blocks are at least as large as a pointer, so that a free block can hold the link to the next free block,
+/// and are a multiple of the pointer size, so that types of similar sizes share a pool.
+template <class T>
+class dstd::impl::node_pool_block_size
+{
+	public:
+
+		static const size_t value = ( (sizeof(T) + sizeof(void*) - 1) / sizeof(void*) ) * sizeof(void*);
+};
+
+
+
+/// A pool of fixed size blocks, carved in turn from large slabs and recycled through a free list.
+/// Allocating or freeing a block is a handful of pointer operations, and blocks which are allocated together
+/// are close together in memory.
+/// pool_allocator shares a single pool for each block size on each thread, whose slabs are never returned to the system,
+/// even when the thread ends, since its blocks may still be in use elsewhere. Freed blocks are reused.
+/// A pool_resource owns pools of its own, and releases them when it is destroyed.
+/// A pool is not thread safe, so each is only used by one thread.
+template <size_t BlockSize>
+class dstd::impl::node_pool
+{
+	public:
+
+		node_pool()
+			: free_list(0), slabs(0), unused(0), unused_end(0)
+		{}
+
+
+		/// Returns the pool for blocks of BlockSize bytes shared by every pool_allocator on the calling thread.
+		static node_pool& instance()
+		{
+			static thread_local node_pool pool;
+			return pool;
+		}
+
+
+		/// Returns a block of BlockSize bytes.
+		/// Throws bad_alloc if a new slab is needed and cannot be allocated.
+		void* allocate()
+		{
+			if( this->free_list != 0 )
+			{
+				free_block* block = this->free_list;
+				this->free_list = block->next;
+				return block;
+			}
+
+			if( this->unused == this->unused_end ) this->add_slab();
+
+			void* block = this->unused;
+			this->unused += BlockSize;
+			return block;
+		}
+
+
+		/// Returns a block, previously returned by allocate, to the pool.
+		void deallocate(void* p)
+		{
+			free_block* block = static_cast<free_block*>(p);
+			block->next = this->free_list;
+			this->free_list = block;
+		}
+
+
+		/// Returns every slab to the system, which frees every block at once.
+		/// Must not be called on a shared instance, whose blocks may be in use until the program ends.
+		void release()
+		{
+			while( this->slabs != 0 )
+			{
+				char* slab = this->slabs;
+				this->slabs = *reinterpret_cast<char**>(slab);
+				dstd::allocator<char>().deallocate( slab, BlockSize * blocks_per_slab );
+			}
+			this->free_list = 0;
+			this->unused = 0;
+			this->unused_end = 0;
+		}
+
+
+	private:
+
+		class free_block
+		{
+			public:
+
+				free_block* next;
+		};
+
+
+		/// Slabs are 64KiB, unless that is too small to hold 16 blocks.
+		static const size_t blocks_per_slab = (BlockSize * 16 > 65536) ? 16 : (65536 / BlockSize);
+
+
+		node_pool(const node_pool&);
+		node_pool& operator= (const node_pool&);
+
+
+		/// Allocates a new slab, whose blocks are handed out in order as they are needed.
+		/// The first block of each slab links to the previous slab, so that every slab stays reachable.
+		void add_slab()
+		{
+			char* slab = dstd::allocator<char>().allocate( BlockSize * blocks_per_slab );
+			*reinterpret_cast<char**>(slab) = this->slabs;
+			this->slabs = slab;
+			this->unused = slab + BlockSize;
+			this->unused_end = slab + BlockSize * blocks_per_slab;
+		}
+
+
+		free_block* free_list;
+		char* slabs;
+		char* unused;
+		char* unused_end;
+};
+
+
+
+#endif
@@ -0,0 +1,942 @@
+#ifndef DSTD_IMPL_NODE_TREE_HXX
+#define DSTD_IMPL_NODE_TREE_HXX
+
+
+
+#include <cstdlib>
+#include <limits>
+
+#include "red_black_tree.hxx"
+
+#include "../functional.hxx"
+#include "../iterator.hxx"
+#include "../memory.hxx"
+#include "../utility.hxx"
+
+
+
+namespace dstd
+{
+	namespace impl
+	{
+		template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple> class node_tree;
+	}
+}
+
+
+
+/// The part of map, multimap, set and multiset which does not depend on whether the key is the whole value.
+/// Each value is held in its own node of a red-black tree, and KeyOfValue extracts the key from a value.
+template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple>
+class dstd::impl::node_tree
+{
+	public:
+		
+		typedef Key key_type;
+		typedef Value value_type;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+		typedef Compare key_compare;
+		typedef Allocator allocator_type;
+		typedef typename allocator_type::reference reference;
+		typedef typename allocator_type::const_reference const_reference;
+		typedef typename allocator_type::pointer pointer;
+		typedef typename allocator_type::const_pointer const_pointer;
+		class iterator;
+		class const_iterator;
+		typedef dstd::reverse_iterator<iterator> reverse_iterator;
+		typedef dstd::reverse_iterator<const_iterator> const_reverse_iterator;
+		
+		
+	protected:
+		
+		class node_compare;
+		typedef dstd::impl::red_black_tree<value_type, node_compare, AllowMultiple> tree_type;
+		typedef typename tree_type::node node;
+		typedef typename Allocator::template rebind<typename tree_type::node>::other node_allocator_type;
+		
+		
+	public:
+		
+		
+		/// Constructs an empty container with no elements.
+		explicit node_tree(const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: a(alloc), comp(compare), tree(node_compare(compare))
+		{}
+		
+		
+		/// Destroys the container including all its elements
+		virtual ~node_tree()
+		{
+			this->clear();
+		}
+		
+		
+		//
+		// Iterators
+		
+		
+		/// Returns an iterator referring to the first element in the container.
+		/// If the container is empty, the returned iterator value shall not be dereferenced.
+		iterator begin()
+		{
+			return iterator( this->tree.left_most() );
+		}
+		
+		
+		const_iterator begin() const
+		{
+			return const_iterator( this->tree.left_most() );
+		}
+		
+		
+		/// Returns an iterator referring to the past-the-end element in the container.
+		/// If the container is empty, this function returns the same as begin.
+		iterator end()
+		{
+			return iterator( this->tree.header() );
+		}
+		
+		
+		const_iterator end() const
+		{
+			return const_iterator( this->tree.header() );
+		}
+		
+		
+		/// Returns a reverse iterator pointing to the last element in the container (i.e., its reverse beginning).
+		reverse_iterator rbegin()
+		{
+			return reverse_iterator( this->end() );
+		}
+		
+		
+		const_reverse_iterator rbegin() const
+		{
+			return const_reverse_iterator( this->end() );
+		}
+		
+		
+		/// Returns a reverse iterator pointing to the theoretical element right before the first element in the container
+		/// (which is considered its reverse end).
+		reverse_iterator rend()
+		{
+			return reverse_iterator( this->begin() );
+		}
+		
+		
+		const_reverse_iterator rend() const
+		{
+			return const_reverse_iterator( this->begin() );
+		}
+		
+		
+		//
+		// Capacity
+		
+		
+		/// Returns whether the container is empty (i.e. whether its size is 0).
+		bool empty() const
+		{
+			return( this->tree.empty() );
+		}
+		
+		
+		/// Returns the number of elements in the container.
+		size_type size() const
+		{
+			return this->tree.size();
+		}
+		
+		
+		/// Returns the maximum number of elements that the container can hold.
+		/// This is the maximum potential size the container can reach due to known system or library implementation limitations,
+		/// but the container is by no means guaranteed to be able to reach that size:
+		/// it can still fail to allocate storage at any point before that size is reached.
+		size_type max_size() const
+		{
+			return std::numeric_limits<size_type>::max();
+		}
+		
+		
+		//
+		// Modifiers
+		
+		
+		/// Removes and destroys an element from the container.
+		/// @param position Iterator to the element to be removed.
+		void erase(iterator position)
+		{
+			node* n = static_cast<node*>( position.p );
+			this->tree.remove( n );
+			this->a.destroy( n );
+			this->a.deallocate( n, 1 );
+		}
+		
+		
+		/// Removes and deletes elements with key k from the container.
+		/// @param k Key of the elements to be erased.
+		/// @returns The number of elements erased
+		size_type erase(const key_type& k)
+		{
+			dstd::pair<iterator,iterator> range = this->equal_range(k);
+			size_type n = this->size();
+			this->erase(range.first, range.second);
+			return (n - this->size());
+		}
+		
+		
+		/// Removes and deletes elements in the range [first,last) from the container.
+		/// @param first Iterator to the first element to be removed.
+		/// @param last Iterator to the first element not to be removed.
+		void erase(iterator first, iterator last)
+		{
+			while( first != last )
+			{
+				this->erase( first++ );
+			}
+		}
+		
+		
+		/// Removes all elements from the container (which are destroyed), leaving the container with a size of 0.
+		void clear()
+		{
+			// since removing nodes from a balanced tree could be expensive, instead just
+			// delete all nodes and reset the tree
+			this->delete_nodes( this->tree.root() );
+			this->tree.clear();
+		}
+		
+		
+		//
+		// Observers
+		
+		
+		/// Returns a copy of the comparison object used by the container to compare keys.
+		key_compare key_comp() const
+		{
+			return this->comp;
+		}
+		
+		
+		//
+		// Lookup
+		
+		
+		dstd::pair<iterator,iterator> equal_range(const key_type& key)
+		{
+			dstd::pair<const node*,const node*> equal = this->equal_range_nodes(key);
+			iterator lower = equal.first == 0 ? this->end() : iterator(const_cast<node*>(equal.first));
+			iterator upper = equal.second == 0 ? this->end() : iterator(const_cast<node*>(equal.second));
+			return dstd::pair<iterator,iterator>( lower, upper );
+		}
+		dstd::pair<const_iterator,const_iterator> equal_range(const key_type& key) const
+		{
+			dstd::pair<const node*,const node*> equal = this->equal_range_nodes(key);
+			const_iterator lower = equal.first == 0 ? this->end() : const_iterator(equal.first);
+			const_iterator upper = equal.second == 0 ? this->end() : const_iterator(equal.second);
+			return dstd::pair<const_iterator,const_iterator>( lower, upper );
+		}
+		
+		
+		/// Returns an iterator pointing to the first element in the container whose key is not considered to go before k
+		/// (i.e., either it is equivalent or goes after).
+		iterator lower_bound(const key_type& key)
+		{
+			node* n = const_cast<node*>( this->lower_bound_node(key) );
+			return ( n == 0 ? this->end() : iterator(n) );
+		}
+		const_iterator lower_bound(const key_type& key) const
+		{
+			const node* n = this->lower_bound_node(key);
+			return ( n == 0 ? this->end() : const_iterator(n) );
+		}
+		
+		
+		/// Returns an iterator pointing to the first element in the container whose key is considered to go after k.
+		iterator upper_bound(const key_type& key)
+		{
+			node* n = const_cast<node*>( this->upper_bound_node(key) );
+			return ( n == 0 ? this->end() : iterator(n) );
+		}
+		const_iterator upper_bound(const key_type& key) const
+		{
+			const node* n = this->upper_bound_node(key);
+			return ( n == 0 ? this->end() : const_iterator(n) );
+		}
+		
+		
+		//
+		// Allocator
+		
+		
+		/// Returns a copy of the allocator object associated with the container.
+		allocator_type get_allocator() const
+		{
+			return allocator_type(this->a);
+		}
+		
+		
+	protected:
+		
+		
+		const node* find_node(const key_type& k) const
+		{
+			const node* n = this->tree.root();
+			while( ! this->tree.is_null(n) )
+			{
+				if( this->comp(k, KeyOfValue()(n->value)) )
+				{
+					n = n->left_child();
+				}
+				else if( this->comp(KeyOfValue()(n->value), k) )
+				{
+					n = n->right_child();
+				}
+				else
+				{
+					return n;
+				}
+			}
+			
+			// we didn't find it
+			return 0;
+		}
+		
+		
+		/// Inserts value, searching the tree only once.
+		/// If AllowMultiple is false and an element with an equivalent key exists, no node is allocated.
+		/// Value is copied or moved into the new node, according to how it is passed.
+		/// @returns The inserted node, or the existing node, and whether value was inserted.
+		template <class V>
+		dstd::pair<node*, bool> insert_node(V&& value)
+		{
+			node* parent = 0;
+			bool left = true;
+			node* existing = this->find_insert_position(KeyOfValue()(value), parent, left);
+			if( existing != 0 ) return dstd::pair<node*, bool>(existing, false);
+			return dstd::pair<node*, bool>( this->create_node(dstd::forward<V>(value), parent, left), true );
+		}
+		
+		
+		/// Inserts an element constructed in place from args.
+		/// The node is built before the tree is searched, because its key is not known until then,
+		/// so if AllowMultiple is false and the key exists, the node is destroyed again.
+		/// @returns The inserted node, or the existing node, and whether a node was inserted.
+		template <class... Args>
+		dstd::pair<node*, bool> emplace_node(Args&&... args)
+		{
+			node* n = this->new_node( dstd::forward<Args>(args)... );
+			node* parent = 0;
+			bool left = true;
+			node* existing = this->find_insert_position(KeyOfValue()(n->value), parent, left);
+			return this->attach_node(n, existing, parent, left);
+		}
+		
+		
+		/// Inserts an element constructed in place from args, as close as possible before hint.
+		template <class... Args>
+		dstd::pair<node*, bool> emplace_node_hint(iterator hint, Args&&... args)
+		{
+			node* n = this->new_node( dstd::forward<Args>(args)... );
+			node* parent = 0;
+			bool left = true;
+			node* existing = this->find_hint_position(hint, KeyOfValue()(n->value), parent, left);
+			return this->attach_node(n, existing, parent, left);
+		}
+		
+		
+		/// Inserts the elements in the range [first,last).
+		/// If the container is empty, the elements are copied into nodes for as long as they arrive in order,
+		/// and those nodes are linked into a balanced tree in linear time, without searching or rebalancing.
+		/// Elements from the first one out of order (or, unless AllowMultiple, equivalent to its predecessor)
+		/// onwards are inserted one at a time, hinted at the end so that a sorted range appended to
+		/// a non-empty container is not searched either.
+		template <class InputIterator>
+		void insert_range(InputIterator first, InputIterator last)
+		{
+			if( this->empty() )
+			{
+				node* chain = 0;
+				node* chain_last = 0;
+				size_type count = 0;
+				try
+				{
+					for( ; first != last; ++first)
+					{
+						const value_type& value = *first;
+						if( chain_last != 0 )
+						{
+							const key_type& k = KeyOfValue()(value);
+							const key_type& k_last = KeyOfValue()(chain_last->value);
+							if( AllowMultiple ? this->comp(k, k_last) : ! this->comp(k_last, k) ) break;
+						}
+						
+						node* n = this->new_node(value);
+						if( chain_last == 0 ) chain = n;
+						else chain_last->right = n;
+						chain_last = n;
+						++count;
+					}
+				}
+				catch(...)
+				{
+					// hand the nodes built so far to the tree, so that they are destroyed with it
+					this->tree.assign_balanced(chain, count);
+					throw;
+				}
+				this->tree.assign_balanced(chain, count);
+			}
+			
+			for( ; first != last; ++first)
+			{
+				const value_type& value = *first;
+				this->insert_node(this->end(), value);
+			}
+		}
+		
+		
+		/// Inserts value as close as possible before hint, searching the tree only if value does not belong next to hint.
+		/// When value belongs immediately before or after hint, it is attached beside its neighbour without a descent
+		/// from the root, and rebalancing afterwards is amortized O(1). Inserting in order with end(), or the element
+		/// last inserted, as the hint therefore costs amortized constant time.
+		/// @returns The inserted node, or the existing node, and whether value was inserted.
+		template <class V>
+		dstd::pair<node*, bool> insert_node(iterator hint, V&& value)
+		{
+			node* parent = 0;
+			bool left = true;
+			node* existing = this->find_hint_position(hint, KeyOfValue()(value), parent, left);
+			if( existing != 0 ) return dstd::pair<node*, bool>(existing, false);
+			return dstd::pair<node*, bool>( this->create_node(dstd::forward<V>(value), parent, left), true );
+		}
+		
+		
+		/// Finds where a node with key k should be attached, as close as possible before hint.
+		/// The tree is only searched if k does not belong next to hint.
+		/// @returns As for find_insert_position.
+		node* find_hint_position(iterator hint, const key_type& k, node*& parent, bool& left)
+		{
+			node* before = 0; // the node which value should follow, or 0 if value should be first
+			node* after = 0;  // the node which value should precede, or 0 if value should be last
+			bool after_hint = false; // whether k goes after the hint's key
+			
+			if( hint.p == this->tree.header() )
+			{
+				if( ! this->empty() ) before = this->tree.right_most();
+			}
+			else
+			{
+				node* h = static_cast<node*>( hint.p );
+				if( this->comp(KeyOfValue()(h->value), k) )
+				{
+					before = h;
+					after_hint = true;
+					if( h != this->tree.right_most() ) after = h->next();
+				}
+				else if( AllowMultiple || this->comp(k, KeyOfValue()(h->value)) )
+				{
+					after = h;
+					if( h != this->tree.left_most() ) before = h->prev();
+				}
+				else
+				{
+					return h;
+				}
+			}
+			
+			const bool fits_before = ( before == 0 || this->may_follow(k, KeyOfValue()(before->value)) );
+			const bool fits_after = ( after == 0 || this->may_follow(KeyOfValue()(after->value), k) );
+			if( ! fits_before || ! fits_after )
+			{
+				// Among equivalent keys, the nearest position to a hint before them is before them all
+				if( AllowMultiple && after_hint ) return this->find_lower_insert_position(k, parent, left);
+				return this->find_insert_position(k, parent, left);
+			}
+			
+			// before and after are neighbours, so at least one of them has a free child between them
+			if( before != 0 && this->tree.is_null(before->right) )
+			{
+				parent = before;
+				left = false;
+			}
+			else
+			{
+				parent = after;
+				left = true;
+			}
+			return 0;
+		}
+		
+		
+		/// Returns whether a node with key k may be placed immediately after a node with key k_before,
+		/// i.e. whether k goes after k_before or, if AllowMultiple, is equivalent to it.
+		bool may_follow(const key_type& k, const key_type& k_before) const
+		{
+			return AllowMultiple ? ! this->comp(k, k_before) : this->comp(k_before, k);
+		}
+		
+		
+		/// Descends the tree looking for key k.
+		/// @returns The node with key k if there is one and AllowMultiple is false. Otherwise returns 0,
+		/// and sets parent and left to the position at which a node with key k should be attached,
+		/// which is after any nodes with an equivalent key.
+		node* find_insert_position(const key_type& k, node*& parent, bool& left)
+		{
+			node* n = this->tree.root();
+			while( ! this->tree.is_null(n) )
+			{
+				parent = n;
+				if( this->comp(k, KeyOfValue()(n->value)) )
+				{
+					left = true;
+					n = n->left_child();
+				}
+				else if( AllowMultiple || this->comp(KeyOfValue()(n->value), k) )
+				{
+					left = false;
+					n = n->right_child();
+				}
+				else
+				{
+					return n;
+				}
+			}
+			return 0;
+		}
+		
+		
+		/// As find_insert_position, but the position found is before any nodes with an equivalent key, and 0 is always returned.
+		node* find_lower_insert_position(const key_type& k, node*& parent, bool& left)
+		{
+			node* n = this->tree.root();
+			while( ! this->tree.is_null(n) )
+			{
+				parent = n;
+				left = ! this->comp(KeyOfValue()(n->value), k);
+				n = left ? n->left_child() : n->right_child();
+			}
+			return 0;
+		}
+		
+		
+		/// Allocates a node holding value, and attaches it to the tree at the position found by find_insert_position.
+		template <class V>
+		node* create_node(V&& value, node* parent, bool left)
+		{
+			node* n = this->new_node( dstd::forward<V>(value) );
+			this->tree.insert_at(n, parent, left);
+			return n;
+		}
+		
+		
+		/// Allocates a node, and constructs its value from args. The node is not attached to the tree.
+		template <class... Args>
+		node* new_node(Args&&... args)
+		{
+			node* n = this->a.allocate(1);
+			try
+			{
+				this->a.construct( n, dstd::forward<Args>(args)... );
+			}
+			catch(...)
+			{
+				this->a.deallocate(n, 1);
+				throw;
+			}
+			return n;
+		}
+		
+		
+		/// Attaches n at the position found by find_insert_position, or destroys it if an equivalent node exists.
+		dstd::pair<node*, bool> attach_node(node* n, node* existing, node* parent, bool left)
+		{
+			if( existing != 0 )
+			{
+				this->a.destroy(n);
+				this->a.deallocate(n, 1);
+				return dstd::pair<node*, bool>(existing, false);
+			}
+			this->tree.insert_at(n, parent, left);
+			return dstd::pair<node*, bool>(n, true);
+		}
+		
+		
+		/// Exchanges the elements, comparison object and allocator of this container with those of x.
+		/// The allocators go with the nodes which they allocated.
+		void swap_base(node_tree& x)
+		{
+			this->tree.swap(x.tree);
+			dstd::swap(this->comp, x.comp);
+			dstd::swap(this->a, x.a);
+		}
+		
+		
+		void delete_nodes(node* root)
+		{
+			if( ! this->tree.is_null( root ) )
+			{
+				this->delete_nodes( root->left_child() );
+				this->delete_nodes( root->right_child() );
+				this->a.destroy(root);
+				this->a.deallocate(root, 1);
+			}
+		}
+		
+		
+		const node* lower_bound_node(const key_type& k) const
+		{
+			if( this->empty() ) return 0;
+			
+			const node* n = this->tree.root();
+			while( true )
+			{
+				if( this->comp( KeyOfValue()(n->value), k ) )
+				{
+					if( this->tree.is_null( n->right ) )
+					{
+						// We have reached a leaf. k doesn't exist.
+						// But this leaf goes before k, so increment before returning
+						return n->next();
+					}
+					else
+					{
+						n = n->right_child();
+					}
+				}
+				else
+				{
+					if( this->tree.is_null( n->left ) )
+					{
+						// we have reached a leaf. k may or may not exist.
+						return n;
+					}
+					else
+					{
+						n = n->left_child();
+					}
+				}
+			}
+		}
+		
+		
+		const node* upper_bound_node(const key_type& k) const
+		{
+			const node* n = this->lower_bound_node(k);
+			while( ! this->tree.is_null(n) && ! this->comp(k, KeyOfValue()(n->value)) )
+			{
+				n = n->next();
+			}
+			return n;
+		}
+		
+		
+		dstd::pair<const node*, const node*> equal_range_nodes(const key_type& k) const
+		{
+			const node* lower = this->lower_bound_node(k);
+			const node* upper = lower;
+			while( ! this->tree.is_null(upper) && ! this->comp(k, KeyOfValue()(upper->value)) )
+			{
+				upper = upper->next();
+			}
+			return dstd::pair<const node*, const node*>(lower, upper);
+		}
+		
+		
+		/// Returns true if the two keys are considered to be equivalent
+		bool keys_equal(const key_type& a, const key_type& b) const
+		{
+			return ( ! this->comp(a,b) && ! this->comp(b,a) );
+		}
+		
+		
+		node_allocator_type a;
+		key_compare comp;
+		tree_type tree;
+};
+
+
+
+/// Orders the values in the tree by their keys.
+template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple>
+class dstd::impl::node_tree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::node_compare
+{
+	public:
+		
+		typedef typename dstd::impl::node_tree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::key_compare key_compare;
+		typedef typename dstd::impl::node_tree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::value_type value_type;
+		
+		
+		node_compare(const key_compare& c)
+			: comp(c)
+		{}
+		
+		
+		bool operator() (const value_type& a, const value_type& b) const
+		{
+			return comp( KeyOfValue()(a), KeyOfValue()(b) );
+		}
+		
+		
+	private:
+		
+		key_compare comp;
+};
+
+
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple>
+class dstd::impl::node_tree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::iterator
+{
+	private:
+		
+		typedef dstd::impl::binary_tree::node node_base;
+		typedef typename dstd::impl::node_tree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::tree_type::node node;
+		
+		
+	public:
+		
+		typedef typename dstd::impl::node_tree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::value_type value_type;
+		typedef value_type* pointer;
+		typedef value_type& reference;
+		typedef typename dstd::impl::node_tree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::size_type size_type;
+		typedef typename dstd::impl::node_tree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::difference_type difference_type;
+		
+		
+		iterator()
+			: p(0)
+		{}
+		
+		
+		iterator(node_base* ptr)
+			: p(ptr)
+		{}
+		
+		
+		iterator(node* ptr)
+			: p(static_cast<node_base*>(ptr))
+		{}
+		
+		
+		iterator(const iterator& it)
+			: p(it.p)
+		{}
+		
+		
+		~iterator(){}
+		
+		
+		iterator& operator= (const iterator& it)
+		{
+			this->p = it.p;
+			return *this;
+		}
+		
+		
+		bool operator== (const iterator& it) const
+		{
+			return (this->p == it.p);
+		}
+		
+		
+		bool operator!= (const iterator& it) const
+		{
+			return ! (*this == it);
+		}
+		
+		
+		reference operator*()
+		{
+			return static_cast<node*>( this->p )->value;
+		}
+		
+		
+		const reference operator*() const
+		{
+			return static_cast<node*>( this->p )->value;
+		}
+		
+		
+		pointer operator->()
+		{
+			return &(static_cast<node*>( this->p )->value);
+		}
+		
+		
+		const pointer operator->() const
+		{
+			return &(static_cast<node*>( this->p )->value);
+		}
+		
+		
+		iterator operator++()
+		{
+			this->p = this->p->next();
+			return *this;
+		}
+		
+		
+		iterator operator++(int)
+		{
+			iterator temp(*this);
+			++(*this);
+			return temp;
+		}
+		
+		
+		iterator operator--()
+		{
+			this->p = this->p->prev();
+			return *this;
+		}
+		
+		
+		iterator operator--(int)
+		{
+			iterator temp(*this);
+			--(*this);
+			return temp;
+		}
+		
+		
+	private:
+		
+		node_base* p;
+		
+		
+	friend class node_tree;
+};
+
+
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Allocator, bool AllowMultiple>
+class dstd::impl::node_tree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::const_iterator
+{
+	private:
+		
+		typedef const typename dstd::impl::binary_tree::node node_base;
+		typedef const typename dstd::impl::node_tree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::node node;
+		
+		
+	public:
+		
+		typedef const typename dstd::impl::node_tree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::value_type value_type;
+		typedef const value_type* pointer;
+		typedef const value_type& reference;
+		typedef typename dstd::impl::node_tree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::size_type size_type;
+		typedef typename dstd::impl::node_tree<Key, Value, KeyOfValue, Compare, Allocator, AllowMultiple>::difference_type difference_type;
+		
+		
+		const_iterator()
+			: p(0)
+		{}
+		
+		
+		const_iterator(node_base* ptr)
+			: p(ptr)
+		{}
+		
+		
+		const_iterator(node* ptr)
+			: p(static_cast<node_base*>(ptr))
+		{}
+		
+		
+		const_iterator(const const_iterator& it)
+			: p(it.p)
+		{}
+		
+		
+		const_iterator(const iterator& it)
+			: p(it.p)
+		{}
+		
+		
+		~const_iterator(){}
+		
+		
+		const_iterator& operator= (const iterator& it)
+		{
+			this->p = it.p;
+			return *this;
+		}
+		
+		
+		const_iterator& operator= (const const_iterator& it)
+		{
+			this->p = it.p;
+			return *this;
+		}
+		
+		
+		bool operator== (const const_iterator& it) const
+		{
+			return (this->p == it.p);
+		}
+		
+		
+		bool operator!= (const const_iterator& it) const
+		{
+			return ! (*this == it);
+		}
+		
+		
+		reference operator*() const
+		{
+			return static_cast<node*>( this->p )->value;
+		}
+		
+		
+		pointer operator->()
+		{
+			return &(static_cast<node*>( this->p )->value);
+		}
+		
+		
+		const pointer operator->() const
+		{
+			return &(static_cast<node*>( this->p )->value);
+		}
+		
+		
+		const_iterator operator++()
+		{
+			this->p = this->p->next();
+			return *this;
+		}
+		
+		
+		const_iterator operator++(int)
+		{
+			const_iterator temp(*this);
+			++(*this);
+			return temp;
+		}
+		
+		
+		const_iterator operator--()
+		{
+			this->p = this->p->prev();
+			return *this;
+		}
+		
+		
+		const_iterator operator--(int)
+		{
+			const_iterator temp(*this);
+			--(*this);
+			return temp;
+		}
+		
+		
+	private:
+		
+		node_base* p;
+		
+		
+	friend class node_tree;
+};
+
+
+
+#endif
@@ -4,10 +4,8 @@
 
 
 #include "binary_search_tree.hxx"
-
-
-
-// TODO
+#include "../functional.hxx"
+#include "../utility.hxx"
 
 
 
@@ -21,35 +19,320 @@ namespace dstd
 
 
 
-template <class T, class Compare, bool AllowEqual>
+/// A binary search tree which keeps itself balanced by colouring each node red or black, such that:
+///   - the root is black,
+///   - a red node never has a red child,
+///   - every path from a node down to a null child passes through the same number of black nodes.
+/// The longest path from the root is therefore at most twice the shortest, so the height is O(log n).
+template <class T, class Compare = dstd::less<T>, bool AllowEqual = false>
 class dstd::impl::red_black_tree : public dstd::impl::binary_search_tree<T, Compare, AllowEqual>
 {
 	public:
-		
+
 		typedef binary_search_tree<T, Compare, AllowEqual> tree_base;
-		
-		class node : public tree_base::node
+		typedef typename tree_base::value_type value_type;
+		typedef typename tree_base::size_type size_type;
+		class node;
+
+
+		red_black_tree(const Compare& compare = Compare())
+			: tree_base(compare)
+		{}
+
+
+		/// Makes an empty tree hold the count nodes chained from first through their right pointers,
+		/// which must already be in order, arranged as a perfectly balanced tree in O(count).
+		/// Every node is black except those on the deepest level, which are red. That level is the
+		/// only one which may be incomplete, so every path to a null child passes the same number of black nodes.
+		void assign_balanced(node* first, size_type count)
 		{
-			public:
-				
-				bool colour;
-		};
+			this->tree_base::assign_balanced(first, count);
+			
+			size_type red_depth = 0;
+			for(size_type i = count; i > 1; i /= 2) ++red_depth;
+			this->colour_balanced(this->root(), 0, red_depth);
+		}
+		
 		
+		node* find(const value_type& value) { return static_cast<node*>( this->tree_base::find(value) ); }
+		const node* find(const value_type& value) const { return static_cast<const node*>( this->tree_base::find(value) ); }
+
+
+		/// Inserts n into the tree, then recolours and rotates to restore the red-black properties.
+		/// @returns n, or the existing node with an equal value if AllowEqual is false.
 		node* insert(node* n, node* parent = 0)
 		{
-			node* new_node = this->tree_base::insert(n, parent);
+			n->colour = node::red;
+			node* new_node = static_cast<node*>( this->tree_base::insert(n, parent) );
 			if( new_node == n )
 			{
-				// this is where the tree must be re-ordered in response
+				this->insert_rebalance(n);
 			}
 			return new_node;
 		}
-		
+
+
+		/// Attaches n as the left or right child of parent (or as the root if parent is null),
+		/// then recolours and rotates to restore the red-black properties.
+		void insert_at(node* n, node* parent, bool left)
+		{
+			n->colour = node::red;
+			this->tree_base::insert_at(n, parent, left);
+			this->insert_rebalance(n);
+		}
+
+
+		node* left_most() { return static_cast<node*>( this->tree_base::left_most() ); }
+		const node* left_most() const { return static_cast<const node*>( this->tree_base::left_most() ); }
+
+
+		/// Removes n from the tree, then recolours and rotates to restore the red-black properties.
+		/// n is not destroyed.
 		void remove(node* n)
 		{
+			if( ! this->is_null(n->left) && ! this->is_null(n->right) )
+			{
+				// Swap n with its predecessor so that it has at most one child.
+				// The colours belong to the positions in the tree, not to the nodes.
+				node* prev = n->prev();
+				this->swap(n, prev);
+				typename node::colour_type temp = n->colour;
+				n->colour = prev->colour;
+				prev->colour = temp;
+			}
+
+			node* child = this->is_null(n->left) ? n->right_child() : n->left_child();
+			if( this->is_null(child) ) child = 0;
+			node* parent = n->parent();
+			const bool left_child = ( ! this->is_null(parent) && parent->left == n );
+			const bool removed_black = ( n->colour == node::black );
+
 			this->tree_base::remove(n);
-			// this is where the tree mush be re-ordered in response
+
+			if( removed_black )
+			{
+				this->remove_rebalance(child, parent, left_child);
+			}
+		}
+
+
+		node* right_most() { return static_cast<node*>( this->tree_base::right_most() ); }
+		const node* right_most() const { return static_cast<const node*>( this->tree_base::right_most() ); }
+
+
+		node* root() { return static_cast<node*>( this->tree_base::root() ); }
+		const node* root() const { return static_cast<const node*>( this->tree_base::root() ); }
+
+
+	private:
+
+		/// Null children (including the header) are black
+		bool is_red(const binary_tree::node* n) const
+		{
+			return ( ! this->is_null(n) && static_cast<const node*>(n)->colour == node::red );
+		}
+
+
+		/// Colours the subtree rooted at n, which is at the given depth, after assign_balanced.
+		void colour_balanced(node* n, size_type depth, size_type red_depth)
+		{
+			if( this->is_null(n) ) return;
+			
+			n->colour = ( depth == red_depth && depth != 0 ) ? node::red : node::black;
+			this->colour_balanced(n->left_child(), depth + 1, red_depth);
+			this->colour_balanced(n->right_child(), depth + 1, red_depth);
 		}
+		
+		
+		void insert_rebalance(node* n)
+		{
+			while( n != this->root() && this->is_red( n->parent() ) )
+			{
+				node* parent = n->parent();
+				node* grandparent = parent->parent(); // the parent is red, so it cannot be the root
+
+				if( parent == grandparent->left )
+				{
+					node* uncle = grandparent->right_child();
+					if( this->is_red(uncle) )
+					{
+						parent->colour = node::black;
+						uncle->colour = node::black;
+						grandparent->colour = node::red;
+						n = grandparent;
+					}
+					else
+					{
+						if( n == parent->right )
+						{
+							n = parent;
+							this->rotate_left(n);
+							parent = n->parent();
+						}
+						parent->colour = node::black;
+						grandparent->colour = node::red;
+						this->rotate_right(grandparent);
+					}
+				}
+				else
+				{
+					node* uncle = grandparent->left_child();
+					if( this->is_red(uncle) )
+					{
+						parent->colour = node::black;
+						uncle->colour = node::black;
+						grandparent->colour = node::red;
+						n = grandparent;
+					}
+					else
+					{
+						if( n == parent->left )
+						{
+							n = parent;
+							this->rotate_right(n);
+							parent = n->parent();
+						}
+						parent->colour = node::black;
+						grandparent->colour = node::red;
+						this->rotate_left(grandparent);
+					}
+				}
+			}
+
+			this->root()->colour = node::black;
+		}
+
+
+		/// Restores the red-black properties after a black node was removed.
+		/// @param n The node which took the place of the removed node (or 0 if none did).
+		/// @param parent The parent of n.
+		/// @param left_child Whether n is the left child of parent.
+		void remove_rebalance(node* n, node* parent, bool left_child)
+		{
+			// Every path through n is one black node short
+			while( ! this->is_null(parent) && ! this->is_red(n) )
+			{
+				if( left_child )
+				{
+					node* sibling = parent->right_child();
+					if( this->is_red(sibling) )
+					{
+						sibling->colour = node::black;
+						parent->colour = node::red;
+						this->rotate_left(parent);
+						sibling = parent->right_child();
+					}
+
+					if( ! this->is_red(sibling->left) && ! this->is_red(sibling->right) )
+					{
+						sibling->colour = node::red;
+						n = parent;
+						parent = n->parent();
+						left_child = ( ! this->is_null(parent) && parent->left == n );
+					}
+					else
+					{
+						if( ! this->is_red(sibling->right) )
+						{
+							sibling->left_child()->colour = node::black;
+							sibling->colour = node::red;
+							this->rotate_right(sibling);
+							sibling = parent->right_child();
+						}
+						sibling->colour = parent->colour;
+						parent->colour = node::black;
+						sibling->right_child()->colour = node::black;
+						this->rotate_left(parent);
+						n = this->root();
+						break;
+					}
+				}
+				else
+				{
+					node* sibling = parent->left_child();
+					if( this->is_red(sibling) )
+					{
+						sibling->colour = node::black;
+						parent->colour = node::red;
+						this->rotate_right(parent);
+						sibling = parent->left_child();
+					}
+
+					if( ! this->is_red(sibling->left) && ! this->is_red(sibling->right) )
+					{
+						sibling->colour = node::red;
+						n = parent;
+						parent = n->parent();
+						left_child = ( ! this->is_null(parent) && parent->left == n );
+					}
+					else
+					{
+						if( ! this->is_red(sibling->left) )
+						{
+							sibling->right_child()->colour = node::black;
+							sibling->colour = node::red;
+							this->rotate_left(sibling);
+							sibling = parent->left_child();
+						}
+						sibling->colour = parent->colour;
+						parent->colour = node::black;
+						sibling->left_child()->colour = node::black;
+						this->rotate_right(parent);
+						n = this->root();
+						break;
+					}
+				}
+			}
+
+			if( n != 0 ) n->colour = node::black;
+		}
+};
+
+
+
+template <class T, class Compare, bool AllowEqual>
+class dstd::impl::red_black_tree<T, Compare, AllowEqual>::node : public dstd::impl::binary_search_tree<T, Compare, AllowEqual>::node
+{
+	private:
+
+		typedef typename dstd::impl::binary_search_tree<T, Compare, AllowEqual>::node node_base;
+
+
+	public:
+
+		typedef typename dstd::impl::red_black_tree<T, Compare, AllowEqual>::value_type value_type;
+		enum colour_type { red, black };
+
+
+		template <class... Args>
+		explicit node(Args&&... args)
+			: node_base( dstd::forward<Args>(args)... ), colour(red)
+		{}
+
+
+		node* left_child() { return static_cast<node*>( this->left ); }
+		const node* left_child() const { return static_cast<const node*>( this->left ); }
+
+
+		node* next() { return static_cast<node*>( node_base::next() ); }
+		const node* next() const { return static_cast<const node*>( node_base::next() ); }
+
+
+		node* parent() { return static_cast<node*>( this->up ); }
+		const node* parent() const { return static_cast<const node*>( this->up ); }
+
+
+		node* prev() { return static_cast<node*>( node_base::prev() ); }
+		const node* prev() const { return static_cast<const node*>( node_base::prev() ); }
+
+
+		node* right_child() { return static_cast<node*>( this->right ); }
+		const node* right_child() const { return static_cast<const node*>( this->right ); }
+
+
+	public:
+
+		colour_type colour;
 };
 
 
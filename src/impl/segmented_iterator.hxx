@@ -0,0 +1,108 @@
+#ifndef DSTD_IMPL_SEGMENTED_ITERATOR_HXX
+#define DSTD_IMPL_SEGMENTED_ITERATOR_HXX
+
+
+
+#include "bool_type.hxx"
+
+
+
+namespace dstd
+{
+	namespace impl
+	{
+		template <class Iterator, class Enable> class segmented_iterator_traits;
+		template <class Iterator> class segment_walker;
+	}
+}
+
+
+
+/// Tells the algorithms whether an iterator walks storage made of contiguous segments, such as the chunks of a deque.
+/// Such an iterator has a segment_iterator type, which steps from one segment to the next, and a local_iterator type,
+/// a pointer within a segment. It provides:
+///     segment() and local(), which return the segment and the position within it that the iterator refers to;
+///     static segment_begin(s) and segment_end(s), which return the contiguous range of segment s;
+///     static compose(s, l), which returns the iterator for position l of segment s.
+/// The algorithms run on each segment's range with plain pointers, without a boundary check on every step.
+template <class Iterator, class Enable = void>
+class dstd::impl::segmented_iterator_traits
+{
+	public:
+
+		typedef dstd::impl::FalseType is_segmented;
+};
+
+
+template <class Iterator>
+class dstd::impl::segmented_iterator_traits<Iterator, decltype( (void)sizeof(typename Iterator::segment_iterator) )>
+{
+	public:
+
+		typedef dstd::impl::TrueType is_segmented;
+		typedef typename Iterator::segment_iterator segment_iterator;
+		typedef typename Iterator::local_iterator local_iterator;
+};
+
+
+
+/// Visits the contiguous ranges which make up [first,last), one segment at a time:
+///     for(segment_walker<Iterator> w(first, last); ! w.done(); w.next()) visit [w.begin(), w.end())
+/// The first and last ranges may be parts of their segments. Some ranges may be empty.
+template <class Iterator>
+class dstd::impl::segment_walker
+{
+	public:
+
+		typedef typename Iterator::segment_iterator segment_iterator;
+		typedef typename Iterator::local_iterator local_iterator;
+
+
+		segment_walker(const Iterator& first, const Iterator& last)
+			: s( first.segment() ), s_last( last.segment() ), l_first( first.local() ), l_last(), last_local( last.local() ), finished(false)
+		{
+			this->l_last = ( this->s == this->s_last ) ? this->last_local : Iterator::segment_end(this->s);
+		}
+
+
+		bool done() const { return this->finished; }
+
+		local_iterator begin() const { return this->l_first; }
+
+		local_iterator end() const { return this->l_last; }
+
+
+		/// Moves on to the next segment's range.
+		void next()
+		{
+			if( this->s == this->s_last )
+			{
+				this->finished = true;
+				return;
+			}
+			++(this->s);
+			this->l_first = Iterator::segment_begin(this->s);
+			this->l_last = ( this->s == this->s_last ) ? this->last_local : Iterator::segment_end(this->s);
+		}
+
+
+		/// Returns the iterator for position l of the current range.
+		Iterator at(local_iterator l) const
+		{
+			return Iterator::compose(this->s, l);
+		}
+
+
+	private:
+
+		segment_iterator s;
+		segment_iterator s_last;
+		local_iterator l_first;
+		local_iterator l_last;
+		local_iterator last_local;
+		bool finished;
+};
+
+
+
+#endif
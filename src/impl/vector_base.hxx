@@ -3,6 +3,7 @@
 
 #include "../cstddef.hxx"
 #include "../limits.hxx"
+#include "growth_policy.hxx"
 
 
 
@@ -47,10 +48,24 @@ class dstd::impl::vector_base
 		}
 
 
+		/// Sets how the capacity grows when the vector runs out of room. The default is grow_double.
+		/// The policy belongs to this vector, and is not copied, moved or swapped with its elements.
+		void set_growth_policy(dstd::growth_policy policy)
+		{
+			growth = policy;
+		}
+
+
+		dstd::growth_policy get_growth_policy() const
+		{
+			return growth;
+		}
+
+
 	protected:
 		
 		vector_base()
-			: n_data(0), n_memory(0)
+			: n_data(0), n_memory(0), growth(dstd::grow_double)
 		{}
 
 
@@ -62,6 +77,8 @@ class dstd::impl::vector_base
 
 		size_type n_memory;
 
+		dstd::growth_policy growth;
+
 
 	private:
 		
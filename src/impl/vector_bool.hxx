@@ -0,0 +1,738 @@
+#ifndef DSTD_IMPL_VECTOR_BOOL_HXX
+#define DSTD_IMPL_VECTOR_BOOL_HXX
+
+#include <climits>
+#include <cstring>
+#include <limits>
+
+#include "bit_ops.hxx"
+#include "bool_type.hxx"
+#include "growth_policy.hxx"
+#include "vector_base.hxx"
+#include "../exception.hxx"
+#include "../iterator.hxx"
+#include "../memory.hxx"
+#include "../utility.hxx"
+
+
+
+//
+// Vector of bool
+//
+// Packs the elements into the bits of whole words, so that it takes an eighth of the memory of a vector of bytes.
+// Elements are accessed through a reference proxy, as with bitset. count, find, flip and filling a range
+// work a word at a time. The bits past the size in the last word are unspecified, and are masked off where they matter.
+
+template <class Allocator>
+class dstd::vector<bool, Allocator> : public dstd::impl::vector_base
+{
+	private:
+
+		typedef unsigned long word_type;
+		typedef typename Allocator::template rebind<word_type>::other word_allocator;
+
+		static const size_t bits_per_word = CHAR_BIT * sizeof(word_type);
+
+
+	public:
+
+		typedef bool value_type;
+		typedef Allocator allocator_type;
+		class reference;
+		typedef bool const_reference;
+		typedef impl::vector_base::size_type size_type;
+		typedef ptrdiff_t difference_type;
+
+		class iterator;
+		class const_iterator;
+		typedef dstd::reverse_iterator< iterator > reverse_iterator;
+		typedef dstd::reverse_iterator< const_iterator > const_reverse_iterator;
+
+
+		//
+		// Constructors
+
+		explicit vector(const allocator_type& alloc = allocator_type())
+			: a(alloc), w(0)
+		{}
+
+
+		explicit vector(size_type n, bool value = false, const allocator_type& alloc = allocator_type())
+			: a(alloc), w(0)
+		{
+			this->assign(n, value);
+		}
+
+
+		template <class InputIterator>
+		vector(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type())
+			: a(alloc), w(0)
+		{
+			this->assign(first, last);
+		}
+
+
+		/// Copy constructor. The new vector uses a copy of v's allocator.
+		vector(const vector& v)
+			: impl::vector_base(), a(v.a), w(0)
+		{
+			this->copy_words(v);
+		}
+
+
+		/// Move constructor. Takes v's words and allocator, leaving v empty.
+		vector(vector&& v) noexcept
+			: a(v.a), w(0)
+		{
+			this->swap(v);
+		}
+
+
+		//
+		// Destructor
+
+		~vector()
+		{
+			if( this->w != 0 ) this->a.deallocate(this->w, this->n_memory / bits_per_word);
+		}
+
+
+		//
+		// Assignment
+
+		/// Copies the elements of v. The vector keeps its own allocator.
+		vector& operator= (const vector& v)
+		{
+			if( this != &v ) this->copy_words(v);
+			return *this;
+		}
+
+
+		/// Takes v's elements, together with the allocator which owns them, leaving v empty.
+		vector& operator= (vector&& v) noexcept
+		{
+			vector temp( dstd::move(v) );
+			this->swap(temp);
+			return *this;
+		}
+
+
+		//
+		// Iterators
+
+		iterator begin() { return iterator(this->w, 0); }
+		const_iterator begin() const { return const_iterator(this->w, 0); }
+		iterator end() { return iterator(this->w, this->size()); }
+		const_iterator end() const { return const_iterator(this->w, this->size()); }
+		reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+		reverse_iterator rend() { return reverse_iterator(this->begin()); }
+		const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+
+		//
+		// Capacity
+
+		/// Makes room for at least n elements, growing the capacity according to the growth policy.
+		void reserve(size_type n)
+		{
+			if( n <= this->capacity() ) return;
+			if( n > this->max_size() - bits_per_word ) throw dstd::length_error();
+
+			const size_type n_words = this->n_memory / bits_per_word;
+			const size_type n_request = dstd::impl::grown_capacity( this->growth, n_words, vector::words_for(n), sizeof(word_type), this->max_size() / bits_per_word );
+
+			if( this->w != 0 && dstd::impl::resize_in_place(this->a, this->w, n_words, n_request) )
+			{
+				this->n_memory = n_request * bits_per_word;
+				return;
+			}
+
+			this->reallocate(n_request);
+		}
+
+
+		/// Reduces the capacity to the fewest words which hold the elements, releasing the unused memory.
+		void shrink_to_fit()
+		{
+			const size_type n_words = this->n_memory / bits_per_word;
+			const size_type n_needed = vector::words_for(this->size());
+			if( n_words == n_needed ) return;
+
+			if( n_needed == 0 )
+			{
+				this->a.deallocate(this->w, n_words);
+				this->w = 0;
+				this->n_memory = 0;
+			}
+			else if( dstd::impl::resize_in_place(this->a, this->w, n_words, n_needed) )
+			{
+				this->n_memory = n_needed * bits_per_word;
+			}
+			else
+			{
+				this->reallocate(n_needed);
+			}
+		}
+
+
+		void resize(size_type n, bool value = false)
+		{
+			if( n < this->size() ) this->n_data = n;
+			else this->insert(this->end(), n - this->size(), value);
+		}
+
+
+		//
+		// Element access
+
+		reference operator[](size_type i)
+		{
+			return reference(this->w + i / bits_per_word, i % bits_per_word);
+		}
+
+
+		const_reference operator[](size_type i) const
+		{
+			return this->get_bit(i);
+		}
+
+
+		reference at(size_type i)
+		{
+			if( i >= this->size() ) throw dstd::out_of_range();
+			return (*this)[i];
+		}
+
+
+		const_reference at(size_type i) const
+		{
+			if( i >= this->size() ) throw dstd::out_of_range();
+			return (*this)[i];
+		}
+
+
+		reference front() { return (*this)[0]; }
+		const_reference front() const { return (*this)[0]; }
+		reference back() { return (*this)[this->size() - 1]; }
+		const_reference back() const { return (*this)[this->size() - 1]; }
+
+
+		//
+		// Bit operations
+
+		/// Returns the number of elements equal to value, counting a word at a time.
+		size_type count(bool value = true) const
+		{
+			size_type n = 0;
+			const size_type n_full = this->size() / bits_per_word;
+			for(size_type i = 0; i != n_full; ++i) n += dstd::impl::popcount(this->w[i]);
+
+			const size_type n_tail = this->size() % bits_per_word;
+			if( n_tail != 0 ) n += dstd::impl::popcount( this->w[n_full] & dstd::impl::low_bits<word_type>(n_tail) );
+
+			return value ? n : this->size() - n;
+		}
+
+
+		/// Returns the first element equal to value, or end if there is none, skipping a word at a time.
+		iterator find(bool value)
+		{
+			return iterator( this->w, this->find_bit(value, 0) );
+		}
+
+
+		const_iterator find(bool value) const
+		{
+			return const_iterator( this->w, this->find_bit(value, 0) );
+		}
+
+
+		/// Returns the first element equal to value at or after first, or end if there is none.
+		iterator find(bool value, const_iterator first)
+		{
+			return iterator( this->w, this->find_bit(value, first.i) );
+		}
+
+
+		const_iterator find(bool value, const_iterator first) const
+		{
+			return const_iterator( this->w, this->find_bit(value, first.i) );
+		}
+
+
+		/// Negates every element.
+		void flip()
+		{
+			const size_type n_words = vector::words_for(this->size());
+			for(size_type i = 0; i != n_words; ++i) this->w[i] = ~(this->w[i]);
+		}
+
+
+		//
+		// Modifiers
+
+		template <class InputIterator>
+		void assign(InputIterator first, InputIterator last)
+		{
+			this->clear();
+			this->insert(this->begin(), first, last);
+		}
+
+
+		/// Sets the vector to n elements equal to value, filling a word at a time.
+		void assign(size_type n, bool value)
+		{
+			this->clear();
+			this->insert(this->begin(), n, value);
+		}
+
+
+		void push_back(bool value)
+		{
+			if( this->size() == this->capacity() ) this->reserve(this->size() + 1);
+			++(this->n_data);
+			this->set_bit(this->size() - 1, value);
+		}
+
+
+		/// Appends an element of value bool(args...).
+		template <class... Args>
+		void emplace_back(Args&&... args)
+		{
+			this->push_back( bool( dstd::forward<Args>(args)... ) );
+		}
+
+
+		void pop_back()
+		{
+			--(this->n_data);
+		}
+
+
+		iterator insert(const_iterator position, bool value)
+		{
+			return this->insert(position, 1, value);
+		}
+
+
+		/// Inserts n elements equal to value before position. The elements after position are shifted along one bit at a time.
+		iterator insert(const_iterator position, size_type n, bool value)
+		{
+			const size_type i = this->make_room(position, n);
+			this->fill_bits(i, i + n, value);
+			return iterator(this->w, i);
+		}
+
+
+		template <class InputIterator>
+		iterator insert(const_iterator position, InputIterator first, InputIterator last)
+		{
+			typedef typename dstd::impl::BoolType< std::numeric_limits<InputIterator>::is_integer >::bool_type is_integer;
+			return this->insert_fix( position, first, last, is_integer() );
+		}
+
+
+		template <class... Args>
+		iterator emplace(const_iterator position, Args&&... args)
+		{
+			return this->insert( position, bool( dstd::forward<Args>(args)... ) );
+		}
+
+
+		iterator erase(const_iterator position)
+		{
+			return this->erase(position, position + 1);
+		}
+
+
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			if( first.i > last.i || last.i > this->size() ) throw dstd::out_of_range();
+
+			this->move_bits(first.i, last.i, this->size() - last.i);
+			this->n_data -= (last.i - first.i);
+			return iterator(this->w, first.i);
+		}
+
+
+		void swap(vector& v)
+		{
+			dstd::swap(this->w, v.w);
+			dstd::swap(this->n_data, v.n_data);
+			dstd::swap(this->n_memory, v.n_memory);
+
+			// the words are exchanged, so the allocators which own them must be too
+			dstd::swap(this->a, v.a);
+		}
+
+
+		void clear()
+		{
+			this->n_data = 0;
+		}
+
+
+		//
+		// Allocator
+
+		allocator_type get_allocator() const
+		{
+			return allocator_type(this->a);
+		}
+
+
+	private:
+
+		/// Returns the number of words which hold n bits.
+		static size_type words_for(size_type n)
+		{
+			return (n / bits_per_word) + (n % bits_per_word > 0);
+		}
+
+
+		bool get_bit(size_type i) const
+		{
+			return ( (this->w[i / bits_per_word] >> (i % bits_per_word)) & 1 ) != 0;
+		}
+
+
+		void set_bit(size_type i, bool value)
+		{
+			const word_type mask = static_cast<word_type>(1) << (i % bits_per_word);
+			if( value ) this->w[i / bits_per_word] |= mask;
+			else this->w[i / bits_per_word] &= ~mask;
+		}
+
+
+		/// Sets the bits selected by mask in word x to value.
+		static void fill_word(word_type& x, word_type mask, bool value)
+		{
+			if( value ) x |= mask;
+			else x &= ~mask;
+		}
+
+
+		/// Sets the bits [first, last) to value: the whole words between the first and last partial words are written at once.
+		void fill_bits(size_type first, size_type last, bool value)
+		{
+			if( first == last ) return;
+
+			size_type i_word = first / bits_per_word;
+			const size_type last_word = last / bits_per_word;
+			const word_type head = ~dstd::impl::low_bits<word_type>(first % bits_per_word);
+			const word_type tail = dstd::impl::low_bits<word_type>(last % bits_per_word);
+
+			if( i_word == last_word )
+			{
+				vector::fill_word(this->w[i_word], head & tail, value);
+				return;
+			}
+
+			vector::fill_word(this->w[i_word], head, value);
+			const word_type all = value ? ~static_cast<word_type>(0) : 0;
+			for(++i_word; i_word < last_word; ++i_word) this->w[i_word] = all;
+			if( tail != 0 ) vector::fill_word(this->w[last_word], tail, value);
+		}
+
+
+		/// Returns the index of the first bit at or after first which equals value, or the size if there is none.
+		size_type find_bit(bool value, size_type first) const
+		{
+			size_type i = first;
+			while( i < this->size() )
+			{
+				const size_type i_word = i / bits_per_word;
+				word_type x = value ? this->w[i_word] : ~(this->w[i_word]);
+				x &= ~dstd::impl::low_bits<word_type>(i % bits_per_word);
+
+				if( x != 0 )
+				{
+					const size_type found = i_word * bits_per_word + dstd::impl::count_trailing_zeros(x);
+					return ( found < this->size() ) ? found : this->size();
+				}
+
+				i = (i_word + 1) * bits_per_word;
+			}
+			return this->size();
+		}
+
+
+		/// Returns the n bits, at most a word's worth, which start at bit i, in the low bits of the result.
+		word_type get_bits(size_type i, size_type n) const
+		{
+			const size_type i_word = i / bits_per_word;
+			const size_type shift = i % bits_per_word;
+
+			word_type x = this->w[i_word] >> shift;
+			if( shift != 0 && shift + n > bits_per_word ) x |= this->w[i_word + 1] << (bits_per_word - shift);
+			return ( n < bits_per_word ) ? ( x & dstd::impl::low_bits<word_type>(n) ) : x;
+		}
+
+
+		/// Writes the low n bits of x, at most a word's worth, to the bits which start at bit i.
+		void set_bits(size_type i, word_type x, size_type n)
+		{
+			const size_type i_word = i / bits_per_word;
+			const size_type shift = i % bits_per_word;
+			const word_type mask = ( n < bits_per_word ) ? dstd::impl::low_bits<word_type>(n) : ~static_cast<word_type>(0);
+
+			this->w[i_word] = ( this->w[i_word] & ~(mask << shift) ) | ( (x & mask) << shift );
+			if( shift != 0 && shift + n > bits_per_word )
+			{
+				// the bits which did not fit carry into the low bits of the next word
+				const word_type carry = mask >> (bits_per_word - shift);
+				this->w[i_word + 1] = ( this->w[i_word + 1] & ~carry ) | ( (x >> (bits_per_word - shift)) & carry );
+			}
+		}
+
+
+		/// Copies the n bits starting at from to the n bits starting at to, a word at a time. The two ranges may overlap.
+		void move_bits(size_type to, size_type from, size_type n)
+		{
+			if( to < from )
+			{
+				for(size_type i = 0; i < n; i += bits_per_word)
+				{
+					const size_type k = ( n - i < bits_per_word ) ? n - i : bits_per_word;
+					this->set_bits( to + i, this->get_bits(from + i, k), k );
+				}
+			}
+			else if( to > from )
+			{
+				for(size_type i = n; i != 0; )
+				{
+					const size_type k = ( i < bits_per_word ) ? i : bits_per_word;
+					i -= k;
+					this->set_bits( to + i, this->get_bits(from + i, k), k );
+				}
+			}
+		}
+
+
+		/// Opens a gap of n elements before position, returning the index of the gap.
+		size_type make_room(const_iterator position, size_type n)
+		{
+			const size_type i = position.i;
+			if( i > this->size() ) throw dstd::out_of_range();
+
+			this->reserve(this->size() + n);
+			this->move_bits(i + n, i, this->size() - i);
+			this->n_data += n;
+			return i;
+		}
+
+
+		/// Moves the words to a new block of n_words, and frees the old block.
+		void reallocate(size_type n_words)
+		{
+			word_type* new_w = this->a.allocate(n_words);
+			const size_type n_used = vector::words_for(this->size());
+			if( n_used != 0 ) std::memcpy(new_w, this->w, n_used * sizeof(word_type));
+
+			if( this->w != 0 ) this->a.deallocate(this->w, this->n_memory / bits_per_word);
+			this->w = new_w;
+			this->n_memory = n_words * bits_per_word;
+		}
+
+
+		/// Makes the elements a copy of v's, a word at a time.
+		void copy_words(const vector& v)
+		{
+			this->n_data = 0;
+			this->reserve(v.size());
+			const size_type n_used = vector::words_for(v.size());
+			if( n_used != 0 ) std::memcpy(this->w, v.w, n_used * sizeof(word_type));
+			this->n_data = v.size();
+		}
+
+
+		iterator insert_fix(const_iterator position, size_type n, bool value, dstd::impl::TrueType)
+		{
+			return this->insert(position, n, value);
+		}
+
+
+		template <class InputIterator>
+		iterator insert_fix(const_iterator position, InputIterator first, InputIterator last, dstd::impl::FalseType)
+		{
+			const size_type n = static_cast<size_type>(last - first);
+			size_type i = this->make_room(position, n);
+			for(; first != last; ++first, ++i) this->set_bit(i, bool(*first));
+			return iterator(this->w, i - n);
+		}
+
+
+		word_allocator a;
+
+		word_type* w;
+
+
+	/// Compares the elements a word at a time.
+	friend bool operator== (const vector& v1, const vector& v2)
+	{
+		if( v1.size() != v2.size() ) return false;
+
+		const size_type n_full = v1.size() / bits_per_word;
+		for(size_type i = 0; i != n_full; ++i)
+		{
+			if( v1.w[i] != v2.w[i] ) return false;
+		}
+
+		const size_type n_tail = v1.size() % bits_per_word;
+		if( n_tail == 0 ) return true;
+		const word_type mask = dstd::impl::low_bits<word_type>(n_tail);
+		return ( (v1.w[n_full] & mask) == (v2.w[n_full] & mask) );
+	}
+
+
+	friend bool operator!= (const vector& v1, const vector& v2)
+	{
+		return ! (v1 == v2);
+	}
+};
+
+
+
+/// A proxy for a single element, which reads and writes its bit.
+template <class Allocator>
+class dstd::vector<bool, Allocator>::reference
+{
+	public:
+
+		~reference() {}
+
+		reference& operator= (bool value)
+		{
+			if( value ) *(this->w) |= this->mask;
+			else *(this->w) &= ~(this->mask);
+			return *this;
+		}
+
+		reference& operator= (const reference& x)
+		{
+			(*this) = bool(x);
+			return *this;
+		}
+
+		operator bool() const
+		{
+			return ( *(this->w) & this->mask ) != 0;
+		}
+
+		bool operator~ () const
+		{
+			return ! bool(*this);
+		}
+
+		reference& flip()
+		{
+			*(this->w) ^= this->mask;
+			return *this;
+		}
+
+
+	private:
+
+		reference(word_type* word, size_type bit_index)
+			: w(word), mask( static_cast<word_type>(1) << bit_index )
+		{}
+
+		word_type* w;
+		word_type mask;
+
+
+	friend class dstd::vector<bool, Allocator>;
+	friend class dstd::vector<bool, Allocator>::iterator;
+};
+
+
+
+template <class Allocator>
+class dstd::vector<bool, Allocator>::iterator
+{
+	public:
+
+		typedef bool value_type;
+		typedef typename dstd::vector<bool, Allocator>::reference reference;
+		typedef void pointer;
+		typedef typename dstd::vector<bool, Allocator>::size_type size_type;
+		typedef typename dstd::vector<bool, Allocator>::difference_type difference_type;
+
+		iterator() : w(0), i(0) {}
+		iterator(word_type* words, size_type index) : w(words), i(index) {}
+		reference operator* () const { return reference(w + i / bits_per_word, i % bits_per_word); }
+		reference operator[] (difference_type n) const { return *(*this + n); }
+		// Operators with int
+		iterator& operator+=(difference_type n) { i += n; return (*this); }
+		iterator& operator-=(difference_type n) { i -= n; return (*this); }
+		iterator operator+ (difference_type n) const { iterator it(*this); it += n; return it; }
+		iterator operator- (difference_type n) const { iterator it(*this); it -= n; return it; }
+		// Operators with iterators
+		difference_type operator- (const iterator& rhs) const { return static_cast<difference_type>(i - rhs.i); }
+		iterator& operator++() { ++i; return (*this); }
+		iterator operator++(int) { iterator temp(*this); ++(*this); return temp; }
+		iterator& operator--() { --i; return (*this); }
+		iterator operator--(int) { iterator temp(*this); --(*this); return temp; }
+		bool operator==(const iterator& rhs) const { return (i == rhs.i); }
+		bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+		bool operator< (const iterator& rhs) const { return (i < rhs.i); }
+		bool operator> (const iterator& rhs) const { return (i > rhs.i); }
+		bool operator<=(const iterator& rhs) const { return !(*this > rhs); }
+		bool operator>=(const iterator& rhs) const { return !(*this < rhs); }
+
+	private:
+
+		word_type* w;
+		size_type i;
+
+		friend class const_iterator;
+};
+
+
+
+template <class Allocator>
+class dstd::vector<bool, Allocator>::const_iterator
+{
+	public:
+
+		typedef bool value_type;
+		typedef bool reference;
+		typedef void pointer;
+		typedef typename dstd::vector<bool, Allocator>::size_type size_type;
+		typedef typename dstd::vector<bool, Allocator>::difference_type difference_type;
+
+		const_iterator() : w(0), i(0) {}
+		const_iterator(const word_type* words, size_type index) : w(words), i(index) {}
+		const_iterator(const iterator& it) : w(it.w), i(it.i) {}
+		reference operator* () const { return ( (w[i / bits_per_word] >> (i % bits_per_word)) & 1 ) != 0; }
+		reference operator[] (difference_type n) const { return *(*this + n); }
+		// Operators with int
+		const_iterator& operator+=(difference_type n) { i += n; return (*this); }
+		const_iterator& operator-=(difference_type n) { i -= n; return (*this); }
+		const_iterator operator+ (difference_type n) const { const_iterator it(*this); it += n; return it; }
+		const_iterator operator- (difference_type n) const { const_iterator it(*this); it -= n; return it; }
+		// Operators with iterators
+		difference_type operator- (const const_iterator& rhs) const { return static_cast<difference_type>(i - rhs.i); }
+		const_iterator& operator++() { ++i; return (*this); }
+		const_iterator operator++(int) { const_iterator temp(*this); ++(*this); return temp; }
+		const_iterator& operator--() { --i; return (*this); }
+		const_iterator operator--(int) { const_iterator temp(*this); --(*this); return temp; }
+		bool operator==(const const_iterator& rhs) const { return (i == rhs.i); }
+		bool operator!=(const const_iterator& rhs) const { return !(*this == rhs); }
+		bool operator< (const const_iterator& rhs) const { return (i < rhs.i); }
+		bool operator> (const const_iterator& rhs) const { return (i > rhs.i); }
+		bool operator<=(const const_iterator& rhs) const { return !(*this > rhs); }
+		bool operator>=(const const_iterator& rhs) const { return !(*this < rhs); }
+
+	private:
+
+		const word_type* w;
+		size_type i;
+
+		friend class dstd::vector<bool, Allocator>;
+};
+
+
+
+#endif
@@ -1,9 +1,16 @@
 #ifndef DSTD_IMPL_VECTOR_IMPL_HXX
 #define DSTD_IMPL_VECTOR_IMPL_HXX
 
+#include <cassert>
+#include <cstring>
+
 #include "vector_base.hxx"
+#include "../algorithm.hxx"
 #include "../iterator.hxx"
 #include "../memory.hxx"
+#include "../type_traits.hxx"
+#include "bool_type.hxx"
+#include "growth_policy.hxx"
 
 
 
@@ -11,14 +18,46 @@ namespace dstd
 {
 	namespace impl
 	{
-		template <class T, class Allocator> class vector_impl;
+		template <class T, size_t N, size_t Alignment> class vector_storage;
+		template <class T, class Allocator, size_t N = 0> class vector_impl;
 	}
 }
 
 
 
-template <class T, class Allocator>
-class dstd::impl::vector_impl : public dstd::impl::vector_base
+/// Room for N elements inside the container itself, which small_vector uses before allocating.
+/// It is aligned as the allocator aligns its blocks, so the elements are equally aligned wherever they are.
+template <class T, size_t N, size_t Alignment>
+class dstd::impl::vector_storage
+{
+	protected:
+
+		T* local() { return reinterpret_cast<T*>(buffer); }
+		const T* local() const { return reinterpret_cast<const T*>(buffer); }
+
+	private:
+
+		alignas(Alignment) unsigned char buffer[N * sizeof(T)];
+};
+
+
+/// A vector has no inline storage, and this base takes no space.
+template <class T, size_t Alignment>
+class dstd::impl::vector_storage<T, 0, Alignment>
+{
+	protected:
+
+		T* local() { return 0; }
+		const T* local() const { return 0; }
+};
+
+
+
+/// The storage and element management shared by vector, small_vector and flat_tree.
+/// The first N elements are kept in inline storage, and the elements only move to memory from the allocator
+/// when there are more than N. With N of 0, every element is in memory from the allocator.
+template <class T, class Allocator, size_t N>
+class dstd::impl::vector_impl : public dstd::impl::vector_base, protected dstd::impl::vector_storage<T, N, dstd::impl::allocator_alignment<Allocator>::value>
 {
 	public:
 
@@ -40,7 +79,7 @@ class dstd::impl::vector_impl : public dstd::impl::vector_base
 		~vector_impl()
 		{
 			erase_range(begin(), end());
-			if( p != 0 ) a.deallocate(p, n_memory);
+			release(p, n_memory);
 		}
 
 
@@ -92,6 +131,15 @@ class dstd::impl::vector_impl : public dstd::impl::vector_base
 		}
 
 		
+		/// Returns the most elements the vector can hold, whose size in bytes still fits in a size_t.
+		size_type max_size() const
+		{
+			return dstd::numeric_limits<size_type>::max() / sizeof(T);
+		}
+
+
+		/// Ensures the capacity is at least n, growing it as the growth policy decides.
+		/// The allocator is first asked to extend the current block in place, so that the elements need not move.
 		void reserve(size_type n)
 		{
 			// Check if this request is necessary and valid
@@ -99,44 +147,66 @@ class dstd::impl::vector_impl : public dstd::impl::vector_base
 			if( n > max_size() ) throw dstd::length_error();
 
 			// Determine how much memory to request
-			unsigned int n_request = dstd::max<unsigned int>(capacity(), 2);
-			while( n_request < n )
-			{
-				n_request = dstd::min<unsigned int>(max_size(), n_request * 2);
-			}
+			const size_type n_request = dstd::impl::grown_capacity(growth, capacity(), n, sizeof(T), max_size());
 
 			assert(n_request >= n);
 
-			// Request new memory, and copy existing values to new memory
-			T* new_p = a.allocate(n_request);
-			for(size_type i = 0; i != size(); ++i)
+			if( p != 0 && p != this->local() && dstd::impl::resize_in_place(a, p, n_memory, n_request) )
 			{
-				a.construct(new_p + i, p[i]);
+				n_memory = n_request;
+				return;
 			}
 
-			// Move the vector to the new memory
-			unsigned int old_n_memory = n_memory;
-			T* old_p = p;
-			p = new_p;
-			n_memory = n_request;
+			reallocate(n_request);
+		}
+
 
-			if( old_p != 0 )
+		/// Reduces the capacity to the size, releasing the unused memory.
+		/// If the elements fit in the inline storage, they move back there.
+		void shrink_to_fit()
+		{
+			if( p == this->local() || capacity() == size() ) return;
+
+			if( size() <= N )
 			{
-				// Clean up the old memory
-				for(size_type i = 0; i != size(); ++i)
-				{
-					a.destroy(old_p + i);
-				}
-				a.deallocate(old_p, old_n_memory);
+				T* old_p = p;
+				relocate(this->local(), old_p, size());
+				p = this->local();
+				release(old_p, n_memory);
+				n_memory = N;
+			}
+			else if( dstd::impl::resize_in_place(a, p, n_memory, size()) )
+			{
+				n_memory = size();
+			}
+			else
+			{
+				reallocate(size());
 			}
 		}
 
 
 	protected:
 
-		vector_impl()
-			: p(0)
-		{}
+		explicit vector_impl(const allocator_type& alloc = allocator_type())
+			: a(alloc), p(this->local())
+		{
+			n_memory = N;
+		}
+
+
+		/// Whether the elements are in the inline storage, rather than memory from the allocator.
+		bool is_local() const
+		{
+			return ( N != 0 && p == this->local() );
+		}
+
+
+		/// Frees a block of n elements, unless it is the inline storage.
+		void release(T* block, size_type n)
+		{
+			if( block != 0 && block != this->local() ) a.deallocate(block, n);
+		}
 
 
 		iterator erase_range(iterator first, iterator last)
@@ -148,25 +218,16 @@ class dstd::impl::vector_impl : public dstd::impl::vector_base
 
 			const size_type n_remove = static_cast<size_type>(last - first);
 
-			iterator it_erase = first;
-			iterator it_shuffle = last;
 			const iterator it_end = end();
 
-			// erase existing elements, and shuffle elements after last into the gap left behind
-			while( it_erase < it_end )
+			// destroy the erased elements, then shuffle elements after last into the gap left behind
+			for(iterator it_erase = first; it_erase < last; ++it_erase)
 			{
 				a.destroy(&(*it_erase));
-
-				if( it_shuffle < end() )
-				{
-					a.construct(&(*it_erase), *it_shuffle);
-					a.destroy(&(*it_shuffle));
-				}
-
-				++it_erase;
-				++it_shuffle;
 			}
 
+			relocate(&(*first), &(*last), static_cast<size_type>(it_end - last));
+
 			// update size
 			n_data -= n_remove;
 
@@ -181,6 +242,13 @@ class dstd::impl::vector_impl : public dstd::impl::vector_base
 				throw dstd::out_of_range();
 			}
 
+			if( &value >= p && &value < p + size() )
+			{
+				// The value is an element of this vector, which is about to move, so a copy of it is inserted instead.
+				const value_type copy(value);
+				return insert_value(position, n, copy);
+			}
+
 			// Make sure there is sufficient capacity
 			if( (size() + n) > capacity() )
 			{
@@ -194,16 +262,8 @@ class dstd::impl::vector_impl : public dstd::impl::vector_base
 
 			if( position < end() )
 			{
-				// Shuffle the last n elements n positions along
-				iterator it_from = end() - 1;
-				iterator it_to = it_from + n;
-				while( it_from >= position )
-				{
-					a.construct(&(*it_to), *it_from);
-					a.destroy(&(*it_from));
-					--it_from;
-					--it_to;
-				}
+				// Shuffle the elements from position onwards n positions along
+				relocate(&(*position) + n, &(*position), static_cast<size_type>(end() - position));
 			}
 
 			// Insert the new elements into the gap
@@ -221,15 +281,57 @@ class dstd::impl::vector_impl : public dstd::impl::vector_base
 		}
 
 
+		/// Inserts an element constructed from args before position.
+		template <class... Args>
+		iterator emplace_value(iterator position, Args&&... args)
+		{
+			if( position > end() || position < begin() )
+			{
+				throw dstd::out_of_range();
+			}
+
+			if( position == end() && size() < capacity() )
+			{
+				a.construct(p + size(), dstd::forward<Args>(args)...);
+				++n_data;
+				return position;
+			}
+
+			// The arguments may refer to elements of this vector, which are about to move,
+			// so the new element is constructed before anything else changes.
+			value_type value( dstd::forward<Args>(args)... );
+
+			if( size() == capacity() )
+			{
+				// If a reallocation occurs during reserve, position is invalidated
+				const size_type i_position = static_cast<size_type>(position - begin());
+				reserve(size() + 1);
+				position = begin() + i_position;
+			}
+
+			if( position < end() )
+			{
+				relocate(&(*position) + 1, &(*position), static_cast<size_type>(end() - position));
+			}
+			a.construct(&(*position), dstd::move(value));
+			++n_data;
+
+			return position;
+		}
+
+
+		/// Inserts copies of [first,last) before position. The iterators need not be random access:
+		/// the range is walked once to count it, unless they are, and once more to copy it.
 		template <class InputIterator>
 		iterator insert_range(iterator position, InputIterator first, InputIterator last)
 		{
-			if( position > end() || position < begin() || last < first )
+			const difference_type count = dstd::distance(first, last);
+			if( position > end() || position < begin() || count < 0 )
 			{
 				throw dstd::out_of_range();
 			}
 
-			const size_type n = static_cast<size_type>(last - first);
+			const size_type n = static_cast<size_type>(count);
 
 			// Make sure there is sufficient capacity
 			if( (size() + n) > capacity() )
@@ -242,22 +344,14 @@ class dstd::impl::vector_impl : public dstd::impl::vector_base
 
 			if( position < end() )
 			{
-				// Shuffle the last n elements n positions along
-				iterator it_from = end() - 1;
-				iterator it_to = it_from + n;
-				while( it_from >= position )
-				{
-					a.construct(&(*it_to), *it_from);
-					a.destroy(&(*it_from));
-					--it_from;
-					--it_to;
-				}
+				// Shuffle the elements from position onwards n positions along
+				relocate(&(*position) + n, &(*position), static_cast<size_type>(end() - position));
 			}
 
 			// Insert the new elements into the gap
 			InputIterator it_from = first;
 			iterator it_to = position;
-			while( it_from < last )
+			while( it_from != last )
 			{
 				a.construct(&(*it_to), *it_from);
 				++it_from;
@@ -278,7 +372,69 @@ class dstd::impl::vector_impl : public dstd::impl::vector_base
 		
 
 	private:
+
+		/// Moves the elements to a new block of n elements, which must be at least the size, and frees the old block.
+		void reallocate(size_type n)
+		{
+			// Request new memory, and move existing values to new memory
+			T* new_p = a.allocate(n);
+			if( p != 0 ) relocate(new_p, p, size());
+
+			// Move the vector to the new memory
+			size_type old_n_memory = n_memory;
+			T* old_p = p;
+			p = new_p;
+			n_memory = n;
+
+			release(old_p, old_n_memory);
+		}
+
 		
+		/// Moves the n elements starting at from to the uninitialised memory starting at to,
+		/// leaving the memory at from uninitialised. The two ranges may overlap.
+		void relocate(T* to, T* from, size_type n)
+		{
+			if( n == 0 || to == from ) return; // an element moved onto itself would be destroyed
+			relocate(to, from, n, typename dstd::impl::BoolType< dstd::is_trivially_relocatable<T>::value >::bool_type());
+		}
+
+
+		/// Elements which are trivially relocatable are moved in one go, at the speed of memory.
+		void relocate(T* to, T* from, size_type n, dstd::impl::TrueType)
+		{
+			std::memmove(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(T));
+		}
+
+
+		/// Other elements are moved and then destroyed one at a time.
+		/// If the ranges do not overlap, every element is moved before any is destroyed, and elements whose move
+		/// constructor may throw are copied instead, so a failure leaves the original elements intact.
+		void relocate(T* to, T* from, size_type n, dstd::impl::FalseType)
+		{
+			if( to + n <= from || from + n <= to )
+			{
+				for(size_type i = 0; i != n; ++i) a.construct(to + i, dstd::move_if_noexcept(from[i]));
+				for(size_type i = 0; i != n; ++i) a.destroy(from + i);
+			}
+			else if( to < from )
+			{
+				for(size_type i = 0; i != n; ++i)
+				{
+					a.construct(to + i, dstd::move(from[i]));
+					a.destroy(from + i);
+				}
+			}
+			else
+			{
+				for(size_type i = n; i != 0; --i)
+				{
+					a.construct(to + i - 1, dstd::move(from[i - 1]));
+					a.destroy(from + i - 1);
+				}
+			}
+		}
+
+
 		/// Not implemented
 		vector_impl(const vector_impl&);
 
@@ -0,0 +1,318 @@
+#ifndef DSTD_IMPL_VECTOR_INTERFACE_HXX
+#define DSTD_IMPL_VECTOR_INTERFACE_HXX
+
+#include <limits>
+
+#include "bool_type.hxx"
+#include "vector_impl.hxx"
+#include "vector_iterator.hxx"
+#include "../algorithm.hxx"
+#include "../exception.hxx"
+#include "../utility.hxx"
+
+
+
+namespace dstd
+{
+	namespace impl
+	{
+		template <class T, class Allocator, size_t N> class vector_interface;
+	}
+}
+
+
+
+/// The sequence interface which vector and small_vector share: element access, assignment, insertion and erasure.
+/// It sits apart from vector_impl so that flat_tree, which keeps its elements sorted, does not inherit it.
+/// Construction, assignment between containers and swap differ, and stay with each container.
+template <class T, class Allocator, size_t N>
+class dstd::impl::vector_interface : public dstd::impl::vector_impl<T, Allocator, N>
+{
+	public:
+
+		typedef typename impl::vector_impl<T,Allocator,N>::value_type value_type;
+		typedef typename impl::vector_impl<T,Allocator,N>::allocator_type allocator_type;
+		typedef typename impl::vector_impl<T,Allocator,N>::reference reference;
+		typedef typename impl::vector_impl<T,Allocator,N>::const_reference const_reference;
+		typedef typename impl::vector_impl<T,Allocator,N>::size_type size_type;
+		typedef typename impl::vector_impl<T,Allocator,N>::iterator iterator;
+
+
+		//
+		// Capacity
+
+
+		void resize(size_type n, const T& value = T())
+		{
+			if( n < this->size() )
+			{
+				iterator first = this->begin() + n;
+				this->erase( first, this->end() );
+			}
+			else if( n > this->size() )
+			{
+				this->insert(this->end(), n - this->size(), value);
+			}
+		}
+
+
+		//
+		// Element access
+
+
+		reference operator[](size_type i)
+		{
+			return this->p[i];
+		}
+
+
+		const_reference operator[](size_type i) const
+		{
+			return this->p[i];
+		}
+
+
+		reference at(size_type i)
+		{
+			if( i >= this->size() )
+			{
+				throw dstd::out_of_range();
+			}
+			return this->p[i];
+		}
+
+
+		const_reference at(size_type i) const
+		{
+			if( i >= this->size() )
+			{
+				throw dstd::out_of_range();
+			}
+			return this->p[i];
+		}
+
+
+		reference front()
+		{
+			return this->p[0];
+		}
+
+
+		const_reference front() const
+		{
+			return this->p[0];
+		}
+
+
+		reference back()
+		{
+			return this->p[this->size() - 1];
+		}
+
+
+		const_reference back() const
+		{
+			return this->p[this->size() - 1];
+		}
+
+
+		//
+		// Modifiers
+
+
+		template <class InputIterator>
+		void assign(InputIterator first, InputIterator last)
+		{
+			this->clear();
+			this->insert(this->begin(), first, last);
+		}
+
+
+		void assign(size_type n, const value_type& value)
+		{
+			this->clear();
+			this->insert(this->begin(), n, value);
+		}
+
+
+		void push_back(const value_type& value)
+		{
+			this->emplace_value(this->end(), value);
+		}
+
+
+		void push_back(value_type&& value)
+		{
+			this->emplace_value(this->end(), dstd::move(value));
+		}
+
+
+		/// Appends an element constructed in place from args.
+		template <class... Args>
+		void emplace_back(Args&&... args)
+		{
+			this->emplace_value(this->end(), dstd::forward<Args>(args)...);
+		}
+
+
+		void pop_back()
+		{
+			this->erase(this->end() - 1);
+		}
+
+
+		iterator insert(iterator position, const value_type& value)
+		{
+			return this->emplace_value(position, value);
+		}
+
+
+		iterator insert(iterator position, value_type&& value)
+		{
+			return this->emplace_value(position, dstd::move(value));
+		}
+
+
+		/// Inserts an element constructed from args before position.
+		template <class... Args>
+		iterator emplace(iterator position, Args&&... args)
+		{
+			return this->emplace_value(position, dstd::forward<Args>(args)...);
+		}
+
+
+		void insert(iterator position, size_type n, const value_type& value)
+		{
+			this->insert_value(position, n, value);
+		}
+
+
+		template <class InputIterator>
+		void insert(iterator position, InputIterator first, InputIterator last)
+		{
+			typedef typename dstd::impl::BoolType< std::numeric_limits<InputIterator>::is_integer >::bool_type is_integer;
+			this->insert_fix( position, first, last, is_integer() );
+		}
+
+
+		iterator erase(iterator position)
+		{
+			return this->erase_range(position, position + 1);
+		}
+
+
+		iterator erase(iterator first, iterator last)
+		{
+			return this->erase_range(first, last);
+		}
+
+
+		void clear()
+		{
+			this->erase(this->begin(), this->end());
+		}
+
+
+		//
+		// Allocator
+
+
+		allocator_type get_allocator() const
+		{
+			return this->a;
+		}
+
+
+	protected:
+
+		explicit vector_interface(const allocator_type& alloc = allocator_type())
+			: impl::vector_impl<T,Allocator,N>(alloc)
+		{}
+
+
+	private:
+
+		iterator insert_fix(iterator position, size_type n, const value_type& value, dstd::impl::TrueType)
+		{
+			return this->insert_value(position, n, value);
+		}
+
+
+		template <class InputIterator>
+		iterator insert_fix(iterator position, InputIterator first, InputIterator last, dstd::impl::FalseType)
+		{
+			return this->insert_range(position, first, last);
+		}
+};
+
+
+
+//
+// Vector Operators
+//
+// These compare any two vectors or small_vectors of the same type, element by element.
+
+template <class T, class Allocator, size_t N>
+bool operator== (const dstd::impl::vector_interface<T, Allocator, N>& lhs, const dstd::impl::vector_interface<T, Allocator, N>& rhs)
+{
+	if( lhs.size() != rhs.size() ) return false;
+	for(size_t i = 0; i != lhs.size(); ++i)
+	{
+		if( ! (lhs[i] == rhs[i]) ) return false;
+	}
+	return true;
+}
+
+
+template <class T, class Allocator, size_t N>
+bool operator!= (const dstd::impl::vector_interface<T, Allocator, N>& lhs, const dstd::impl::vector_interface<T, Allocator, N>& rhs)
+{
+	return ! (lhs == rhs);
+}
+
+
+template <class T, class Allocator, size_t N>
+bool operator< (const dstd::impl::vector_interface<T, Allocator, N>& lhs, const dstd::impl::vector_interface<T, Allocator, N>& rhs)
+{
+	const size_t n = dstd::min(lhs.size(), rhs.size());
+
+	for(size_t i = 0; i < n; ++i)
+	{
+		if( lhs[i] < rhs[i] )
+		{
+			return true;
+		}
+		else if( rhs[i] < lhs[i] )
+		{
+			return false;
+		}
+	}
+
+	// one is a prefix of the other, so the shorter goes first
+	return ( lhs.size() < rhs.size() );
+}
+
+
+template <class T, class Allocator, size_t N>
+bool operator<= (const dstd::impl::vector_interface<T, Allocator, N>& lhs, const dstd::impl::vector_interface<T, Allocator, N>& rhs)
+{
+	return ! (rhs < lhs);
+}
+
+
+template <class T, class Allocator, size_t N>
+bool operator> (const dstd::impl::vector_interface<T, Allocator, N>& lhs, const dstd::impl::vector_interface<T, Allocator, N>& rhs)
+{
+	return ( rhs < lhs );
+}
+
+
+template <class T, class Allocator, size_t N>
+bool operator>= (const dstd::impl::vector_interface<T, Allocator, N>& lhs, const dstd::impl::vector_interface<T, Allocator, N>& rhs)
+{
+	return ! (lhs < rhs);
+}
+
+
+
+#endif
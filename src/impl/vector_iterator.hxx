@@ -6,16 +6,16 @@
 
 
 
-template <class T, class Allocator>
-class dstd::impl::vector_impl<T, Allocator>::iterator
+template <class T, class Allocator, size_t N>
+class dstd::impl::vector_impl<T, Allocator, N>::iterator
 {
 	public:
 
-		typedef typename dstd::impl::vector_impl<T, Allocator>::value_type value_type;
-		typedef typename dstd::impl::vector_impl<T, Allocator>::reference reference;
-		typedef typename dstd::impl::vector_impl<T, Allocator>::pointer pointer;
-		typedef typename dstd::impl::vector_impl<T, Allocator>::size_type size_type;
-		typedef typename dstd::impl::vector_impl<T, Allocator>::difference_type difference_type;
+		typedef typename dstd::impl::vector_impl<T, Allocator, N>::value_type value_type;
+		typedef typename dstd::impl::vector_impl<T, Allocator, N>::reference reference;
+		typedef typename dstd::impl::vector_impl<T, Allocator, N>::pointer pointer;
+		typedef typename dstd::impl::vector_impl<T, Allocator, N>::size_type size_type;
+		typedef typename dstd::impl::vector_impl<T, Allocator, N>::difference_type difference_type;
 
 		iterator(pointer ptr = 0) : p(ptr) {}
 		iterator(const iterator& it) : p(it.p) {}
@@ -23,16 +23,16 @@ class dstd::impl::vector_impl<T, Allocator>::iterator
 		pointer operator-> () const { return p; }
 		iterator& operator=(const iterator& rhs) { p = rhs.p; return *this; }
 		// Operators with int
-		iterator& operator+=(const int& n) { p += n; return (*this); }
-		iterator& operator-=(const int& n) { p -= n; return (*this); }
-		iterator operator+ (const int& n) { iterator it(*this); it += n; return it; }
-		iterator operator- (const int& n) { iterator it(*this); it -= n; return it; }
+		iterator& operator+=(difference_type n) { p += n; return (*this); }
+		iterator& operator-=(difference_type n) { p -= n; return (*this); }
+		iterator operator+ (difference_type n) const { iterator it(*this); it += n; return it; }
+		iterator operator- (difference_type n) const { iterator it(*this); it -= n; return it; }
 		// Operators with iterators
-		int operator- (const iterator& rhs) { return p - rhs.p; }
+		difference_type operator- (const iterator& rhs) const { return p - rhs.p; }
 		iterator& operator++() { (*this) += 1; return (*this); }
-		iterator& operator++(int) { iterator temp(*this); ++(*this); return temp; }
+		iterator operator++(int) { iterator temp(*this); ++(*this); return temp; }
 		iterator& operator--() { (*this) -= 1; return (*this); }
-		iterator& operator--(int) { iterator temp(*this); --(*this); return temp; }
+		iterator operator--(int) { iterator temp(*this); --(*this); return temp; }
 		bool operator==(const iterator& rhs) const { return (p == rhs.p); }
 		bool operator==(const const_iterator& rhs) const { return (p == rhs.p); }
 		bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
@@ -55,16 +55,16 @@ class dstd::impl::vector_impl<T, Allocator>::iterator
 
 
 
-template <class T, class Allocator>
-class dstd::impl::vector_impl<T, Allocator>::const_iterator
+template <class T, class Allocator, size_t N>
+class dstd::impl::vector_impl<T, Allocator, N>::const_iterator
 {
 	public:
 
-		typedef typename dstd::impl::vector_impl<T, Allocator>::value_type value_type;
-		typedef typename dstd::impl::vector_impl<T, Allocator>::const_reference  reference;
-		typedef typename dstd::impl::vector_impl<T, Allocator>::const_pointer  pointer;
-		typedef typename dstd::impl::vector_impl<T, Allocator>::size_type size_type;
-		typedef typename dstd::impl::vector_impl<T, Allocator>::difference_type difference_type;
+		typedef typename dstd::impl::vector_impl<T, Allocator, N>::value_type value_type;
+		typedef typename dstd::impl::vector_impl<T, Allocator, N>::const_reference  reference;
+		typedef typename dstd::impl::vector_impl<T, Allocator, N>::const_pointer  pointer;
+		typedef typename dstd::impl::vector_impl<T, Allocator, N>::size_type size_type;
+		typedef typename dstd::impl::vector_impl<T, Allocator, N>::difference_type difference_type;
 
 		const_iterator(pointer ptr = 0) : p(ptr) {}
 		const_iterator(const const_iterator& it) : p(it.p) {}
@@ -74,16 +74,16 @@ class dstd::impl::vector_impl<T, Allocator>::const_iterator
 		const_iterator& operator=(const const_iterator& rhs) { p = rhs.p; return *this; }
 		const_iterator& operator=(const iterator& rhs) { p = rhs.p; return *this; }
 		// Operators with int
-		const_iterator& operator+=(const int& n) { p += n; return (*this); }
-		const_iterator& operator-=(const int& n) { p -= n; return (*this); }
-		const_iterator operator+ (const int& n) { const_iterator it(*this); it += n; return it; }
-		const_iterator operator- (const int& n) { const_iterator it(*this); it -= n; return it; }
+		const_iterator& operator+=(difference_type n) { p += n; return (*this); }
+		const_iterator& operator-=(difference_type n) { p -= n; return (*this); }
+		const_iterator operator+ (difference_type n) const { const_iterator it(*this); it += n; return it; }
+		const_iterator operator- (difference_type n) const { const_iterator it(*this); it -= n; return it; }
 		// Operators with iterators
-		int operator- (const const_iterator& rhs) { return p - rhs.p; }
+		difference_type operator- (const const_iterator& rhs) const { return p - rhs.p; }
 		const_iterator& operator++() { (*this) += 1; return (*this); }
-		const_iterator& operator++(int) { const_iterator temp(*this); ++(*this); return temp; }
+		const_iterator operator++(int) { const_iterator temp(*this); ++(*this); return temp; }
 		const_iterator& operator--() { (*this) -= 1; return (*this); }
-		const_iterator& operator--(int) { const_iterator temp(*this); --(*this); return temp; }
+		const_iterator operator--(int) { const_iterator temp(*this); --(*this); return temp; }
 
 		bool operator==(const const_iterator& rhs) const { return (p == rhs.p); }
 		bool operator==(const iterator& rhs) const { return (p == rhs.p); }
@@ -3,10 +3,25 @@
 
 
 
+#include "impl/bool_type.hxx"
+
+#include "cstddef.hxx"
+#include "type_traits.hxx"
+
+
+
 namespace dstd
 {
 	template <class Iterator> class iterator_traits;
 	template <class Iterator> class reverse_iterator;
+	
+	template <class Iterator> typename iterator_traits<Iterator>::difference_type distance(Iterator first, Iterator last);
+	template <class Iterator, class Distance> void advance(Iterator& it, Distance n);
+	
+	namespace impl
+	{
+		template <class Iterator, class Enable> class is_random_access;
+	}
 }
 
 
@@ -24,6 +39,32 @@ class dstd::iterator_traits
 
 
 
+template <class T>
+class dstd::iterator_traits<T*>
+{
+	public:
+	typedef T value_type;
+	typedef T* pointer;
+	typedef T& reference;
+	typedef size_t size_type;
+	typedef ptrdiff_t difference_type;
+};
+
+
+
+template <class T>
+class dstd::iterator_traits<const T*>
+{
+	public:
+	typedef T value_type;
+	typedef const T* pointer;
+	typedef const T& reference;
+	typedef size_t size_type;
+	typedef ptrdiff_t difference_type;
+};
+
+
+
 template <class Iterator>
 class dstd::reverse_iterator
 {
@@ -186,11 +227,86 @@ dstd::reverse_iterator<Iterator> operator+ (const int n, const dstd::reverse_ite
 
 
 template <class Iterator1, class Iterator2>
-unsigned int operator- (const dstd::reverse_iterator<Iterator1>& lhs, const dstd::reverse_iterator<Iterator2>& rhs)
+ptrdiff_t operator- (const dstd::reverse_iterator<Iterator1>& lhs, const dstd::reverse_iterator<Iterator2>& rhs)
 {
 	return (rhs.base() - lhs.base());
 }
 
 
 
+/// Whether an iterator can move any distance in a single step. Iterators which can be subtracted from each other are taken to be able to.
+template <class Iterator, class Enable = void>
+class dstd::impl::is_random_access
+{
+	public:
+
+		typedef dstd::impl::FalseType type;
+};
+
+
+template <class Iterator>
+class dstd::impl::is_random_access<Iterator, decltype( (void)( dstd::declval<Iterator&>() - dstd::declval<Iterator&>() ) )>
+{
+	public:
+
+		typedef dstd::impl::TrueType type;
+};
+
+
+
+namespace dstd
+{
+	namespace impl
+	{
+		template <class Iterator>
+		typename iterator_traits<Iterator>::difference_type distance(Iterator first, Iterator last, dstd::impl::TrueType)
+		{
+			return last - first;
+		}
+		
+		
+		template <class Iterator>
+		typename iterator_traits<Iterator>::difference_type distance(Iterator first, Iterator last, dstd::impl::FalseType)
+		{
+			typename iterator_traits<Iterator>::difference_type n = 0;
+			for( ; first != last; ++first) ++n;
+			return n;
+		}
+		
+		
+		template <class Iterator, class Distance>
+		void advance(Iterator& it, Distance n, dstd::impl::TrueType)
+		{
+			it += n;
+		}
+		
+		
+		template <class Iterator, class Distance>
+		void advance(Iterator& it, Distance n, dstd::impl::FalseType)
+		{
+			for( ; n > 0; --n) ++it;
+		}
+	}
+}
+
+
+
+/// Returns the number of steps from first to last: in one step for random access iterators, and by counting them otherwise.
+template <class Iterator>
+typename dstd::iterator_traits<Iterator>::difference_type dstd::distance(Iterator first, Iterator last)
+{
+	return dstd::impl::distance( first, last, typename dstd::impl::is_random_access<Iterator>::type() );
+}
+
+
+
+/// Moves it n steps forward: in one step for random access iterators, and one at a time otherwise.
+template <class Iterator, class Distance>
+void dstd::advance(Iterator& it, Distance n)
+{
+	dstd::impl::advance( it, n, typename dstd::impl::is_random_access<Iterator>::type() );
+}
+
+
+
 #endif
@@ -10,6 +10,7 @@
 #include "memory.hxx"
 #include "exception.hxx"
 #include "iterator.hxx"
+#include "utility.hxx"
 
 
 
@@ -56,7 +57,7 @@ class dstd::list
 		
 		
 		explicit list (const allocator_type& alloc = allocator_type())
-			: a( node_allocator_type(alloc) ), n(new node_base(0,0))
+			: a( node_allocator_type(alloc) ), n(&this->sentinel), sentinel(0,0)
 		{
 			this->n->prev = this->n;
 			this->n->next = this->n;
@@ -64,7 +65,7 @@ class dstd::list
 		
 		
 		explicit list(size_t n, const value_type& val = value_type(), const allocator_type& alloc = allocator_type())
-			: a( node_allocator_type(alloc) ), n(new node_base(0,0))
+			: a( node_allocator_type(alloc) ), n(&this->sentinel), sentinel(0,0)
 		{
 			this->n->prev = this->n;
 			this->n->next = this->n;
@@ -73,7 +74,7 @@ class dstd::list
 		
 		
 		template <class InputIterator> list (InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type())
-			: a( node_allocator_type(alloc) ), n(new node_base(0,0))
+			: a( node_allocator_type(alloc) ), n(&this->sentinel), sentinel(0,0)
 		{
 			this->n->prev = this->n;
 			this->n->next = this->n;
@@ -82,7 +83,7 @@ class dstd::list
 		
 		
 		list(const list& x)
-			: a( node_allocator_type(x.get_allocator()) ), n(new node_base(0,0))
+			: a( node_allocator_type(x.get_allocator()) ), n(&this->sentinel), sentinel(0,0)
 		{
 			this->n->prev = this->n;
 			this->n->next = this->n;
@@ -90,10 +91,19 @@ class dstd::list
 		}
 		
 		
+		/// Move constructor. Takes x's nodes and allocator without allocating, leaving x empty.
+		list(list&& x) noexcept
+			: a( x.a ), n(&this->sentinel), sentinel(0,0)
+		{
+			this->n->prev = this->n;
+			this->n->next = this->n;
+			this->swap(x);
+		}
+		
+		
 		~list()
 		{
 			this->clear();
-			delete(this->n);
 		}
 		
 		
@@ -104,6 +114,15 @@ class dstd::list
 		}
 		
 		
+		/// Takes x's nodes, together with the allocator which owns them, leaving x empty.
+		list& operator= (list&& x) noexcept
+		{
+			list temp( dstd::move(x) );
+			this->swap(temp);
+			return *this;
+		}
+		
+		
 		iterator begin()
 		{
 			return iterator(this->n->next);
@@ -219,6 +238,19 @@ class dstd::list
 		}
 		
 		
+		void push_front(value_type&& val)
+		{
+			this->emplace(this->begin(), dstd::move(val));
+		}
+		
+		
+		template <class... Args>
+		void emplace_front(Args&&... args)
+		{
+			this->emplace(this->begin(), dstd::forward<Args>(args)...);
+		}
+		
+		
 		void pop_front()
 		{
 			this->erase(this->begin());
@@ -231,6 +263,19 @@ class dstd::list
 		}
 		
 		
+		void push_back(value_type&& val)
+		{
+			this->emplace(this->end(), dstd::move(val));
+		}
+		
+		
+		template <class... Args>
+		void emplace_back(Args&&... args)
+		{
+			this->emplace(this->end(), dstd::forward<Args>(args)...);
+		}
+		
+		
 		void pop_back()
 		{
 			this->erase(iterator(this->n->prev));
@@ -238,10 +283,32 @@ class dstd::list
 		
 		
 		iterator insert (iterator position, const value_type& val)
+		{
+			return this->emplace(position, val);
+		}
+		
+		
+		iterator insert (iterator position, value_type&& val)
+		{
+			return this->emplace(position, dstd::move(val));
+		}
+		
+		
+		/// Inserts an element constructed in place from args before position.
+		template <class... Args>
+		iterator emplace(iterator position, Args&&... args)
 		{
 			// create new node
 			node* new_node = this->a.allocate(1);
-			this->a.construct( new_node, node(val, position.p->prev, position.p) );
+			try
+			{
+				this->a.construct( new_node, position.p->prev, position.p, dstd::forward<Args>(args)... );
+			}
+			catch(...)
+			{
+				this->a.deallocate(new_node, 1);
+				throw;
+			}
 			
 			// put new node in list
 			position.p->prev->next = new_node;
@@ -321,9 +388,16 @@ class dstd::list
 		
 		void swap(list& x)
 		{
-			node_base* temp( this->n );
-			this->n = x.n;
-			x.n = temp;
+			// each list keeps its own sentinel, so the nodes are moved from one ring to the other through a third
+			node_base temp(0,0);
+			temp.prev = &temp;
+			temp.next = &temp;
+			list::relink(temp, *this->n);
+			list::relink(*this->n, *x.n);
+			list::relink(*x.n, temp);
+			
+			// the nodes are exchanged, so the allocators which own them must be too
+			dstd::swap(this->a, x.a);
 		}
 		
 		
@@ -565,8 +639,24 @@ class dstd::list
 		}
 		
 		
+		/// Moves the nodes in the ring of the sentinel from to the ring of the sentinel to, which must be empty, leaving from empty.
+		static void relink(node_base& to, node_base& from)
+		{
+			if( from.next == &from ) return;
+			
+			to.next = from.next;
+			to.prev = from.prev;
+			to.next->prev = &to;
+			to.prev->next = &to;
+			
+			from.next = &from;
+			from.prev = &from;
+		}
+		
+		
 		node_allocator_type a;
-		node_base* n;
+		node_base* n; ///< The sentinel, which is end(). It points at sentinel, kept inside the list so that no list allocates one.
+		node_base sentinel;
 };
 
 
@@ -595,8 +685,9 @@ class dstd::list<T, Allocator>::node : public dstd::list<T, Allocator>::node_bas
 {
 	public:
 		
-		node(T node_value, node_base* prev_node, node_base* next_node)
-			: node_base(prev_node, next_node), value(node_value)
+		template <class... Args>
+		node(node_base* prev_node, node_base* next_node, Args&&... args)
+			: node_base(prev_node, next_node), value( dstd::forward<Args>(args)... )
 		{}
 		
 		T value;
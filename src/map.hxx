@@ -74,12 +74,18 @@ class dstd::map : public dstd::impl::map_base<Key, T, Compare, Allocator, false>
 		map (const map& x)
 			: map_base(x.key_comp(), x.get_allocator())
 		{
-			// TODO: this might be quite time consuming for a balanced tree, because the
-			// elements are being inserted in-order. Could be made more efficient?
 			this->insert(x.begin(), x.end());
 		}
 		
 		
+		/// Move constructor. Takes the elements, comparison object and allocator of x, leaving x empty.
+		map (map&& x) noexcept
+			: map_base(x.key_comp(), x.get_allocator())
+		{
+			this->swap_base(x);
+		}
+		
+		
 		//
 		// Destructors
 		
@@ -99,6 +105,15 @@ class dstd::map : public dstd::impl::map_base<Key, T, Compare, Allocator, false>
 		}
 		
 		
+		/// Takes the elements of x, together with the allocator which owns them, leaving x empty.
+		map& operator= (map&& x) noexcept
+		{
+			this->clear();
+			this->swap_base(x);
+			return *this;
+		}
+		
+		
 		//
 		// Element Access
 		
@@ -107,13 +122,10 @@ class dstd::map : public dstd::impl::map_base<Key, T, Compare, Allocator, false>
 		/// If k matches the key of an element in the container, the function returns a reference to its mapped value.
 		/// If k does not match the key of any element in the container,
 		/// the function inserts a new element with that key and returns a reference to its mapped value.
+		/// An existing element is found with a single search, without constructing a value_type.
 		mapped_type& operator[] (const key_type& k)
 		{
-			dstd::pair<iterator, bool> res = this->insert(value_type(k, mapped_type()));
-			iterator location = res.first;
-			mapped_type& v = location->second;
-			return v;
-			//return this->insert( value_type(k, mapped_type()) ).first->second;
+			return this->try_emplace(k).first->second;
 		}
 		
 		
@@ -130,9 +142,27 @@ class dstd::map : public dstd::impl::map_base<Key, T, Compare, Allocator, false>
 		/// and its second member set to true if a new element was inserted or false if an equivalent key already existed.
 		dstd::pair< iterator, bool > insert(const value_type& value)
 		{
-			size_type n = this->size();
-			iterator new_node = this->insert_node(value);
-			return dstd::pair<iterator, bool>( new_node, (n < this->size()) );
+			dstd::pair<node*, bool> result = this->insert_node(value);
+			return dstd::pair<iterator, bool>( iterator(result.first), result.second );
+		}
+		
+		
+		/// Extends the container by moving value into a new element, if no element with an equivalent key exists.
+		dstd::pair< iterator, bool > insert(value_type&& value)
+		{
+			dstd::pair<node*, bool> result = this->insert_node( dstd::move(value) );
+			return dstd::pair<iterator, bool>( iterator(result.first), result.second );
+		}
+		
+		
+		/// Constructs an element in place from args, and inserts it if no element with an equivalent key exists.
+		/// The element is constructed before the map is searched. Prefer try_emplace, which constructs nothing
+		/// when the key already exists.
+		template <class... Args>
+		dstd::pair< iterator, bool > emplace(Args&&... args)
+		{
+			dstd::pair<node*, bool> result = this->emplace_node( dstd::forward<Args>(args)... );
+			return dstd::pair<iterator, bool>( iterator(result.first), result.second );
 		}
 		
 		
@@ -141,37 +171,94 @@ class dstd::map : public dstd::impl::map_base<Key, T, Compare, Allocator, false>
 		/// are made and an iterator to the existing value is returned.
 		/// @param position An iterator pointing to an element in the map, hinting at a suitable
 		/// location for the new element to be inserted.
+		/// If the element belongs immediately before or after position, the map is not searched.
 		/// @param value The key/value pair to be inserted.
 		/// @returns An iterator pointing to either the newly inserted element or
 		/// to the element with an equivalent key already in the map.
 		iterator insert(iterator position, const value_type& value)
 		{
-			// TODO
-			// position is a hint as to where value can be inserted
-			// making use of this could optimise insertion
-			// for now just doing a non-optimised, but conforming, insert
-			dstd::pair< iterator, bool > result = this->insert(value);
-			return result.first;
+			return iterator( this->insert_node(position, value).first );
+		}
+		iterator insert(iterator position, value_type&& value)
+		{
+			return iterator( this->insert_node(position, dstd::move(value)).first );
+		}
+		
+		
+		/// Constructs an element in place from args, and inserts it as close as possible before position,
+		/// if no element with an equivalent key exists.
+		template <class... Args>
+		iterator emplace_hint(iterator position, Args&&... args)
+		{
+			return iterator( this->emplace_node_hint(position, dstd::forward<Args>(args)...).first );
+		}
+		
+		
+		/// Inserts an element with key k and a mapped value constructed in place from args, if no element with key k exists.
+		/// With no args, the mapped value is value initialised.
+		/// The tree is searched once, and nothing is constructed or allocated if k already exists.
+		/// @returns A pair, with its first member an iterator to the element with key k,
+		/// and its second member set to true if a new element was inserted.
+		template <class... Args>
+		dstd::pair< iterator, bool > try_emplace(const key_type& k, Args&&... args)
+		{
+			node* parent = 0;
+			bool left = true;
+			node* existing = this->find_insert_position(k, parent, left);
+			if( existing != 0 ) return dstd::pair<iterator, bool>( iterator(existing), false );
+			node* n = this->new_node( k, mapped_type( dstd::forward<Args>(args)... ) );
+			this->tree.insert_at(n, parent, left);
+			return dstd::pair<iterator, bool>( iterator(n), true );
+		}
+		
+		
+		/// As try_emplace above, but if a new element is inserted, its key is moved from k.
+		template <class... Args>
+		dstd::pair< iterator, bool > try_emplace(key_type&& k, Args&&... args)
+		{
+			node* parent = 0;
+			bool left = true;
+			node* existing = this->find_insert_position(k, parent, left);
+			if( existing != 0 ) return dstd::pair<iterator, bool>( iterator(existing), false );
+			node* n = this->new_node( dstd::move(k), mapped_type( dstd::forward<Args>(args)... ) );
+			this->tree.insert_at(n, parent, left);
+			return dstd::pair<iterator, bool>( iterator(n), true );
+		}
+		
+		
+		/// Assigns obj to the mapped value of the element with key k, or inserts a new element if there is none.
+		/// The tree is searched once.
+		/// @returns A pair, with its first member an iterator to the element with key k,
+		/// and its second member set to true if a new element was inserted or false if the mapped value was assigned.
+		template <class M>
+		dstd::pair< iterator, bool > insert_or_assign(const key_type& k, const M& obj)
+		{
+			node* parent = 0;
+			bool left = true;
+			node* existing = this->find_insert_position(k, parent, left);
+			if( existing != 0 )
+			{
+				existing->value.second = obj;
+				return dstd::pair<iterator, bool>( iterator(existing), false );
+			}
+			return dstd::pair<iterator, bool>( iterator( this->create_node(value_type(k, mapped_type(obj)), parent, left) ), true );
 		}
 		
 		
 		/// Extends the container by copying elements in the range [first,last).
 		/// If an element with the key value::first already exists in the map that element remains unchanged.
+		/// If the map is empty, the leading run of sorted elements is built into a balanced tree in linear time.
 		/// @param first An iterator to the first element to be inserted.
 		/// @param last An iterator to the first element not to be inserted.
 		template <class InputIterator>
 		void insert(InputIterator first, InputIterator last)
 		{
-			while( first != last )
-			{
-				this->insert( *first );
-				++first;
-			}
+			this->insert_range(first, last);
 		}
 		
 		
 		/// Exchanges the content of the container by the content of x, which is another map of the same type.
-		void swap(map& x) { dstd::swap( this->tree, x.tree ); }
+		void swap(map& x) { this->swap_base(x); }
 		
 		
 		//
@@ -274,12 +361,18 @@ class dstd::multimap : public dstd::impl::map_base<Key, T, Compare, Allocator, t
 		multimap (const multimap& x)
 			: map_base(x.key_comp(), x.get_allocator())
 		{
-			// TODO: this might be quite time consuming for a balanced tree, because the
-			// elements are being inserted in-order. Could be made more efficient?
 			this->insert(x.begin(), x.end());
 		}
 		
 		
+		/// Move constructor. Takes the elements, comparison object and allocator of x, leaving x empty.
+		multimap (multimap&& x) noexcept
+			: map_base(x.key_comp(), x.get_allocator())
+		{
+			this->swap_base(x);
+		}
+		
+		
 		//
 		// Destructor
 		
@@ -299,6 +392,15 @@ class dstd::multimap : public dstd::impl::map_base<Key, T, Compare, Allocator, t
 		}
 		
 		
+		/// Takes the elements of x, together with the allocator which owns them, leaving x empty.
+		multimap& operator= (multimap&& x) noexcept
+		{
+			this->clear();
+			this->swap_base(x);
+			return *this;
+		}
+		
+		
 		//
 		// Modifiers
 		
@@ -308,26 +410,46 @@ class dstd::multimap : public dstd::impl::map_base<Key, T, Compare, Allocator, t
 		/// @returns An iterator to the newly inserted element.
 		iterator insert(const value_type& value)
 		{
-			return iterator( this->insert_node(value) );
-			//node* n = this->find_insert_parent(value.first);
-			//n = this->insert_node(value, n);
-			//return iterator(n);
+			return iterator( this->insert_node(value).first );
+		}
+		
+		
+		/// Extends the container by moving value into a new element.
+		iterator insert(value_type&& value)
+		{
+			return iterator( this->insert_node( dstd::move(value) ).first );
+		}
+		
+		
+		/// Constructs an element in place from args, and inserts it after any elements with an equivalent key.
+		template <class... Args>
+		iterator emplace(Args&&... args)
+		{
+			return iterator( this->emplace_node( dstd::forward<Args>(args)... ).first );
 		}
 		
 		
 		/// Extends the container by inserting a new element.
 		/// @param position An iterator pointing to an element in the map, hinting at a suitable
 		/// location for the new element to be inserted.
+		/// If the element belongs immediately before or after position, the map is not searched.
 		/// @param value The key/value pair to be inserted.
-		/// @returns An iterator pointing to either the newly inserted element or
-		/// to the element with an equivalent key already in the map.
+		/// @returns An iterator pointing to the newly inserted element.
 		iterator insert(iterator position, const value_type& value)
 		{
-			// TODO
-			// position is a hint as to where value can be inserted
-			// making use of this could optimise insertion
-			// for now just doing a non-optimised, but conforming, insert
-			return this->insert(value);
+			return iterator( this->insert_node(position, value).first );
+		}
+		iterator insert(iterator position, value_type&& value)
+		{
+			return iterator( this->insert_node(position, dstd::move(value)).first );
+		}
+		
+		
+		/// Constructs an element in place from args, and inserts it as close as possible before position.
+		template <class... Args>
+		iterator emplace_hint(iterator position, Args&&... args)
+		{
+			return iterator( this->emplace_node_hint(position, dstd::forward<Args>(args)...).first );
 		}
 		
 		
@@ -337,23 +459,12 @@ class dstd::multimap : public dstd::impl::map_base<Key, T, Compare, Allocator, t
 		template <class InputIterator>
 		void insert(InputIterator first, InputIterator last)
 		{
-			while( first != last )
-			{
-				this->insert( *first );
-				++first;
-			}
+			this->insert_range(first, last);
 		}
 		
 		
 		/// Exchanges the content of the container by the content of x, which is another map of the same type.
-		void swap(multimap& x)
-		{
-			// TODO: why doesn't this work? Get linker error
-			//dstd::swap( this->tree, x.tree );
-			typename map_base::tree_type* temp = this->tree;
-			this->tree = x.tree;
-			x.tree = temp;
-		}
+		void swap(multimap& x) { this->swap_base(x); }
 		
 		
 		//
@@ -377,15 +488,11 @@ class dstd::multimap : public dstd::impl::map_base<Key, T, Compare, Allocator, t
 		/// Searches the container for elements with a key equivalent to k and returns the number of matches.
 		size_type count(const key_type& k) const
 		{
-			size_t n = 0;
-			const_iterator it = this->find(k);
-			if( it != this->end() )
+			dstd::pair<const_iterator,const_iterator> range = this->equal_range(k);
+			size_type n = 0;
+			for( ; range.first != range.second; ++range.first )
 			{
-				while( this->keys_equal( it->first, k ) )
-				{
-					++n;
-					++it;
-				}
+				++n;
 			}
 			return n;
 		}
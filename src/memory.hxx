@@ -3,13 +3,21 @@
 
 #include <new>
 
+#include "cstddef.hxx"
 #include "exception.hxx"
+#include "limits.hxx"
+#include "utility.hxx"
 
 
 
 namespace dstd
 {
 	template <class T> class allocator;
+
+	namespace impl
+	{
+		template <class Allocator, class Enable> class allocator_alignment;
+	}
 }
 
 
@@ -56,17 +64,26 @@ class dstd::allocator
 		}
 
 		
+		/// Returns the largest n which may be passed to allocate, whose size in bytes still fits in a size_t.
+		size_t max_size() const
+		{
+			return dstd::numeric_limits<size_t>::max() / sizeof(T);
+		}
+		
+		
 		/// Attempts to allocate a block of storage with a size large enough to contain n elements and returns a pointer to the first element.
-		/// Throws bad_alloc if it cannot allocate the total amount of storage requested.
-		T* allocate(unsigned int n) //, const T* hint = 0)
+		/// Throws bad_alloc if it cannot allocate the total amount of storage requested, including when n*sizeof(T) would not fit in a size_t.
+		T* allocate(size_t n) //, const T* hint = 0)
 		{
+			if( n > this->max_size() ) throw dstd::bad_alloc();
+			
 			T* a = 0;
 			
 			try
 			{
 				a = reinterpret_cast< T* >( ::operator new(n*sizeof(T)) );
 			}
-			catch( std::bad_alloc )
+			catch( std::bad_alloc& )
 			{
 				throw dstd::bad_alloc();
 			}
@@ -82,16 +99,20 @@ class dstd::allocator
 		
 		/// Releases a block of storage previously allocated with member allocate and not yet released
 		/// The elements in the array are not destroyed by a call to this member function.
-		void deallocate(T* p, size_t size = 0)
+		/// n should be the number of elements the block was allocated with, which is passed on to ::operator delete as its size in bytes.
+		/// An n of 0 means the size is not known.
+		void deallocate(T* p, size_t n = 0)
 		{
-			::operator delete( p );
+			if( n == 0 ) ::operator delete( p );
+			else ::operator delete( p, n * sizeof(T) );
 		}
 		
 		
-		/// Constructs an element object on the location pointed by p.
-		void construct(T* p, const T& value)
+		/// Constructs an object on the location pointed by p, passing args on to its constructor.
+		template <class U, class... Args>
+		void construct(U* p, Args&&... args)
 		{
-			new(p) T(value);
+			new(p) U( dstd::forward<Args>(args)... );
 		}
 		
 		
@@ -103,4 +124,40 @@ class dstd::allocator
 };
 
 
+
+/// The alignment of the blocks an allocator returns: its alignment member, if it has one, and otherwise that of its value_type.
+template <class Allocator, class Enable = void>
+class dstd::impl::allocator_alignment
+{
+	public:
+
+		static const size_t value = alignof(typename Allocator::value_type);
+};
+
+
+template <class Allocator>
+class dstd::impl::allocator_alignment<Allocator, decltype( (void)Allocator::alignment )>
+{
+	public:
+
+		static const size_t value = Allocator::alignment;
+};
+
+
+
+template <class T, class U>
+bool operator==(const dstd::allocator<T>& a, const dstd::allocator<U>& b)
+{
+	return true;
+}
+
+
+
+template <class T, class U>
+bool operator!=(const dstd::allocator<T>& a, const dstd::allocator<U>& b)
+{
+	return false;
+}
+
+
 #endif
@@ -0,0 +1,489 @@
+#ifndef DSTD_MEMORY_RESOURCE_HXX
+#define DSTD_MEMORY_RESOURCE_HXX
+
+#include <new>
+
+#include "impl/bit_ops.hxx"
+#include "impl/node_pool.hxx"
+
+#include "arena.hxx"
+#include "cstddef.hxx"
+#include "exception.hxx"
+#include "limits.hxx"
+#include "utility.hxx"
+
+
+
+namespace dstd
+{
+	class memory_resource;
+	class monotonic_resource;
+	class pool_resource;
+	template <class T> class polymorphic_allocator;
+
+	memory_resource* new_delete_resource();
+	memory_resource* get_default_resource();
+	memory_resource* set_default_resource(memory_resource* r);
+
+	namespace impl
+	{
+		class new_delete_resource;
+	}
+}
+
+
+
+//
+// dstd::memory_resource
+//
+// The interface through which a polymorphic_allocator obtains its memory.
+// A container's type fixes its allocator, but a container using polymorphic_allocator is given its memory_resource at run time,
+// so the same map type can take its nodes from the heap in one place and from a pool or a monotonic resource in another.
+// Implementations override do_allocate, do_deallocate and do_is_equal.
+
+class dstd::memory_resource
+{
+	public:
+
+		typedef size_t size_type;
+
+		/// The alignment of blocks for which none is given, enough for any scalar type.
+		static constexpr size_type default_alignment = alignof(std::max_align_t);
+
+
+		virtual ~memory_resource(){}
+
+
+		/// Returns a block of bytes bytes, aligned to alignment, which must be a power of two.
+		/// Throws bad_alloc if the block cannot be allocated.
+		void* allocate(size_type bytes, size_type alignment = default_alignment)
+		{
+			return this->do_allocate(bytes, alignment);
+		}
+
+
+		/// Returns a block, previously returned by allocate with the same bytes and alignment, to the resource.
+		void deallocate(void* p, size_type bytes, size_type alignment = default_alignment)
+		{
+			this->do_deallocate(p, bytes, alignment);
+		}
+
+
+		/// Returns whether memory allocated from this resource may be freed through other, and the other way round.
+		bool is_equal(const memory_resource& other) const
+		{
+			return this->do_is_equal(other);
+		}
+
+
+	private:
+
+		virtual void* do_allocate(size_type bytes, size_type alignment) = 0;
+		virtual void do_deallocate(void* p, size_type bytes, size_type alignment) = 0;
+		virtual bool do_is_equal(const memory_resource& other) const = 0;
+};
+
+
+
+inline bool operator==(const dstd::memory_resource& a, const dstd::memory_resource& b)
+{
+	return ( &a == &b || a.is_equal(b) );
+}
+
+
+
+inline bool operator!=(const dstd::memory_resource& a, const dstd::memory_resource& b)
+{
+	return ! (a == b);
+}
+
+
+
+//
+// dstd::new_delete_resource
+//
+// A resource which passes every request on to the global operator new and operator delete.
+// It is the default resource unless set_default_resource is given another.
+
+class dstd::impl::new_delete_resource : public dstd::memory_resource
+{
+	private:
+
+		void* do_allocate(size_type bytes, size_type alignment)
+		{
+			try
+			{
+				if( alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ) return ::operator new( bytes, std::align_val_t(alignment) );
+				return ::operator new(bytes);
+			}
+			catch( std::bad_alloc& )
+			{
+				throw dstd::bad_alloc();
+			}
+		}
+
+
+		void do_deallocate(void* p, size_type bytes, size_type alignment)
+		{
+			if( alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ) ::operator delete( p, bytes, std::align_val_t(alignment) );
+			else ::operator delete(p, bytes);
+		}
+
+
+		bool do_is_equal(const memory_resource& other) const
+		{
+			return ( this == &other );
+		}
+};
+
+
+
+/// Returns the resource which uses the global operator new and operator delete.
+inline dstd::memory_resource* dstd::new_delete_resource()
+{
+	static dstd::impl::new_delete_resource resource;
+	return &resource;
+}
+
+
+
+namespace dstd
+{
+	namespace impl
+	{
+		inline memory_resource*& default_resource()
+		{
+			static memory_resource* resource = dstd::new_delete_resource();
+			return resource;
+		}
+	}
+}
+
+
+
+/// Returns the resource used by polymorphic_allocators which are not given one.
+inline dstd::memory_resource* dstd::get_default_resource()
+{
+	return dstd::impl::default_resource();
+}
+
+
+
+/// Makes r the resource used by polymorphic_allocators which are not given one, or new_delete_resource() if r is null.
+/// Allocators constructed before the call keep the resource they were given.
+/// @returns The previous default resource.
+inline dstd::memory_resource* dstd::set_default_resource(dstd::memory_resource* r)
+{
+	dstd::memory_resource* previous = dstd::impl::default_resource();
+	dstd::impl::default_resource() = ( r == 0 ) ? dstd::new_delete_resource() : r;
+	return previous;
+}
+
+
+
+//
+// dstd::monotonic_resource
+//
+// A resource which hands out memory from an arena. Deallocating does nothing;
+// the memory is reclaimed all at once by release, or when the resource is destroyed,
+// which makes allocating very cheap for containers that are built, used and then thrown away together.
+// It is not thread safe.
+
+class dstd::monotonic_resource : public dstd::memory_resource
+{
+	public:
+
+		/// Constructs a resource which allocates chunks of at least chunk_size bytes.
+		explicit monotonic_resource(size_type chunk_size = 65536)
+			: a(chunk_size)
+		{}
+
+
+		/// Frees everything allocated from the resource, keeping the first chunk for reuse.
+		/// Nothing allocated from it may be used afterwards.
+		void release()
+		{
+			this->a.reset();
+		}
+
+
+		/// Returns the arena the memory comes from.
+		dstd::arena& get_arena() { return this->a; }
+
+
+	private:
+
+		monotonic_resource(const monotonic_resource&);
+		monotonic_resource& operator= (const monotonic_resource&);
+
+
+		void* do_allocate(size_type bytes, size_type alignment)
+		{
+			return this->a.allocate(bytes, alignment);
+		}
+
+
+		void do_deallocate(void* /*p*/, size_type /*bytes*/, size_type /*alignment*/)
+		{}
+
+
+		bool do_is_equal(const memory_resource& other) const
+		{
+			return ( this == &other );
+		}
+
+
+		dstd::arena a;
+};
+
+
+
+//
+// dstd::pool_resource
+//
+// A resource which sorts small blocks by size into pools of 8, 16, 32 ... 512 bytes, and recycles freed blocks within each pool.
+// Larger blocks, and blocks aligned more strictly than default_alignment, come from an upstream resource.
+// Since a block's pool is found from its size, blocks must be freed with the size they were allocated with, as the dstd containers do.
+// Every pooled block is freed when the resource is destroyed. It is not thread safe.
+
+class dstd::pool_resource : public dstd::memory_resource
+{
+	public:
+
+		/// The largest block held in a pool.
+		static const size_type max_pooled_size = 512;
+
+
+		/// Constructs a resource which takes large blocks from upstream.
+		explicit pool_resource(dstd::memory_resource* upstream = dstd::get_default_resource())
+			: up(upstream)
+		{}
+
+
+		~pool_resource()
+		{
+			this->release();
+		}
+
+
+		/// Frees every pooled block at once. Large blocks are not freed, since they belong to the upstream resource.
+		void release()
+		{
+			this->p8.release();
+			this->p16.release();
+			this->p32.release();
+			this->p64.release();
+			this->p128.release();
+			this->p256.release();
+			this->p512.release();
+		}
+
+
+		/// Returns the resource large blocks come from.
+		dstd::memory_resource* upstream_resource() const { return this->up; }
+
+
+	private:
+
+		pool_resource(const pool_resource&);
+		pool_resource& operator= (const pool_resource&);
+
+
+		/// Returns the index of the pool holding blocks of the given size and alignment: 0 for 8 bytes, 1 for 16 and so on.
+		/// Blocks take up a power of two, so each block in a slab is aligned to its size, up to the alignment of the slab.
+		static size_type pool_index(size_type bytes, size_type alignment)
+		{
+			if( bytes < alignment ) bytes = alignment;
+			if( bytes <= 8 ) return 0;
+			return dstd::impl::highest_bit_index(bytes - 1) - 2;
+		}
+
+
+		static bool is_pooled(size_type bytes, size_type alignment)
+		{
+			return ( bytes <= max_pooled_size && alignment <= default_alignment );
+		}
+
+
+		void* do_allocate(size_type bytes, size_type alignment)
+		{
+			if( ! pool_resource::is_pooled(bytes, alignment) ) return this->up->allocate(bytes, alignment);
+
+			switch( pool_resource::pool_index(bytes, alignment) )
+			{
+				case 0: return this->p8.allocate();
+				case 1: return this->p16.allocate();
+				case 2: return this->p32.allocate();
+				case 3: return this->p64.allocate();
+				case 4: return this->p128.allocate();
+				case 5: return this->p256.allocate();
+				default: return this->p512.allocate();
+			}
+		}
+
+
+		void do_deallocate(void* p, size_type bytes, size_type alignment)
+		{
+			if( ! pool_resource::is_pooled(bytes, alignment) )
+			{
+				this->up->deallocate(p, bytes, alignment);
+				return;
+			}
+
+			switch( pool_resource::pool_index(bytes, alignment) )
+			{
+				case 0: this->p8.deallocate(p); break;
+				case 1: this->p16.deallocate(p); break;
+				case 2: this->p32.deallocate(p); break;
+				case 3: this->p64.deallocate(p); break;
+				case 4: this->p128.deallocate(p); break;
+				case 5: this->p256.deallocate(p); break;
+				default: this->p512.deallocate(p); break;
+			}
+		}
+
+
+		bool do_is_equal(const memory_resource& other) const
+		{
+			return ( this == &other );
+		}
+
+
+		dstd::memory_resource* up;
+		dstd::impl::node_pool<8> p8;
+		dstd::impl::node_pool<16> p16;
+		dstd::impl::node_pool<32> p32;
+		dstd::impl::node_pool<64> p64;
+		dstd::impl::node_pool<128> p128;
+		dstd::impl::node_pool<256> p256;
+		dstd::impl::node_pool<512> p512;
+};
+
+
+
+//
+// dstd::polymorphic_allocator
+//
+// An allocator which obtains its memory from a memory_resource chosen at run time.
+// Copies, including those obtained through rebind, share the resource, so the nodes of a map or list come from it too.
+// The resource is not owned, and must outlive every container using it.
+
+template <class T>
+class dstd::polymorphic_allocator
+{
+	public:
+
+		typedef T value_type;
+		typedef T* pointer;
+		typedef T& reference;
+		typedef const T* const_pointer;
+		typedef const T& const_reference;
+
+		template <class OtherType>
+		struct rebind
+		{
+			typedef polymorphic_allocator< OtherType > other;
+		};
+
+
+		/// Constructs an allocator using get_default_resource().
+		polymorphic_allocator()
+			: r( dstd::get_default_resource() )
+		{}
+
+
+		/// Constructs an allocator using resource.
+		polymorphic_allocator(dstd::memory_resource* resource)
+			: r(resource)
+		{}
+
+
+		template <class U>
+		polymorphic_allocator(const dstd::polymorphic_allocator<U>& other)
+			: r( other.resource() )
+		{}
+
+
+		~polymorphic_allocator(){}
+
+
+		T* address(T& obj) const
+		{
+			return &obj;
+		}
+
+
+		const T* address(const T& obj) const
+		{
+			return &obj;
+		}
+
+
+		/// Returns the largest n which may be passed to allocate.
+		size_t max_size() const
+		{
+			return dstd::numeric_limits<size_t>::max() / sizeof(T);
+		}
+
+
+		/// Allocates storage for n objects of type T from the resource.
+		/// Throws bad_alloc if the storage cannot be allocated.
+		T* allocate(size_t n)
+		{
+			if( n > this->max_size() ) throw dstd::bad_alloc();
+			return static_cast<T*>( this->r->allocate(n * sizeof(T), alignof(T)) );
+		}
+
+
+		/// Returns storage for n objects, previously allocated with allocate(n), to the resource.
+		/// The objects are not destroyed by a call to this member function.
+		void deallocate(T* p, size_t n = 0)
+		{
+			if( p == 0 ) return;
+			this->r->deallocate(p, n * sizeof(T), alignof(T));
+		}
+
+
+		/// Constructs an object on the location pointed by p, passing args on to its constructor.
+		template <class U, class... Args>
+		void construct(U* p, Args&&... args)
+		{
+			new(p) U( dstd::forward<Args>(args)... );
+		}
+
+
+		/// Destroys in-place the object pointed by p.
+		void destroy(T* p)
+		{
+			p->~T();
+		}
+
+
+		/// Returns the resource the memory comes from.
+		dstd::memory_resource* resource() const { return this->r; }
+
+
+	private:
+
+		dstd::memory_resource* r;
+};
+
+
+
+template <class T, class U>
+bool operator==(const dstd::polymorphic_allocator<T>& a, const dstd::polymorphic_allocator<U>& b)
+{
+	return ( *a.resource() == *b.resource() );
+}
+
+
+
+template <class T, class U>
+bool operator!=(const dstd::polymorphic_allocator<T>& a, const dstd::polymorphic_allocator<U>& b)
+{
+	return ! (a == b);
+}
+
+
+
+#endif
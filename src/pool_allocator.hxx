@@ -0,0 +1,131 @@
+#ifndef DSTD_POOL_ALLOCATOR_HXX
+#define DSTD_POOL_ALLOCATOR_HXX
+
+#include <new>
+
+#include "impl/node_pool.hxx"
+
+#include "cstddef.hxx"
+#include "memory.hxx"
+#include "utility.hxx"
+
+
+
+namespace dstd
+{
+	template <class T> class pool_allocator;
+}
+
+
+
+//
+// dstd::pool_allocator
+//
+// An allocator for the nodes of lists, maps and sets, which takes single objects from a node_pool
+// rather than calling ::operator new for each one.
+// On each thread, every pool_allocator for types of the same (rounded up) size shares one pool, so all pool_allocators
+// compare equal, and memory allocated by one may be deallocated by any other pool_allocator for the same type.
+// Each thread has pools of its own, so allocating and deallocating take no lock. A block deallocated on another thread
+// than the one which allocated it joins the pool of the thread which deallocates it.
+// Requests for more than one object are passed on to ::operator new, and must be deallocated with their size.
+
+template <class T>
+class dstd::pool_allocator
+{
+	public:
+
+		typedef T value_type;
+		typedef T* pointer;
+		typedef T& reference;
+		typedef const T* const_pointer;
+		typedef const T& const_reference;
+
+		template <class OtherType>
+		struct rebind
+		{
+			typedef pool_allocator< OtherType > other;
+		};
+
+
+		pool_allocator(){}
+
+
+		template <class U>
+		pool_allocator(const dstd::pool_allocator<U>& /*a*/){}
+
+
+		~pool_allocator(){}
+
+
+		T* address(T& obj) const
+		{
+			return &obj;
+		}
+
+
+		const T* address(const T& obj) const
+		{
+			return &obj;
+		}
+
+
+		/// Allocates storage for n objects of type T. A single object is taken from the pool.
+		/// Throws bad_alloc if the storage cannot be allocated.
+		T* allocate(size_t n)
+		{
+			if( n == 1 ) return static_cast<T*>( pool_allocator::pool().allocate() );
+			return dstd::allocator<T>().allocate(n);
+		}
+
+
+		/// Releases storage for n objects, previously allocated with allocate(n).
+		/// The objects are not destroyed by a call to this member function.
+		void deallocate(T* p, size_t n = 1)
+		{
+			if( p == 0 ) return;
+			if( n == 1 ) pool_allocator::pool().deallocate(p);
+			else dstd::allocator<T>().deallocate(p, n);
+		}
+
+
+		/// Constructs an object on the location pointed by p, passing args on to its constructor.
+		template <class U, class... Args>
+		void construct(U* p, Args&&... args)
+		{
+			new(p) U( dstd::forward<Args>(args)... );
+		}
+
+
+		/// Destroys in-place the object pointed by p.
+		void destroy(T* p)
+		{
+			p->~T();
+		}
+
+
+	private:
+
+		typedef dstd::impl::node_pool< dstd::impl::node_pool_block_size<T>::value > pool_type;
+
+		static pool_type& pool() { return pool_type::instance(); }
+};
+
+
+
+template <class T, class U>
+bool operator==(const dstd::pool_allocator<T>& /*a*/, const dstd::pool_allocator<U>& /*b*/)
+{
+	return true;
+}
+
+
+
+template <class T, class U>
+bool operator!=(const dstd::pool_allocator<T>& /*a*/, const dstd::pool_allocator<U>& /*b*/)
+{
+	return false;
+}
+
+
+
+#endif
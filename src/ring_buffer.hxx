@@ -0,0 +1,692 @@
+#ifndef DSTD_RING_BUFFER_HXX
+#define DSTD_RING_BUFFER_HXX
+
+#include "impl/vector_impl.hxx"
+
+#include "cstddef.hxx"
+#include "exception.hxx"
+#include "iterator.hxx"
+#include "memory.hxx"
+#include "utility.hxx"
+
+
+
+namespace dstd
+{
+	/// What a ring_buffer does with an element pushed while it is full.
+	enum full_policy
+	{
+		reject_when_full,   ///< Throw length_error, leaving the buffer unchanged.
+		overwrite_oldest    ///< Drop the element at the other end to make room: the oldest, when pushing at the back.
+	};
+
+	template <class T, size_t N, class Allocator> class ring_buffer;
+	template <class T, size_t N, class Allocator> void swap(ring_buffer<T, N, Allocator>& a, ring_buffer<T, N, Allocator>& b);
+
+	namespace impl
+	{
+		constexpr size_t ring_buffer_slots(size_t capacity);
+	}
+}
+template <class T, size_t N, class Allocator> bool operator== (const dstd::ring_buffer<T, N, Allocator>& lhs, const dstd::ring_buffer<T, N, Allocator>& rhs);
+template <class T, size_t N, class Allocator> bool operator!= (const dstd::ring_buffer<T, N, Allocator>& lhs, const dstd::ring_buffer<T, N, Allocator>& rhs);
+
+
+
+/// Returns the number of slots a ring_buffer of the given capacity keeps: the capacity rounded up to a power of two,
+/// so that a position is turned into a slot with a mask rather than a division.
+constexpr size_t dstd::impl::ring_buffer_slots(size_t capacity)
+{
+	size_t slots = 1;
+	while( slots < capacity ) slots *= 2;
+	return ( capacity == 0 ) ? 0 : slots;
+}
+
+
+
+//
+// Ring Buffer
+//
+// A FIFO of at most capacity() elements, kept in one array of slots which the elements go round.
+// Pushing and popping at either end is O(1) and never allocates, and the memory used is fixed when the buffer is made.
+// With N greater than 0, the slots for N elements are kept inside the buffer itself and nothing is ever allocated;
+// with N of 0, the capacity is given at run time and the slots are allocated once, by the constructor.
+// Either way the slots are rounded up to a power of two, so the memory taken is less than twice the capacity.
+// The elements occupy at most two contiguous spans of slots, returned by first_span and second_span, and
+// read and write move elements a span at a time.
+// It can be the Container of a dstd::queue.
+
+template < class T, size_t N = 0, class Allocator = dstd::allocator<T> >
+class dstd::ring_buffer : protected dstd::impl::vector_storage< T, dstd::impl::ring_buffer_slots(N), dstd::impl::allocator_alignment<Allocator>::value >
+{
+	public:
+
+		typedef T value_type;
+		typedef Allocator allocator_type;
+		typedef typename allocator_type::reference reference;
+		typedef typename allocator_type::const_reference const_reference;
+		typedef typename allocator_type::pointer pointer;
+		typedef typename allocator_type::const_pointer const_pointer;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+		class iterator;
+		class const_iterator;
+		typedef dstd::reverse_iterator< iterator > reverse_iterator;
+		typedef dstd::reverse_iterator< const_iterator > const_reverse_iterator;
+
+
+		//
+		// Constructors
+
+
+		/// Constructs an empty buffer with a capacity of N.
+		explicit ring_buffer(dstd::full_policy policy = dstd::reject_when_full, const allocator_type& alloc = allocator_type())
+			: a(alloc), p(0), n_slots(0), cap(0), head(0), n(0), policy(policy)
+		{
+			this->initialise(N);
+		}
+
+
+		/// Constructs an empty buffer with room for capacity elements.
+		/// If N is greater than 0, capacity may be at most N, and throws length_error otherwise.
+		explicit ring_buffer(size_type capacity, dstd::full_policy policy = dstd::reject_when_full, const allocator_type& alloc = allocator_type())
+			: a(alloc), p(0), n_slots(0), cap(0), head(0), n(0), policy(policy)
+		{
+			this->initialise(capacity);
+		}
+
+
+		/// Constructs a buffer with the same capacity, policy and elements as x.
+		ring_buffer(const ring_buffer& x)
+			: a(x.a), p(0), n_slots(0), cap(0), head(0), n(0), policy(x.policy)
+		{
+			this->initialise(x.cap);
+			this->write( x.begin(), x.n );
+		}
+
+
+		/// Takes x's slots if they were allocated, and otherwise moves its elements one at a time, leaving x empty.
+		ring_buffer(ring_buffer&& x) noexcept( N == 0 || dstd::is_nothrow_move_constructible<T>::value )
+			: a(x.a), p(0), n_slots(0), cap(0), head(0), n(0), policy(x.policy)
+		{
+			this->take(x);
+		}
+
+
+		//
+		// Destructor
+
+
+		~ring_buffer()
+		{
+			this->clear();
+			this->release();
+		}
+
+
+		//
+		// Assignment
+
+
+		/// Copies the capacity, policy and elements of x. If the slots must grow, they are allocated anew.
+		ring_buffer& operator= (const ring_buffer& x)
+		{
+			if( this != &x )
+			{
+				this->clear();
+				if( N == 0 && this->n_slots != x.n_slots )
+				{
+					this->release();
+					this->initialise(x.cap);
+				}
+				this->cap = x.cap;
+				this->policy = x.policy;
+				this->write( x.begin(), x.n );
+			}
+			return *this;
+		}
+
+
+		/// Takes x's capacity, policy and elements, leaving x empty.
+		/// If x's slots were allocated, they are taken along with the allocator which owns them.
+		ring_buffer& operator= (ring_buffer&& x) noexcept( N == 0 || dstd::is_nothrow_move_constructible<T>::value )
+		{
+			if( this != &x )
+			{
+				this->clear();
+				this->release();
+				this->policy = x.policy;
+				this->take(x);
+			}
+			return *this;
+		}
+
+
+		//
+		// Iterators
+
+
+		iterator begin() { return iterator( this->p, this->n_slots - 1, this->head ); }
+		const_iterator begin() const { return const_iterator( this->p, this->n_slots - 1, this->head ); }
+		iterator end() { return iterator( this->p, this->n_slots - 1, this->head + this->n ); }
+		const_iterator end() const { return const_iterator( this->p, this->n_slots - 1, this->head + this->n ); }
+		reverse_iterator rbegin() { return reverse_iterator( this->end() ); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator( this->end() ); }
+		reverse_iterator rend() { return reverse_iterator( this->begin() ); }
+		const_reverse_iterator rend() const { return const_reverse_iterator( this->begin() ); }
+		const_iterator cbegin() const { return this->begin(); }
+		const_iterator cend() const { return this->end(); }
+		const_reverse_iterator crbegin() const { return this->rbegin(); }
+		const_reverse_iterator crend() const { return this->rend(); }
+
+
+		//
+		// Capacity
+
+
+		size_type size() const { return this->n; }
+
+		bool empty() const { return ( this->n == 0 ); }
+
+		/// Returns whether pushing another element would throw, or drop one, depending on the policy.
+		bool full() const { return ( this->n == this->cap ); }
+
+		/// Returns the most elements the buffer holds at once.
+		size_type capacity() const { return this->cap; }
+
+		size_type max_size() const { return this->cap; }
+
+		void set_full_policy(dstd::full_policy policy) { this->policy = policy; }
+
+		dstd::full_policy get_full_policy() const { return this->policy; }
+
+
+		//
+		// Element access
+
+
+		reference operator[] (size_type i) { return *( this->slot(i) ); }
+
+		const_reference operator[] (size_type i) const { return *( this->slot(i) ); }
+
+
+		reference at(size_type i)
+		{
+			if( i >= this->n ) throw dstd::out_of_range();
+			return (*this)[i];
+		}
+
+
+		const_reference at(size_type i) const
+		{
+			if( i >= this->n ) throw dstd::out_of_range();
+			return (*this)[i];
+		}
+
+
+		/// Returns the oldest element.
+		reference front() { return *( this->slot(0) ); }
+
+		const_reference front() const { return *( this->slot(0) ); }
+
+		/// Returns the newest element.
+		reference back() { return *( this->slot(this->n - 1) ); }
+
+		const_reference back() const { return *( this->slot(this->n - 1) ); }
+
+
+		/// Returns the first contiguous run of elements, starting with the oldest, as a pointer and a length.
+		/// It holds every element unless they wrap round the end of the slots, when second_span holds the rest.
+		dstd::pair<pointer, size_type> first_span() { return dstd::pair<pointer, size_type>( this->p + this->head, this->first_span_size() ); }
+
+		dstd::pair<const_pointer, size_type> first_span() const { return dstd::pair<const_pointer, size_type>( this->p + this->head, this->first_span_size() ); }
+
+		/// Returns the elements which follow first_span, from the start of the slots. Its length is 0 if they do not wrap round.
+		dstd::pair<pointer, size_type> second_span() { return dstd::pair<pointer, size_type>( this->p, this->n - this->first_span_size() ); }
+
+		dstd::pair<const_pointer, size_type> second_span() const { return dstd::pair<const_pointer, size_type>( this->p, this->n - this->first_span_size() ); }
+
+
+		//
+		// Modifiers
+
+
+		void push_back(const value_type& value)
+		{
+			this->emplace_back(value);
+		}
+
+
+		void push_back(value_type&& value)
+		{
+			this->emplace_back( dstd::move(value) );
+		}
+
+
+		/// Appends an element constructed from args.
+		/// If the buffer is full, either throws length_error or drops the oldest element, depending on the policy.
+		template <class... Args>
+		void emplace_back(Args&&... args)
+		{
+			if( this->full() )
+			{
+				this->check_overwrite();
+				// The arguments may refer to the oldest element.
+				value_type value( dstd::forward<Args>(args)... );
+				this->pop_front();
+				this->a.construct( this->slot(this->n), dstd::move(value) );
+			}
+			else
+			{
+				this->a.construct( this->slot(this->n), dstd::forward<Args>(args)... );
+			}
+			++(this->n);
+		}
+
+
+		void push_front(const value_type& value)
+		{
+			this->emplace_front(value);
+		}
+
+
+		void push_front(value_type&& value)
+		{
+			this->emplace_front( dstd::move(value) );
+		}
+
+
+		/// Prepends an element constructed from args.
+		/// If the buffer is full, either throws length_error or drops the newest element, depending on the policy.
+		template <class... Args>
+		void emplace_front(Args&&... args)
+		{
+			if( this->full() )
+			{
+				this->check_overwrite();
+				value_type value( dstd::forward<Args>(args)... );
+				this->pop_back();
+				this->a.construct( this->slot(this->n_slots - 1), dstd::move(value) );
+			}
+			else
+			{
+				this->a.construct( this->slot(this->n_slots - 1), dstd::forward<Args>(args)... );
+			}
+			this->head = (this->head - 1) & (this->n_slots - 1);
+			++(this->n);
+		}
+
+
+		/// Removes the oldest element.
+		void pop_front()
+		{
+			this->a.destroy( this->slot(0) );
+			this->head = (this->head + 1) & (this->n_slots - 1);
+			--(this->n);
+		}
+
+
+		/// Removes the newest element.
+		void pop_back()
+		{
+			this->a.destroy( this->slot(this->n - 1) );
+			--(this->n);
+		}
+
+
+		/// Appends up to count elements, copied in turn from src, into the free slots a span at a time.
+		/// If they do not all fit, either only as many as fit are appended, or the oldest elements are dropped
+		/// to make room for the newest, depending on the policy.
+		/// @returns The number of elements taken from src: all count of them when overwriting.
+		template <class InputIterator>
+		size_type write(InputIterator src, size_type count)
+		{
+			const size_type taken = count;
+			if( this->policy == dstd::overwrite_oldest )
+			{
+				if( count > this->cap )
+				{
+					// Only the last capacity() elements would be left.
+					dstd::advance(src, count - this->cap);
+					count = this->cap;
+				}
+				if( count > this->cap - this->n ) this->drop_front( count - (this->cap - this->n) );
+			}
+			else if( count > this->cap - this->n )
+			{
+				count = this->cap - this->n;
+			}
+
+			for(size_type done = 0; done != count; )
+			{
+				pointer dest = this->slot(this->n);
+				size_type run = this->n_slots - ( dest - this->p );
+				if( run > count - done ) run = count - done;
+				for(size_type i = 0; i != run; ++i, ++src)
+				{
+					this->a.construct(dest + i, *src);
+					++(this->n);
+				}
+				done += run;
+			}
+			return ( this->policy == dstd::overwrite_oldest ) ? taken : count;
+		}
+
+
+		/// Moves up to count of the oldest elements to dest a span at a time, and removes them.
+		/// @returns The number of elements moved.
+		template <class OutputIterator>
+		size_type read(OutputIterator dest, size_type count)
+		{
+			if( count > this->n ) count = this->n;
+			for(size_type done = 0; done != count; )
+			{
+				pointer src = this->p + this->head;
+				size_type run = this->first_span_size();
+				if( run > count - done ) run = count - done;
+				for(size_type i = 0; i != run; ++i, ++dest) *dest = dstd::move( src[i] );
+				this->drop_front(run);
+				done += run;
+			}
+			return count;
+		}
+
+
+		void clear()
+		{
+			this->drop_front(this->n);
+			this->head = 0;
+		}
+
+
+		/// Exchanges the elements of the two buffers. If the slots were allocated, the slots and allocators are exchanged,
+		/// and otherwise the elements are moved.
+		void swap(ring_buffer& x)
+		{
+			if( this == &x ) return;
+
+			if( N == 0 )
+			{
+				dstd::swap(this->a, x.a);
+				dstd::swap(this->p, x.p);
+				dstd::swap(this->n_slots, x.n_slots);
+				dstd::swap(this->cap, x.cap);
+				dstd::swap(this->head, x.head);
+				dstd::swap(this->n, x.n);
+				dstd::swap(this->policy, x.policy);
+				return;
+			}
+
+			ring_buffer temp( dstd::move(x) );
+			x = dstd::move(*this);
+			*this = dstd::move(temp);
+		}
+
+
+		//
+		// Allocator
+
+
+		allocator_type get_allocator() const
+		{
+			return this->a;
+		}
+
+
+	private:
+
+		/// Sets up the slots for capacity elements: inside the buffer if N is greater than 0, and from the allocator otherwise.
+		void initialise(size_type capacity)
+		{
+			if( N != 0 )
+			{
+				if( capacity > N ) throw dstd::length_error();
+				this->p = this->local();
+				this->n_slots = dstd::impl::ring_buffer_slots(N);
+			}
+			else if( capacity != 0 )
+			{
+				const size_type slots = dstd::impl::ring_buffer_slots(capacity);
+				this->p = this->a.allocate(slots);
+				this->n_slots = slots;
+			}
+			this->cap = capacity;
+			this->head = 0;
+		}
+
+
+		/// Frees the slots, if they were allocated. The buffer must be empty.
+		void release()
+		{
+			if( N == 0 && this->p != 0 ) this->a.deallocate(this->p, this->n_slots);
+			this->p = 0;
+			this->n_slots = 0;
+			this->cap = 0;
+		}
+
+
+		/// Takes x's slots, along with the allocator which owns them, if they were allocated,
+		/// and otherwise moves its elements, leaving x empty. The buffer must be empty and have no slots.
+		void take(ring_buffer& x)
+		{
+			if( N == 0 )
+			{
+				dstd::swap(this->a, x.a);
+				this->p = x.p;
+				this->n_slots = x.n_slots;
+				this->cap = x.cap;
+				this->head = x.head;
+				this->n = x.n;
+				x.p = 0;
+				x.n_slots = 0;
+				x.cap = 0;
+				x.head = 0;
+				x.n = 0;
+			}
+			else
+			{
+				this->initialise(x.cap);
+				for( ; this->n != x.n; ++(this->n)) this->a.construct( this->slot(this->n), dstd::move( x[this->n] ) );
+				x.clear();
+			}
+		}
+
+
+		pointer slot(size_type i) { return this->p + ( (this->head + i) & (this->n_slots - 1) ); }
+
+		const_pointer slot(size_type i) const { return this->p + ( (this->head + i) & (this->n_slots - 1) ); }
+
+
+		size_type first_span_size() const
+		{
+			const size_type to_end = this->n_slots - this->head;
+			return ( this->n < to_end ) ? this->n : to_end;
+		}
+
+
+		/// Destroys the count oldest elements, a span at a time.
+		void drop_front(size_type count)
+		{
+			while( count != 0 )
+			{
+				size_type run = this->first_span_size();
+				if( run > count ) run = count;
+				pointer first = this->p + this->head;
+				for(size_type i = 0; i != run; ++i) this->a.destroy(first + i);
+				this->head = (this->head + run) & (this->n_slots - 1);
+				this->n -= run;
+				count -= run;
+			}
+		}
+
+
+		/// Throws length_error unless the policy allows a full buffer to drop an element.
+		void check_overwrite() const
+		{
+			if( this->policy != dstd::overwrite_oldest || this->cap == 0 ) throw dstd::length_error();
+		}
+
+
+		allocator_type a;
+		pointer p; // the first slot
+		size_type n_slots; // a power of two, or 0 if there are none
+		size_type cap;
+		size_type head; // the slot of the oldest element
+		size_type n;
+		dstd::full_policy policy;
+};
+
+
+
+/// The name boost and others use for a ring_buffer.
+namespace dstd
+{
+	template < class T, size_t N = 0, class Allocator = dstd::allocator<T> >
+	using circular_buffer = ring_buffer<T, N, Allocator>;
+}
+
+
+
+//
+// Iterators
+//
+// An iterator holds the position of an element counted from the start of the slots, which keeps counting
+// rather than going back to 0 when it passes the last slot, and masks it to find the slot.
+
+
+template <class T, size_t N, class Allocator>
+class dstd::ring_buffer<T, N, Allocator>::iterator
+{
+	public:
+
+		typedef typename dstd::ring_buffer<T, N, Allocator>::value_type value_type;
+		typedef typename dstd::ring_buffer<T, N, Allocator>::reference reference;
+		typedef typename dstd::ring_buffer<T, N, Allocator>::pointer pointer;
+		typedef typename dstd::ring_buffer<T, N, Allocator>::size_type size_type;
+		typedef typename dstd::ring_buffer<T, N, Allocator>::difference_type difference_type;
+
+		// constructors
+		iterator() : slots(0), mask(0), i(0) {}
+		// access
+		reference operator* () const { return this->slots[ this->i & this->mask ]; }
+		pointer operator-> () const { return this->slots + ( this->i & this->mask ); }
+		reference operator[] (difference_type n) const { return *( *this + n ); }
+		// increment/decrement
+		iterator& operator++() { ++(this->i); return *this; }
+		iterator& operator--() { --(this->i); return *this; }
+		iterator operator++(int) { iterator temp(*this); ++(*this); return temp; }
+		iterator operator--(int) { iterator temp(*this); --(*this); return temp; }
+		// addition/subtraction of ints
+		iterator& operator+= (difference_type n) { this->i += n; return *this; }
+		iterator& operator-= (difference_type n) { this->i -= n; return *this; }
+		iterator  operator+  (difference_type n) const { iterator temp(*this); temp += n; return temp; }
+		iterator  operator-  (difference_type n) const { iterator temp(*this); temp -= n; return temp; }
+		// addition/subtraction with iterators
+		difference_type operator- (const iterator& x) const { return this->i - x.i; }
+		// comparison operators
+		bool operator== (const iterator& x) const { return (this->i == x.i); }
+		bool operator!= (const iterator& x) const { return ! (*this == x); }
+		bool operator<  (const iterator& x) const { return (this->i < x.i); }
+		bool operator>  (const iterator& x) const { return (this->i > x.i); }
+		bool operator<= (const iterator& x) const { return ! ( *this > x ); }
+		bool operator>= (const iterator& x) const { return ! ( *this < x ); }
+
+
+	private:
+
+		iterator(pointer slots, size_type mask, size_type i) : slots(slots), mask(mask), i(i) {}
+
+		pointer slots;
+		size_type mask;
+		size_type i;
+
+
+	friend class dstd::ring_buffer<T, N, Allocator>;
+	friend class dstd::ring_buffer<T, N, Allocator>::const_iterator;
+};
+
+
+
+template <class T, size_t N, class Allocator>
+class dstd::ring_buffer<T, N, Allocator>::const_iterator
+{
+	public:
+
+		typedef const typename dstd::ring_buffer<T, N, Allocator>::value_type value_type;
+		typedef typename dstd::ring_buffer<T, N, Allocator>::const_reference reference;
+		typedef typename dstd::ring_buffer<T, N, Allocator>::const_pointer pointer;
+		typedef typename dstd::ring_buffer<T, N, Allocator>::size_type size_type;
+		typedef typename dstd::ring_buffer<T, N, Allocator>::difference_type difference_type;
+
+		// constructors
+		const_iterator() : slots(0), mask(0), i(0) {}
+		const_iterator(const iterator& x) : slots(x.slots), mask(x.mask), i(x.i) {}
+		// access
+		reference operator* () const { return this->slots[ this->i & this->mask ]; }
+		pointer operator-> () const { return this->slots + ( this->i & this->mask ); }
+		reference operator[] (difference_type n) const { return *( *this + n ); }
+		// increment/decrement
+		const_iterator& operator++() { ++(this->i); return *this; }
+		const_iterator& operator--() { --(this->i); return *this; }
+		const_iterator operator++(int) { const_iterator temp(*this); ++(*this); return temp; }
+		const_iterator operator--(int) { const_iterator temp(*this); --(*this); return temp; }
+		// addition/subtraction of ints
+		const_iterator& operator+= (difference_type n) { this->i += n; return *this; }
+		const_iterator& operator-= (difference_type n) { this->i -= n; return *this; }
+		const_iterator  operator+  (difference_type n) const { const_iterator temp(*this); temp += n; return temp; }
+		const_iterator  operator-  (difference_type n) const { const_iterator temp(*this); temp -= n; return temp; }
+		// addition/subtraction with iterators
+		difference_type operator- (const const_iterator& x) const { return this->i - x.i; }
+		// comparison operators
+		bool operator== (const const_iterator& x) const { return (this->i == x.i); }
+		bool operator!= (const const_iterator& x) const { return ! (*this == x); }
+		bool operator<  (const const_iterator& x) const { return (this->i < x.i); }
+		bool operator>  (const const_iterator& x) const { return (this->i > x.i); }
+		bool operator<= (const const_iterator& x) const { return ! ( *this > x ); }
+		bool operator>= (const const_iterator& x) const { return ! ( *this < x ); }
+
+
+	private:
+
+		const_iterator(pointer slots, size_type mask, size_type i) : slots(slots), mask(mask), i(i) {}
+
+		pointer slots;
+		size_type mask;
+		size_type i;
+
+
+	friend class dstd::ring_buffer<T, N, Allocator>;
+};
+
+
+
+template <class T, size_t N, class Allocator>
+void dstd::swap(dstd::ring_buffer<T, N, Allocator>& a, dstd::ring_buffer<T, N, Allocator>& b)
+{
+	a.swap(b);
+}
+
+
+
+template <class T, size_t N, class Allocator>
+bool operator== (const dstd::ring_buffer<T, N, Allocator>& lhs, const dstd::ring_buffer<T, N, Allocator>& rhs)
+{
+	if( lhs.size() != rhs.size() ) return false;
+	for(size_t i = 0; i != lhs.size(); ++i)
+	{
+		if( ! (lhs[i] == rhs[i]) ) return false;
+	}
+	return true;
+}
+
+
+
+template <class T, size_t N, class Allocator>
+bool operator!= (const dstd::ring_buffer<T, N, Allocator>& lhs, const dstd::ring_buffer<T, N, Allocator>& rhs)
+{
+	return ! (lhs == rhs);
+}
+
+
+
+#endif
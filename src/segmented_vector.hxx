@@ -0,0 +1,462 @@
+#ifndef DSTD_SEGMENTED_VECTOR_HXX
+#define DSTD_SEGMENTED_VECTOR_HXX
+
+#include <climits>
+
+#include "impl/bit_ops.hxx"
+#include "cstddef.hxx"
+#include "exception.hxx"
+#include "iterator.hxx"
+#include "memory.hxx"
+#include "utility.hxx"
+
+
+
+namespace dstd
+{
+	template <class T, class Allocator> class segmented_vector;
+	template <class T, class Allocator> void swap(segmented_vector<T, Allocator>& v1, segmented_vector<T, Allocator>& v2);
+}
+
+
+
+//
+// Segmented Vector
+//
+// A sequence which grows at the end by adding blocks, each twice the size of the one before, and never moves an element.
+// Growing never needs the old and new storage at once, nor copies any element, so a segmented_vector can grow far
+// past half of the memory, and pointers and references to its elements stay valid until they are removed.
+// Indexing is O(1): an element's block is the position of the highest bit of its scaled index.
+// Elements can only be added and removed at the end, since anything else would move them.
+
+template < class T, class Allocator = dstd::allocator<T> >
+class dstd::segmented_vector
+{
+	public:
+
+		typedef T value_type;
+		typedef Allocator allocator_type;
+		typedef typename allocator_type::reference reference;
+		typedef typename allocator_type::const_reference const_reference;
+		typedef typename allocator_type::pointer pointer;
+		typedef typename allocator_type::const_pointer const_pointer;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+		class iterator;
+		class const_iterator;
+		typedef dstd::reverse_iterator< iterator > reverse_iterator;
+		typedef dstd::reverse_iterator< const_iterator > const_reverse_iterator;
+
+
+		//
+		// Constructors
+
+		explicit segmented_vector(const allocator_type& alloc = allocator_type())
+			: a(alloc), n_data(0), n_blocks(0)
+		{
+			for(size_type k = 0; k != max_blocks; ++k) this->blocks[k] = 0;
+		}
+
+
+		explicit segmented_vector(size_type n, const T& value = T(), const allocator_type& alloc = allocator_type())
+			: a(alloc), n_data(0), n_blocks(0)
+		{
+			for(size_type k = 0; k != max_blocks; ++k) this->blocks[k] = 0;
+			this->resize(n, value);
+		}
+
+
+		/// Copy constructor. The new vector uses a copy of v's allocator.
+		segmented_vector(const segmented_vector& v)
+			: a(v.a), n_data(0), n_blocks(0)
+		{
+			for(size_type k = 0; k != max_blocks; ++k) this->blocks[k] = 0;
+			this->append(v);
+		}
+
+
+		/// Move constructor. Takes v's blocks and allocator without moving any element, leaving v empty.
+		segmented_vector(segmented_vector&& v) noexcept
+			: a(v.a), n_data(0), n_blocks(0)
+		{
+			for(size_type k = 0; k != max_blocks; ++k) this->blocks[k] = 0;
+			this->swap(v);
+		}
+
+
+		//
+		// Destructor
+
+		~segmented_vector()
+		{
+			this->clear();
+			this->release_blocks(0);
+		}
+
+
+		//
+		// Assignment
+
+		/// Copies the elements of v. The vector keeps its own allocator.
+		segmented_vector& operator= (const segmented_vector& v)
+		{
+			if( this != &v )
+			{
+				this->clear();
+				this->append(v);
+			}
+			return *this;
+		}
+
+
+		/// Takes v's elements, together with the allocator which owns them, leaving v empty.
+		segmented_vector& operator= (segmented_vector&& v) noexcept
+		{
+			segmented_vector temp( dstd::move(v) );
+			this->swap(temp);
+			return *this;
+		}
+
+
+		//
+		// Iterators
+
+		iterator begin() { return iterator(this, 0); }
+		const_iterator begin() const { return const_iterator(this, 0); }
+		iterator end() { return iterator(this, this->size()); }
+		const_iterator end() const { return const_iterator(this, this->size()); }
+		reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+		reverse_iterator rend() { return reverse_iterator(this->begin()); }
+		const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+
+		//
+		// Capacity
+
+		size_type size() const { return this->n_data; }
+
+		bool empty() const { return ( this->n_data == 0 ); }
+
+		size_type max_size() const { return segmented_vector::block_start(max_blocks); }
+
+		/// Returns the number of elements the allocated blocks hold.
+		size_type capacity() const { return segmented_vector::block_start(this->n_blocks); }
+
+
+		/// Allocates blocks until there is room for n elements. No element moves.
+		void reserve(size_type n)
+		{
+			if( n > this->max_size() ) throw dstd::length_error();
+			while( this->capacity() < n ) this->add_block();
+		}
+
+
+		/// Frees the blocks which hold no elements.
+		void shrink_to_fit()
+		{
+			const size_type n_needed = ( this->n_data == 0 ) ? 0 : segmented_vector::block_index(this->n_data - 1) + 1;
+			this->release_blocks(n_needed);
+		}
+
+
+		void resize(size_type n, const T& value = T())
+		{
+			while( this->size() > n ) this->pop_back();
+			if( this->size() < n ) this->reserve(n);
+			while( this->size() < n ) this->push_back(value);
+		}
+
+
+		//
+		// Element access
+
+		reference operator[](size_type i)
+		{
+			const size_type k = segmented_vector::block_index(i);
+			return this->blocks[k][i - segmented_vector::block_start(k)];
+		}
+
+
+		const_reference operator[](size_type i) const
+		{
+			const size_type k = segmented_vector::block_index(i);
+			return this->blocks[k][i - segmented_vector::block_start(k)];
+		}
+
+
+		reference at(size_type i)
+		{
+			if( i >= this->size() ) throw dstd::out_of_range();
+			return (*this)[i];
+		}
+
+
+		const_reference at(size_type i) const
+		{
+			if( i >= this->size() ) throw dstd::out_of_range();
+			return (*this)[i];
+		}
+
+
+		reference front() { return (*this)[0]; }
+		const_reference front() const { return (*this)[0]; }
+		reference back() { return (*this)[this->size() - 1]; }
+		const_reference back() const { return (*this)[this->size() - 1]; }
+
+
+		//
+		// Modifiers
+
+		void push_back(const value_type& value)
+		{
+			this->emplace_back(value);
+		}
+
+
+		void push_back(value_type&& value)
+		{
+			this->emplace_back( dstd::move(value) );
+		}
+
+
+		/// Appends an element constructed in place from args. If a new block is needed, it is twice the size of the last.
+		template <class... Args>
+		void emplace_back(Args&&... args)
+		{
+			if( this->n_data == this->capacity() ) this->add_block();
+			this->a.construct( &(*this)[this->n_data], dstd::forward<Args>(args)... );
+			++(this->n_data);
+		}
+
+
+		void pop_back()
+		{
+			--(this->n_data);
+			this->a.destroy( &(*this)[this->n_data] );
+		}
+
+
+		/// Destroys the elements. The blocks are kept, for elements added later.
+		void clear()
+		{
+			while( this->n_data != 0 ) this->pop_back();
+		}
+
+
+		void swap(segmented_vector& v)
+		{
+			for(size_type k = 0; k != max_blocks; ++k) dstd::swap(this->blocks[k], v.blocks[k]);
+			dstd::swap(this->n_data, v.n_data);
+			dstd::swap(this->n_blocks, v.n_blocks);
+
+			// the blocks are exchanged, so the allocators which own them must be too
+			dstd::swap(this->a, v.a);
+		}
+
+
+		//
+		// Allocator
+
+		allocator_type get_allocator() const
+		{
+			return this->a;
+		}
+
+
+	private:
+
+		/// The first block holds first_block_size elements, and each block after it twice as many as the one before.
+		static const size_type first_block_shift = 4;
+		static const size_type first_block_size = static_cast<size_type>(1) << first_block_shift;
+
+		/// Enough blocks to hold the most elements a size_type can count.
+		static const size_type max_blocks = sizeof(size_type) * CHAR_BIT - first_block_shift - 1;
+
+
+		/// Returns the size of block k.
+		static size_type block_size(size_type k)
+		{
+			return first_block_size << k;
+		}
+
+
+		/// Returns the index of the first element in block k, which is also the number of elements in the blocks before it.
+		static size_type block_start(size_type k)
+		{
+			return segmented_vector::block_size(k) - first_block_size;
+		}
+
+
+		/// Returns the block holding element i.
+		static size_type block_index(size_type i)
+		{
+			return dstd::impl::highest_bit_index( (i >> first_block_shift) + 1 );
+		}
+
+
+		void add_block()
+		{
+			if( this->n_blocks == max_blocks ) throw dstd::length_error();
+			this->blocks[this->n_blocks] = this->a.allocate( segmented_vector::block_size(this->n_blocks) );
+			++(this->n_blocks);
+		}
+
+
+		/// Frees every block after the first n_kept, which must hold no elements.
+		void release_blocks(size_type n_kept)
+		{
+			while( this->n_blocks > n_kept )
+			{
+				--(this->n_blocks);
+				this->a.deallocate( this->blocks[this->n_blocks], segmented_vector::block_size(this->n_blocks) );
+				this->blocks[this->n_blocks] = 0;
+			}
+		}
+
+
+		/// Appends copies of v's elements.
+		void append(const segmented_vector& v)
+		{
+			this->reserve( this->size() + v.size() );
+			for(size_type i = 0; i != v.size(); ++i) this->push_back(v[i]);
+		}
+
+
+		allocator_type a;
+
+		pointer blocks[max_blocks];
+
+		size_type n_data;
+
+		size_type n_blocks;
+};
+
+
+
+//
+// Segmented Vector: Relational Operators
+
+template <class T, class Allocator>
+bool operator== (const dstd::segmented_vector<T, Allocator>& v1, const dstd::segmented_vector<T, Allocator>& v2)
+{
+	if( v1.size() != v2.size() ) return false;
+	for(size_t i = 0; i != v1.size(); ++i)
+	{
+		if( ! (v1[i] == v2[i]) ) return false;
+	}
+	return true;
+}
+
+
+template <class T, class Allocator>
+bool operator!= (const dstd::segmented_vector<T, Allocator>& v1, const dstd::segmented_vector<T, Allocator>& v2)
+{
+	return ! (v1 == v2);
+}
+
+
+
+//
+// Segmented Vector: Swap
+
+template <class T, class Allocator>
+void dstd::swap(dstd::segmented_vector<T, Allocator>& v1, dstd::segmented_vector<T, Allocator>& v2)
+{
+	v1.swap(v2);
+}
+
+
+
+//
+// Iterators
+
+
+template <class T, class Allocator>
+class dstd::segmented_vector<T, Allocator>::iterator
+{
+	public:
+
+		typedef typename dstd::segmented_vector<T, Allocator>::value_type value_type;
+		typedef typename dstd::segmented_vector<T, Allocator>::reference reference;
+		typedef typename dstd::segmented_vector<T, Allocator>::pointer pointer;
+		typedef typename dstd::segmented_vector<T, Allocator>::size_type size_type;
+		typedef typename dstd::segmented_vector<T, Allocator>::difference_type difference_type;
+
+		iterator() : v(0), i(0) {}
+		iterator(dstd::segmented_vector<T, Allocator>* vector, size_type index) : v(vector), i(index) {}
+		reference operator* () const { return (*v)[i]; }
+		pointer operator-> () const { return &(*v)[i]; }
+		reference operator[] (difference_type n) const { return (*v)[i + n]; }
+		// Operators with int
+		iterator& operator+=(difference_type n) { i += n; return (*this); }
+		iterator& operator-=(difference_type n) { i -= n; return (*this); }
+		iterator operator+ (difference_type n) const { iterator it(*this); it += n; return it; }
+		iterator operator- (difference_type n) const { iterator it(*this); it -= n; return it; }
+		// Operators with iterators
+		difference_type operator- (const iterator& rhs) const { return static_cast<difference_type>(i - rhs.i); }
+		iterator& operator++() { ++i; return (*this); }
+		iterator operator++(int) { iterator temp(*this); ++(*this); return temp; }
+		iterator& operator--() { --i; return (*this); }
+		iterator operator--(int) { iterator temp(*this); --(*this); return temp; }
+		bool operator==(const iterator& rhs) const { return (i == rhs.i); }
+		bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+		bool operator< (const iterator& rhs) const { return (i < rhs.i); }
+		bool operator> (const iterator& rhs) const { return (i > rhs.i); }
+		bool operator<=(const iterator& rhs) const { return !(*this > rhs); }
+		bool operator>=(const iterator& rhs) const { return !(*this < rhs); }
+
+	private:
+
+		dstd::segmented_vector<T, Allocator>* v;
+		size_type i;
+
+		friend class const_iterator;
+};
+
+
+
+template <class T, class Allocator>
+class dstd::segmented_vector<T, Allocator>::const_iterator
+{
+	public:
+
+		typedef typename dstd::segmented_vector<T, Allocator>::value_type value_type;
+		typedef typename dstd::segmented_vector<T, Allocator>::const_reference reference;
+		typedef typename dstd::segmented_vector<T, Allocator>::const_pointer pointer;
+		typedef typename dstd::segmented_vector<T, Allocator>::size_type size_type;
+		typedef typename dstd::segmented_vector<T, Allocator>::difference_type difference_type;
+
+		const_iterator() : v(0), i(0) {}
+		const_iterator(const dstd::segmented_vector<T, Allocator>* vector, size_type index) : v(vector), i(index) {}
+		const_iterator(const iterator& it) : v(it.v), i(it.i) {}
+		reference operator* () const { return (*v)[i]; }
+		pointer operator-> () const { return &(*v)[i]; }
+		reference operator[] (difference_type n) const { return (*v)[i + n]; }
+		// Operators with int
+		const_iterator& operator+=(difference_type n) { i += n; return (*this); }
+		const_iterator& operator-=(difference_type n) { i -= n; return (*this); }
+		const_iterator operator+ (difference_type n) const { const_iterator it(*this); it += n; return it; }
+		const_iterator operator- (difference_type n) const { const_iterator it(*this); it -= n; return it; }
+		// Operators with iterators
+		difference_type operator- (const const_iterator& rhs) const { return static_cast<difference_type>(i - rhs.i); }
+		const_iterator& operator++() { ++i; return (*this); }
+		const_iterator operator++(int) { const_iterator temp(*this); ++(*this); return temp; }
+		const_iterator& operator--() { --i; return (*this); }
+		const_iterator operator--(int) { const_iterator temp(*this); --(*this); return temp; }
+		bool operator==(const const_iterator& rhs) const { return (i == rhs.i); }
+		bool operator!=(const const_iterator& rhs) const { return !(*this == rhs); }
+		bool operator< (const const_iterator& rhs) const { return (i < rhs.i); }
+		bool operator> (const const_iterator& rhs) const { return (i > rhs.i); }
+		bool operator<=(const const_iterator& rhs) const { return !(*this > rhs); }
+		bool operator>=(const const_iterator& rhs) const { return !(*this < rhs); }
+
+	private:
+
+		const dstd::segmented_vector<T, Allocator>* v;
+		size_type i;
+};
+
+
+
+#endif
@@ -6,7 +6,7 @@
 #include <cstddef>
 #include <limits>
 
-#include "impl/binary_search_tree.hxx"
+#include "impl/node_tree.hxx"
 #include "functional.hxx"
 #include "iterator.hxx"
 #include "memory.hxx"
@@ -22,106 +22,44 @@ namespace dstd
 	}
 	template <class T, class Compare, class Allocator> class set;
 	template <class T, class Compare, class Allocator> class multiset;
+	
+	template <class T, class Compare, class Allocator> void swap(set<T, Compare, Allocator>& lhs, set<T, Compare, Allocator>& rhs);
+	template <class T, class Compare, class Allocator> void swap(multiset<T, Compare, Allocator>& lhs, multiset<T, Compare, Allocator>& rhs);
 }
 
 
 
+/// The part of set and multiset which differs from map: each value is its own key.
 template <class T, class Compare, class Allocator, bool AllowMultiple>
-class dstd::impl::set_base
+class dstd::impl::set_base : public dstd::impl::node_tree< T, T, dstd::impl::identity<T>, Compare, Allocator, AllowMultiple >
 {
-	public:
-		
-		typedef T key_type;
-		typedef T value_type;
-		typedef size_t size_type;
-		typedef ptrdiff_t difference_type;
-		typedef Compare key_compare;
-		typedef Compare value_compare;
-		typedef Allocator allocator_type;
-		typedef typename allocator_type::reference reference;
-		typedef typename allocator_type::const_reference const_reference;
-		typedef typename allocator_type::pointer pointer;
-		typedef typename allocator_type::const_pointer const_pointer;
-		class iterator;
-		class const_iterator;
-		typedef dstd::reverse_iterator<iterator> reverse_iterator;
-		typedef dstd::reverse_iterator<const_iterator> const_reverse_iterator;
-	
-	
-	protected:
-		
-		typedef dstd::impl::binary_search_tree<T, Compare, AllowMultiple> tree_type;
-		typedef typename tree_type::node node;
-		typedef typename Allocator::template rebind<typename tree_type::node>::other node_allocator_type;
-	
-	
-	public:
-		
-		
-		//
-		// Iterators
-		
-		
-		iterator begin() { return iterator(this->tree->left_most()); }
-		const_iterator begin() const { return const_iterator(this->tree->left_most()); }
-		
-		
-		iterator end() { return iterator(this->tree->header()); }
-		const_iterator end() const { return const_iterator(this->tree->header()); }
-		
-		
-		reverse_iterator rbegin() { return reverse_iterator(this->end()); }
-		const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
-		
-		
-		reverse_iterator rend() { return reverse_iterator(this->begin()); }
-		const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
-		
-		
-		//
-		// Capacity
-		
-		
-		bool empty() const { return this->tree->empty(); }
-		
-		
-		size_type size() const { return this->tree->size(); }
-		
+	private:
 		
-		size_type max_size() const { return std::numeric_limits<size_type>::max(); }
+		typedef dstd::impl::node_tree< T, T, dstd::impl::identity<T>, Compare, Allocator, AllowMultiple > node_tree;
 		
 		
-		//
-		// Modifiers
+	protected:
 		
+		typedef typename node_tree::node node;
 		
-		void clear()
-		{
-			this->delete_node(this->tree->root());
-			delete(this->tree);
-			this->tree = new tree_type();
-		}
 		
+	public:
 		
-		void erase(iterator pos) { this->tree->remove(pos.p); }
+		typedef typename node_tree::key_type key_type;
+		typedef typename node_tree::key_compare key_compare;
+		typedef Compare value_compare;
+		typedef typename node_tree::allocator_type allocator_type;
+		typedef typename node_tree::iterator iterator;
+		typedef typename node_tree::const_iterator const_iterator;
 		
 		
-		void erase(iterator first, iterator last)
-		{
-			while(first != last)
-			{
-				this->erase( first++ );
-			}
-		}
+		/// Constructs an empty set with no elements.
+		explicit set_base(const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: node_tree(compare, alloc)
+		{}
 		
 		
-		size_type erase(const key_type key)
-		{
-			size_type n = this->size();
-			dstd::pair<iterator,iterator> range = this->equal_range(key);
-			this->erase(range.first, range.second);
-			return (this->size() - n);
-		}
+		virtual ~set_base() {}
 		
 		
 		//
@@ -130,53 +68,12 @@ class dstd::impl::set_base
 		
 		iterator find(const key_type& key)
 		{
-			return iterator( const_cast<node*>( this->tree->find(key) ) );
-		}
-		const_iterator find(const key_type& key) const
-		{
-			return const_iterator( this->tree->find(key) );
-		}
-		
-		
-		dstd::pair<iterator,iterator> equal_range(const key_type& key)
-		{
-			dstd::pair<const node*,const node*> equal = this->equal_range_nodes(key);
-			iterator lower = equal.first == 0 ? this->end() : iterator(const_cast<node*>(equal.first));
-			iterator upper = equal.second == 0 ? this->end() : iterator(const_cast<node*>(equal.second));
-			return dstd::pair<iterator,iterator>( lower, upper );
-		}
-		dstd::pair<const_iterator,const_iterator> equal_range(const key_type& key) const
-		{
-			dstd::pair<const node*,const node*> equal = this->equal_range_nodes(key);
-			const_iterator lower = equal.first == 0 ? this->end() : const_iterator(equal.first);
-			const_iterator upper = equal.second == 0 ? this->end() : const_iterator(equal.second);
-			return dstd::pair<const_iterator,const_iterator>( lower, upper );
-		}
-		
-		
-		/// Returns an iterator pointing to the first element in the container whose key is not considered to go before k
-		/// (i.e., either it is equivalent or goes after).
-		iterator lower_bound(const key_type& key)
-		{
-			node* n = const_cast<node*>( this->lower_bound_node(key) );
+			node* n = const_cast<node*>( this->find_node(key) );
 			return ( n == 0 ? this->end() : iterator(n) );
 		}
-		const_iterator lower_bound(const key_type& key) const
-		{
-			const node* n = this->lower_bound_node(key);
-			return ( n == 0 ? this->end() : const_iterator(n) );
-		}
-		
-		
-		/// Returns an iterator pointing to the first element in the container whose key is considered to go after k.
-		iterator upper_bound(const key_type& key)
-		{
-			node* n = const_cast<node*>( this->upper_bound_node(key) );
-			return ( n == 0 ? this->end() : iterator(n) );
-		}
-		const_iterator upper_bound(const key_type& key) const
+		const_iterator find(const key_type& key) const
 		{
-			const node* n = this->upper_bound_node(key);
+			const node* n = this->find_node(key);
 			return ( n == 0 ? this->end() : const_iterator(n) );
 		}
 		
@@ -185,380 +82,154 @@ class dstd::impl::set_base
 		// Observers
 		
 		
-		key_compare key_comp() const { return this->comp; }
-		
-		
 		value_compare value_comp() const { return this->comp; }
-		
-		
-		allocator_type get_allocator() const { return allocator_type(this->a); }
-	
-	
-	protected:
-		
-		
-		void delete_nodes(node* root)
-		{
-			if( ! this->tree->is_null(root->left) ) this->delete_nodes(root->left_child());
-			if( ! this->tree->is_null(root->right) ) this->delete_nodes(root->left_child());
-			this->a.destroy(root);
-			this->a.deallocate(root);
-		}
-		
-		
-		node* insert_node(const value_type& value, node* parent = 0)
-		{
-			// TODO: this is messy. if the value alread exists and we're
-			// not allowed multiple, we shouldn't allocate/construct a new node
-			
-			node* new_node = this->a.allocate(1);
-			this->a.construct(new_node, node(value));
-			
-			node* inserted_node = this->tree->insert( new_node );
-			
-			if( inserted_node != new_node )
-			{
-				this->a.destroy(new_node);
-				this->a.deallocate(new_node);
-			}
-			
-			return inserted_node;
-		}
-		
-		
-		const node* lower_bound_node(const key_type& key) const
-		{
-			if( this->empty() ) return 0;
-			
-			const node* n = this->tree->root();
-			while( true )
-			{
-				if( this->comp( n->value, key ) )
-				{
-					if( this->tree->is_null( n->right ) )
-					{
-						// We have reached a leaf. k doesn't exist.
-						// But this leaf goes before k, so increment before returning
-						return n->next();
-					}
-					else
-					{
-						n = n->right_child();
-					}
-				}
-				else
-				{
-					if( this->tree->is_null( n->left ) )
-					{
-						// we have reached a leaf. k may or may not exist.
-						return n;
-					}
-					else
-					{
-						n = n->left_child();
-					}
-				}
-			}
-		}
-		
-		
-		const node* upper_bound_node(const key_type& key) const
-		{
-			const node* n = this->lower_bound_node(key);
-			while( ! this->tree->is_null(n) && ! this->comp(key, n->value) )
-			{
-				n = n->next();
-			}
-			return n;
-		}
-		
-		
-		dstd::pair<const node*, const node*> equal_range_nodes(const key_type& key) const
-		{
-			const node* lower = this->lower_bound_node(key);
-			const node* upper = lower;
-			while( ! this->tree->is_null(upper) && ! this->comp(key, upper->value.first) )
-			{
-				upper = upper->next();
-			}
-			return dstd::pair<const node*, const node*>(lower, upper);
-		}
-		
-		
-		/// Returns true if the two keys are considered to be equivalent
-		bool keys_equal(const key_type& a, const key_type& b) const
-		{
-			return ( ! this->comp(a,b) && ! this->comp(b,a) );
-		}
-		
-		
-		node_allocator_type a;
-		key_compare comp;
-		tree_type* tree;
 };
 
 
 
-template <class T, class Compare, class Allocator, bool AllowMultiple>
-class dstd::impl::set_base<T, Compare, Allocator, AllowMultiple>::iterator
+template < class T, class Compare = dstd::less<T>, class Allocator = dstd::allocator<T> >
+class dstd::set : public dstd::impl::set_base<T, Compare, Allocator, false>
 {
 	private:
-		
-		typedef dstd::impl::binary_tree::node node_base;
-		typedef typename dstd::impl::set_base<T, Compare, Allocator, AllowMultiple>::tree_type::node node;
-		
-		
+	
+		typedef dstd::impl::set_base<T, Compare, Allocator, false> set_base;
+		typedef typename set_base::node node;
+	
+	
 	public:
 		
-		typedef typename dstd::impl::set_base<T, Compare, Allocator, AllowMultiple>::value_type value_type;
-		typedef value_type* pointer;
-		typedef value_type& reference;
-		typedef typename dstd::impl::set_base<T, Compare, Allocator, AllowMultiple>::size_type size_type;
-		typedef typename dstd::impl::set_base<T, Compare, Allocator, AllowMultiple>::difference_type difference_type;
-		
-		
-		iterator()
-			: p(0)
-		{}
-		
-		
-		iterator(node_base* ptr)
-			: p(ptr)
-		{}
+		typedef typename set_base::key_type key_type;
+		typedef typename set_base::value_type value_type;
+		typedef typename set_base::key_compare key_compare;
+		typedef typename set_base::value_compare value_compare;
+		typedef typename set_base::size_type size_type;
+		typedef typename set_base::difference_type difference_type;
+		typedef typename set_base::allocator_type allocator_type;
+		typedef typename set_base::iterator iterator;
+		typedef typename set_base::const_iterator const_iterator;
+		typedef typename set_base::reverse_iterator reverse_iterator;
+		typedef typename set_base::const_reverse_iterator const_reverse_iterator;
 		
 		
-		iterator(node* ptr)
-			: p(static_cast<node_base*>(ptr))
-		{}
+		//
+		// Constructors
 		
 		
-		iterator(const iterator& it)
-			: p(it.p)
+		/// Constructs an empty set with no elements.
+		explicit set(const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: set_base(compare, alloc)
 		{}
 		
 		
-		~iterator(){}
-		
-		
-		iterator& operator= (const iterator& it)
-		{
-			this->p = it.p;
-			return *this;
-		}
-		
-		
-		bool operator== (const iterator& it) const
-		{
-			return (this->p == it.p);
-		}
-		
-		
-		bool operator!= (const iterator& it) const
-		{
-			return ! (*this == it);
-		}
-		
-		
-		reference operator*()
-		{
-			return static_cast<node*>( this->p )->value;
-		}
-		
-		
-		const reference operator*() const
-		{
-			return static_cast<node*>( this->p )->value;
-		}
-		
-		
-		pointer operator->()
-		{
-			return &(static_cast<node*>( this->p )->value);
-		}
-		
-		
-		const pointer operator->() const
-		{
-			return &(static_cast<node*>( this->p )->value);
-		}
-		
-		
-		iterator operator++()
-		{
-			this->p = this->p->next();
-			return *this;
-		}
-		
-		
-		iterator operator++(int)
+		/// Constructs a set with as many elements as the range [first,last),
+		/// with each element constructed from its corresponding element in that range.
+		template <class InputIterator>
+		set(InputIterator first, InputIterator last, const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: set_base(compare, alloc)
 		{
-			iterator temp(*this);
-			++(*this);
-			return temp;
+			this->insert(first, last);
 		}
 		
 		
-		iterator operator--()
+		/// Copy constructor. Constructs a set with a copy of each of the elements in x.
+		set(const set& x)
+			: set_base(x.key_comp(), x.get_allocator())
 		{
-			this->p = this->p->prev();
-			return *this;
+			this->insert(x.begin(), x.end());
 		}
 		
 		
-		iterator operator--(int)
+		/// Move constructor. Takes the elements, comparison object and allocator of x, leaving x empty.
+		set(set&& x) noexcept
+			: set_base(x.key_comp(), x.get_allocator())
 		{
-			iterator temp(*this);
-			--(*this);
-			return temp;
+			this->swap_base(x);
 		}
 		
 		
-	private:
-		
-		node_base* p;
-	
-	
-	friend class map_base;
-};
-
-
-
-template <class T, class Compare, class Allocator, bool AllowMultiple>
-class dstd::impl::set_base<T, Compare, Allocator, AllowMultiple>::const_iterator
-{
-	private:
-		
-		typedef const typename dstd::impl::binary_tree::node node_base;
-		typedef const typename dstd::impl::set_base<T, Compare, Allocator, AllowMultiple>::node node;
-		
-		
-	public:
+		virtual ~set() {}
 		
-		typedef const typename dstd::impl::set_base<T, Compare, Allocator, AllowMultiple>::value_type value_type;
-		typedef const value_type* pointer;
-		typedef const value_type& reference;
-		typedef typename dstd::impl::set_base<T, Compare, Allocator, AllowMultiple>::size_type size_type;
-		typedef typename dstd::impl::set_base<T, Compare, Allocator, AllowMultiple>::difference_type difference_type;
 		
-		
-		const_iterator()
-			: p(0)
-		{}
-		
-		
-		const_iterator(node_base* ptr)
-			: p(ptr)
-		{}
-		
-		
-		const_iterator(node* ptr)
-			: p(static_cast<node_base*>(ptr))
-		{}
-		
-		
-		const_iterator(const const_iterator& it)
-			: p(it.p)
-		{}
-		
-		
-		const_iterator(const iterator& it)
-			: p(it.p)
-		{}
-		
-		
-		~const_iterator(){}
-		
-		
-		const_iterator& operator= (const iterator& it)
+		set& operator= (const set& x)
 		{
-			this->p = it.p;
+			this->clear();
+			this->insert(x.begin(), x.end());
 			return *this;
 		}
 		
 		
-		const_iterator& operator= (const const_iterator& it)
+		/// Takes the elements of x, together with the allocator which owns them, leaving x empty.
+		set& operator= (set&& x) noexcept
 		{
-			this->p = it.p;
+			this->clear();
+			this->swap_base(x);
 			return *this;
 		}
 		
 		
-		bool operator== (const const_iterator& it) const
-		{
-			return (this->p == it.p);
-		}
+		//
+		// Modifiers
 		
 		
-		bool operator!= (const const_iterator& it) const
+		dstd::pair<iterator, bool> insert(const value_type& value)
 		{
-			return ! (*this == it);
+			dstd::pair<node*, bool> result = this->insert_node(value);
+			return dstd::pair<iterator,bool>( iterator(result.first), result.second );
 		}
 		
 		
-		reference operator*() const
+		dstd::pair<iterator, bool> insert(value_type&& value)
 		{
-			return static_cast<node*>( this->p )->value;
+			dstd::pair<node*, bool> result = this->insert_node( dstd::move(value) );
+			return dstd::pair<iterator,bool>( iterator(result.first), result.second );
 		}
 		
 		
-		pointer operator->()
+		/// Constructs an element in place from args, and inserts it if no equivalent element exists.
+		template <class... Args>
+		dstd::pair<iterator, bool> emplace(Args&&... args)
 		{
-			return &(static_cast<node*>( this->p )->value);
+			dstd::pair<node*, bool> result = this->emplace_node( dstd::forward<Args>(args)... );
+			return dstd::pair<iterator,bool>( iterator(result.first), result.second );
 		}
 		
 		
-		const pointer operator->() const
-		{
-			return &(static_cast<node*>( this->p )->value);
-		}
+		/// Inserts value as close as possible before hint.
+		/// If value belongs immediately before or after hint, the set is not searched.
+		iterator insert(iterator hint, const value_type& value) { return iterator( this->insert_node(hint, value).first ); }
+		iterator insert(iterator hint, value_type&& value) { return iterator( this->insert_node(hint, dstd::move(value)).first ); }
 		
 		
-		const_iterator operator++()
-		{
-			this->p = this->p->next();
-			return *this;
-		}
+		/// Constructs an element in place from args, and inserts it as close as possible before hint.
+		template <class... Args>
+		iterator emplace_hint(iterator hint, Args&&... args) { return iterator( this->emplace_node_hint(hint, dstd::forward<Args>(args)...).first ); }
 		
 		
-		const_iterator operator++(int)
+		template <class InputIterator>
+		void insert(InputIterator first, InputIterator last)
 		{
-			const_iterator temp(*this);
-			++(*this);
-			return temp;
+			this->insert_range(first, last);
 		}
 		
 		
-		const_iterator operator--()
-		{
-			this->p = this->p->prev();
-			return *this;
-		}
-		
+		void swap(set& x) { this->swap_base(x); }
 		
-		const_iterator operator--(int)
-		{
-			const_iterator temp(*this);
-			--(*this);
-			return temp;
-		}
 		
+		//
+		// Lookup
 		
-	private:
 		
-		node_base* p;
-	
-	
-	friend class set_base;
+		size_type count(const key_type& key) const { return (this->find(key) == this->end()) ? 0 : 1; }
 };
 
 
 
 template < class T, class Compare = dstd::less<T>, class Allocator = dstd::allocator<T> >
-class dstd::set : public dstd::impl::set_base<T, Compare, Allocator, false>
+class dstd::multiset : public dstd::impl::set_base<T, Compare, Allocator, true>
 {
 	private:
 	
-		typedef dstd::impl::set_base<T, Compare, Allocator, false> set_base;
+		typedef dstd::impl::set_base<T, Compare, Allocator, true> set_base;
 		typedef typename set_base::node node;
 	
 	
@@ -566,7 +237,6 @@ class dstd::set : public dstd::impl::set_base<T, Compare, Allocator, false>
 		
 		typedef typename set_base::key_type key_type;
 		typedef typename set_base::value_type value_type;
-		typedef typename set_base::mapped_type mapped_type;
 		typedef typename set_base::key_compare key_compare;
 		typedef typename set_base::value_compare value_compare;
 		typedef typename set_base::size_type size_type;
@@ -578,84 +248,59 @@ class dstd::set : public dstd::impl::set_base<T, Compare, Allocator, false>
 		typedef typename set_base::const_reverse_iterator const_reverse_iterator;
 		
 		
-		set& operator= (const set& x)
-		{
-			this->clear();
-			this->insert(x.begin(), x.end());
-		}
-		
-		
 		//
-		// Modifiers
-		
-		
-		dstd::pair<iterator, bool> insert(const value_type& value)
-		{
-			size_type n = this->size();
-			iterator it = this->insert_node(value);
-			return dstd::pair<iterator,bool>( it, (n == this->size()) );
-		}
+		// Constructors
 		
 		
-		// TODO: optimise using hint
-		iterator insert(iterator hint, const value_type& value) { return this->insert(value).first; }
+		/// Constructs an empty multiset with no elements.
+		explicit multiset(const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: set_base(compare, alloc)
+		{}
 		
 		
+		/// Constructs a multiset with as many elements as the range [first,last),
+		/// with each element constructed from its corresponding element in that range.
 		template <class InputIterator>
-		void insert(InputIterator first, InputIterator last)
+		multiset(InputIterator first, InputIterator last, const key_compare& compare = key_compare(), const allocator_type& alloc = allocator_type())
+			: set_base(compare, alloc)
 		{
-			while( first != last )
-			{
-				this->insert(*first);
-				++first;
-			}
+			this->insert(first, last);
 		}
 		
 		
-		void swap(set& x)
+		/// Copy constructor. Constructs a multiset with a copy of each of the elements in x.
+		multiset(const multiset& x)
+			: set_base(x.key_comp(), x.get_allocator())
 		{
-			dstd::swap(this->tree, x.tree);
+			this->insert(x.begin(), x.end());
 		}
 		
 		
-		//
-		// Lookup
-		
+		/// Move constructor. Takes the elements, comparison object and allocator of x, leaving x empty.
+		multiset(multiset&& x) noexcept
+			: set_base(x.key_comp(), x.get_allocator())
+		{
+			this->swap_base(x);
+		}
 		
-		size_type count(const key_type& key) const { return (this->find(key) == this->end()) ? 0 : 1; }
-};
-
-
-
-template < class T, class Compare = dstd::less<T>, class Allocator = dstd::allocator<T> >
-class dstd::multiset : public dstd::impl::set_base<T, Compare, Allocator, true>
-{
-	private:
-	
-		typedef dstd::impl::set_base<T, Compare, Allocator, false> set_base;
-		typedef typename set_base::node node;
-	
-	
-	public:
 		
-		typedef typename set_base::key_type key_type;
-		typedef typename set_base::value_type value_type;
-		typedef typename set_base::mapped_type mapped_type;
-		typedef typename set_base::key_compare key_compare;
-		typedef typename set_base::value_compare value_compare;
-		typedef typename set_base::size_type size_type;
-		typedef typename set_base::difference_type difference_type;
-		typedef typename set_base::allocator_type allocator_type;
-		typedef typename set_base::iterator iterator;
-		typedef typename set_base::const_iterator const_iterator;
-		typedef typename set_base::reverse_iterator reverse_iterator;
-		typedef typename set_base::const_reverse_iterator const_reverse_iterator;
+		virtual ~multiset() {}
 		
 		
 		multiset& operator= (const multiset& x)
 		{
 			this->clear();
 			this->insert(x.begin(), x.end());
+			return *this;
+		}
+		
+		
+		/// Takes the elements of x, together with the allocator which owns them, leaving x empty.
+		multiset& operator= (multiset&& x) noexcept
+		{
+			this->clear();
+			this->swap_base(x);
+			return *this;
 		}
 		
 		
@@ -663,28 +308,36 @@ class dstd::multiset : public dstd::impl::set_base<T, Compare, Allocator, true>
 		// Modifiers
 		
 		
-		iterator insert(const value_type& value) { return iterator(this->insert_node(value)); }
+		iterator insert(const value_type& value) { return iterator(this->insert_node(value).first); }
+		
+		
+		iterator insert(value_type&& value) { return iterator(this->insert_node( dstd::move(value) ).first); }
+		
 		
+		/// Constructs an element in place from args, and inserts it after any equivalent elements.
+		template <class... Args>
+		iterator emplace(Args&&... args) { return iterator(this->emplace_node( dstd::forward<Args>(args)... ).first); }
 		
-		// TODO: optimise using hint
-		iterator insert(iterator hint, const value_type& value) { return this->insert(value); }
+		
+		/// Inserts value as close as possible before hint.
+		/// If value belongs immediately before or after hint, the set is not searched.
+		iterator insert(iterator hint, const value_type& value) { return iterator( this->insert_node(hint, value).first ); }
+		iterator insert(iterator hint, value_type&& value) { return iterator( this->insert_node(hint, dstd::move(value)).first ); }
+		
+		
+		/// Constructs an element in place from args, and inserts it as close as possible before hint.
+		template <class... Args>
+		iterator emplace_hint(iterator hint, Args&&... args) { return iterator( this->emplace_node_hint(hint, dstd::forward<Args>(args)...).first ); }
 		
 		
 		template <class InputIterator>
 		void insert(InputIterator first, InputIterator last)
 		{
-			while( first != last )
-			{
-				this->insert(*first);
-				++first;
-			}
+			this->insert_range(first, last);
 		}
 		
 		
-		void swap(multiset& x)
-		{
-			dstd::swap(this->tree, x.tree);
-		}
+		void swap(multiset& x) { this->swap_base(x); }
 		
 		
 		//
@@ -693,12 +346,11 @@ class dstd::multiset : public dstd::impl::set_base<T, Compare, Allocator, true>
 		
 		size_type count(const key_type& key) const
 		{
-			iterator it = this->find(key);
+			dstd::pair<const_iterator,const_iterator> range = this->equal_range(key);
 			size_type n = 0;
-			while( ! this->comp(key, *it) && it != this->end() )
+			for( ; range.first != range.second; ++range.first )
 			{
 				++n;
-				++it;
 			}
 			return n;
 		}
@@ -714,4 +366,12 @@ void dstd::swap(dstd::set<T, Compare, Allocator>& lhs, dstd::set<T, Compare, All
 
 
 
+template <class T, class Compare, class Allocator>
+void dstd::swap(dstd::multiset<T, Compare, Allocator>& lhs, dstd::multiset<T, Compare, Allocator>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+
+
 #endif
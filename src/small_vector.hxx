@@ -0,0 +1,198 @@
+#ifndef DSTD_SMALL_VECTOR_HXX
+#define DSTD_SMALL_VECTOR_HXX
+
+#include "impl/vector_interface.hxx"
+#include "utility.hxx"
+#include "type_traits.hxx"
+
+
+
+namespace dstd
+{
+	template <class T, size_t N, class Allocator > class small_vector;
+	template <class T, size_t N, class Allocator > void swap(small_vector<T, N, Allocator>& v1, small_vector<T, N, Allocator>& v2);
+}
+
+
+
+//
+// Small Vector
+//
+// A vector which keeps up to N elements inside itself, and only allocates memory once it holds more.
+// Short sequences, which are the common case for many containers, then cost no allocation at all.
+// shrink_to_fit moves the elements back inside once there are N or fewer.
+// Moving or swapping a small_vector whose elements are inside moves the elements one at a time,
+// so iterators to them are invalidated, unlike a vector.
+
+template < class T, size_t N, class Allocator = dstd::allocator<T> >
+class dstd::small_vector : public dstd::impl::vector_interface<T, Allocator, N>
+{
+	public:
+
+	typedef typename impl::vector_interface<T,Allocator,N>::value_type value_type;
+	typedef typename impl::vector_interface<T,Allocator,N>::allocator_type allocator_type;
+	typedef typename impl::vector_interface<T,Allocator,N>::reference reference;
+	typedef typename impl::vector_interface<T,Allocator,N>::const_reference const_reference;
+	typedef typename impl::vector_interface<T,Allocator,N>::pointer pointer;
+	typedef typename impl::vector_interface<T,Allocator,N>::const_pointer const_pointer;
+	typedef typename impl::vector_interface<T,Allocator,N>::size_type size_type;
+	typedef typename impl::vector_interface<T,Allocator,N>::difference_type difference_type;
+
+	typedef typename impl::vector_interface<T,Allocator,N>::iterator iterator;
+	typedef typename impl::vector_interface<T,Allocator,N>::const_iterator const_iterator;
+	typedef dstd::reverse_iterator< iterator > reverse_iterator;
+	typedef dstd::reverse_iterator< const_iterator > const_reverse_iterator;
+
+
+	//
+	// Constructors
+
+	explicit small_vector(const allocator_type& alloc = allocator_type())
+		: impl::vector_interface<T,Allocator,N>(alloc)
+	{}
+
+
+	explicit small_vector(size_type n, const T& value = T(), const allocator_type& alloc = allocator_type())
+		: impl::vector_interface<T,Allocator,N>(alloc)
+	{
+		this->assign(n, value);
+	}
+
+
+	small_vector(iterator first, iterator last, const allocator_type& alloc = allocator_type())
+		: impl::vector_interface<T,Allocator,N>(alloc)
+	{
+		this->assign(first, last);
+	}
+
+
+	/// Copy constructor. The new vector uses a copy of v's allocator.
+	small_vector(const small_vector& v)
+		: impl::vector_interface<T,Allocator,N>(v.get_allocator())
+	{
+		this->assign(v.begin(), v.end());
+	}
+
+
+	/// Move constructor. Takes v's memory if it has allocated any, and otherwise moves its elements, leaving v empty.
+	small_vector(small_vector&& v) noexcept( dstd::is_nothrow_move_constructible<T>::value )
+		: impl::vector_interface<T,Allocator,N>(v.get_allocator())
+	{
+		this->take(v);
+	}
+
+
+	//
+	// Destructor
+
+
+	~small_vector()
+	{}
+
+
+	//
+	// Assignment
+
+
+	/// Copies the elements of v. The vector keeps its own allocator.
+	small_vector& operator= (const small_vector& v)
+	{
+		if( this != &v ) this->assign(v.begin(), v.end());
+		return *this;
+	}
+
+
+	/// Takes v's elements, leaving v empty. If v has allocated memory, the memory is taken along with the allocator which owns it.
+	small_vector& operator= (small_vector&& v) noexcept( dstd::is_nothrow_move_constructible<T>::value )
+	{
+		if( this != &v )
+		{
+			this->clear();
+			this->take(v);
+		}
+		return *this;
+	}
+
+
+	//
+	// Capacity
+
+
+	/// Returns the number of elements which fit inside the vector without allocating.
+	static size_type inline_capacity()
+	{
+		return N;
+	}
+
+
+	/// Whether the elements are inside the vector, rather than in memory from the allocator.
+	bool is_inline() const
+	{
+		return this->is_local();
+	}
+
+
+	//
+	// Modifiers
+
+
+	/// Exchanges the elements of the two vectors. If both have allocated memory, the memory and allocators are exchanged,
+	/// and otherwise the elements are moved.
+	void swap(small_vector& v)
+	{
+		if( this == &v ) return;
+
+		if( ! this->is_local() && ! v.is_local() )
+		{
+			dstd::swap(this->p, v.p);
+			dstd::swap(this->n_data, v.n_data);
+			dstd::swap(this->n_memory, v.n_memory);
+			dstd::swap(this->a, v.a);
+			return;
+		}
+
+		small_vector temp( dstd::move(v) );
+		v = dstd::move(*this);
+		*this = dstd::move(temp);
+	}
+
+
+private:
+
+
+	/// Takes the elements of v, which this empty vector must have room for if they are inline, leaving v empty and inline.
+	void take(small_vector& v)
+	{
+		if( v.is_local() || v.p == 0 )
+		{
+			for(size_type i = 0; i != v.size(); ++i) this->emplace_value(this->end(), dstd::move(v.p[i]));
+			v.clear();
+			return;
+		}
+
+		this->release(this->p, this->n_memory);
+		this->p = v.p;
+		this->n_data = v.n_data;
+		this->n_memory = v.n_memory;
+		dstd::swap(this->a, v.a);
+
+		v.p = v.local();
+		v.n_data = 0;
+		v.n_memory = N;
+	}
+};
+
+
+
+//
+// Swap
+
+template <class T, size_t N, class Allocator>
+void dstd::swap(dstd::small_vector<T, N, Allocator>& v1, dstd::small_vector<T, N, Allocator>& v2)
+{
+	v1.swap(v2);
+}
+
+
+
+#endif
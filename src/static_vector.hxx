@@ -0,0 +1,198 @@
+#ifndef DSTD_STATIC_VECTOR_HXX
+#define DSTD_STATIC_VECTOR_HXX
+
+#include <new>
+
+#include "cstddef.hxx"
+#include "exception.hxx"
+#include "small_vector.hxx"
+#include "utility.hxx"
+
+
+
+namespace dstd
+{
+	template <class T, size_t N> class static_vector;
+	template <class T, size_t N> void swap(static_vector<T, N>& v1, static_vector<T, N>& v2);
+
+	namespace impl
+	{
+		template <class T> class no_heap_allocator;
+	}
+}
+
+
+
+/// The allocator of a static_vector, which has nowhere to allocate from.
+/// A container asks for memory only when its elements no longer fit inside it, so allocate reports that instead.
+template <class T>
+class dstd::impl::no_heap_allocator
+{
+	public:
+
+		typedef T value_type;
+		typedef T* pointer;
+		typedef T& reference;
+		typedef const T* const_pointer;
+		typedef const T& const_reference;
+
+		template <class OtherType>
+		struct rebind
+		{
+			typedef no_heap_allocator< OtherType > other;
+		};
+
+
+		/// Always throws length_error, since the elements would not fit in the container.
+		T* allocate(size_t /*n*/)
+		{
+			throw dstd::length_error();
+		}
+
+
+		/// Does nothing. Nothing is ever allocated.
+		void deallocate(T* /*p*/, size_t /*n*/ = 0)
+		{}
+
+
+		/// Constructs an object on the location pointed by p, passing args on to its constructor.
+		template <class U, class... Args>
+		void construct(U* p, Args&&... args)
+		{
+			new(p) U( dstd::forward<Args>(args)... );
+		}
+
+
+		/// Destroys in-place the object pointed by p.
+		void destroy(T* p)
+		{
+			p->~T();
+		}
+};
+
+
+
+//
+// Static Vector
+//
+// A vector with a fixed capacity of N elements, which are kept inside the vector itself.
+// It never allocates memory: an insertion which would take it past N elements throws length_error
+// and leaves the vector unchanged, rather than reallocating.
+// It has the same interface as small_vector, but moving or swapping one always moves its elements.
+
+template <class T, size_t N>
+class dstd::static_vector : public dstd::small_vector< T, N, dstd::impl::no_heap_allocator<T> >
+{
+	public:
+
+	typedef dstd::small_vector< T, N, dstd::impl::no_heap_allocator<T> > base_type;
+
+	typedef typename base_type::value_type value_type;
+	typedef typename base_type::allocator_type allocator_type;
+	typedef typename base_type::reference reference;
+	typedef typename base_type::const_reference const_reference;
+	typedef typename base_type::pointer pointer;
+	typedef typename base_type::const_pointer const_pointer;
+	typedef typename base_type::size_type size_type;
+	typedef typename base_type::difference_type difference_type;
+
+	typedef typename base_type::iterator iterator;
+	typedef typename base_type::const_iterator const_iterator;
+	typedef typename base_type::reverse_iterator reverse_iterator;
+	typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+
+
+	//
+	// Constructors
+
+	static_vector()
+		: base_type()
+	{}
+
+
+	/// Throws length_error if n is more than N.
+	explicit static_vector(size_type n, const T& value = T())
+		: base_type(n, value)
+	{}
+
+
+	/// Throws length_error if the range holds more than N elements.
+	template <class InputIterator>
+	static_vector(InputIterator first, InputIterator last)
+		: base_type()
+	{
+		this->assign(first, last);
+	}
+
+
+	static_vector(const static_vector& v)
+		: base_type(v)
+	{}
+
+
+	/// Moves the elements of v, leaving v empty.
+	static_vector(static_vector&& v) noexcept( dstd::is_nothrow_move_constructible<T>::value )
+		: base_type( dstd::move(v) )
+	{}
+
+
+	//
+	// Assignment
+
+
+	static_vector& operator= (const static_vector& v)
+	{
+		base_type::operator=(v);
+		return *this;
+	}
+
+
+	static_vector& operator= (static_vector&& v) noexcept( dstd::is_nothrow_move_constructible<T>::value )
+	{
+		base_type::operator=( dstd::move(v) );
+		return *this;
+	}
+
+
+	//
+	// Capacity
+
+
+	/// Returns N, the most elements the vector can hold.
+	size_type max_size() const
+	{
+		return N;
+	}
+
+
+	/// Whether the vector holds N elements, so that any insertion would throw length_error.
+	bool full() const
+	{
+		return ( this->size() == N );
+	}
+
+
+	//
+	// Modifiers
+
+
+	void swap(static_vector& v)
+	{
+		base_type::swap(v);
+	}
+};
+
+
+
+//
+// Swap
+
+template <class T, size_t N>
+void dstd::swap(dstd::static_vector<T, N>& v1, dstd::static_vector<T, N>& v2)
+{
+	v1.swap(v2);
+}
+
+
+
+#endif
@@ -9,9 +9,12 @@
 #include <limits>
 
 #include "algorithm.hxx"
+#include "functional.hxx"
 #include "impl/bool_type.hxx"
+#include "impl/growth_policy.hxx"
 #include "iterator.hxx"
 #include "memory.hxx"
+#include "utility.hxx"
 
 
 
@@ -29,6 +32,10 @@ namespace dstd
 	template <class Character, class Traits = dstd::char_traits<Character>, class Allocator = dstd::allocator<Character> > class basic_string;
 	typedef basic_string<char> string;
 	typedef basic_string<wchar_t> wstring;
+	
+	template <class Character, class Traits, class Allocator> bool operator== (const basic_string<Character, Traits, Allocator>& lhs, const basic_string<Character, Traits, Allocator>& rhs);
+	template <class Character, class Traits, class Allocator> bool operator== (const Character* lhs, const basic_string<Character, Traits, Allocator>& rhs);
+	template <class Character, class Traits, class Allocator> bool operator== (const basic_string<Character, Traits, Allocator>& lhs, const Character* rhs);
 }
 
 
@@ -81,7 +88,7 @@ class dstd::char_traits
 		/// Assigns 'a' to the 'count' characters begining at 'p'
 		static char_type* assign(char_type* p, size_t count, char_type a)
 		{
-			for(size_t i = 0; i < count; ++i, ++p)
+			for(size_t i = 0; i < count; ++i)
 			{
 				char_traits::assign(p[i], a);
 			}
@@ -261,53 +268,62 @@ class dstd::basic_string
 		// Constructors
 		
 		explicit basic_string(const Allocator& alloc = Allocator())
-			: a(alloc), n_data(0), n_memory(0), p(0)
+			: a(alloc), n_data(0), n_memory(0), p(0), growth(dstd::grow_double)
 		{
 			this->reserve(7);
 		}
 		
 		basic_string(size_type count, Character c, const Allocator& alloc = Allocator())
-			: a(alloc), n_data(0), n_memory(0), p(0)
+			: a(alloc), n_data(0), n_memory(0), p(0), growth(dstd::grow_double)
 		{
 			this->assign(count, c);
 			if( this->capacity() == 0 ) this->reserve(7);
 		}
 		
 		basic_string(const basic_string& s, size_type pos, size_type count = basic_string::npos, const Allocator& alloc = Allocator())
-			: a(alloc), n_data(0), n_memory(0), p(0)
+			: a(alloc), n_data(0), n_memory(0), p(0), growth(dstd::grow_double)
 		{
 			this->assign(s, pos, count);
 			if( this->capacity() == 0 ) this->reserve(7);
 		}
 		
 		basic_string(const Character* s, size_type count, const Allocator& alloc = Allocator())
-			: a(alloc), n_data(0), n_memory(0), p(0)
+			: a(alloc), n_data(0), n_memory(0), p(0), growth(dstd::grow_double)
 		{
 			this->assign(s, count);
 			if( this->capacity() == 0 ) this->reserve(7);
 		}
 		
 		basic_string(const Character* s, const Allocator& alloc = Allocator())
-			: a(alloc), n_data(0), n_memory(0), p(0)
+			: a(alloc), n_data(0), n_memory(0), p(0), growth(dstd::grow_double)
 		{
 			this->assign(s);
 			if( this->capacity() == 0 ) this->reserve(7);
 		}
 		
 		template <class InputIterator> basic_string(InputIterator first, InputIterator last, const Allocator& alloc = Allocator())
-			: a(alloc), n_data(0), n_memory(0), p(0)
+			: a(alloc), n_data(0), n_memory(0), p(0), growth(dstd::grow_double)
 		{
 			this->assign(first, last);
 			if( this->capacity() == 0 ) this->reserve(7);
 		}
 		
 		basic_string(const basic_string& s)
-			: a(s.get_allocator()), n_data(0), n_memory(0), p(0)
+			: a(s.get_allocator()), n_data(0), n_memory(0), p(0), growth(dstd::grow_double)
 		{
 			this->assign(s);
 			if( this->capacity() == 0 ) this->reserve(7);
 		}
 		
+		/// Takes s's characters and allocator without copying or allocating. s is left empty, owning no memory.
+		basic_string(basic_string&& s) noexcept
+			: a(s.a), n_data(s.n_data), n_memory(s.n_memory), p(s.p), growth(dstd::grow_double)
+		{
+			s.p = basic_string::empty_buffer();
+			s.n_data = 1;
+			s.n_memory = 0;
+		}
+		
 		
 		//
 		// Destructor
@@ -315,6 +331,7 @@ class dstd::basic_string
 		
 		~basic_string()
 		{
+			if( this->n_memory == 0 ) return; // a moved-from string owns no memory
 			this->clear();
 			this->a.destroy(this->p); // the null character
 			this->a.deallocate(this->p, this->n_memory);
@@ -326,6 +343,14 @@ class dstd::basic_string
 		basic_string& operator= (const basic_string& x) { return this->assign(x); }
 		
 		
+		basic_string& operator= (basic_string&& x) noexcept
+		{
+			basic_string temp( dstd::move(x) );
+			this->swap(temp);
+			return *this;
+		}
+		
+		
 		basic_string& operator= (const Character* s) { return this->assign(s); }
 		
 		
@@ -418,24 +443,63 @@ class dstd::basic_string
 		size_type length() const { return this->size(); }
 		
 		
-		size_type max_size() const { return (std::numeric_limits<size_type>::max() - 1); }
+		size_type max_size() const { return (std::numeric_limits<size_type>::max() / sizeof(Character) - 1); }
 		
 		
 		void reserve(size_type n)
 		{
 			// Check if this request is necessary and valid
-			if( n <= this->capacity() ) return;
+			// A string which owns no memory has nowhere to write to, even to keep it empty
+			if( n <= this->capacity() && this->n_memory != 0 ) return;
 			if( n > this->max_size() ) throw dstd::length_error();
 			
 			n += 1; // to account for the null-terminator
 			
 			// Determine how much memory to request
-			size_type n_request = dstd::max<size_type>( this->n_memory, 2 );
-			while( n_request < n )
+			const size_type n_request = dstd::impl::grown_capacity( this->growth, this->n_memory, n, sizeof(Character), this->max_size() + 1 );
+			
+			// Try to extend the current block, so that the characters need not be copied
+			if( this->n_memory != 0 && dstd::impl::resize_in_place(this->a, this->p, this->n_memory, n_request) )
+			{
+				this->n_memory = n_request;
+				return;
+			}
+			
+			this->reallocate(n_request);
+		}
+		
+		
+		/// Reduces the capacity to the size, releasing the unused memory.
+		void shrink_to_fit()
+		{
+			if( this->n_memory == this->n_data || this->n_memory == 0 ) return;
+			
+			if( dstd::impl::resize_in_place(this->a, this->p, this->n_memory, this->n_data) )
 			{
-				n_request *= 2;
+				this->n_memory = this->n_data;
+				return;
 			}
 			
+			this->reallocate(this->n_data);
+		}
+		
+		
+		size_type capacity() const { return ( (this->n_memory == 0) ? 0 : (this->n_memory - 1) ); } // -1 to account for the null-terminator
+		
+		
+		/// Sets how the capacity grows when the string runs out of room. The default is grow_double.
+		/// The policy belongs to this string, and is not copied, moved or swapped with its characters.
+		void set_growth_policy(dstd::growth_policy policy) { this->growth = policy; }
+		
+		
+		dstd::growth_policy get_growth_policy() const { return this->growth; }
+	
+	
+	private:
+		
+		/// Copies the characters, including the null-terminator, to a new block of n_request characters and frees the old block.
+		void reallocate(size_type n_request)
+		{
 			// Request new memory, and copy existing values to new memory
 			pointer new_p = this->a.allocate( n_request );
 			for(size_type i = 0; i < this->n_data; ++i)
@@ -449,7 +513,7 @@ class dstd::basic_string
 			this->p = new_p;
 			this->n_memory = n_request;
 			
-			if( old_p != 0 )
+			if( old_n_memory != 0 )
 			{
 				// Clean up the old memory
 				for(size_type i = 0; i < this->n_data; ++i)
@@ -458,7 +522,7 @@ class dstd::basic_string
 				}
 				this->a.deallocate(old_p, old_n_memory);
 			}
-			else
+			else if( old_p == 0 )
 			{
 				// this is the construction of the string
 				// so make sure there is a null character in place
@@ -466,16 +530,16 @@ class dstd::basic_string
 				this->n_data += 1;
 			}
 		}
-		
-		
-		size_type capacity() const { return ( (this->n_memory == 0) ? 0 : (this->n_memory - 1) ); } // -1 to account for the null-terminator
+	
+	
+	public:
 		
 		
 		//
 		// Operations
 		
 		
-		void clear() { this->erase(); }
+		void clear() { if( this->n_memory != 0 ) this->erase(); }
 		
 		
 		// Insert
@@ -696,7 +760,7 @@ class dstd::basic_string
 			{
 				// The characters being inserted are within this string.
 				// Create a copy before trying anything.
-				return this->replace(pos, count, basic_string(s, s_count));
+				return this->replace(pos, count, basic_string(s, s_count, this->a));
 			}
 			
 			return *this;
@@ -744,7 +808,7 @@ class dstd::basic_string
 		//
 		
 		
-		basic_string substr(size_type pos = 0, size_type count = basic_string::npos) const { return basic_string(*this, pos, count); }
+		basic_string substr(size_type pos = 0, size_type count = basic_string::npos) const { return basic_string(*this, pos, count, this->a); }
 		
 		
 		size_type copy(Character* dest, size_type count, size_type pos = 0) const
@@ -776,6 +840,7 @@ class dstd::basic_string
 			dstd::swap(this->p, x.p);
 			dstd::swap(this->n_data, x.n_data);
 			dstd::swap(this->n_memory, x.n_memory);
+			dstd::swap(this->a, x.a);
 		}
 		
 		
@@ -867,10 +932,20 @@ class dstd::basic_string
 	
 	private:
 		
+		/// The null-terminator of every string which owns no memory, which is where a moved-from string is left.
+		/// It is never written to: any change to such a string first allocates memory of its own.
+		static pointer empty_buffer()
+		{
+			static Character null_character = Character();
+			return &null_character;
+		}
+		
+		
 		allocator_type a;
-		unsigned int n_data;
-		unsigned int n_memory;
+		size_type n_data;
+		size_type n_memory;
 		pointer p;
+		dstd::growth_policy growth;
 };
 
 
@@ -993,21 +1068,21 @@ dstd::basic_string<Character, Traits, Allocator> operator+ (
 
 
 template <class Character, class Traits, class Allocator>
-bool operator== ( const dstd::basic_string<Character, Traits, Allocator>& lhs, const dstd::basic_string<Character, Traits, Allocator>& rhs )
+bool dstd::operator== ( const dstd::basic_string<Character, Traits, Allocator>& lhs, const dstd::basic_string<Character, Traits, Allocator>& rhs )
 {
 	return ( (lhs.length() == rhs.length()) && (lhs.compare(rhs) == 0) );
 }
 
 
 template <class Character, class Traits, class Allocator>
-bool operator== ( const Character* lhs, const dstd::basic_string<Character, Traits, Allocator>& rhs )
+bool dstd::operator== ( const Character* lhs, const dstd::basic_string<Character, Traits, Allocator>& rhs )
 {
 	return ( rhs.compare(lhs) == 0 );
 }
 
 
 template <class Character, class Traits, class Allocator>
-bool operator== ( const dstd::basic_string<Character, Traits, Allocator>& lhs, const Character* rhs )
+bool dstd::operator== ( const dstd::basic_string<Character, Traits, Allocator>& lhs, const Character* rhs )
 {
 	return ( lhs.compare(rhs) == 0 );
 }
@@ -1017,4 +1092,24 @@ bool operator== ( const dstd::basic_string<Character, Traits, Allocator>& lhs, c
 
 
 
+/// Hashes a string by its characters (FNV-1a).
+template <class Character, class Traits, class Allocator>
+class dstd::hash< dstd::basic_string<Character, Traits, Allocator> >
+{
+	public:
+		
+		size_t operator() (const dstd::basic_string<Character, Traits, Allocator>& s) const
+		{
+			size_t h = static_cast<size_t>(2166136261u);
+			for(size_t i = 0; i < s.size(); ++i)
+			{
+				h ^= static_cast<size_t>( Traits::to_int_type(s[i]) );
+				h *= static_cast<size_t>(16777619u);
+			}
+			return h;
+		}
+};
+
+
+
 #endif
@@ -0,0 +1,295 @@
+#ifndef DSTD_TRACKING_ALLOCATOR_HXX
+#define DSTD_TRACKING_ALLOCATOR_HXX
+
+#include <climits>
+
+#include "impl/bit_ops.hxx"
+#include "impl/growth_policy.hxx"
+
+#include "cstddef.hxx"
+#include "limits.hxx"
+#include "memory.hxx"
+#include "utility.hxx"
+
+
+
+namespace dstd
+{
+	class allocation_stats;
+	template <class T, class Allocator> class tracking_allocator;
+}
+
+
+
+//
+// dstd::allocation_stats
+//
+// Counts the allocations made through the tracking_allocators which report to it:
+// how many blocks were allocated and freed, how many bytes are in use now and at most, and how the block sizes are spread.
+// Give each container, or each group of containers, its own allocation_stats to see which of them uses the memory.
+// It is not thread safe.
+
+class dstd::allocation_stats
+{
+	public:
+
+		typedef size_t size_type;
+
+		/// The histogram has a bucket for each power of two.
+		static const size_type histogram_size = sizeof(size_type) * CHAR_BIT;
+
+
+		allocation_stats()
+		{
+			this->reset();
+		}
+
+
+		/// Returns the stats which tracking_allocators report to unless they are given others.
+		static allocation_stats& global()
+		{
+			static allocation_stats stats;
+			return stats;
+		}
+
+
+		/// Returns the number of blocks allocated.
+		size_type allocations() const { return this->n_allocations; }
+
+		/// Returns the number of blocks freed.
+		size_type deallocations() const { return this->n_deallocations; }
+
+		/// Returns the number of bytes allocated and not yet freed.
+		size_type live_bytes() const { return this->n_live_bytes; }
+
+		/// Returns the most bytes that were in use at once.
+		size_type peak_bytes() const { return this->n_peak_bytes; }
+
+		/// Returns the total bytes ever allocated.
+		size_type total_bytes() const { return this->n_total_bytes; }
+
+
+		/// Returns the number of allocations of between 2^k and 2^(k+1) - 1 bytes. Bucket 0 also counts empty allocations.
+		size_type histogram(size_type k) const
+		{
+			return ( k < histogram_size ) ? this->buckets[k] : 0;
+		}
+
+
+		/// Returns the bucket of the histogram which counts blocks of the given size.
+		static size_type bucket(size_type bytes)
+		{
+			return ( bytes == 0 ) ? 0 : dstd::impl::highest_bit_index(bytes);
+		}
+
+
+		/// Forgets everything recorded so far.
+		void reset()
+		{
+			this->n_allocations = 0;
+			this->n_deallocations = 0;
+			this->n_live_bytes = 0;
+			this->n_peak_bytes = 0;
+			this->n_total_bytes = 0;
+			for(size_type k = 0; k != histogram_size; ++k) this->buckets[k] = 0;
+		}
+
+
+		void record_allocation(size_type bytes)
+		{
+			++(this->n_allocations);
+			++(this->buckets[allocation_stats::bucket(bytes)]);
+			this->n_total_bytes += bytes;
+			this->grow(bytes);
+		}
+
+
+		/// Records a block being freed. If its size is not known, pass 0: the block is counted, but not its bytes.
+		void record_deallocation(size_type bytes)
+		{
+			++(this->n_deallocations);
+			this->shrink(bytes);
+		}
+
+
+		/// Records a block changing size without moving.
+		void record_resize(size_type old_bytes, size_type new_bytes)
+		{
+			if( new_bytes > old_bytes )
+			{
+				this->n_total_bytes += new_bytes - old_bytes;
+				this->grow(new_bytes - old_bytes);
+			}
+			else
+			{
+				this->shrink(old_bytes - new_bytes);
+			}
+		}
+
+
+	private:
+
+		allocation_stats(const allocation_stats&);
+		allocation_stats& operator= (const allocation_stats&);
+
+
+		void grow(size_type bytes)
+		{
+			this->n_live_bytes += bytes;
+			if( this->n_live_bytes > this->n_peak_bytes ) this->n_peak_bytes = this->n_live_bytes;
+		}
+
+
+		void shrink(size_type bytes)
+		{
+			this->n_live_bytes -= ( bytes < this->n_live_bytes ) ? bytes : this->n_live_bytes;
+		}
+
+
+		size_type n_allocations;
+		size_type n_deallocations;
+		size_type n_live_bytes;
+		size_type n_peak_bytes;
+		size_type n_total_bytes;
+		size_type buckets[histogram_size];
+};
+
+
+
+//
+// dstd::tracking_allocator
+//
+// Wraps another allocator, dstd::allocator by default, and records every allocation and deallocation in an allocation_stats.
+// Copies, including those obtained through rebind, report to the same stats, so the stats of a map or list include its nodes.
+// Live bytes are only exact if the container passes the size of each block it frees, as the dstd containers do.
+
+template < class T, class Allocator = dstd::allocator<T> >
+class dstd::tracking_allocator
+{
+	public:
+
+		typedef T value_type;
+		typedef T* pointer;
+		typedef T& reference;
+		typedef const T* const_pointer;
+		typedef const T& const_reference;
+
+		template <class OtherType>
+		struct rebind
+		{
+			typedef tracking_allocator< OtherType, typename Allocator::template rebind<OtherType>::other > other;
+		};
+
+
+		/// The alignment of every block, which is that of the wrapped allocator's blocks.
+		static constexpr size_t alignment = dstd::impl::allocator_alignment<Allocator>::value;
+
+
+		/// Constructs an allocator which reports to allocation_stats::global().
+		tracking_allocator(const Allocator& alloc = Allocator())
+			: a(alloc), s( &dstd::allocation_stats::global() )
+		{}
+
+
+		/// Constructs an allocator which reports to stats.
+		tracking_allocator(dstd::allocation_stats& stats, const Allocator& alloc = Allocator())
+			: a(alloc), s(&stats)
+		{}
+
+
+		template <class U, class OtherAllocator>
+		tracking_allocator(const dstd::tracking_allocator<U, OtherAllocator>& other)
+			: a( other.get_allocator() ), s( &other.get_stats() )
+		{}
+
+
+		~tracking_allocator(){}
+
+
+		T* address(T& obj) const
+		{
+			return &obj;
+		}
+
+
+		const T* address(const T& obj) const
+		{
+			return &obj;
+		}
+
+
+		/// Allocates storage for n objects from the wrapped allocator, and records it.
+		T* allocate(size_t n)
+		{
+			T* p = this->a.allocate(n);
+			this->s->record_allocation(n * sizeof(T));
+			return p;
+		}
+
+
+		/// Returns storage for n objects to the wrapped allocator, and records it.
+		void deallocate(T* p, size_t n = 0)
+		{
+			if( p == 0 ) return;
+			this->a.deallocate(p, n);
+			this->s->record_deallocation(n * sizeof(T));
+		}
+
+
+		/// Passes the request on to the wrapped allocator, recording the change in size if it succeeds.
+		bool resize_in_place(T* p, size_t old_n, size_t new_n)
+		{
+			if( ! dstd::impl::resize_in_place(this->a, p, old_n, new_n) ) return false;
+			this->s->record_resize(old_n * sizeof(T), new_n * sizeof(T));
+			return true;
+		}
+
+
+		/// Constructs an object on the location pointed by p, passing args on to its constructor.
+		template <class U, class... Args>
+		void construct(U* p, Args&&... args)
+		{
+			new(p) U( dstd::forward<Args>(args)... );
+		}
+
+
+		/// Destroys in-place the object pointed by p.
+		void destroy(T* p)
+		{
+			p->~T();
+		}
+
+
+		/// Returns the stats this allocator reports to.
+		dstd::allocation_stats& get_stats() const { return *(this->s); }
+
+
+		/// Returns the wrapped allocator.
+		const Allocator& get_allocator() const { return this->a; }
+
+
+	private:
+
+		Allocator a;
+		dstd::allocation_stats* s;
+};
+
+
+
+template <class T, class A, class U, class B>
+bool operator==(const dstd::tracking_allocator<T, A>& a, const dstd::tracking_allocator<U, B>& b)
+{
+	return ( &a.get_stats() == &b.get_stats() && a.get_allocator() == b.get_allocator() );
+}
+
+
+
+template <class T, class A, class U, class B>
+bool operator!=(const dstd::tracking_allocator<T, A>& a, const dstd::tracking_allocator<U, B>& b)
+{
+	return ! (a == b);
+}
+
+
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef DSTD_TYPE_TRAITS_HXX
+#define DSTD_TYPE_TRAITS_HXX
+
+#include <type_traits>
+
+
+
+namespace dstd
+{
+	template <class T> class remove_reference;
+	template <bool Condition, class T = void> class enable_if;
+	template <bool Condition, class T, class F> class conditional;
+	template <class T, class... Args> class is_constructible;
+	template <class T> class is_copy_constructible;
+	template <class T> class is_nothrow_move_constructible;
+	template <class T> class is_trivially_relocatable;
+
+	/// Names a T, to be used only in unevaluated expressions such as decltype, so that a trait can test what a T supports
+	/// without constructing one. It is never defined.
+	template <class T> T&& declval();
+}
+
+
+
+/// Names T with any reference removed, as type.
+template <class T>
+class dstd::remove_reference
+{
+	public:
+
+		typedef T type;
+};
+
+template <class T>
+class dstd::remove_reference<T&>
+{
+	public:
+
+		typedef T type;
+};
+
+template <class T>
+class dstd::remove_reference<T&&>
+{
+	public:
+
+		typedef T type;
+};
+
+
+
+/// Names T as type, only if Condition is true, so that a template using type is discarded otherwise.
+template <bool Condition, class T>
+class dstd::enable_if
+{};
+
+template <class T>
+class dstd::enable_if<true, T>
+{
+	public:
+
+		typedef T type;
+};
+
+
+
+/// Names T as type if Condition is true, and F otherwise.
+template <bool Condition, class T, class F>
+class dstd::conditional
+{
+	public:
+
+		typedef T type;
+};
+
+template <class T, class F>
+class dstd::conditional<false, T, F>
+{
+	public:
+
+		typedef F type;
+};
+
+
+
+/// Whether a T can be constructed from arguments of types Args.
+template <class T, class... Args>
+class dstd::is_constructible : public std::is_constructible<T, Args...>
+{};
+
+
+
+/// Whether a T can be constructed from a const T.
+template <class T>
+class dstd::is_copy_constructible : public std::is_copy_constructible<T>
+{};
+
+
+
+/// Whether a T can be constructed from an rvalue T without throwing.
+template <class T>
+class dstd::is_nothrow_move_constructible : public std::is_nothrow_move_constructible<T>
+{};
+
+
+
+/// Whether an object of type T can be moved to new memory by copying its bytes, after which the old bytes are
+/// simply forgotten rather than destroyed. Containers use memcpy and memmove to move such elements.
+/// This holds for every trivially copyable type. It may be specialised to be true for other types which hold no pointers
+/// into themselves and are not registered anywhere by address, such as most types which only own heap memory.
+template <class T>
+class dstd::is_trivially_relocatable
+{
+	public:
+
+		static const bool value = std::is_trivially_copyable<T>::value;
+};
+
+
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef DSTD_UNORDERED_MAP_HXX
+#define DSTD_UNORDERED_MAP_HXX
+
+
+
+#include "impl/hash_table.hxx"
+
+#include "exception.hxx"
+#include "functional.hxx"
+#include "memory.hxx"
+#include "utility.hxx"
+
+
+
+namespace dstd
+{
+	template < class Key, class T, class Hash = dstd::hash<Key>, class KeyEqual = dstd::equal_to<Key>, class Allocator = dstd::allocator< dstd::pair<Key, T> > > class unordered_map;
+
+	template <class Key, class T, class Hash, class KeyEqual, class Allocator> void swap(unordered_map<Key, T, Hash, KeyEqual, Allocator>& lhs, unordered_map<Key, T, Hash, KeyEqual, Allocator>& rhs);
+}
+
+
+
+//
+// dstd::unordered_map
+//
+// An unordered map of unique keys, stored in an open addressing hash table.
+// Elements live directly in the table's slots, so rehashing invalidates iterators and references to elements,
+// but inserting without rehashing and erasing do not.
+
+template <class Key, class T, class Hash, class KeyEqual, class Allocator>
+class dstd::unordered_map : public dstd::impl::hash_table<Key, dstd::pair<Key, T>, dstd::impl::select_first< dstd::pair<Key, T> >, Hash, KeyEqual, Allocator>
+{
+	private:
+
+		typedef dstd::impl::hash_table<Key, dstd::pair<Key, T>, dstd::impl::select_first< dstd::pair<Key, T> >, Hash, KeyEqual, Allocator> hash_table;
+
+	public:
+
+		typedef typename hash_table::key_type key_type;
+		typedef T mapped_type;
+		typedef typename hash_table::value_type value_type;
+		typedef typename hash_table::size_type size_type;
+		typedef typename hash_table::difference_type difference_type;
+		typedef typename hash_table::hasher hasher;
+		typedef typename hash_table::key_equal key_equal;
+		typedef typename hash_table::allocator_type allocator_type;
+		typedef typename hash_table::iterator iterator;
+		typedef typename hash_table::const_iterator const_iterator;
+
+
+		//
+		// Contructors
+
+
+		/// Constructs an empty map with no elements.
+		explicit unordered_map(size_type bucket_count = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+			: hash_table(bucket_count, hash, equal, alloc)
+		{}
+
+
+		/// Constructs a map with as many elements as the range [first,last),
+		/// with each element constructed from its corresponding element in that range.
+		template <class InputIterator>
+		unordered_map(InputIterator first, InputIterator last, size_type bucket_count = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+			: hash_table(bucket_count, hash, equal, alloc)
+		{
+			this->insert(first, last);
+		}
+
+
+		/// Copy constructor. Constructs a map with a copy of each of the elements in x.
+		unordered_map(const unordered_map& x)
+			: hash_table(x)
+		{}
+
+
+		virtual ~unordered_map() {}
+
+
+		unordered_map& operator= (const unordered_map& x)
+		{
+			hash_table::operator=(x);
+			return *this;
+		}
+
+
+		//
+		// Element Access
+
+
+		/// Access the mapped value of an element with key k.
+		/// If k does not match the key of any element in the container,
+		/// the function inserts a new element with that key and returns a reference to its mapped value.
+		mapped_type& operator[] (const key_type& k)
+		{
+			return this->try_emplace(k).first->second;
+		}
+
+
+		/// Access the mapped value of the element with key k.
+		/// Throws out_of_range if there is no such element.
+		mapped_type& at(const key_type& k)
+		{
+			iterator it = this->find(k);
+			if( it == this->end() ) throw dstd::out_of_range();
+			return it->second;
+		}
+		const mapped_type& at(const key_type& k) const
+		{
+			const_iterator it = this->find(k);
+			if( it == this->end() ) throw dstd::out_of_range();
+			return it->second;
+		}
+
+
+		//
+		// Modifiers
+
+
+		/// Extends the container by inserting a new element, if no element with an equivalent key already exists.
+		/// @returns A pair, with its first member an iterator pointing to either the newly inserted
+		/// element or to the element with an equivalent key already in the map,
+		/// and its second member set to true if a new element was inserted.
+		dstd::pair<iterator, bool> insert(const value_type& value)
+		{
+			return this->insert_unique(value);
+		}
+
+
+		/// Inserts an element with key k and a mapped value constructed from args, if no element with key k exists.
+		/// With no args, the mapped value is value initialised.
+		/// The key is hashed and the table probed once, and nothing is constructed if k already exists.
+		/// @returns A pair, with its first member an iterator to the element with key k,
+		/// and its second member set to true if a new element was inserted.
+		template <class... Args>
+		dstd::pair<iterator, bool> try_emplace(const key_type& k, Args&&... args)
+		{
+			return this->emplace_unique( k, k, mapped_type( dstd::forward<Args>(args)... ) );
+		}
+
+
+		/// Extends the container by inserting a new element, if no element with an equivalent key already exists.
+		/// The hint is ignored.
+		iterator insert(const_iterator hint, const value_type& value)
+		{
+			return this->insert_unique(value).first;
+		}
+
+
+		/// Extends the container by copying elements in the range [first,last).
+		template <class InputIterator>
+		void insert(InputIterator first, InputIterator last)
+		{
+			for( ; first != last; ++first)
+			{
+				this->insert_unique(*first);
+			}
+		}
+
+
+		/// Exchanges the content of the container by the content of x.
+		void swap(unordered_map& x) { hash_table::swap(x); }
+};
+
+
+
+template <class Key, class T, class Hash, class KeyEqual, class Allocator>
+bool operator==(const dstd::unordered_map<Key, T, Hash, KeyEqual, Allocator>& a, const dstd::unordered_map<Key, T, Hash, KeyEqual, Allocator>& b)
+{
+	if( a.size() != b.size() ) return false;
+	for(typename dstd::unordered_map<Key, T, Hash, KeyEqual, Allocator>::const_iterator it = a.begin(); it != a.end(); ++it)
+	{
+		typename dstd::unordered_map<Key, T, Hash, KeyEqual, Allocator>::const_iterator found = b.find(it->first);
+		if( found == b.end() || found->second != it->second ) return false;
+	}
+	return true;
+}
+
+
+
+template <class Key, class T, class Hash, class KeyEqual, class Allocator>
+bool operator!=(const dstd::unordered_map<Key, T, Hash, KeyEqual, Allocator>& a, const dstd::unordered_map<Key, T, Hash, KeyEqual, Allocator>& b)
+{
+	return ! (a == b);
+}
+
+
+
+template <class Key, class T, class Hash, class KeyEqual, class Allocator>
+void dstd::swap(dstd::unordered_map<Key, T, Hash, KeyEqual, Allocator>& lhs, dstd::unordered_map<Key, T, Hash, KeyEqual, Allocator>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+
+
+#endif
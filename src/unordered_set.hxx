@@ -0,0 +1,140 @@
+#ifndef DSTD_UNORDERED_SET_HXX
+#define DSTD_UNORDERED_SET_HXX
+
+
+
+#include "impl/hash_table.hxx"
+
+#include "functional.hxx"
+#include "memory.hxx"
+#include "utility.hxx"
+
+
+
+namespace dstd
+{
+	template < class T, class Hash = dstd::hash<T>, class KeyEqual = dstd::equal_to<T>, class Allocator = dstd::allocator<T> > class unordered_set;
+
+	template <class T, class Hash, class KeyEqual, class Allocator> void swap(unordered_set<T, Hash, KeyEqual, Allocator>& lhs, unordered_set<T, Hash, KeyEqual, Allocator>& rhs);
+}
+
+
+
+//
+// dstd::unordered_set
+//
+// An unordered set of unique values, stored in an open addressing hash table.
+// Rehashing invalidates iterators, but inserting without rehashing and erasing do not.
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+class dstd::unordered_set : public dstd::impl::hash_table<T, T, dstd::impl::identity<T>, Hash, KeyEqual, Allocator>
+{
+	private:
+
+		typedef dstd::impl::hash_table<T, T, dstd::impl::identity<T>, Hash, KeyEqual, Allocator> hash_table;
+
+	public:
+
+		typedef typename hash_table::key_type key_type;
+		typedef typename hash_table::value_type value_type;
+		typedef typename hash_table::size_type size_type;
+		typedef typename hash_table::difference_type difference_type;
+		typedef typename hash_table::hasher hasher;
+		typedef typename hash_table::key_equal key_equal;
+		typedef typename hash_table::allocator_type allocator_type;
+		typedef typename hash_table::iterator iterator;
+		typedef typename hash_table::const_iterator const_iterator;
+
+
+		//
+		// Constructors
+
+
+		/// Constructs an empty set with no elements.
+		explicit unordered_set(size_type bucket_count = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+			: hash_table(bucket_count, hash, equal, alloc)
+		{}
+
+
+		/// Constructs a set with as many elements as the range [first,last),
+		/// with each element constructed from its corresponding element in that range.
+		template <class InputIterator>
+		unordered_set(InputIterator first, InputIterator last, size_type bucket_count = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+			: hash_table(bucket_count, hash, equal, alloc)
+		{
+			this->insert(first, last);
+		}
+
+
+		/// Copy constructor. Constructs a set with a copy of each of the elements in x.
+		unordered_set(const unordered_set& x)
+			: hash_table(x)
+		{}
+
+
+		virtual ~unordered_set() {}
+
+
+		unordered_set& operator= (const unordered_set& x)
+		{
+			hash_table::operator=(x);
+			return *this;
+		}
+
+
+		//
+		// Modifiers
+
+
+		dstd::pair<iterator, bool> insert(const value_type& value) { return this->insert_unique(value); }
+
+
+		/// The hint is ignored.
+		iterator insert(const_iterator hint, const value_type& value) { return this->insert_unique(value).first; }
+
+
+		template <class InputIterator>
+		void insert(InputIterator first, InputIterator last)
+		{
+			for( ; first != last; ++first)
+			{
+				this->insert_unique(*first);
+			}
+		}
+
+
+		void swap(unordered_set& x) { hash_table::swap(x); }
+};
+
+
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+bool operator==(const dstd::unordered_set<T, Hash, KeyEqual, Allocator>& a, const dstd::unordered_set<T, Hash, KeyEqual, Allocator>& b)
+{
+	if( a.size() != b.size() ) return false;
+	for(typename dstd::unordered_set<T, Hash, KeyEqual, Allocator>::const_iterator it = a.begin(); it != a.end(); ++it)
+	{
+		if( b.count(*it) == 0 ) return false;
+	}
+	return true;
+}
+
+
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+bool operator!=(const dstd::unordered_set<T, Hash, KeyEqual, Allocator>& a, const dstd::unordered_set<T, Hash, KeyEqual, Allocator>& b)
+{
+	return ! (a == b);
+}
+
+
+
+template <class T, class Hash, class KeyEqual, class Allocator>
+void dstd::swap(dstd::unordered_set<T, Hash, KeyEqual, Allocator>& lhs, dstd::unordered_set<T, Hash, KeyEqual, Allocator>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef DSTD_UTILITY_HXX
 #define DSTD_UTILITY_HXX
 
+#include "type_traits.hxx"
+
 
 
 namespace dstd
@@ -9,6 +11,11 @@ namespace dstd
 	template <class T1, class T2> pair<T1, T2> make_pair(const T1& a, const T2& b);
 	template <class T> void swap(T& a, T& b);
 	
+	template <class T> typename remove_reference<T>::type&& move(T&& x);
+	template <class T> T&& forward(typename remove_reference<T>::type& x);
+	template <class T> T&& forward(typename remove_reference<T>::type&& x);
+	template <class T> typename conditional< ! is_nothrow_move_constructible<T>::value && is_copy_constructible<T>::value, const T&, T&& >::type move_if_noexcept(T& x);
+	
 	namespace rel_ops
 	{
 		template <class T> bool operator!= (const T& x, const T& y);
@@ -37,13 +44,30 @@ class dstd::pair
 		pair(){};
 		
 		
+		pair(const pair& p) : first( p.first ), second( p.second ) {}
+		
+		
+		pair(pair&& p) noexcept( dstd::is_nothrow_move_constructible<T1>::value && dstd::is_nothrow_move_constructible<T2>::value )
+			: first( dstd::move(p.first) ), second( dstd::move(p.second) )
+		{}
+		
+		
 		template <class U1, class U2>
 		pair(const pair<U1, U2>& p): first( p.first ), second( p.second ) {}
 		
 		
+		template <class U1, class U2>
+		pair(pair<U1, U2>&& p): first( dstd::move(p.first) ), second( dstd::move(p.second) ) {}
+		
+		
 		pair(const first_type& a, const second_type& b) : first(a), second(b) {}
 		
 		
+		/// Constructs first and second from a and b, moving them if they are rvalues.
+		template < class U1, class U2, class = typename dstd::enable_if< dstd::is_constructible<T1, U1&&>::value && dstd::is_constructible<T2, U2&&>::value >::type >
+		pair(U1&& a, U2&& b) : first( dstd::forward<U1>(a) ), second( dstd::forward<U2>(b) ) {}
+		
+		
 		//
 		// Operations
 		
@@ -56,6 +80,14 @@ class dstd::pair
 		}
 		
 		
+		pair& operator= (pair&& p)
+		{
+			this->first = dstd::move(p.first);
+			this->second = dstd::move(p.second);
+			return *this;
+		}
+		
+		
 		//
 		// Data Members
 		
@@ -130,9 +162,46 @@ template <class T1, class T2> dstd::pair<T1, T2> dstd::make_pair(const T1& a, co
 template <class T>
 void dstd::swap(T& a, T& b)
 {
-	T temp = a;
-	a = b;
-	b = temp;
+	T temp = dstd::move(a);
+	a = dstd::move(b);
+	b = dstd::move(temp);
+}
+
+
+
+//
+// move and forward
+
+
+/// Casts x to an rvalue, so that it may be moved from.
+template <class T>
+typename dstd::remove_reference<T>::type&& dstd::move(T&& x)
+{
+	return static_cast<typename dstd::remove_reference<T>::type&&>(x);
+}
+
+
+/// Passes on an argument of a template function with the value category it was passed with.
+template <class T>
+T&& dstd::forward(typename dstd::remove_reference<T>::type& x)
+{
+	return static_cast<T&&>(x);
+}
+
+
+template <class T>
+T&& dstd::forward(typename dstd::remove_reference<T>::type&& x)
+{
+	return static_cast<T&&>(x);
+}
+
+
+/// Casts x to an rvalue, unless moving it might throw and it can be copied instead.
+/// Copying keeps x intact if constructing from it fails, so containers use this when moving elements to new memory.
+template <class T>
+typename dstd::conditional< ! dstd::is_nothrow_move_constructible<T>::value && dstd::is_copy_constructible<T>::value, const T&, T&& >::type dstd::move_if_noexcept(T& x)
+{
+	return dstd::move(x);
 }
 
 
@@ -1,10 +1,7 @@
 #ifndef DSTD_VECTOR_HXX
 #define DSTD_VECTOR_HXX
 
-#include "impl/bool_type.hxx"
-#include "impl/vector_impl.hxx"
-#include "impl/vector_iterator.hxx"
-#include "algorithm.hxx"
+#include "impl/vector_interface.hxx"
 
 
 
@@ -20,21 +17,21 @@ namespace dstd
 // Vector
 
 template < class T, class Allocator = dstd::allocator<T> >
-class dstd::vector : public dstd::impl::vector_impl<T, Allocator>
+class dstd::vector : public dstd::impl::vector_interface<T, Allocator, 0>
 {
 	public:
 	
-	typedef typename impl::vector_impl<T,Allocator>::value_type value_type;
-	typedef typename impl::vector_impl<T,Allocator>::allocator_type allocator_type;
-	typedef typename impl::vector_impl<T,Allocator>::reference reference;
-	typedef typename impl::vector_impl<T,Allocator>::const_reference const_reference;
-	typedef typename impl::vector_impl<T,Allocator>::pointer pointer;
-	typedef typename impl::vector_impl<T,Allocator>::const_pointer const_pointer;
-	typedef typename impl::vector_impl<T,Allocator>::size_type size_type;
-	typedef typename impl::vector_impl<T,Allocator>::difference_type difference_type;
-
-	typedef impl::vector_impl<T,Allocator>::iterator iterator;
-	typedef impl::vector_impl<T,Allocator>::const_iterator const_iterator;
+	typedef typename impl::vector_interface<T,Allocator,0>::value_type value_type;
+	typedef typename impl::vector_interface<T,Allocator,0>::allocator_type allocator_type;
+	typedef typename impl::vector_interface<T,Allocator,0>::reference reference;
+	typedef typename impl::vector_interface<T,Allocator,0>::const_reference const_reference;
+	typedef typename impl::vector_interface<T,Allocator,0>::pointer pointer;
+	typedef typename impl::vector_interface<T,Allocator,0>::const_pointer const_pointer;
+	typedef typename impl::vector_interface<T,Allocator,0>::size_type size_type;
+	typedef typename impl::vector_interface<T,Allocator,0>::difference_type difference_type;
+
+	typedef typename impl::vector_interface<T,Allocator,0>::iterator iterator;
+	typedef typename impl::vector_interface<T,Allocator,0>::const_iterator const_iterator;
 	typedef dstd::reverse_iterator< iterator > reverse_iterator;
 	typedef dstd::reverse_iterator< const_iterator > const_reverse_iterator;
 	
@@ -42,25 +39,38 @@ class dstd::vector : public dstd::impl::vector_impl<T, Allocator>
 	//
 	// Constructors
 	
-	explicit vector()
+	explicit vector(const allocator_type& alloc = allocator_type())
+		: impl::vector_interface<T,Allocator,0>(alloc)
 	{}
 	
 	
-	explicit vector(unsigned int n, const T& value = T())
+	explicit vector(size_type n, const T& value = T(), const allocator_type& alloc = allocator_type())
+		: impl::vector_interface<T,Allocator,0>(alloc)
 	{
-		assign(n, value);
+		this->assign(n, value);
 	}
 	
 	
-	vector(iterator first, iterator last)
+	vector(iterator first, iterator last, const allocator_type& alloc = allocator_type())
+		: impl::vector_interface<T,Allocator,0>(alloc)
 	{
-		assign(first, last);
+		this->assign(first, last);
 	}
 	
 	
+	/// Copy constructor. The new vector uses a copy of v's allocator.
 	vector(const vector& v)
+		: impl::vector_interface<T,Allocator,0>(v.get_allocator())
+	{
+		this->assign(v.begin(), v.end());
+	}
+	
+	
+	/// Move constructor. Takes v's elements and allocator without copying any elements, leaving v empty.
+	vector(vector&& v) noexcept
+		: impl::vector_interface<T,Allocator,0>(v.get_allocator())
 	{
-		assign<const_iterator>(v.begin(), v.end());
+		this->swap(v);
 	}
 	
 	
@@ -76,100 +86,20 @@ class dstd::vector : public dstd::impl::vector_impl<T, Allocator>
 	// Assignment
 	
 	
+	/// Copies the elements of v. The vector keeps its own allocator.
 	vector& operator= (const vector& v)
 	{
-		assign(v.begin(), v.end());
+		this->assign(v.begin(), v.end());
 		return *this;
 	}
 	
 	
-	//
-	// Capacity
-	
-	
-	void resize(size_type n, const T& value = T())
-	{
-		if( n < size() )
-		{
-			iterator first = begin() + n;
-			erase( first, end() );
-		}
-		else if( n > size() )
-		{
-			size_type n_add = n - size();
-			for(unsigned int i = 0; i != n_add; ++i)
-			{
-				push_back(value);
-			}
-		}
-	}
-	
-	
-	//
-	// Element access
-	
-	
-	reference operator[](size_type i)
-	{
-		return p[i];
-	}
-	
-	
-	const_reference operator[](size_type i) const
-	{
-		return p[i];
-	}
-	
-	
-	reference at(size_type i)
-	{
-		if( i >= size() )
-		{
-			throw dstd::out_of_range();
-		}
-		return p[i];
-	}
-	
-	
-	const_reference at(size_type i) const
-	{
-		if( i >= size() )
-		{
-			throw dstd::out_of_range();
-		}
-		return p[i];
-	}
-	
-	
-	reference front()
-	{
-		return p[0];
-	}
-	
-	
-	const_reference front() const
-	{
-		return p[0];
-	}
-
-
-	reference back()
+	/// Takes v's elements, together with the allocator which owns them, leaving v empty.
+	vector& operator= (vector&& v) noexcept
 	{
-		if( empty() )
-		{
-			return front();
-		}
-		return p[size() - 1];
-	}
-	
-	
-	const_reference back() const
-	{
-		if( empty() )
-		{
-			return front();
-		}
-		return p[size() - 1];
+		vector temp( dstd::move(v) );
+		this->swap(temp);
+		return *this;
 	}
 	
 	
@@ -177,207 +107,27 @@ class dstd::vector : public dstd::impl::vector_impl<T, Allocator>
 	// Modifiers
 	
 	
-	template <class InputIterator>
-	void assign(InputIterator first, InputIterator last)
-	{
-		clear();
-		insert(begin(), first, last);
-	}
-	
-	
-	void assign(size_type n, const value_type& value)
-	{
-		clear();
-		insert(begin(), n, value);
-	}
-	
-	
-	void push_back(const value_type& value)
-	{
-		insert(end(), value);
-	}
-	
-	
-	void pop_back()
-	{
-		erase(end() - 1);
-	}
-	
-	
-	iterator insert(iterator position, const value_type& value)
-	{
-		return insert_value(position, 1, value);
-	}
-	
-	
-	void insert(iterator position, size_type n, const value_type& value)
-	{
-		insert_value(position, n, value);
-	}
-	
-	
-	template <class InputIterator>
-	void insert(iterator position, InputIterator first, InputIterator last)
-	{
-		typedef typename dstd::impl::BoolType< std::numeric_limits<InputIterator>::is_integer >::bool_type is_integer;
-		insert_fix( position, first, last, is_integer() );
-	}
-	
-	
-	iterator erase(iterator position)
-	{
-		return erase_range(position, position + 1);
-	}
-
-
-	iterator erase(iterator first, iterator last)
-	{
-		return erase_range(first, last);
-	}
-
-
 	void swap(vector& v)
 	{
-		pointer temp_p = p;
-		size_type temp_n_data = size();
-		size_type temp_n_memory = capacity();
+		pointer temp_p = this->p;
+		size_type temp_n_data = this->size();
+		size_type temp_n_memory = this->capacity();
 		
-		p = v.p;
-		n_data = v.n_data;
-		n_memory = v.n_memory;
+		this->p = v.p;
+		this->n_data = v.n_data;
+		this->n_memory = v.n_memory;
 		
 		v.p = temp_p;
 		v.n_data = temp_n_data;
 		v.n_memory = temp_n_memory;
-	}
-	
-	
-	void clear()		
-	{
-		erase(begin(), end());
-	}
-
-
-private:
-
-
-	iterator insert_fix(iterator position, size_type n, const value_type& value, dstd::impl::TrueType)
-	{
-		return insert_value(position, n, value);
-	}
-
-
-	template <class InputIterator>
-	iterator insert_fix(iterator position, InputIterator first, InputIterator last, dstd::impl::FalseType)
-	{
-		return insert_range(position, first, last);
+		
+		// the memory is exchanged, so the allocators which own it must be too
+		dstd::swap(this->a, v.a);
 	}
 };
 
 
 
-//
-// Vector Operators
-//
-
-template <class T, class Allocator>
-bool operator== (const dstd::vector<T, Allocator>& v1, const dstd::vector<T, Allocator>& v2)
-{
-	if( v1.size() != v2.size() ) return false;
-	for(unsigned int i = 0; i != v1.size(); ++i)
-	{
-		if( v1[i] != v2[i] ) return false;
-	}
-	return true;
-}
-
-
-template <class T, class Allocator>
-bool operator!= (const dstd::vector<T,Allocator>& lhs, const dstd::vector<T,Allocator>& rhs)
-{
-	return ! (lhs == rhs);
-}
-
-
-template <class T, class Allocator>
-bool operator< (const dstd::vector<T,Allocator>& lhs, const dstd::vector<T,Allocator>& rhs)
-{
-	typedef dstd::vector<T,Allocator>::size_type size_type;
-	
-	const size_type n = dstd::min(lhs.size(), rhs.size());
-	
-	for(unsigned int i = 0; i < n; ++i)
-	{
-		if( lhs[i] < rhs[i] )
-		{
-			return true;
-		}
-		else if( rhs[i] < rhs[i] )
-		{
-			return false;
-		}
-	}
-	
-	if( lhs.size() == rhs.size() )
-	{
-		return false; // they vectors are equal
-	}
-	else if( lhs.size() < rhs.size() )
-	{
-		return true;
-	}
-	else
-	{
-		return false;
-	}
-}
-
-
-template <class T, class Allocator>
-bool operator<= (const dstd::vector<T,Allocator>& lhs, const dstd::vector<T,Allocator>& rhs)
-{
-	typedef dstd::vector<T, Allocator>::size_type size_type;
-
-	const size_type n = dstd::min(lhs.size(), rhs.size());
-	
-	for(unsigned int i = 0; i < n; ++i)
-	{
-		if( lhs[i] < rhs[i] )
-		{
-			return true;
-		}
-		else if( rhs[i] < rhs[i] )
-		{
-			return false;
-		}
-	}
-	
-	if( lhs.size() <= rhs.size() )
-	{
-		return true;
-	}
-	else
-	{
-		return false;
-	}
-}
-
-
-template <class T, class Allocator>
-bool operator> (const dstd::vector<T,Allocator>& lhs, const dstd::vector<T,Allocator>& rhs)
-{
-	return ! (lhs <= rhs);
-}
-
-
-template <class T, class Allocator>
-bool operator>= (const dstd::vector<T,Allocator>& lhs, const dstd::vector<T,Allocator>& rhs)
-{
-	return ! (lhs < rhs);
-}
-
-
-
 //
 // Swap
 
@@ -389,4 +139,8 @@ void dstd::swap(dstd::vector<T, Allocator>& v1, dstd::vector<T, Allocator>& v2)
 
 
 
+#include "impl/vector_bool.hxx"
+
+
+
 #endif